@@ -4,118 +4,550 @@
 #include "Bullet/BulletWorldDefinition.h"
 #include "Bullet/BulletBodyComponent.h"
 #include "Bullet/BulletWorldComponent.h"
+#include "Engine/JobPool.h"
+#include "Foundation/Log.h"
+#include "Platform/Timer.h"
+
+#include "BulletCollision/CollisionDispatch/btCollisionObjectWrapper.h"
 
 using namespace Helium;
 
-void InternalTickCallback(btDynamicsWorld *world, btScalar timeStep)
+namespace Helium
 {
-	BulletWorld * pWorld = static_cast<BulletWorld *>( world->getWorldUserInfo() );
-
-	ComponentManager &pComponentManager = *static_cast<BulletWorldComponent *>(world->getWorldUserInfo())->GetComponentManager();
-	for (ComponentIteratorT<HasPhysicalContactsComponent> iter( pComponentManager ); iter.GetBaseComponent(); iter.Advance())
+	// Lets BulletWorld::RestoreState put the manifolds back in the order the snapshot recorded them in. The solver
+	// visits manifolds in dispatcher order, so that order is part of the simulation state.
+	class BulletCollisionDispatcher : public btCollisionDispatcher
 	{
-		//HELIUM_TRACE( TraceLevels::Debug, "iter->m_EndFrameTouching.Clear %d\n", iter->m_EndFrameTouching.GetSize());
-		iter->m_EndFrameTouching.Clear();
-	}
+	public:
+		BulletCollisionDispatcher( btCollisionConfiguration *pCollisionConfiguration )
+			: btCollisionDispatcher( pCollisionConfiguration )
+		{
+		}
 
-	int numManifolds = world->getDispatcher()->getNumManifolds();
-	for (int i=0;i<numManifolds;i++)
+		void SetManifoldOrder( const btAlignedObjectArray< btPersistentManifold * > &rManifolds )
+		{
+			HELIUM_ASSERT( rManifolds.size() == m_manifoldsPtr.size() );
+
+			m_manifoldsPtr = rManifolds;
+			for ( int i = 0; i < m_manifoldsPtr.size(); ++i )
+			{
+				m_manifoldsPtr[ i ]->m_index1a = i;
+			}
+		}
+	};
+
+	// Thin wrapper that exposes the fixed step accumulator so that it can be captured by BulletWorld::SaveState,
+	// and times the phases of each substep for BulletWorldStepStats
+	class BulletDynamicsWorld : public btDiscreteDynamicsWorld
 	{
-		btPersistentManifold* contactManifold =  world->getDispatcher()->getManifoldByIndexInternal(i);
-		const btCollisionObject* obA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
-		const btCollisionObject* obB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
-		
-		BulletBodyComponent *pBodyComponentA = static_cast<BulletBodyComponent *>( obA->getUserPointer() );
-		BulletBodyComponent *pBodyComponentB = static_cast<BulletBodyComponent *>( obB->getUserPointer() );
+	public:
+		BulletDynamicsWorld(
+			btDispatcher *pDispatcher,
+			btBroadphaseInterface *pPairCache,
+			btConstraintSolver *pConstraintSolver,
+			btCollisionConfiguration *pCollisionConfiguration )
+			: btDiscreteDynamicsWorld( pDispatcher, pPairCache, pConstraintSolver, pCollisionConfiguration )
+			, m_IslandCount( 0 )
+		{
+			ResetStepTimings();
+		}
+
+		btScalar GetLocalTime() const { return m_localTime; }
+		void SetLocalTime( btScalar localTime ) { m_localTime = localTime; }
+
+		void ResetStepTimings()
+		{
+			m_CollisionDetectionTicks = 0;
+			m_SolverTicks = 0;
+			m_IntegrationTicks = 0;
+		}
+
+		uint64_t GetCollisionDetectionTicks() const { return m_CollisionDetectionTicks; }
+		uint64_t GetSolverTicks() const { return m_SolverTicks; }
+		uint64_t GetIntegrationTicks() const { return m_IntegrationTicks; }
+		uint32_t GetIslandCount() const { return m_IslandCount; }
+
+		virtual void performDiscreteCollisionDetection()
+		{
+			uint64_t startTicks = Timer::GetTickCount();
+
+			// Same as btCollisionWorld::performDiscreteCollisionDetection, with the pairs found while updating the
+			// bounds put in a fixed order before the broadphase cleanup and the narrowphase see them
+			updateAabbs();
+			SortNewPairs();
+			computeOverlappingPairs();
+			m_dispatcher1->dispatchAllCollisionPairs(
+				m_broadphasePairCache->getOverlappingPairCache(),
+				getDispatchInfo(),
+				m_dispatcher1 );
 
-		bool trackACollisions = pBodyComponentA && pBodyComponentA->ShouldTrackCollisions();
-		bool trackBCollisions = pBodyComponentB && pBodyComponentB->ShouldTrackCollisions();
+			m_CollisionDetectionTicks += Timer::GetTickCount() - startTicks;
+		}
 
-		trackACollisions = pBodyComponentA->GetShouldTrackPhysicalContact( pBodyComponentB );
-		trackBCollisions = pBodyComponentB->GetShouldTrackPhysicalContact( pBodyComponentA );
+	protected:
+		virtual void predictUnconstraintMotion( btScalar timeStep )
+		{
+			uint64_t startTicks = Timer::GetTickCount();
+			btDiscreteDynamicsWorld::predictUnconstraintMotion( timeStep );
+			m_IntegrationTicks += Timer::GetTickCount() - startTicks;
+		}
 
-		if ( trackACollisions || trackBCollisions )
+		virtual void calculateSimulationIslands()
 		{
-			int numContacts = contactManifold->getNumContacts();
+			uint64_t startTicks = Timer::GetTickCount();
+			btDiscreteDynamicsWorld::calculateSimulationIslands();
 
-			if (numContacts)
+			// Only dynamic bodies take part in the union find, so every root is one island
+			btUnionFind &rUnionFind = getSimulationIslandManager()->getUnionFind();
+			uint32_t islandCount = 0;
+			for ( int i = 0; i < rUnionFind.getNumElements(); ++i )
 			{
-				if ( trackACollisions )
+				if ( rUnionFind.isRoot( i ) )
 				{
-					HasPhysicalContactsComponent *pContacts = pBodyComponentA->GetOrCreateHasPhysicalContactsComponent();
-					pContacts->m_EverTouchedThisFrame.Insert( pBodyComponentB->GetEntity() );
-
-					// TODO: Only need to do this on last subtick really
-					pContacts->m_EndFrameTouching.Insert( pBodyComponentB->GetEntity() );
+					++islandCount;
 				}
+			}
+			m_IslandCount = islandCount;
 
-				if ( trackBCollisions )
-				{
-					HasPhysicalContactsComponent *pContacts = pBodyComponentB->GetOrCreateHasPhysicalContactsComponent();
-					pContacts->m_EverTouchedThisFrame.Insert( pBodyComponentA->GetEntity() );
+			m_SolverTicks += Timer::GetTickCount() - startTicks;
+		}
+
+		virtual void solveConstraints( btContactSolverInfo &rSolverInfo )
+		{
+			uint64_t startTicks = Timer::GetTickCount();
+			btDiscreteDynamicsWorld::solveConstraints( rSolverInfo );
+			m_SolverTicks += Timer::GetTickCount() - startTicks;
+		}
 
-					// TODO: Only need to do this on last subtick really
-					pContacts->m_EndFrameTouching.Insert( pBodyComponentA->GetEntity() );
+		virtual void integrateTransforms( btScalar timeStep )
+		{
+			uint64_t startTicks = Timer::GetTickCount();
+			btDiscreteDynamicsWorld::integrateTransforms( timeStep );
+			m_IntegrationTicks += Timer::GetTickCount() - startTicks;
+		}
+
+		virtual void updateActivationState( btScalar timeStep )
+		{
+			uint64_t startTicks = Timer::GetTickCount();
+			btDiscreteDynamicsWorld::updateActivationState( timeStep );
+			m_IntegrationTicks += Timer::GetTickCount() - startTicks;
+		}
+
+	private:
+		// The broadphase appends new pairs in the order its trees happen to be walked, and the tree layout depends
+		// on the whole history of the world. Pairs that have no collision algorithm yet are moved to the end of the
+		// pair array in proxy id order, so the pair order (and the manifold order that follows from it) is the same
+		// for any two worlds with the same state, whether they got there by simulating or by RestoreState.
+		void SortNewPairs()
+		{
+			btOverlappingPairCache *pPairCache = m_broadphasePairCache->getOverlappingPairCache();
+			btBroadphasePairArray &rPairs = pPairCache->getOverlappingPairArray();
+
+			// Walk backwards so each removal only swaps in a pair that is staying where it is
+			btAlignedObjectArray< btBroadphasePair > newPairs;
+			for ( int i = rPairs.size() - 1; i >= 0; --i )
+			{
+				if ( !rPairs[ i ].m_algorithm )
+				{
+					btBroadphasePair pair = rPairs[ i ];
+					newPairs.push_back( pair );
+					pPairCache->removeOverlappingPair( pair.m_pProxy0, pair.m_pProxy1, m_dispatcher1 );
 				}
 			}
 
-			// If we want more complex collision tracking than just touch, we could maybe run the below code given the existence of a "complex touch tracking" flag
-#if 0
-			int numContacts = contactManifold->getNumContacts();
-			for (int j=0;j<numContacts;j++)
+			newPairs.quickSort( btBroadphasePairSortPredicate() );
+
+			for ( int i = 0; i < newPairs.size(); ++i )
+			{
+				pPairCache->addOverlappingPair( newPairs[ i ].m_pProxy0, newPairs[ i ].m_pProxy1 );
+			}
+		}
+
+		uint64_t m_CollisionDetectionTicks;
+		uint64_t m_SolverTicks;
+		uint64_t m_IntegrationTicks;
+		uint32_t m_IslandCount;
+	};
+}
+
+namespace
+{
+	static const uint32_t s_StateMagic = 0x54535748; // 'HWST'
+	static const uint32_t s_StateVersion = 2;
+
+	struct BulletStateHeader
+	{
+		uint32_t m_Magic;
+		uint32_t m_Version;
+		uint32_t m_ObjectCount;
+		uint32_t m_PairCount;
+		uint32_t m_ManifoldCount;
+		uint32_t m_ManifoldPointSize;
+		uint32_t m_SolverSeed;
+		btScalar m_LocalTime;
+	};
+
+	// Bookkeeping of btDbvtBroadphase that decides when pairs are found and dropped
+	struct BulletBroadphaseState
+	{
+		int32_t m_StageCurrent;
+		int32_t m_NewPairs;
+		int32_t m_FixedLeft;
+		int32_t m_Pid;
+		int32_t m_Cid;
+		int32_t m_Gid;
+		uint32_t m_UpdatesCall;
+		uint32_t m_UpdatesDone;
+		btScalar m_UpdatesRatio;
+		int32_t m_NeedCleanup;
+	};
+
+	// Stored through the bullet serialization structs so the buffer has no alignment requirements
+	struct BulletObjectState
+	{
+		btTransformData m_WorldTransform;
+		btTransformData m_InterpolationWorldTransform;
+		btTransformData m_MotionStateTransform;
+		btVector3Data m_InterpolationLinearVelocity;
+		btVector3Data m_InterpolationAngularVelocity;
+		btVector3Data m_LinearVelocity;
+		btVector3Data m_AngularVelocity;
+		btVector3Data m_TotalForce;
+		btVector3Data m_TotalTorque;
+		btVector3Data m_ProxyAabbMin;
+		btVector3Data m_ProxyAabbMax;
+		btVector3Data m_LeafVolumeMin;
+		btVector3Data m_LeafVolumeMax;
+		btScalar m_DeactivationTime;
+		btScalar m_HitFraction;
+		int32_t m_ActivationState;
+		int32_t m_HasMotionState;
+		int32_t m_ProxyUniqueId;
+		int32_t m_ProxyStage;
+	};
+
+	// One record per overlapping pair, in pair cache order
+	struct BulletPairState
+	{
+		int32_t m_ObjectIndex0;
+		int32_t m_ObjectIndex1;
+		int32_t m_HasAlgorithm;
+	};
+
+	// One record per manifold, in dispatcher order, followed by m_ContactCount raw btManifoldPoint records
+	struct BulletManifoldState
+	{
+		int32_t m_ObjectIndexA;
+		int32_t m_ObjectIndexB;
+		int32_t m_ContactCount;
+	};
+
+	// Manifolds are matched between the snapshot and the rebuilt world by body pair, then by the order in
+	// which they appeared for that pair (compound shapes produce several manifolds per pair).
+	struct BulletManifoldKey
+	{
+		int32_t m_ObjectIndexA;
+		int32_t m_ObjectIndexB;
+		int32_t m_Sequence;
+		const void *m_pData;
+
+		bool IsSamePair( const BulletManifoldKey &rOther ) const
+		{
+			return m_ObjectIndexA == rOther.m_ObjectIndexA && m_ObjectIndexB == rOther.m_ObjectIndexB;
+		}
+	};
+
+	struct BulletManifoldKeyLess
+	{
+		bool operator()( const BulletManifoldKey &rA, const BulletManifoldKey &rB ) const
+		{
+			if ( rA.m_ObjectIndexA != rB.m_ObjectIndexA )
 			{
-				HELIUM_TRACE(
-					TraceLevels::Debug,
-					"%d\n",
-					numContacts);
+				return rA.m_ObjectIndexA < rB.m_ObjectIndexA;
+			}
 
-				btManifoldPoint& pt = contactManifold->getContactPoint(j);
-				if (pt.getDistance()<0.f)
-				{
-					Simd::Vector3 ptA;
-					Simd::Vector3 ptB;
-					Simd::Vector3 normalB;
-
-					ConvertFromBullet( pt.getPositionWorldOnA(), ptA );
-					ConvertFromBullet( pt.getPositionWorldOnB(), ptB );
-					ConvertFromBullet( pt.m_normalWorldOnB, normalB );
-
-					if ( trackACollisions )
-					{
-						HasPhysicalContactsComponent *pContacts = pBodyComponentA->GetOrCreateHasPhysicalContactsComponent();
-						ContactInfo *pInfo = pContacts->CreateContact();
-						pInfo->m_pEntity = pBodyComponentB->GetEntity();
-						pInfo->m_OurPosition = ptA;
-						pInfo->m_TheirPosition = ptB;
-						pInfo->m_Normal = normalB;
-					}
-
-					if ( trackBCollisions )
-					{
-						Simd::Vector3 normalA;
-						normalB.GetNegated( normalA );
-
-						HasPhysicalContactsComponent *pContacts = pBodyComponentB->GetOrCreateHasPhysicalContactsComponent();
-						ContactInfo *pInfo = pContacts->CreateContact();
-						pInfo->m_pEntity = pBodyComponentA->GetEntity();
-						pInfo->m_OurPosition = ptB;
-						pInfo->m_TheirPosition = ptA;
-						pInfo->m_Normal = normalA;
-					}
-				}
+			if ( rA.m_ObjectIndexB != rB.m_ObjectIndexB )
+			{
+				return rA.m_ObjectIndexB < rB.m_ObjectIndexB;
 			}
-#endif
+
+			return rA.m_Sequence < rB.m_Sequence;
+		}
+	};
+
+	// Same as the stage list helpers private to btDbvtBroadphase.cpp
+	void UnlinkProxy( btDbvtProxy *pProxy, btDbvtProxy *&rpList )
+	{
+		if ( pProxy->links[ 0 ] )
+		{
+			pProxy->links[ 0 ]->links[ 1 ] = pProxy->links[ 1 ];
+		}
+		else
+		{
+			rpList = pProxy->links[ 1 ];
+		}
+
+		if ( pProxy->links[ 1 ] )
+		{
+			pProxy->links[ 1 ]->links[ 0 ] = pProxy->links[ 0 ];
 		}
 	}
+
+	void LinkProxy( btDbvtProxy *pProxy, btDbvtProxy *&rpList )
+	{
+		pProxy->links[ 0 ] = NULL;
+		pProxy->links[ 1 ] = rpList;
+		if ( rpList )
+		{
+			rpList->links[ 0 ] = pProxy;
+		}
+		rpList = pProxy;
+	}
+
+	void BuildObjectIndexMap( btCollisionObjectArray &rObjects, btHashMap< btHashPtr, int32_t > &rObjectIndices )
+	{
+		rObjectIndices.clear();
+		for ( int i = 0; i < rObjects.size(); ++i )
+		{
+			rObjectIndices.insert( btHashPtr( rObjects[ i ] ), i );
+		}
+	}
+
+	void SaveObjectState( const btCollisionObject *pObject, BulletObjectState &rState )
+	{
+		MemoryZero( &rState, sizeof( rState ) );
+
+		pObject->getWorldTransform().serialize( rState.m_WorldTransform );
+		pObject->getInterpolationWorldTransform().serialize( rState.m_InterpolationWorldTransform );
+		pObject->getInterpolationLinearVelocity().serialize( rState.m_InterpolationLinearVelocity );
+		pObject->getInterpolationAngularVelocity().serialize( rState.m_InterpolationAngularVelocity );
+		rState.m_DeactivationTime = pObject->getDeactivationTime();
+		rState.m_HitFraction = pObject->getHitFraction();
+		rState.m_ActivationState = pObject->getActivationState();
+
+		const btDbvtProxy *pProxy = static_cast< const btDbvtProxy * >( pObject->getBroadphaseHandle() );
+		HELIUM_ASSERT( pProxy );
+		pProxy->m_aabbMin.serialize( rState.m_ProxyAabbMin );
+		pProxy->m_aabbMax.serialize( rState.m_ProxyAabbMax );
+		pProxy->leaf->volume.Mins().serialize( rState.m_LeafVolumeMin );
+		pProxy->leaf->volume.Maxs().serialize( rState.m_LeafVolumeMax );
+		rState.m_ProxyUniqueId = pProxy->m_uniqueId;
+		rState.m_ProxyStage = pProxy->stage;
+
+		const btRigidBody *pBody = btRigidBody::upcast( pObject );
+		if ( pBody )
+		{
+			pBody->getLinearVelocity().serialize( rState.m_LinearVelocity );
+			pBody->getAngularVelocity().serialize( rState.m_AngularVelocity );
+			pBody->getTotalForce().serialize( rState.m_TotalForce );
+			pBody->getTotalTorque().serialize( rState.m_TotalTorque );
+
+			if ( pBody->getMotionState() )
+			{
+				btTransform motionStateTransform;
+				pBody->getMotionState()->getWorldTransform( motionStateTransform );
+				motionStateTransform.serialize( rState.m_MotionStateTransform );
+				rState.m_HasMotionState = 1;
+			}
+		}
+	}
+
+	void RestoreObjectState( btCollisionObject *pObject, const BulletObjectState &rState )
+	{
+		btTransform transform;
+		btVector3 vector;
+
+		btRigidBody *pBody = btRigidBody::upcast( pObject );
+		transform.deSerialize( rState.m_WorldTransform );
+		if ( pBody )
+		{
+			// Also refreshes the world space inertia tensor
+			pBody->setCenterOfMassTransform( transform );
+		}
+		else
+		{
+			pObject->setWorldTransform( transform );
+		}
+
+		transform.deSerialize( rState.m_InterpolationWorldTransform );
+		pObject->setInterpolationWorldTransform( transform );
+		vector.deSerialize( rState.m_InterpolationLinearVelocity );
+		pObject->setInterpolationLinearVelocity( vector );
+		vector.deSerialize( rState.m_InterpolationAngularVelocity );
+		pObject->setInterpolationAngularVelocity( vector );
+		pObject->setHitFraction( rState.m_HitFraction );
+
+		if ( pBody )
+		{
+			vector.deSerialize( rState.m_LinearVelocity );
+			pBody->setLinearVelocity( vector );
+			vector.deSerialize( rState.m_AngularVelocity );
+			pBody->setAngularVelocity( vector );
+
+			// Forces are stored with the linear and angular factors already applied, and those factors are
+			// always either zero or one, so re-applying them is lossless.
+			pBody->clearForces();
+			vector.deSerialize( rState.m_TotalForce );
+			pBody->applyCentralForce( vector );
+			vector.deSerialize( rState.m_TotalTorque );
+			pBody->applyTorque( vector );
+
+			if ( rState.m_HasMotionState && pBody->getMotionState() )
+			{
+				transform.deSerialize( rState.m_MotionStateTransform );
+				pBody->getMotionState()->setWorldTransform( transform );
+			}
+		}
+
+		pObject->forceActivationState( rState.m_ActivationState );
+		pObject->setDeactivationTime( rState.m_DeactivationTime );
+	}
+}
+
+/// Number of manifolds scanned by each contact gathering job.
+static const int CONTACT_GATHER_JOB_MANIFOLD_COUNT = 256;
+
+namespace
+{
+	struct GatherContactsJobData
+	{
+		btDispatcher *m_pDispatcher;
+		int m_ManifoldCount;
+		DynamicArray< PhysicalContactCandidate > *m_pBuffers;
+	};
+
+	// Scans one chunk of manifolds for contacts that either body wants to track. This runs on the job pool, so it
+	// must only read body state; anything that touches components is left to the merge step.
+	void GatherContactsJob( void *pData, size_t chunkIndex )
+	{
+		GatherContactsJobData &rData = *static_cast< GatherContactsJobData * >( pData );
+		DynamicArray< PhysicalContactCandidate > &rBuffer = rData.m_pBuffers[ chunkIndex ];
+		rBuffer.Resize( 0 );
+
+		int beginIndex = static_cast< int >( chunkIndex ) * CONTACT_GATHER_JOB_MANIFOLD_COUNT;
+		int endIndex = Min( beginIndex + CONTACT_GATHER_JOB_MANIFOLD_COUNT, rData.m_ManifoldCount );
+		for ( int i = beginIndex; i < endIndex; ++i )
+		{
+			btPersistentManifold* contactManifold = rData.m_pDispatcher->getManifoldByIndexInternal(i);
+			if ( !contactManifold->getNumContacts() )
+			{
+				continue;
+			}
+
+			const btCollisionObject* obA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
+			const btCollisionObject* obB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
+
+			BulletBodyComponent *pBodyComponentA = static_cast<BulletBodyComponent *>( obA->getUserPointer() );
+			BulletBodyComponent *pBodyComponentB = static_cast<BulletBodyComponent *>( obB->getUserPointer() );
+			if ( !pBodyComponentA || !pBodyComponentB )
+			{
+				continue;
+			}
+
+			// If we want more complex collision tracking than just touch, the contact points could be captured
+			// into the candidate here given the existence of a "complex touch tracking" flag
+			if ( pBodyComponentA->GetShouldTrackPhysicalContact( pBodyComponentB ) )
+			{
+				PhysicalContactCandidate candidate = { pBodyComponentA, pBodyComponentB };
+				rBuffer.Push( candidate );
+			}
+
+			if ( pBodyComponentB->GetShouldTrackPhysicalContact( pBodyComponentA ) )
+			{
+				PhysicalContactCandidate candidate = { pBodyComponentB, pBodyComponentA };
+				rBuffer.Push( candidate );
+			}
+		}
+	}
+}
+
+void InternalTickCallback(btDynamicsWorld *world, btScalar timeStep)
+{
+	BulletWorldComponent *pWorldComponent = static_cast<BulletWorldComponent *>( world->getWorldUserInfo() );
+	if ( !pWorldComponent )
+	{
+		// Worlds that are not owned by a component (tools, tests) have no contacts to track
+		return;
+	}
+
+	ComponentManager &pComponentManager = *pWorldComponent->GetComponentManager();
+	for (ComponentIteratorT<HasPhysicalContactsComponent> iter( pComponentManager ); iter.GetBaseComponent(); iter.Advance())
+	{
+		//HELIUM_TRACE( TraceLevels::Debug, "iter->m_EndFrameTouching.Clear %d\n", iter->m_EndFrameTouching.GetSize());
+		iter->m_EndFrameTouching.Clear();
+	}
+
+	// Gather candidate contacts in parallel, each chunk of manifolds into its own buffer
+	GatherContactsJobData jobData;
+	jobData.m_pDispatcher = world->getDispatcher();
+	jobData.m_ManifoldCount = jobData.m_pDispatcher->getNumManifolds();
+
+	size_t chunkCount = static_cast< size_t >( ( jobData.m_ManifoldCount + CONTACT_GATHER_JOB_MANIFOLD_COUNT - 1 ) / CONTACT_GATHER_JOB_MANIFOLD_COUNT );
+	DynamicArray< DynamicArray< PhysicalContactCandidate > > &rBuffers = pWorldComponent->GetContactCandidateBuffers();
+	if ( rBuffers.GetSize() < chunkCount )
+	{
+		rBuffers.Resize( chunkCount );
+	}
+
+	jobData.m_pBuffers = rBuffers.GetData();
+	JobPool::GetStaticInstance().Run( &GatherContactsJob, &jobData, chunkCount );
+
+	// Merge in chunk order so results match a serial walk of the manifolds. This is the only place contact
+	// components get created, so allocation never happens from a worker thread.
+	for ( size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex )
+	{
+		DynamicArray< PhysicalContactCandidate > &rBuffer = rBuffers[ chunkIndex ];
+		for ( size_t i = 0; i < rBuffer.GetSize(); ++i )
+		{
+			const PhysicalContactCandidate &rCandidate = rBuffer[ i ];
+			Entity *pOtherEntity = rCandidate.m_pOtherBodyComponent->GetEntity();
+
+			HasPhysicalContactsComponent *pContacts = rCandidate.m_pBodyComponent->GetOrCreateHasPhysicalContactsComponent();
+			pContacts->m_EverTouchedThisFrame.Insert( pOtherEntity );
+
+			// TODO: Only need to do this on last subtick really
+			pContacts->m_EndFrameTouching.Insert( pOtherEntity );
+		}
+	}
+}
+
+BulletWorldStepStats::BulletWorldStepStats()
+	: m_SubStepCount( 0 )
+	, m_OverlappingPairCount( 0 )
+	, m_ManifoldCount( 0 )
+	, m_ContactCount( 0 )
+	, m_ActiveBodyCount( 0 )
+	, m_IslandCount( 0 )
+	, m_CollisionDetectionMilliseconds( 0.0f )
+	, m_SolverMilliseconds( 0.0f )
+	, m_IntegrationMilliseconds( 0.0f )
+	, m_TotalMilliseconds( 0.0f )
+{
+
+}
+
+BulletWorld::BulletWorld()
+	: m_CollisionConfiguration( NULL )
+	, m_Dispatcher( NULL )
+	, m_OverlappingPairCache( NULL )
+	, m_Solver( NULL )
+	, m_DynamicsWorld( NULL )
+	, m_MaxSubSteps( 10 )
+	, m_ProfileSteps( false )
+{
+
 }
 
 void BulletWorld::Initialize(const BulletWorldDefinition &rWorldDefinition)
 {	
+	m_MaxSubSteps = rWorldDefinition.m_MaxSubSteps;
+	m_ProfileSteps = rWorldDefinition.m_ProfileSteps;
+
 	// collision configuration contains default setup for memory, collision setup. Advanced users can create their own configuration.
 	m_CollisionConfiguration = new btDefaultCollisionConfiguration();
 
 	// use the default collision dispatcher. For parallel processing you can use a diffent dispatcher (see Extras/BulletMultiThreaded)
-	m_Dispatcher = new btCollisionDispatcher(m_CollisionConfiguration);
+	m_Dispatcher = new BulletCollisionDispatcher(m_CollisionConfiguration);
 
 	// btDbvtBroadphase is a good general purpose broadphase. You can also try out btAxis3Sweep.
 	m_OverlappingPairCache = new btDbvtBroadphase();
@@ -123,7 +555,7 @@ void BulletWorld::Initialize(const BulletWorldDefinition &rWorldDefinition)
 	// the default constraint solver. For parallel processing you can use a different solver (see Extras/BulletMultiThreaded)
 	m_Solver = new btSequentialImpulseConstraintSolver;
 	
-	m_DynamicsWorld = new btDiscreteDynamicsWorld(
+	m_DynamicsWorld = new BulletDynamicsWorld(
 		m_Dispatcher,
 		m_OverlappingPairCache,
 		m_Solver,
@@ -134,7 +566,7 @@ void BulletWorld::Initialize(const BulletWorldDefinition &rWorldDefinition)
 	ConvertToBullet(rWorldDefinition.m_Gravity, gravity);
 
 	m_DynamicsWorld->setGravity(gravity);
-	m_DynamicsWorld->setInternalTickCallback(&InternalTickCallback, this, false);
+	m_DynamicsWorld->setInternalTickCallback(&InternalTickCallback, NULL, false);
 }
 
 BulletWorld::~BulletWorld()
@@ -148,5 +580,539 @@ BulletWorld::~BulletWorld()
 
 void BulletWorld::Simulate( float dt )
 {
-	m_DynamicsWorld->stepSimulation(dt,10);
+	BulletDynamicsWorld *pWorld = static_cast< BulletDynamicsWorld * >( m_DynamicsWorld );
+	pWorld->ResetStepTimings();
+
+	uint64_t startTicks = Timer::GetTickCount();
+	int subStepCount = m_DynamicsWorld->stepSimulation( dt, static_cast< int >( m_MaxSubSteps ) );
+	uint64_t totalTicks = Timer::GetTickCount() - startTicks;
+
+	m_StepStats.m_SubStepCount = static_cast< uint32_t >( subStepCount );
+	m_StepStats.m_OverlappingPairCount = static_cast< uint32_t >( m_OverlappingPairCache->getOverlappingPairCache()->getNumOverlappingPairs() );
+	m_StepStats.m_IslandCount = pWorld->GetIslandCount();
+	m_StepStats.m_CollisionDetectionMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( pWorld->GetCollisionDetectionTicks() ) );
+	m_StepStats.m_SolverMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( pWorld->GetSolverTicks() ) );
+	m_StepStats.m_IntegrationMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( pWorld->GetIntegrationTicks() ) );
+	m_StepStats.m_TotalMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( totalTicks ) );
+
+	uint32_t contactCount = 0;
+	int numManifolds = m_Dispatcher->getNumManifolds();
+	for ( int i = 0; i < numManifolds; ++i )
+	{
+		contactCount += static_cast< uint32_t >( m_Dispatcher->getManifoldByIndexInternal( i )->getNumContacts() );
+	}
+	m_StepStats.m_ManifoldCount = static_cast< uint32_t >( numManifolds );
+	m_StepStats.m_ContactCount = contactCount;
+
+	uint32_t activeBodyCount = 0;
+	btCollisionObjectArray &rObjects = m_DynamicsWorld->getCollisionObjectArray();
+	for ( int i = 0; i < rObjects.size(); ++i )
+	{
+		if ( !rObjects[ i ]->isStaticOrKinematicObject() && rObjects[ i ]->isActive() )
+		{
+			++activeBodyCount;
+		}
+	}
+	m_StepStats.m_ActiveBodyCount = activeBodyCount;
+
+	if ( m_ProfileSteps )
+	{
+		Log::Profile(
+			TXT( "BulletWorld step: %" ) PRIu32 TXT( " substeps, %" ) PRIu32 TXT( " pairs, %" ) PRIu32 TXT( " manifolds, %" ) PRIu32 TXT( " contacts, %" )
+			PRIu32 TXT( " active bodies, %" ) PRIu32 TXT( " islands; collision %fms, solver %fms, integration %fms, total %fms\n" ),
+			m_StepStats.m_SubStepCount,
+			m_StepStats.m_OverlappingPairCount,
+			m_StepStats.m_ManifoldCount,
+			m_StepStats.m_ContactCount,
+			m_StepStats.m_ActiveBodyCount,
+			m_StepStats.m_IslandCount,
+			m_StepStats.m_CollisionDetectionMilliseconds,
+			m_StepStats.m_SolverMilliseconds,
+			m_StepStats.m_IntegrationMilliseconds,
+			m_StepStats.m_TotalMilliseconds );
+	}
+}
+
+size_t BulletWorld::GetStateSize() const
+{
+	size_t stateSize = sizeof( BulletStateHeader ) + sizeof( BulletBroadphaseState );
+	stateSize += static_cast< size_t >( m_DynamicsWorld->getNumCollisionObjects() ) * sizeof( BulletObjectState );
+	int numPairs = m_OverlappingPairCache->getOverlappingPairCache()->getNumOverlappingPairs();
+	stateSize += static_cast< size_t >( numPairs ) * sizeof( BulletPairState );
+
+	int numManifolds = m_Dispatcher->getNumManifolds();
+	for ( int i = 0; i < numManifolds; ++i )
+	{
+		const btPersistentManifold *pManifold = m_Dispatcher->getManifoldByIndexInternal( i );
+		stateSize += sizeof( BulletManifoldState );
+		stateSize += static_cast< size_t >( pManifold->getNumContacts() ) * sizeof( btManifoldPoint );
+	}
+
+	return stateSize;
+}
+
+size_t BulletWorld::SaveState( void *pBuffer, size_t bufferSize ) const
+{
+	HELIUM_ASSERT( pBuffer );
+
+	size_t stateSize = GetStateSize();
+	if ( bufferSize < stateSize )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"BulletWorld::SaveState - Buffer size (%" PRIuSZ ") is smaller than the state size (%" PRIuSZ ").\n",
+			bufferSize,
+			stateSize );
+
+		return 0;
+	}
+
+	BulletDynamicsWorld *pWorld = static_cast< BulletDynamicsWorld * >( m_DynamicsWorld );
+	btCollisionObjectArray &rObjects = pWorld->getCollisionObjectArray();
+	const btDbvtBroadphase *pBroadphase = static_cast< const btDbvtBroadphase * >( m_OverlappingPairCache );
+	const btOverlappingPairCache *pPairCache = pBroadphase->getOverlappingPairCache();
+
+	uint8_t *pCursor = static_cast< uint8_t * >( pBuffer );
+
+	BulletStateHeader header;
+	MemoryZero( &header, sizeof( header ) );
+	header.m_Magic = s_StateMagic;
+	header.m_Version = s_StateVersion;
+	header.m_ObjectCount = static_cast< uint32_t >( rObjects.size() );
+	header.m_PairCount = static_cast< uint32_t >( pPairCache->getNumOverlappingPairs() );
+	header.m_ManifoldCount = static_cast< uint32_t >( m_Dispatcher->getNumManifolds() );
+	header.m_ManifoldPointSize = static_cast< uint32_t >( sizeof( btManifoldPoint ) );
+	header.m_SolverSeed = static_cast< uint32_t >( m_Solver->getRandSeed() );
+	header.m_LocalTime = pWorld->GetLocalTime();
+	MemoryCopy( pCursor, &header, sizeof( header ) );
+	pCursor += sizeof( header );
+
+	BulletBroadphaseState broadphaseState;
+	MemoryZero( &broadphaseState, sizeof( broadphaseState ) );
+	broadphaseState.m_StageCurrent = pBroadphase->m_stageCurrent;
+	broadphaseState.m_NewPairs = pBroadphase->m_newpairs;
+	broadphaseState.m_FixedLeft = pBroadphase->m_fixedleft;
+	broadphaseState.m_Pid = pBroadphase->m_pid;
+	broadphaseState.m_Cid = pBroadphase->m_cid;
+	broadphaseState.m_Gid = pBroadphase->m_gid;
+	broadphaseState.m_UpdatesCall = pBroadphase->m_updates_call;
+	broadphaseState.m_UpdatesDone = pBroadphase->m_updates_done;
+	broadphaseState.m_UpdatesRatio = pBroadphase->m_updates_ratio;
+	broadphaseState.m_NeedCleanup = pBroadphase->m_needcleanup ? 1 : 0;
+	MemoryCopy( pCursor, &broadphaseState, sizeof( broadphaseState ) );
+	pCursor += sizeof( broadphaseState );
+
+	for ( int i = 0; i < rObjects.size(); ++i )
+	{
+		BulletObjectState objectState;
+		SaveObjectState( rObjects[ i ], objectState );
+		MemoryCopy( pCursor, &objectState, sizeof( objectState ) );
+		pCursor += sizeof( objectState );
+	}
+
+	btHashMap< btHashPtr, int32_t > objectIndices;
+	BuildObjectIndexMap( rObjects, objectIndices );
+
+	// Pairs and manifolds are written in the order the broadphase and the dispatcher hold them. Both orders decide
+	// which pairs the broadphase cleans up next and the order the solver visits contacts in.
+	const btBroadphasePair *pPairs = pPairCache->getOverlappingPairArrayPtr();
+	for ( uint32_t i = 0; i < header.m_PairCount; ++i )
+	{
+		BulletPairState pairState;
+		pairState.m_ObjectIndex0 = *objectIndices.find( btHashPtr( pPairs[ i ].m_pProxy0->m_clientObject ) );
+		pairState.m_ObjectIndex1 = *objectIndices.find( btHashPtr( pPairs[ i ].m_pProxy1->m_clientObject ) );
+		pairState.m_HasAlgorithm = pPairs[ i ].m_algorithm ? 1 : 0;
+		MemoryCopy( pCursor, &pairState, sizeof( pairState ) );
+		pCursor += sizeof( pairState );
+	}
+
+	for ( uint32_t i = 0; i < header.m_ManifoldCount; ++i )
+	{
+		const btPersistentManifold *pManifold = m_Dispatcher->getManifoldByIndexInternal( static_cast< int >( i ) );
+
+		BulletManifoldState manifoldState;
+		manifoldState.m_ObjectIndexA = *objectIndices.find( btHashPtr( pManifold->getBody0() ) );
+		manifoldState.m_ObjectIndexB = *objectIndices.find( btHashPtr( pManifold->getBody1() ) );
+		manifoldState.m_ContactCount = pManifold->getNumContacts();
+		MemoryCopy( pCursor, &manifoldState, sizeof( manifoldState ) );
+		pCursor += sizeof( manifoldState );
+
+		for ( int j = 0; j < manifoldState.m_ContactCount; ++j )
+		{
+			btManifoldPoint point = pManifold->getContactPoint( j );
+			point.m_userPersistentData = NULL;
+			MemoryCopy( pCursor, &point, sizeof( point ) );
+			pCursor += sizeof( point );
+		}
+	}
+
+	HELIUM_ASSERT( static_cast< size_t >( pCursor - static_cast< uint8_t * >( pBuffer ) ) == stateSize );
+
+	return stateSize;
+}
+
+bool BulletWorld::RestoreState( const void *pBuffer, size_t bufferSize )
+{
+	HELIUM_ASSERT( pBuffer );
+
+	const uint8_t *pCursor = static_cast< const uint8_t * >( pBuffer );
+	const uint8_t *pEnd = pCursor + bufferSize;
+
+	BulletStateHeader header;
+	if ( bufferSize < sizeof( header ) )
+	{
+		HELIUM_TRACE( TraceLevels::Error, "BulletWorld::RestoreState - Buffer is too small to contain a physics state.\n" );
+		return false;
+	}
+
+	MemoryCopy( &header, pCursor, sizeof( header ) );
+	pCursor += sizeof( header );
+
+	if ( header.m_Magic != s_StateMagic || header.m_Version != s_StateVersion || header.m_ManifoldPointSize != sizeof( btManifoldPoint ) )
+	{
+		HELIUM_TRACE( TraceLevels::Error, "BulletWorld::RestoreState - Buffer does not contain a physics state saved by this build.\n" );
+		return false;
+	}
+
+	if ( header.m_ObjectCount != static_cast< uint32_t >( m_DynamicsWorld->getNumCollisionObjects() ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"BulletWorld::RestoreState - Physics state has %" PRIu32 " bodies but the world has %d.\n",
+			header.m_ObjectCount,
+			m_DynamicsWorld->getNumCollisionObjects() );
+
+		return false;
+	}
+
+	// Validate the object, pair and manifold records before touching the world
+	size_t fixedSize = sizeof( BulletBroadphaseState );
+	fixedSize += static_cast< size_t >( header.m_ObjectCount ) * sizeof( BulletObjectState );
+	fixedSize += static_cast< size_t >( header.m_PairCount ) * sizeof( BulletPairState );
+	if ( static_cast< size_t >( pEnd - pCursor ) < fixedSize )
+	{
+		pCursor = pEnd + 1;
+	}
+	else
+	{
+		pCursor += sizeof( BulletBroadphaseState );
+
+		for ( uint32_t i = 0; i < header.m_ObjectCount && pCursor <= pEnd; ++i )
+		{
+			BulletObjectState objectState;
+			MemoryCopy( &objectState, pCursor, sizeof( objectState ) );
+			pCursor += sizeof( objectState );
+
+			if ( objectState.m_ProxyStage < 0 || objectState.m_ProxyStage > btDbvtBroadphase::STAGECOUNT )
+			{
+				pCursor = pEnd + 1;
+			}
+		}
+
+		for ( uint32_t i = 0; i < header.m_PairCount && pCursor <= pEnd; ++i )
+		{
+			BulletPairState pairState;
+			MemoryCopy( &pairState, pCursor, sizeof( pairState ) );
+			pCursor += sizeof( pairState );
+
+			if ( pairState.m_ObjectIndex0 < 0 || static_cast< uint32_t >( pairState.m_ObjectIndex0 ) >= header.m_ObjectCount ||
+				pairState.m_ObjectIndex1 < 0 || static_cast< uint32_t >( pairState.m_ObjectIndex1 ) >= header.m_ObjectCount ||
+				pairState.m_ObjectIndex0 == pairState.m_ObjectIndex1 )
+			{
+				pCursor = pEnd + 1;
+			}
+		}
+	}
+
+	for ( uint32_t i = 0; i < header.m_ManifoldCount && pCursor <= pEnd; ++i )
+	{
+		BulletManifoldState manifoldState;
+		if ( pCursor + sizeof( manifoldState ) > pEnd )
+		{
+			pCursor = pEnd + 1;
+			break;
+		}
+
+		MemoryCopy( &manifoldState, pCursor, sizeof( manifoldState ) );
+		pCursor += sizeof( manifoldState );
+
+		if ( manifoldState.m_ObjectIndexA < 0 || static_cast< uint32_t >( manifoldState.m_ObjectIndexA ) >= header.m_ObjectCount ||
+			manifoldState.m_ObjectIndexB < 0 || static_cast< uint32_t >( manifoldState.m_ObjectIndexB ) >= header.m_ObjectCount ||
+			manifoldState.m_ContactCount < 0 || manifoldState.m_ContactCount > MANIFOLD_CACHE_SIZE )
+		{
+			pCursor = pEnd + 1;
+			break;
+		}
+
+		pCursor += static_cast< size_t >( manifoldState.m_ContactCount ) * sizeof( btManifoldPoint );
+	}
+
+	if ( pCursor > pEnd )
+	{
+		HELIUM_TRACE( TraceLevels::Error, "BulletWorld::RestoreState - Physics state buffer is truncated or corrupt.\n" );
+		return false;
+	}
+
+	ApplyState( static_cast< const uint8_t * >( pBuffer ) );
+
+	return true;
+}
+
+void BulletWorld::ApplyState( const uint8_t *pState )
+{
+	BulletDynamicsWorld *pWorld = static_cast< BulletDynamicsWorld * >( m_DynamicsWorld );
+
+	BulletStateHeader header;
+	MemoryCopy( &header, pState, sizeof( header ) );
+
+	BulletBroadphaseState broadphaseState;
+	MemoryCopy( &broadphaseState, pState + sizeof( BulletStateHeader ), sizeof( broadphaseState ) );
+
+	const uint8_t *pObjectData = pState + sizeof( BulletStateHeader ) + sizeof( BulletBroadphaseState );
+	const uint8_t *pPairData = pObjectData + static_cast< size_t >( header.m_ObjectCount ) * sizeof( BulletObjectState );
+	const uint8_t *pManifoldData = pPairData + static_cast< size_t >( header.m_PairCount ) * sizeof( BulletPairState );
+
+	m_Solver->setRandSeed( header.m_SolverSeed );
+	pWorld->SetLocalTime( header.m_LocalTime );
+
+	// Pull every object out of the world, remembering the original order and filtering, so they can be added
+	// back to a fresh broadphase in the same order.
+	btCollisionObjectArray &rObjects = pWorld->getCollisionObjectArray();
+	btAlignedObjectArray< btCollisionObject * > objects;
+	btAlignedObjectArray< short > filterGroups;
+	btAlignedObjectArray< short > filterMasks;
+
+	for ( int i = 0; i < rObjects.size(); ++i )
+	{
+		btBroadphaseProxy *pProxy = rObjects[ i ]->getBroadphaseHandle();
+		HELIUM_ASSERT( pProxy );
+
+		objects.push_back( rObjects[ i ] );
+		filterGroups.push_back( pProxy->m_collisionFilterGroup );
+		filterMasks.push_back( pProxy->m_collisionFilterMask );
+	}
+
+	for ( int i = objects.size() - 1; i >= 0; --i )
+	{
+		pWorld->removeCollisionObject( objects[ i ] );
+	}
+
+	// The new broadphase must not look for pairs while the objects are added; the pairs, the proxy bookkeeping
+	// and the leaf bounds all come from the snapshot instead
+	delete m_OverlappingPairCache;
+	btDbvtBroadphase *pBroadphase = new btDbvtBroadphase();
+	pBroadphase->m_deferedcollide = true;
+	m_OverlappingPairCache = pBroadphase;
+	pWorld->setBroadphase( m_OverlappingPairCache );
+
+	btAlignedObjectArray< BulletObjectState > objectStates;
+	objectStates.resize( objects.size() );
+	for ( int i = 0; i < objects.size(); ++i )
+	{
+		const uint8_t *pObjectState = pObjectData + static_cast< size_t >( i ) * sizeof( BulletObjectState );
+		MemoryCopy( &objectStates[ i ], pObjectState, sizeof( BulletObjectState ) );
+		RestoreObjectState( objects[ i ], objectStates[ i ] );
+	}
+
+	for ( int i = 0; i < objects.size(); ++i )
+	{
+		btRigidBody *pBody = btRigidBody::upcast( objects[ i ] );
+		if ( pBody )
+		{
+			pWorld->addRigidBody( pBody, filterGroups[ i ], filterMasks[ i ] );
+		}
+		else
+		{
+			pWorld->addCollisionObject( objects[ i ], filterGroups[ i ], filterMasks[ i ] );
+		}
+
+		// The dispatcher skips pairs of sleeping bodies, but the snapshot may hold algorithms created before the
+		// bodies fell asleep. Keep everything awake until the algorithms are back.
+		objects[ i ]->forceActivationState( ACTIVE_TAG );
+	}
+
+	btVector3 leafMin;
+	btVector3 leafMax;
+	for ( int i = 0; i < objects.size(); ++i )
+	{
+		const BulletObjectState &rObjectState = objectStates[ i ];
+		btDbvtProxy *pProxy = static_cast< btDbvtProxy * >( objects[ i ]->getBroadphaseHandle() );
+
+		pProxy->m_uniqueId = rObjectState.m_ProxyUniqueId;
+		pProxy->m_aabbMin.deSerialize( rObjectState.m_ProxyAabbMin );
+		pProxy->m_aabbMax.deSerialize( rObjectState.m_ProxyAabbMax );
+
+		leafMin.deSerialize( rObjectState.m_LeafVolumeMin );
+		leafMax.deSerialize( rObjectState.m_LeafVolumeMax );
+		btDbvtVolume leafVolume = btDbvtVolume::FromMM( leafMin, leafMax );
+
+		UnlinkProxy( pProxy, pBroadphase->m_stageRoots[ pProxy->stage ] );
+		if ( rObjectState.m_ProxyStage == btDbvtBroadphase::STAGECOUNT )
+		{
+			pBroadphase->m_sets[ btDbvtBroadphase::DYNAMIC_SET ].remove( pProxy->leaf );
+			pProxy->leaf = pBroadphase->m_sets[ btDbvtBroadphase::FIXED_SET ].insert( leafVolume, pProxy );
+		}
+		else
+		{
+			pBroadphase->m_sets[ btDbvtBroadphase::DYNAMIC_SET ].update( pProxy->leaf, leafVolume );
+		}
+
+		pProxy->stage = rObjectState.m_ProxyStage;
+		LinkProxy( pProxy, pBroadphase->m_stageRoots[ pProxy->stage ] );
+	}
+
+	pBroadphase->m_stageCurrent = broadphaseState.m_StageCurrent;
+	pBroadphase->m_newpairs = broadphaseState.m_NewPairs;
+	pBroadphase->m_fixedleft = broadphaseState.m_FixedLeft;
+	pBroadphase->m_pid = broadphaseState.m_Pid;
+	pBroadphase->m_cid = broadphaseState.m_Cid;
+	pBroadphase->m_gid = broadphaseState.m_Gid;
+	pBroadphase->m_updates_call = broadphaseState.m_UpdatesCall;
+	pBroadphase->m_updates_done = broadphaseState.m_UpdatesDone;
+	pBroadphase->m_updates_ratio = broadphaseState.m_UpdatesRatio;
+	pBroadphase->m_needcleanup = broadphaseState.m_NeedCleanup != 0;
+	pBroadphase->m_deferedcollide = false;
+
+	// Add the pairs in snapshot order. The proxy ids are restored first so each pair keeps its proxy order.
+	btOverlappingPairCache *pPairCache = pBroadphase->getOverlappingPairCache();
+	HELIUM_ASSERT( pPairCache->getNumOverlappingPairs() == 0 );
+
+	for ( uint32_t i = 0; i < header.m_PairCount; ++i )
+	{
+		BulletPairState pairState;
+		MemoryCopy( &pairState, pPairData + static_cast< size_t >( i ) * sizeof( BulletPairState ), sizeof( pairState ) );
+
+		btBroadphasePair *pPair = pPairCache->addOverlappingPair(
+			objects[ pairState.m_ObjectIndex0 ]->getBroadphaseHandle(),
+			objects[ pairState.m_ObjectIndex1 ]->getBroadphaseHandle() );
+		if ( !pPair || !pairState.m_HasAlgorithm || pPair->m_algorithm )
+		{
+			continue;
+		}
+
+		const btCollisionObject *pObject0 = static_cast< const btCollisionObject * >( pPair->m_pProxy0->m_clientObject );
+		const btCollisionObject *pObject1 = static_cast< const btCollisionObject * >( pPair->m_pProxy1->m_clientObject );
+		btCollisionObjectWrapper wrapper0(
+			NULL, pObject0->getCollisionShape(), pObject0, pObject0->getWorldTransform(), -1, -1 );
+		btCollisionObjectWrapper wrapper1(
+			NULL, pObject1->getCollisionShape(), pObject1, pObject1->getWorldTransform(), -1, -1 );
+		pPair->m_algorithm = m_Dispatcher->findAlgorithm( &wrapper0, &wrapper1 );
+	}
+
+	for ( int i = 0; i < objects.size(); ++i )
+	{
+		objects[ i ]->forceActivationState( objectStates[ i ].m_ActivationState );
+		objects[ i ]->setDeactivationTime( objectStates[ i ].m_DeactivationTime );
+	}
+
+	// The algorithms created their manifolds in pair order. Match them to the snapshot manifolds, copy the
+	// persistent contact points over so warm starting carries on, and put them back in the dispatcher order the
+	// snapshot recorded.
+	btHashMap< btHashPtr, int32_t > objectIndices;
+	BuildObjectIndexMap( rObjects, objectIndices );
+
+	btAlignedObjectArray< BulletManifoldKey > savedKeys;
+	const uint8_t *pCursor = pManifoldData;
+	for ( uint32_t i = 0; i < header.m_ManifoldCount; ++i )
+	{
+		BulletManifoldState manifoldState;
+		MemoryCopy( &manifoldState, pCursor, sizeof( manifoldState ) );
+
+		BulletManifoldKey key;
+		key.m_ObjectIndexA = manifoldState.m_ObjectIndexA;
+		key.m_ObjectIndexB = manifoldState.m_ObjectIndexB;
+		key.m_Sequence = static_cast< int32_t >( i );
+		key.m_pData = pCursor;
+		savedKeys.push_back( key );
+
+		pCursor += sizeof( manifoldState ) + static_cast< size_t >( manifoldState.m_ContactCount ) * sizeof( btManifoldPoint );
+	}
+
+	btAlignedObjectArray< BulletManifoldKey > liveKeys;
+	int numManifolds = m_Dispatcher->getNumManifolds();
+	for ( int i = 0; i < numManifolds; ++i )
+	{
+		btPersistentManifold *pManifold = m_Dispatcher->getManifoldByIndexInternal( i );
+
+		BulletManifoldKey key;
+		key.m_ObjectIndexA = *objectIndices.find( btHashPtr( pManifold->getBody0() ) );
+		key.m_ObjectIndexB = *objectIndices.find( btHashPtr( pManifold->getBody1() ) );
+		key.m_Sequence = i;
+		key.m_pData = pManifold;
+		liveKeys.push_back( key );
+	}
+
+	savedKeys.quickSort( BulletManifoldKeyLess() );
+	liveKeys.quickSort( BulletManifoldKeyLess() );
+
+	btAlignedObjectArray< btPersistentManifold * > savedManifolds;
+	savedManifolds.resize( savedKeys.size(), NULL );
+	btAlignedObjectArray< btPersistentManifold * > unmatchedManifolds;
+
+	BulletManifoldKeyLess less;
+	int savedIndex = 0;
+	for ( int liveIndex = 0; liveIndex < liveKeys.size(); ++liveIndex )
+	{
+		const BulletManifoldKey &rLiveKey = liveKeys[ liveIndex ];
+		btPersistentManifold *pManifold = static_cast< btPersistentManifold * >( const_cast< void * >( rLiveKey.m_pData ) );
+
+		// Skip snapshot manifolds whose pair no longer produced a manifold
+		while ( savedIndex < savedKeys.size() && !savedKeys[ savedIndex ].IsSamePair( rLiveKey ) && less( savedKeys[ savedIndex ], rLiveKey ) )
+		{
+			++savedIndex;
+		}
+
+		pManifold->clearManifold();
+
+		if ( savedIndex < savedKeys.size() && savedKeys[ savedIndex ].IsSamePair( rLiveKey ) )
+		{
+			savedManifolds[ savedKeys[ savedIndex ].m_Sequence ] = pManifold;
+
+			const uint8_t *pSaved = static_cast< const uint8_t * >( savedKeys[ savedIndex ].m_pData );
+			++savedIndex;
+
+			BulletManifoldState manifoldState;
+			MemoryCopy( &manifoldState, pSaved, sizeof( manifoldState ) );
+			pSaved += sizeof( manifoldState );
+
+			for ( int j = 0; j < manifoldState.m_ContactCount; ++j )
+			{
+				btManifoldPoint point;
+				MemoryCopy( &point, pSaved, sizeof( point ) );
+				pSaved += sizeof( point );
+
+				pManifold->addManifoldPoint( point );
+			}
+		}
+		else
+		{
+			unmatchedManifolds.push_back( pManifold );
+		}
+	}
+
+	btAlignedObjectArray< btPersistentManifold * > manifoldOrder;
+	for ( int i = 0; i < savedManifolds.size(); ++i )
+	{
+		if ( savedManifolds[ i ] )
+		{
+			manifoldOrder.push_back( savedManifolds[ i ] );
+		}
+	}
+
+	for ( int i = 0; i < unmatchedManifolds.size(); ++i )
+	{
+		manifoldOrder.push_back( unmatchedManifolds[ i ] );
+	}
+
+	if ( unmatchedManifolds.size() || manifoldOrder.size() != savedManifolds.size() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"BulletWorld::RestoreState - Rebuilt %d manifolds but the physics state has %" PRIu32
+			"; the restored simulation may diverge.\n",
+			manifoldOrder.size(),
+			header.m_ManifoldCount );
+	}
+
+	static_cast< BulletCollisionDispatcher * >( m_Dispatcher )->SetManifoldOrder( manifoldOrder );
 }
@@ -1,4 +1,3 @@
-
 #pragma once 
 
 #include "Bullet/Bullet.h"
@@ -19,9 +18,29 @@ namespace Helium
 {
     class BulletWorldDefinition;
 
+    // Counters and timings for the most recent BulletWorld::Simulate call. Counts are taken at the end of the
+    // last substep, timings are summed over all substeps.
+    struct HELIUM_BULLET_API BulletWorldStepStats
+    {
+        BulletWorldStepStats();
+
+        uint32_t m_SubStepCount;
+        uint32_t m_OverlappingPairCount;
+        uint32_t m_ManifoldCount;
+        uint32_t m_ContactCount;
+        uint32_t m_ActiveBodyCount;
+        uint32_t m_IslandCount;
+
+        float32_t m_CollisionDetectionMilliseconds;
+        float32_t m_SolverMilliseconds;
+        float32_t m_IntegrationMilliseconds;
+        float32_t m_TotalMilliseconds;
+    };
+
     class HELIUM_BULLET_API BulletWorld
     {
     public:
+        BulletWorld();
         ~BulletWorld();
         
         void Initialize(const BulletWorldDefinition &rWorldDefinition);
@@ -30,12 +49,32 @@ namespace Helium
 
         void Simulate(float dt);
 
+        const BulletWorldStepStats &GetStepStats() const { return m_StepStats; }
+
+        // Snapshot and restore of the dynamic state of the world (body transforms, velocities, activation
+        // state, pending forces, the broadphase pairs and the persistent contact manifolds). The buffer is owned
+        // by the caller and is only valid for a world with the same bodies added in the same order, built by the
+        // same binary.
+        //
+        // Saving only serializes the world and leaves the running simulation untouched. Restoring puts back the
+        // broadphase bounds, the pair order and the manifold order along with the bodies, so a world stepped
+        // after a RestoreState is bit-for-bit identical to the world the snapshot was taken from.
+        size_t GetStateSize() const;
+        size_t SaveState( void *pBuffer, size_t bufferSize ) const;
+        bool RestoreState( const void *pBuffer, size_t bufferSize );
+
     private:
+        void ApplyState( const uint8_t *pState );
+
         btDefaultCollisionConfiguration *m_CollisionConfiguration;
 	    btCollisionDispatcher* m_Dispatcher;
 	    btBroadphaseInterface* m_OverlappingPairCache;
 	    btSequentialImpulseConstraintSolver* m_Solver;
         btDynamicsWorld * m_DynamicsWorld;
+
+        BulletWorldStepStats m_StepStats;
+        uint32_t m_MaxSubSteps;
+        bool m_ProfileSteps;
     };
     typedef Helium::StrongPtr< BulletWorld > BulletWorldPtr;
 }
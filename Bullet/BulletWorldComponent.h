@@ -10,6 +10,15 @@
 namespace Helium
 {
 	class BulletWorldComponentDefinition;
+	class BulletBodyComponent;
+
+	// A touch between two bodies found while scanning manifolds after a physics substep. Candidates are gathered
+	// on the job pool and applied to HasPhysicalContactsComponents afterwards on the simulating thread.
+	struct PhysicalContactCandidate
+	{
+		BulletBodyComponent *m_pBodyComponent;
+		BulletBodyComponent *m_pOtherBodyComponent;
+	};
 
 	class HELIUM_BULLET_API BulletWorldComponent : public Component
 	{
@@ -26,11 +35,16 @@ namespace Helium
 
 		BulletWorld *GetBulletWorld() { return m_World; }
 
+		// Scratch buffers for contact gathering, one per chunk of manifolds, kept to avoid reallocating every substep
+		DynamicArray< DynamicArray< PhysicalContactCandidate > > &GetContactCandidateBuffers() { return m_ContactCandidateBuffers; }
+
 	private:
 		
 		// I would love to use an auto_ptr here but microsoft's compiler breaks when I try to do that. 
 		// http://www.youtube.com/watch?v=1ytCEuuW2_A
 		BulletWorld *m_World;
+
+		DynamicArray< DynamicArray< PhysicalContactCandidate > > m_ContactCandidateBuffers;
 	};
 
 	class HELIUM_BULLET_API BulletWorldComponentDefinition : public Helium::ComponentDefinitionHelper<BulletWorldComponent, BulletWorldComponentDefinition>
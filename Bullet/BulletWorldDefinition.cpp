@@ -9,4 +9,14 @@ HELIUM_DEFINE_BASE_STRUCT(Helium::BulletWorldDefinition);
 void BulletWorldDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
 {
     comp.AddField(&BulletWorldDefinition::m_Gravity, TXT( "m_Gravity" ) );
+    comp.AddField(&BulletWorldDefinition::m_MaxSubSteps, TXT( "m_MaxSubSteps" ) );
+    comp.AddField(&BulletWorldDefinition::m_ProfileSteps, TXT( "m_ProfileSteps" ) );
+}
+
+BulletWorldDefinition::BulletWorldDefinition()
+    : m_Gravity( Simd::Vector3::Zero )
+    , m_MaxSubSteps( 10 )
+    , m_ProfileSteps( false )
+{
+
 }
@@ -14,6 +14,15 @@ namespace Helium
         HELIUM_DECLARE_BASE_STRUCT(Helium::BulletWorldDefinition);
         static void PopulateMetaType( Reflect::MetaStruct& comp );
 
+        BulletWorldDefinition();
+
         Helium::Simd::Vector3 m_Gravity;
+
+        // Maximum number of fixed substeps run per frame before simulation time is dropped. Zero steps the
+        // world once with the raw frame time instead of using fixed substeps.
+        uint32_t m_MaxSubSteps;
+
+        // Write BulletWorld step statistics to the profile log every frame
+        bool m_ProfileSteps;
     };
 }
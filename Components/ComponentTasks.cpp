@@ -57,6 +57,54 @@ HELIUM_DEFINE_TASK( UpdateRotatorComponentsTask, (ForEachWorld< QueryComponents<
 
 //////////////////////////////////////////////////////////////////////////
 
+// Transforms bucketed by hierarchy depth, reused between frames to avoid reallocating.
+static DynamicArray< DynamicArray< TransformComponent * > > s_TransformLevels;
+
+/// Recompute the world matrices of every transform allocated by a component manager, from the roots down.
+///
+/// @param[in] rComponentManager  Component manager owning the transforms.
+void Helium::PropagateTransforms( ComponentManager &rComponentManager )
+{
+	for( size_t levelIndex = 0; levelIndex < s_TransformLevels.GetSize(); ++levelIndex )
+	{
+		s_TransformLevels[ levelIndex ].Resize( 0 );
+	}
+
+	// Breadth-first ordering: every level is one contiguous batch whose parents were all finalized by the level above.
+	for( ImplementingComponentIterator<TransformComponent> iter( rComponentManager ); iter.GetBaseComponent(); iter.Advance() )
+	{
+		TransformComponent *pTransform = *iter;
+		uint32_t depth = pTransform->GetDepth();
+		if( depth >= s_TransformLevels.GetSize() )
+		{
+			s_TransformLevels.Resize( depth + 1 );
+		}
+
+		s_TransformLevels[ depth ].Push( pTransform );
+	}
+
+	for( size_t levelIndex = 0; levelIndex < s_TransformLevels.GetSize(); ++levelIndex )
+	{
+		const DynamicArray< TransformComponent * > &rLevel = s_TransformLevels[ levelIndex ];
+		TransformComponent::UpdateWorldMatrices( rLevel.GetData(), rLevel.GetSize() );
+	}
+}
+
+void PropagateWorldTransforms( World *pWorld )
+{
+	PropagateTransforms( *pWorld->GetComponentManager() );
+}
+
+void Helium::PropagateTransformsTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteBefore<StandardDependencies::Render>();
+	rContract.ExecuteAfter<StandardDependencies::PostPhysicsGameplay>();
+}
+
+HELIUM_DEFINE_TASK( PropagateTransformsTask, (ForEachWorld< PropagateWorldTransforms >), TickTypes::Render );
+
+//////////////////////////////////////////////////////////////////////////
+
 static GraphicsScene *pGraphicsScene = NULL;
 
 void UpdateMeshComponent(TransformComponent *pTransform, MeshComponent *pMeshComponent)
@@ -79,6 +127,7 @@ void Helium::UpdateMeshComponentsTask::DefineContract( TaskContract &rContract )
 {
 	rContract.ExecuteBefore<StandardDependencies::Render>();
 	rContract.ExecuteAfter<StandardDependencies::ProcessPhysics>();
+	rContract.ExecuteAfter<Helium::PropagateTransformsTask>();
 }
 
 HELIUM_DEFINE_TASK( UpdateMeshComponentsTask, (ForEachWorld< UpdateMeshComponents >), TickTypes::Render );
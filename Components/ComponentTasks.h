@@ -18,6 +18,16 @@ namespace Helium
         virtual void DefineContract(TaskContract &rContract);
     };
         
+    class ComponentManager;
+
+    HELIUM_COMPONENTS_API void PropagateTransforms( ComponentManager &rComponentManager );
+
+    struct HELIUM_COMPONENTS_API PropagateTransformsTask : public TaskDefinition
+    {
+        HELIUM_DECLARE_TASK(PropagateTransformsTask)
+        virtual void DefineContract(TaskContract &rContract);
+    };
+        
     struct HELIUM_COMPONENTS_API UpdateMeshComponentsTask : public TaskDefinition
     {
         HELIUM_DECLARE_TASK(UpdateMeshComponentsTask)
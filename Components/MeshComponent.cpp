@@ -185,17 +185,13 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 	HELIUM_ASSERT( pScene );
 	HELIUM_ASSERT( pSceneObject );
 	
-	const Simd::Vector3& rPosition = pTransform->GetPosition();
-	Simd::Matrix44 transform(
-		Simd::Matrix44::INIT_ROTATION_TRANSLATION,
-		pTransform->GetRotation(),
-		rPosition);
-	transform.ScaleLocal( pTransform->GetScale() );
+	const Simd::Matrix44& transform = pTransform->GetWorldMatrix();
 	pSceneObject->SetTransform( transform );
 
 	Mesh* pMesh = pThis->m_Mesh;
 
-	Simd::AaBox worldBounds( rPosition, rPosition );
+	Simd::Vector3 position = Simd::Vector4ToVector3( transform.GetRow( 3 ) );
+	Simd::AaBox worldBounds( position, position );
 
 	// Only thing remaining if this is a transform-only update is the world bounds, so update it and return.
 	if( pSceneObject->GetUpdateMode() == GraphicsSceneObject::UPDATE_TRANSFORM_ONLY )
@@ -1,19 +1,166 @@
 #include "ComponentsPch.h"
 #include "Components/TransformComponent.h"
+#include "GraphicsTypes/TransformBatch.h"
 #include "Reflect/TranslatorDeduction.h"
 
 HELIUM_DEFINE_COMPONENT(Helium::TransformComponent, 128);
 
+// Incremented whenever any transform is reparented, invalidating every cached depth.
+static uint32_t s_HierarchyGeneration = 0;
+
 void Helium::TransformComponent::PopulateMetaType( Reflect::MetaStruct& comp )
 {
 }
 
+Helium::TransformComponent::TransformComponent()
+: m_Position( 0.0f )
+, m_Rotation( Simd::Quat::IDENTITY )
+, m_Scale( 1.f )
+, m_bDirty( true )
+, m_LocalPosition( 0.0f )
+, m_LocalRotation( Simd::Quat::IDENTITY )
+, m_LocalScale( 1.f )
+, m_Depth( 0 )
+, m_DepthGeneration( s_HierarchyGeneration )
+, m_WorldMatrix( Simd::Matrix44::IDENTITY )
+{
+
+}
+
 void Helium::TransformComponent::Initialize( const TransformComponentDefinition &definition )
 {
 	m_Position = definition.m_Position;
 	m_Rotation = definition.m_Rotation;
 	m_Scale = definition.m_Scale;
+	m_LocalPosition = definition.m_Position;
+	m_LocalRotation = definition.m_Rotation;
+	m_LocalScale = definition.m_Scale;
 	m_bDirty = true;
+
+	// Make the world matrix valid before the first propagation pass.  There is no parent yet, so the local transform
+	// is the world transform.
+	BuildTransformMatrices( &m_LocalPosition, &m_LocalRotation, &m_LocalScale, 1, &m_WorldMatrix );
+}
+
+/// Attach this transform to a parent transform.
+///
+/// The current local transform is kept, so the world transform of this component will follow the parent from the next
+/// propagation pass on.  Passing null detaches this transform and makes its last world transform its own.
+///
+/// @param[in] pParent  Parent transform, or null to make this a root transform.
+void Helium::TransformComponent::SetParent( TransformComponent *pParent )
+{
+	HELIUM_ASSERT( pParent != this );
+
+#if HELIUM_DEBUG
+	for( TransformComponent *pAncestor = pParent; pAncestor; pAncestor = pAncestor->GetParent() )
+	{
+		HELIUM_ASSERT_MSG( pAncestor != this, TXT( "TransformComponent::SetParent(): Parenting would create a cycle." ) );
+	}
+#endif
+
+	m_Parent = pParent;
+	m_bDirty = true;
+
+	++s_HierarchyGeneration;
+}
+
+/// Get the depth of this transform in its hierarchy.
+///
+/// The depth is cached, and only recomputed (from the cached depth of the parent) after a transform has been
+/// reparented.  If an ancestor is destroyed, the cached depth can be larger than the actual depth until the next
+/// reparenting, but every transform is still deeper than its parent, which is all the propagation pass relies on.
+///
+/// @return  Number of ancestors of this transform (zero for a root transform).
+uint32_t Helium::TransformComponent::GetDepth() const
+{
+	if( m_DepthGeneration != s_HierarchyGeneration )
+	{
+		TransformComponent *pParent = GetParent();
+		m_Depth = ( pParent ? pParent->GetDepth() + 1 : 0 );
+		m_DepthGeneration = s_HierarchyGeneration;
+	}
+
+	return m_Depth;
+}
+
+// Scratch space for UpdateWorldMatrices(), reused between calls to avoid reallocating every frame.
+static DynamicArray< TransformComponent * > s_UpdatedTransforms;
+static DynamicArray< Simd::Vector3 > s_UpdatedPositions;
+static DynamicArray< Simd::Quat > s_UpdatedRotations;
+static DynamicArray< float32_t > s_UpdatedScales;
+static DynamicArray< Simd::Matrix44 > s_UpdatedMatrices;
+
+/// Recompute the world matrices of a batch of transforms that all share the same hierarchy depth.
+///
+/// Batches must be processed from the roots down, so every parent has its final world matrix (and dirty flag) for the
+/// frame by the time its children are processed.  A transform is only recomputed if it or its parent changed, and
+/// children of a recomputed transform are flagged dirty so the change carries down the hierarchy.  The transforms
+/// that need updating are gathered into contiguous arrays and converted to matrices in one batch.
+///
+/// @param[in] ppTransforms    Transforms to update.
+/// @param[in] transformCount  Number of transforms in the batch.
+void Helium::TransformComponent::UpdateWorldMatrices( TransformComponent* const* ppTransforms, size_t transformCount )
+{
+	HELIUM_ASSERT( ppTransforms || transformCount == 0 );
+
+	s_UpdatedTransforms.Resize( 0 );
+	s_UpdatedPositions.Resize( 0 );
+	s_UpdatedRotations.Resize( 0 );
+	s_UpdatedScales.Resize( 0 );
+
+	for( size_t transformIndex = 0; transformIndex < transformCount; ++transformIndex )
+	{
+		TransformComponent *pTransform = ppTransforms[ transformIndex ];
+		HELIUM_ASSERT( pTransform );
+
+		TransformComponent *pParent = pTransform->m_Parent.Get();
+		if( !pParent )
+		{
+			if( pTransform->m_bDirty )
+			{
+				s_UpdatedTransforms.Push( pTransform );
+				s_UpdatedPositions.Push( pTransform->m_Position );
+				s_UpdatedRotations.Push( pTransform->m_Rotation );
+				s_UpdatedScales.Push( pTransform->m_Scale );
+			}
+		}
+		else if( pTransform->m_bDirty || pParent->m_bDirty )
+		{
+			s_UpdatedTransforms.Push( pTransform );
+			s_UpdatedPositions.Push( pTransform->m_LocalPosition );
+			s_UpdatedRotations.Push( pTransform->m_LocalRotation );
+			s_UpdatedScales.Push( pTransform->m_LocalScale );
+		}
+	}
+
+	size_t updatedCount = s_UpdatedTransforms.GetSize();
+	s_UpdatedMatrices.Resize( updatedCount );
+	BuildTransformMatrices(
+		s_UpdatedPositions.GetData(),
+		s_UpdatedRotations.GetData(),
+		s_UpdatedScales.GetData(),
+		updatedCount,
+		s_UpdatedMatrices.GetData() );
+
+	for( size_t updatedIndex = 0; updatedIndex < updatedCount; ++updatedIndex )
+	{
+		TransformComponent *pTransform = s_UpdatedTransforms[ updatedIndex ];
+		TransformComponent *pParent = pTransform->m_Parent.UncheckedGet();
+		if( !pParent )
+		{
+			pTransform->m_WorldMatrix = s_UpdatedMatrices[ updatedIndex ];
+			continue;
+		}
+
+		pTransform->m_WorldMatrix.MultiplySet( s_UpdatedMatrices[ updatedIndex ], pParent->m_WorldMatrix );
+
+		// Keep the decomposed world transform in sync for gameplay and physics code that reads it.
+		pTransform->m_Position = Simd::Vector4ToVector3( pTransform->m_WorldMatrix.GetRow( 3 ) );
+		pTransform->m_Rotation = pParent->m_Rotation * pTransform->m_LocalRotation;
+		pTransform->m_Scale = pParent->m_Scale * pTransform->m_LocalScale;
+		pTransform->m_bDirty = true;
+	}
 }
 
 HELIUM_DEFINE_CLASS(Helium::TransformComponentDefinition);
@@ -16,8 +16,14 @@ namespace Helium
 		HELIUM_DECLARE_COMPONENT( Helium::TransformComponent, Helium::Component );
 		static void PopulateMetaType( Reflect::MetaStruct& comp );
 
+		TransformComponent();
+
 		void Initialize( const TransformComponentDefinition &definition );
-				
+
+		/// @name World Transform
+		/// For a transform with a parent, these are written by the hierarchy propagation pass each frame; set the
+		/// local transform instead.
+		//@{
 		inline const Simd::Vector3& GetPosition() const { return m_Position; }
 		virtual void SetPosition( const Simd::Vector3& rPosition ) { m_Position = rPosition; m_bDirty = true; }
 
@@ -25,7 +31,28 @@ namespace Helium
 		virtual void SetRotation( const Simd::Quat& rRotation ) { m_Rotation = rRotation; m_bDirty = true; }
 
 		inline float32_t GetScale() const { return m_Scale; }
-		virtual void SetScale( float32_t scale ) { m_Scale = scale; }
+		virtual void SetScale( float32_t scale ) { m_Scale = scale; m_bDirty = true; }
+
+		inline const Simd::Matrix44& GetWorldMatrix() const;
+		//@}
+
+		/// @name Hierarchy
+		//@{
+		void SetParent( TransformComponent *pParent );
+		inline TransformComponent* GetParent() const;
+		uint32_t GetDepth() const;
+
+		inline const Simd::Vector3& GetLocalPosition() const;
+		inline void SetLocalPosition( const Simd::Vector3& rPosition );
+
+		inline const Simd::Quat& GetLocalRotation() const;
+		inline void SetLocalRotation( const Simd::Quat& rRotation );
+
+		inline float32_t GetLocalScale() const;
+		inline void SetLocalScale( float32_t scale );
+
+		static void UpdateWorldMatrices( TransformComponent* const* ppTransforms, size_t transformCount );
+		//@}
 
 		bool IsDirty() const { return m_bDirty; }
 		void ClearDirtyFlag() { m_bDirty = false; }
@@ -34,6 +61,22 @@ namespace Helium
 		Simd::Quat m_Rotation;
 		float32_t m_Scale;
 		bool m_bDirty;
+
+		/// Transform relative to m_Parent (unused when there is no parent).
+		Simd::Vector3 m_LocalPosition;
+		Simd::Quat m_LocalRotation;
+		float32_t m_LocalScale;
+
+		/// Optional parent transform.
+		ComponentPtr<TransformComponent> m_Parent;
+
+		/// Cached hierarchy depth, valid while m_DepthGeneration matches the current hierarchy generation.
+		mutable uint32_t m_Depth;
+		/// Hierarchy generation at which m_Depth was computed.
+		mutable uint32_t m_DepthGeneration;
+
+		/// Cached world matrix, valid after the hierarchy propagation pass has run for the frame.
+		Simd::Matrix44 m_WorldMatrix;
 	};
 	typedef Helium::ComponentPtr<TransformComponent> TransformComponentPtr;
 		
@@ -1,5 +1,66 @@
-
 namespace Helium
 {
+	/// Get the world transform matrix computed by the last hierarchy propagation pass.
+	///
+	/// @return  World transform matrix.
+	const Simd::Matrix44& TransformComponent::GetWorldMatrix() const
+	{
+		return m_WorldMatrix;
+	}
+
+	/// Get the parent of this transform.
+	///
+	/// @return  Parent transform, or null if this is a root transform.
+	///
+	/// @see SetParent()
+	TransformComponent* TransformComponent::GetParent() const
+	{
+		m_Parent.Check();
+		return m_Parent.UncheckedGet();
+	}
+
+	/// @see SetLocalPosition()
+	const Simd::Vector3& TransformComponent::GetLocalPosition() const
+	{
+		return m_LocalPosition;
+	}
+
+	/// Set the position of this transform relative to its parent.
+	///
+	/// @param[in] rPosition  Local position.
+	void TransformComponent::SetLocalPosition( const Simd::Vector3& rPosition )
+	{
+		m_LocalPosition = rPosition;
+		m_bDirty = true;
+	}
+
+	/// @see SetLocalRotation()
+	const Simd::Quat& TransformComponent::GetLocalRotation() const
+	{
+		return m_LocalRotation;
+	}
+
+	/// Set the rotation of this transform relative to its parent.
+	///
+	/// @param[in] rRotation  Local rotation.
+	void TransformComponent::SetLocalRotation( const Simd::Quat& rRotation )
+	{
+		m_LocalRotation = rRotation;
+		m_bDirty = true;
+	}
+
+	/// @see SetLocalScale()
+	float32_t TransformComponent::GetLocalScale() const
+	{
+		return m_LocalScale;
+	}
 
-}
\ No newline at end of file
+	/// Set the scale of this transform relative to its parent.
+	///
+	/// @param[in] scale  Local uniform scale.
+	void TransformComponent::SetLocalScale( float32_t scale )
+	{
+		m_LocalScale = scale;
+		m_bDirty = true;
+	}
+}
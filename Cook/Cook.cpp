@@ -0,0 +1,454 @@
+#include "CookPch.h"
+
+#include "Platform/Exception.h"
+#include "Platform/MemoryHeap.h"
+#include "Reflect/Registry.h"
+#include "Framework/Components.h"
+#include "Bullet/BulletEngine.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Helium;
+
+namespace Helium
+{
+	Helium::DynamicMemoryHeap& GetComponentsDefaultHeap();
+	Helium::DynamicMemoryHeap& GetBulletDefaultHeap();
+	Helium::DynamicMemoryHeap& GetEditorSupportDefaultHeap();
+}
+
+/// Asset in the cook work list.
+struct CookWorkItem
+{
+	/// Asset path.
+	AssetPath path;
+	/// Number of objects between the asset and its package (zero for top-level assets).
+	size_t depth;
+};
+
+/// Default time to wait without any load making progress before giving up on the remaining loads, in seconds.
+static const float32_t DEFAULT_STALL_TIMEOUT = 300.0f;
+
+/// Sort comparison for ordering the cook work list so that owning objects are loaded before the objects they own.
+static bool CompareWorkItemDepths( const CookWorkItem& rA, const CookWorkItem& rB )
+{
+	return rA.depth < rB.depth;
+}
+
+/// Enumerate every package in the data directory along with all assets to cook.
+///
+/// Packages are walked breadth-first, so parent packages are always loaded before their contents, and assets are
+/// ordered so that objects are loaded before the objects they own.
+///
+/// @param[out] rWorkItems  Assets to cook.
+/// @param[out] rReport     Cook report to update.
+static void BuildWorkList( DynamicArray< CookWorkItem >& rWorkItems, CookReport& rReport )
+{
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
+	DynamicArray< AssetPath > packagePaths;
+	pAssetLoader->EnumerateRootPackages( packagePaths );
+
+	DynamicArray< AssetPath > children;
+	for( size_t packageIndex = 0; packageIndex < packagePaths.GetSize(); ++packageIndex )
+	{
+		AssetPath packagePath = packagePaths[ packageIndex ];
+
+		AssetPtr spPackageAsset;
+		pAssetLoader->LoadObject( packagePath, spPackageAsset );
+		Package* pPackage = Reflect::SafeCast< Package >( spPackageAsset.Get() );
+		PackageLoader* pPackageLoader = ( pPackage ? pPackage->GetLoader() : NULL );
+		if( !pPackageLoader )
+		{
+			HELIUM_TRACE( TraceLevels::Error, TXT( "Cook: Failed to load package \"%s\".\n" ), *packagePath.ToString() );
+			rReport.AddFailure( packagePath, TXT( "enumerate" ) );
+
+			continue;
+		}
+
+		children.Resize( 0 );
+		pPackageLoader->EnumerateChildren( children );
+
+		size_t childCount = children.GetSize();
+		for( size_t childIndex = 0; childIndex < childCount; ++childIndex )
+		{
+			const AssetPath& rChildPath = children[ childIndex ];
+			if( rChildPath.IsPackage() )
+			{
+				packagePaths.Push( rChildPath );
+
+				continue;
+			}
+
+			CookWorkItem* pWorkItem = rWorkItems.New();
+			HELIUM_ASSERT( pWorkItem );
+			pWorkItem->path = rChildPath;
+			pWorkItem->depth = 0;
+			for( AssetPath parentPath = rChildPath.GetParent();
+				!parentPath.IsEmpty() && !parentPath.IsPackage();
+				parentPath = parentPath.GetParent() )
+			{
+				++pWorkItem->depth;
+			}
+		}
+	}
+
+	std::stable_sort( rWorkItems.GetData(), rWorkItems.GetData() + rWorkItems.GetSize(), CompareWorkItemDepths );
+
+	rReport.packageCount = packagePaths.GetSize();
+	rReport.assetCount = rWorkItems.GetSize();
+}
+
+/// Load a range of assets from the work list at once, waiting until all of them finish loading.
+///
+/// @param[in]     rWorkItems    Assets to cook.
+/// @param[in]     startIndex    Index of the first work item to load.
+/// @param[in]     endIndex      Index past the last work item to load.
+/// @param[in]     stallTimeout  Time to wait without any load finishing before giving up, in seconds.
+/// @param[in,out] rReport       Cook report to update.
+///
+/// @return  True if every load finished, false if loading stalled and the remaining loads were reported as failures.
+static bool LoadWave(
+	const DynamicArray< CookWorkItem >& rWorkItems,
+	size_t startIndex,
+	size_t endIndex,
+	float32_t stallTimeout,
+	CookReport& rReport )
+{
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	DynamicArray< size_t > loadIds;
+	loadIds.Reserve( endIndex - startIndex );
+	DynamicArray< size_t > pendingIndices;
+	pendingIndices.Reserve( endIndex - startIndex );
+
+	for( size_t workItemIndex = startIndex; workItemIndex < endIndex; ++workItemIndex )
+	{
+		loadIds.Push( pAssetLoader->BeginLoadObject( rWorkItems[ workItemIndex ].path ) );
+		pendingIndices.Push( workItemIndex );
+	}
+
+	uint64_t progressTicks = Timer::GetTickCount();
+
+	while( !pendingIndices.IsEmpty() )
+	{
+		int32_t completionCount = rAsyncLoader.GetCompletionCount();
+		size_t pendingCount = pendingIndices.GetSize();
+
+		pAssetLoader->Tick();
+
+		size_t pendingIndex = 0;
+		while( pendingIndex < pendingIndices.GetSize() )
+		{
+			size_t workItemIndex = pendingIndices[ pendingIndex ];
+			size_t loadId = loadIds[ workItemIndex - startIndex ];
+
+			AssetPtr spAsset;
+			if( IsValid( loadId ) && !pAssetLoader->TryFinishLoad( loadId, spAsset ) )
+			{
+				++pendingIndex;
+
+				continue;
+			}
+
+			if( !spAsset || spAsset->GetAnyFlagSet( Asset::FLAG_BROKEN ) )
+			{
+				const AssetPath& rPath = rWorkItems[ workItemIndex ].path;
+				HELIUM_TRACE( TraceLevels::Error, TXT( "Cook: Failed to load \"%s\".\n" ), *rPath.ToString() );
+				rReport.AddFailure( rPath, TXT( "load" ) );
+			}
+
+			pendingIndices[ pendingIndex ] = pendingIndices.GetLast();
+			pendingIndices.Pop();
+		}
+
+		uint64_t currentTicks = Timer::GetTickCount();
+		if( pendingIndices.GetSize() != pendingCount || rAsyncLoader.GetCompletionCount() != completionCount )
+		{
+			progressTicks = currentTicks;
+
+			continue;
+		}
+
+		if( static_cast< float32_t >( currentTicks - progressTicks ) * Timer::GetSecondsPerTick() >= stallTimeout )
+		{
+			size_t stalledCount = pendingIndices.GetSize();
+			for( size_t stalledIndex = 0; stalledIndex < stalledCount; ++stalledIndex )
+			{
+				const AssetPath& rPath = rWorkItems[ pendingIndices[ stalledIndex ] ].path;
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					TXT( "Cook: Timed out waiting for \"%s\" to load.\n" ),
+					*rPath.ToString() );
+				rReport.AddFailure( rPath, TXT( "timeout" ) );
+			}
+
+			return false;
+		}
+
+		// Nothing finished this tick, so sleep until file I/O completes instead of spinning.
+		rAsyncLoader.WaitForCompletion( completionCount, AssetLoader::FINISH_LOAD_WAIT_TIMEOUT );
+	}
+
+	return true;
+}
+
+/// Load every asset in the work list, caching objects and queuing resources that need preprocessing.
+///
+/// Assets are loaded in waves of equal depth, so that every object has finished loading before the objects it owns are
+/// requested.  If a wave stalls, its remaining assets and all assets in later waves are reported as failures.
+///
+/// @param[in]     rWorkItems    Assets to cook, sorted by depth.
+/// @param[in]     stallTimeout  Time to wait without any load finishing before giving up, in seconds.
+/// @param[in,out] rReport       Cook report to update.
+static void LoadAssets( const DynamicArray< CookWorkItem >& rWorkItems, float32_t stallTimeout, CookReport& rReport )
+{
+	size_t workItemCount = rWorkItems.GetSize();
+
+	size_t waveStartIndex = 0;
+	while( waveStartIndex < workItemCount )
+	{
+		size_t waveDepth = rWorkItems[ waveStartIndex ].depth;
+		size_t waveEndIndex = waveStartIndex + 1;
+		while( waveEndIndex < workItemCount && rWorkItems[ waveEndIndex ].depth == waveDepth )
+		{
+			++waveEndIndex;
+		}
+
+		if( !LoadWave( rWorkItems, waveStartIndex, waveEndIndex, stallTimeout, rReport ) )
+		{
+			for( size_t workItemIndex = waveEndIndex; workItemIndex < workItemCount; ++workItemIndex )
+			{
+				rReport.AddFailure( rWorkItems[ workItemIndex ].path, TXT( "timeout" ) );
+			}
+
+			break;
+		}
+
+		waveStartIndex = waveEndIndex;
+	}
+}
+
+/// Print command-line usage.
+static void PrintUsage()
+{
+	printf(
+		TXT( "Usage: Cook [options]\n" )
+		TXT( "Preprocesses and caches every asset in the data directory for all supported platforms.\n\n" )
+		TXT( "  --report <file>        Write a JSON report to <file> (written to stdout on failure if omitted).\n" )
+		TXT( "  --workers <count>      Number of worker threads (defaults to one per processor).\n" )
+		TXT( "  --stall-timeout <sec>  Give up on loads that make no progress for <sec> seconds (defaults to 300).\n" )
+		TXT( "  --shared-cache <dir>   Share preprocessed resource data with other workspaces through <dir>.\n" ) );
+}
+
+/// Headless cook entry point.
+///
+/// @param[in] argc  Number of command-line arguments.
+/// @param[in] argv  Command-line arguments.
+///
+/// @return  Zero if every asset was cooked successfully, one if any asset failed, or two on invalid usage or
+///          initialization failure.
+int main( int argc, const char* argv[] )
+{
+	const char* pReportFileName = NULL;
+	const char* pSharedCacheDirectory = NULL;
+	uint32_t workerCount = Invalid< uint32_t >();
+	float32_t stallTimeout = DEFAULT_STALL_TIMEOUT;
+
+	for( int argIndex = 1; argIndex < argc; ++argIndex )
+	{
+		const char* pArg = argv[ argIndex ];
+		const char* pValue = ( argIndex + 1 < argc ? argv[ argIndex + 1 ] : NULL );
+
+		if( pValue && strcmp( pArg, TXT( "--report" ) ) == 0 )
+		{
+			pReportFileName = pValue;
+			++argIndex;
+		}
+		else if( pValue && strcmp( pArg, TXT( "--workers" ) ) == 0 )
+		{
+			workerCount = static_cast< uint32_t >( atoi( pValue ) );
+			++argIndex;
+		}
+		else if( pValue && strcmp( pArg, TXT( "--stall-timeout" ) ) == 0 )
+		{
+			stallTimeout = static_cast< float32_t >( atof( pValue ) );
+			++argIndex;
+		}
+		else if( pValue && strcmp( pArg, TXT( "--shared-cache" ) ) == 0 )
+		{
+			pSharedCacheDirectory = pValue;
+			++argIndex;
+		}
+		else
+		{
+			PrintUsage();
+
+			return CookReport::RESULT_ERROR;
+		}
+	}
+
+	HELIUM_TRACE_SET_LEVEL( TraceLevels::Warning );
+
+	Helium::GetComponentsDefaultHeap();
+	Helium::GetBulletDefaultHeap();
+	Helium::GetEditorSupportDefaultHeap();
+
+#if !HELIUM_RELEASE && !HELIUM_PROFILE
+	Helium::InitializeSymbols();
+#endif
+
+	AsyncLoader::GetStaticInstance().Initialize();
+	JobPool::GetStaticInstance().Initialize( workerCount );
+
+	FilePath baseDirectory;
+	if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cook: Could not get base directory.\n" ) );
+
+		return CookReport::RESULT_ERROR;
+	}
+
+	HELIUM_VERIFY( CacheManager::InitializeStaticInstance( baseDirectory ) );
+	Helium::Bullet::Initialize();
+
+	Reflect::Initialize();
+	Helium::Components::Initialize( NULL );
+
+	InitEngineJobsDefaultHeap();
+	InitGraphicsJobsDefaultHeap();
+
+	HELIUM_VERIFY( LooseAssetLoader::InitializeStaticInstance() );
+
+	AssetPreprocessor* pAssetPreprocessor = AssetPreprocessor::CreateStaticInstance();
+	HELIUM_ASSERT( pAssetPreprocessor );
+	PlatformPreprocessor* pPlatformPreprocessor = new PcPreprocessor;
+	HELIUM_ASSERT( pPlatformPreprocessor );
+	pAssetPreprocessor->SetPlatformPreprocessor( Cache::PLATFORM_PC, pPlatformPreprocessor );
+
+	int resultCode = CookReport::RESULT_SUCCESS;
+
+	if( pSharedCacheDirectory && !pAssetPreprocessor->EnableSharedCache( FilePath( pSharedCacheDirectory ) ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cook: Failed to open shared cache directory \"%s\".\n" ),
+			pSharedCacheDirectory );
+
+		resultCode = CookReport::RESULT_ERROR;
+	}
+
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
+	if( resultCode == CookReport::RESULT_SUCCESS )
+	{
+		uint64_t startTicks = Timer::GetTickCount();
+
+		CookReport report;
+
+		// Hold all cache updates in memory so that each cache is written once at the end.
+		CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+		rCacheManager.BeginBatchWrites();
+
+		Config& rConfig = Config::GetStaticInstance();
+		rConfig.BeginLoad();
+		while( !rConfig.TryFinishLoad() )
+		{
+			pAssetLoader->Tick();
+		}
+
+		// Load everything first, queuing resources that need preprocessing, then preprocess them across all cores.
+		pAssetPreprocessor->SetDeferResourcePreprocessing( true );
+
+		DynamicArray< CookWorkItem > workItems;
+		BuildWorkList( workItems, report );
+		LoadAssets( workItems, stallTimeout, report );
+
+		report.preprocessedCount = pAssetPreprocessor->GetDeferredResourceCount();
+
+		DynamicArray< AssetPath > failedPaths;
+		pAssetPreprocessor->PreprocessDeferredResources( failedPaths );
+		pAssetPreprocessor->SetDeferResourcePreprocessing( false );
+
+		size_t failedPathCount = failedPaths.GetSize();
+		for( size_t failedPathIndex = 0; failedPathIndex < failedPathCount; ++failedPathIndex )
+		{
+			report.AddFailure( failedPaths[ failedPathIndex ], TXT( "preprocess" ) );
+		}
+
+		DynamicArray< String > failedCacheFiles;
+		rCacheManager.EndBatchWrites( &failedCacheFiles );
+
+		size_t failedCacheFileCount = failedCacheFiles.GetSize();
+		for( size_t failedCacheFileIndex = 0; failedCacheFileIndex < failedCacheFileCount; ++failedCacheFileIndex )
+		{
+			report.AddFailure( failedCacheFiles[ failedCacheFileIndex ], TXT( "write" ) );
+		}
+
+		report.seconds = static_cast< float32_t >( Timer::GetTickCount() - startTicks ) * Timer::GetSecondsPerTick();
+
+		resultCode = report.GetResult();
+
+		printf(
+			( TXT( "Cooked %" ) PRIuSZ TXT( " assets in %" ) PRIuSZ TXT( " packages (%" ) PRIuSZ
+			TXT( " resources preprocessed) in %.2f seconds, %" ) PRIuSZ TXT( " failures.\n" ) ),
+			report.assetCount,
+			report.packageCount,
+			report.preprocessedCount,
+			report.seconds,
+			report.failures.GetSize() );
+
+		String reportJson;
+		report.BuildJson( reportJson );
+
+		if( pReportFileName )
+		{
+			FileStream* pReportStream = FileStream::OpenFileStream( FilePath( pReportFileName ), FileStream::MODE_WRITE, true );
+			if( !pReportStream ||
+				pReportStream->Write( reportJson.GetData(), 1, reportJson.GetSize() ) != reportJson.GetSize() )
+			{
+				HELIUM_TRACE( TraceLevels::Error, TXT( "Cook: Failed to write report \"%s\".\n" ), pReportFileName );
+
+				resultCode = ( resultCode != CookReport::RESULT_SUCCESS ? resultCode : CookReport::RESULT_ERROR );
+			}
+
+			delete pReportStream;
+		}
+		else if( resultCode != CookReport::RESULT_SUCCESS )
+		{
+			printf( TXT( "%s" ), *reportJson );
+		}
+	}
+
+	Config::DestroyStaticInstance();
+	AssetPreprocessor::DestroyStaticInstance();
+	AssetLoader::DestroyStaticInstance();
+	CacheManager::DestroyStaticInstance();
+	JobPool::DestroyStaticInstance();
+
+	Helium::Components::Cleanup();
+
+	Reflect::Cleanup();
+	AssetType::Shutdown();
+	Asset::Shutdown();
+
+	Reflect::ObjectRefCountSupport::Shutdown();
+	Helium::Bullet::Cleanup();
+
+	AssetPath::Shutdown();
+	Name::Shutdown();
+
+	FileLocations::Shutdown();
+
+	ThreadLocalStackAllocator::ReleaseMemoryHeap();
+
+	return resultCode;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Platform/Trace.h"
+#include "Platform/Timer.h"
+#include "Foundation/DynamicArray.h"
+#include "Foundation/FilePath.h"
+#include "Foundation/FileStream.h"
+#include "Engine/Asset.h"
+#include "Engine/AssetLoader.h"
+#include "Engine/AsyncLoader.h"
+#include "Engine/CacheManager.h"
+#include "Engine/Config.h"
+#include "Engine/FileLocations.h"
+#include "Engine/JobPool.h"
+#include "Engine/PackageLoader.h"
+#include "EngineJobs/EngineJobsInterface.h"
+#include "GraphicsJobs/GraphicsJobs.h"
+#include "PcSupport/AssetPreprocessor.h"
+#include "PcSupport/CookReport.h"
+#include "PcSupport/LooseAssetLoader.h"
+#include "PreprocessingPc/PcPreprocessor.h"
@@ -22,6 +22,7 @@
 
 #include "Engine/FileLocations.h"
 #include "Engine/AsyncLoader.h"
+#include "Engine/JobPool.h"
 #include "Engine/AssetLoader.h"
 #include "Engine/CacheManager.h"
 #include "Engine/Config.h"
@@ -212,6 +213,11 @@ bool App::OnInit()
 	HELIUM_VERIFY( asyncLoader.Initialize() );
 	m_InitializerStack.Push( AsyncLoader::DestroyStaticInstance );
 
+	// Worker threads for parallel engine work.
+	JobPool& jobPool = JobPool::GetStaticInstance();
+	HELIUM_VERIFY( jobPool.Initialize() );
+	m_InitializerStack.Push( JobPool::DestroyStaticInstance );
+
 	// Asset cache management.
 	FilePath baseDirectory;
 	if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
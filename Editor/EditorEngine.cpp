@@ -7,6 +7,7 @@
 #endif
 
 #include "Graphics/DynamicDrawer.h"
+#include "Graphics/TextureStreamingManager.h"
 #include "Framework/WorldManager.h"
 #include "Reflect/Object.h"
 #include "Graphics/BufferedDrawer.h"
@@ -359,6 +360,7 @@ void EditorEngine::Shutdown()
 		DynamicDrawer::DestroyStaticInstance();
 		RenderResourceManager::DestroyStaticInstance();
 		Renderer::DestroyStaticInstance();
+		TextureStreamingManager::DestroyStaticInstance();
 		ForciblyFullyLoadedPackageManager::DestroyStaticInstance();
 
 		m_SceneManager = NULL;
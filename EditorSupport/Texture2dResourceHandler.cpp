@@ -327,4 +327,11 @@ bool Texture2dResourceHandler::CacheResource(
     return true;
 }
 
+/// @copydoc ResourceHandler::IsThreadSafe()
+bool Texture2dResourceHandler::IsThreadSafe() const
+{
+    // Image loading and texture compression only use per-call state.
+    return true;
+}
+
 #endif  // HELIUM_TOOLS
@@ -28,6 +28,7 @@ namespace Helium
 
         virtual bool CacheResource(
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
+        virtual bool IsThreadSafe() const;
         //@}
     };
 }
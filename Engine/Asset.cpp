@@ -117,6 +117,7 @@ AssetWPtr Asset::sm_wpFirstTopLevelObject;
 Asset::ChildNameInstanceIndexMap* Asset::sm_pNameInstanceIndexMap = NULL;
 Pair< AssetPath, Asset::NameInstanceIndexMap >* Asset::sm_pEmptyNameInstanceIndexMap = NULL;
 Pair< Name, Asset::InstanceIndexSet >* Asset::sm_pEmptyInstanceIndexSet = NULL;
+Asset::PathObjectMap* Asset::sm_pPathObjectMap = NULL;
 
 ReadWriteLock Asset::sm_objectListLock;
 
@@ -995,9 +996,14 @@ bool Asset::CreateObject(
 
 /// Find an object based on its path name.
 ///
+/// Objects are registered by path whenever they are named or renamed, so this is a single hash map lookup that does
+/// not need to acquire the object list lock.
+///
 /// @param[in] path  FilePath of the object to locate.
 ///
 /// @return  Pointer to the object if found, null pointer if not found.
+///
+/// @see FindObjectInHierarchy()
 Asset* Asset::FindObject( AssetPath path )
 {
 	// Make sure the path isn't empty.
@@ -1006,6 +1012,40 @@ Asset* Asset::FindObject( AssetPath path )
 		return NULL;
 	}
 
+	// The lookup map is only created once the first object is named.
+	PathObjectMap* pPathObjectMap = sm_pPathObjectMap;
+	if( !pPathObjectMap )
+	{
+		return NULL;
+	}
+
+	PathObjectMap::ConstAccessor objectAccessor;
+	if( !pPathObjectMap->Find( objectAccessor, path ) )
+	{
+		return NULL;
+	}
+
+	return objectAccessor->Second();
+}
+
+/// Find an object based on its path name by searching down the object ownership hierarchy.
+///
+/// This yields the same results as FindObject(), but walks the children of each object along the path under the
+/// object list lock instead of using the path lookup map.
+///
+/// @param[in] path  FilePath of the object to locate.
+///
+/// @return  Pointer to the object if found, null pointer if not found.
+///
+/// @see FindObject()
+Asset* Asset::FindObjectInHierarchy( AssetPath path )
+{
+	// Make sure the path isn't empty.
+	if( path.IsEmpty() )
+	{
+		return NULL;
+	}
+
 	// Assemble a list of object names and instance indices, from the top level on down.
 	size_t pathDepth = 0;
 	size_t packageDepth = 0;
@@ -1283,6 +1323,9 @@ void Asset::Shutdown()
 	delete sm_pEmptyInstanceIndexSet;
 	sm_pEmptyInstanceIndexSet = NULL;
 
+	delete sm_pPathObjectMap;
+	sm_pPathObjectMap = NULL;
+
 	sm_serializationBuffer.Clear();
 }
 
@@ -1384,6 +1427,8 @@ void Asset::SetCustomDestroyCallback( CUSTOM_DESTROY_CALLBACK* pDestroyCallback
 /// This should be called whenever the name of this object or one of its parents changes.
 void Asset::UpdatePath()
 {
+	AssetPath oldPath = m_path;
+
 	// Update this object's path first.
 	HELIUM_VERIFY( m_path.Set(
 		m_name,
@@ -1391,6 +1436,30 @@ void Asset::UpdatePath()
 		( m_spOwner ? m_spOwner->m_path : AssetPath( NULL_NAME ) ),
 		m_instanceIndex ) );
 
+	// Move this object's entry in the path lookup map.
+	if( m_path != oldPath )
+	{
+		PathObjectMap& rPathObjectMap = GetPathObjectMap();
+
+		if( !oldPath.IsEmpty() )
+		{
+			PathObjectMap::Accessor objectAccessor;
+			if( rPathObjectMap.Find( objectAccessor, oldPath ) && objectAccessor->Second().HasObjectProxy( this ) )
+			{
+				rPathObjectMap.Remove( objectAccessor );
+			}
+		}
+
+		if( !m_path.IsEmpty() )
+		{
+			PathObjectMap::Accessor objectAccessor;
+			if( !rPathObjectMap.Insert( objectAccessor, KeyValue< AssetPath, AssetWPtr >( m_path, AssetWPtr( this ) ) ) )
+			{
+				objectAccessor->Second() = this;
+			}
+		}
+	}
+
 	// Update the path of each child object.
 	for( Asset* pChild = m_wpFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
 	{
@@ -1435,6 +1504,25 @@ Asset::ChildNameInstanceIndexMap& Asset::GetNameInstanceIndexMap()
 	return *sm_pNameInstanceIndexMap;
 }
 
+/// Get the static path lookup map, creating it if necessary.
+///
+/// This should only be called while holding a write lock on the object list.  The map is created dynamically for the
+/// same reason as the name instance lookup map.
+///
+/// @return  Reference to the path lookup map.
+///
+/// @see GetNameInstanceIndexMap()
+Asset::PathObjectMap& Asset::GetPathObjectMap()
+{
+	if( !sm_pPathObjectMap )
+	{
+		sm_pPathObjectMap = new PathObjectMap;
+		HELIUM_ASSERT( sm_pPathObjectMap );
+	}
+
+	return *sm_pPathObjectMap;
+}
+
 AssetRegistrar< Asset, void > Asset::s_Registrar(TXT("Helium::Asset"));
 
 
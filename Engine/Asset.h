@@ -340,6 +340,7 @@ namespace Helium
 
 		static Asset* FindObject( AssetPath path );
 		template< typename T > static T* Find( AssetPath path );
+		static Asset* FindObjectInHierarchy( AssetPath path );
 
 		static Asset* FindChildOf( const Asset* pObject, Name name, uint32_t instanceIndex = Invalid< uint32_t >() );
 		static Asset* FindChildOf(
@@ -378,6 +379,8 @@ namespace Helium
 		typedef ConcurrentHashMap< Name, InstanceIndexSet > NameInstanceIndexMap;
 		/// Child object name instance lookup map type.
 		typedef ConcurrentHashMap< AssetPath, NameInstanceIndexMap > ChildNameInstanceIndexMap;
+		/// Named object lookup map type.
+		typedef ConcurrentHashMap< AssetPath, AssetWPtr > PathObjectMap;
 
 		/// Object name.
 		Name m_name;
@@ -416,6 +419,9 @@ namespace Helium
 		/// Empty name instance index lookup set.
 		static Pair< Name, InstanceIndexSet >* sm_pEmptyInstanceIndexSet;
 
+		/// Named object lookup, keyed by full object path.
+		static PathObjectMap* sm_pPathObjectMap;
+
 		/// Read-write lock for synchronizing access to the object lists.
 		static ReadWriteLock sm_objectListLock;
 
@@ -435,6 +441,7 @@ namespace Helium
 		/// @name Static Asset Management
 		//@{
 		static ChildNameInstanceIndexMap& GetNameInstanceIndexMap();
+		static PathObjectMap& GetPathObjectMap();
 		//@}
 	};
 
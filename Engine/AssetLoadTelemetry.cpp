@@ -0,0 +1,468 @@
+#include "EnginePch.h"
+#include "Engine/AssetLoadTelemetry.h"
+
+#include "Platform/Timer.h"
+#include "Foundation/FileStream.h"
+
+#include <algorithm>
+
+using namespace Helium;
+
+/// Get a tick count in milliseconds.
+///
+/// @param[in] ticks  Tick count.
+///
+/// @return  Number of milliseconds.
+static float64_t GetMilliseconds( uint64_t ticks )
+{
+	return static_cast< float64_t >( Timer::TicksToMilliseconds( ticks ) );
+}
+
+/// Append a string to a JSON document as a quoted, escaped string value.
+///
+/// @param[in,out] rJson    JSON document.
+/// @param[in]     pString  String to append.
+static void AppendJsonString( String& rJson, const char* pString )
+{
+	rJson += TXT( '"' );
+	for( ; *pString; ++pString )
+	{
+		char character = *pString;
+		if( character == TXT( '"' ) || character == TXT( '\\' ) )
+		{
+			rJson += TXT( '\\' );
+			rJson += character;
+		}
+		else if( static_cast< unsigned char >( character ) < 0x20 )
+		{
+			char escape[ 8 ];
+			StringPrint( escape, TXT( "\\u%04x" ), static_cast< unsigned int >( character ) );
+			rJson += escape;
+		}
+		else
+		{
+			rJson += character;
+		}
+	}
+	rJson += TXT( '"' );
+}
+
+/// Append the beginning or end of an asynchronous event to a trace document.
+///
+/// @param[in,out] rJson      Trace document.
+/// @param[in]     pName      Event name.
+/// @param[in]     pCategory  Event category.
+/// @param[in]     bBegin     True for the beginning of the event, false for the end.
+/// @param[in]     id         Event ID.
+/// @param[in]     ticks      Event time, relative to the start of the trace.
+/// @param[in]     pArgs      JSON object with additional event arguments, or null if the event has none.
+static void AppendTraceEvent(
+	String& rJson,
+	const char* pName,
+	const char* pCategory,
+	bool bBegin,
+	size_t id,
+	uint64_t ticks,
+	const char* pArgs = NULL )
+{
+	rJson += TXT( ",\n\t\t{ \"name\": " );
+	AppendJsonString( rJson, pName );
+	rJson += TXT( ", \"cat\": " );
+	AppendJsonString( rJson, pCategory );
+
+	char buffer[ 128 ];
+	StringPrint(
+		buffer,
+		TXT( ", \"ph\": \"%s\", \"id\": %" ) PRIuSZ TXT( ", \"ts\": %.3f, \"pid\": 0, \"tid\": 0" ),
+		( bBegin ? TXT( "b" ) : TXT( "e" ) ),
+		id,
+		GetMilliseconds( ticks ) * 1000.0 );
+	rJson += buffer;
+
+	if( pArgs )
+	{
+		rJson += TXT( ", \"args\": " );
+		rJson += pArgs;
+	}
+
+	rJson += TXT( " }" );
+}
+
+/// Constructor.
+///
+/// @param[in] recordLimit  Maximum number of load records to keep.
+AssetLoadTelemetry::AssetLoadTelemetry( size_t recordLimit )
+	: m_oldestRecordIndex( 0 )
+	, m_recordLimit( recordLimit )
+	, m_droppedRecordCount( 0 )
+	, m_startTicks( 0 )
+	, m_endTicks( 0 )
+{
+	HELIUM_ASSERT( recordLimit != 0 );
+}
+
+/// Destructor.
+AssetLoadTelemetry::~AssetLoadTelemetry()
+{
+}
+
+/// Add the statistics for a completed asset load.
+///
+/// Once the record limit has been reached, the oldest record is replaced.
+///
+/// @param[in] rRecord  Asset load statistics.
+void AssetLoadTelemetry::AddRecord( const Record& rRecord )
+{
+	m_lock.Lock();
+
+	if( m_records.GetSize() < m_recordLimit )
+	{
+		m_records.Push( rRecord );
+	}
+	else
+	{
+		m_records[ m_oldestRecordIndex ] = rRecord;
+		m_oldestRecordIndex = ( m_oldestRecordIndex + 1 ) % m_recordLimit;
+		++m_droppedRecordCount;
+	}
+
+	uint64_t endTicks = rRecord.stageEndTicks[ STAGE_LAST ];
+	if( m_typeStatistics.IsEmpty() )
+	{
+		m_startTicks = rRecord.queuedTicks;
+		m_endTicks = endTicks;
+	}
+	else
+	{
+		m_startTicks = Min( m_startTicks, rRecord.queuedTicks );
+		m_endTicks = Max( m_endTicks, endTicks );
+	}
+
+	TypeStatistics* pTypeStatistics = NULL;
+
+	size_t typeCount = m_typeStatistics.GetSize();
+	for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		if( m_typeStatistics[ typeIndex ].type == rRecord.type )
+		{
+			pTypeStatistics = &m_typeStatistics[ typeIndex ];
+
+			break;
+		}
+	}
+
+	if( !pTypeStatistics )
+	{
+		pTypeStatistics = m_typeStatistics.New();
+		HELIUM_ASSERT( pTypeStatistics );
+		pTypeStatistics->type = rRecord.type;
+		pTypeStatistics->loadCount = 0;
+		pTypeStatistics->errorCount = 0;
+		pTypeStatistics->bytesRead = 0;
+		pTypeStatistics->deserializeTicks = 0;
+		for( size_t stageIndex = 0; stageIndex < STAGE_MAX; ++stageIndex )
+		{
+			pTypeStatistics->stageTicks[ stageIndex ] = 0;
+		}
+		pTypeStatistics->totalTicks = 0;
+		pTypeStatistics->maxTicks = 0;
+	}
+
+	uint64_t totalTicks = rRecord.GetTotalTicks();
+
+	++pTypeStatistics->loadCount;
+	if( rRecord.bError )
+	{
+		++pTypeStatistics->errorCount;
+	}
+
+	pTypeStatistics->bytesRead += rRecord.bytesRead;
+	pTypeStatistics->deserializeTicks += rRecord.deserializeTicks;
+	for( size_t stageIndex = 0; stageIndex < STAGE_MAX; ++stageIndex )
+	{
+		pTypeStatistics->stageTicks[ stageIndex ] += rRecord.GetStageTicks( static_cast< EStage >( stageIndex ) );
+	}
+	pTypeStatistics->totalTicks += totalTicks;
+	pTypeStatistics->maxTicks = Max( pTypeStatistics->maxTicks, totalTicks );
+
+	m_lock.Unlock();
+}
+
+/// Discard all recorded statistics.
+void AssetLoadTelemetry::Reset()
+{
+	m_lock.Lock();
+
+	m_records.Clear();
+	m_oldestRecordIndex = 0;
+	m_droppedRecordCount = 0;
+	m_typeStatistics.Clear();
+	m_startTicks = 0;
+	m_endTicks = 0;
+
+	m_lock.Unlock();
+}
+
+/// Get the number of asset load records kept.
+///
+/// @return  Asset load record count (never more than the record limit).
+///
+/// @see GetDroppedRecordCount()
+size_t AssetLoadTelemetry::GetRecordCount() const
+{
+	m_lock.Lock();
+	size_t recordCount = m_records.GetSize();
+	m_lock.Unlock();
+
+	return recordCount;
+}
+
+/// Get the number of asset load records discarded since the last reset to stay within the record limit.
+///
+/// @return  Number of records dropped.
+///
+/// @see GetRecordCount()
+size_t AssetLoadTelemetry::GetDroppedRecordCount() const
+{
+	m_lock.Lock();
+	size_t droppedRecordCount = m_droppedRecordCount;
+	m_lock.Unlock();
+
+	return droppedRecordCount;
+}
+
+/// Get a copy of the statistics for each asset load record kept.
+///
+/// @param[out] rRecords  Asset load records, in order of completion.
+void AssetLoadTelemetry::GetRecords( DynamicArray< Record >& rRecords ) const
+{
+	m_lock.Lock();
+
+	size_t recordCount = m_records.GetSize();
+	rRecords.Resize( 0 );
+	rRecords.Reserve( recordCount );
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		rRecords.Push( m_records[ ( m_oldestRecordIndex + recordIndex ) % recordCount ] );
+	}
+
+	m_lock.Unlock();
+}
+
+/// Get a copy of the statistics for each asset type loaded.
+///
+/// @param[out] rTypeStatistics  Type statistics, sorted by total load time from slowest to fastest.
+void AssetLoadTelemetry::GetTypeStatistics( DynamicArray< TypeStatistics >& rTypeStatistics ) const
+{
+	m_lock.Lock();
+	rTypeStatistics = m_typeStatistics;
+	m_lock.Unlock();
+
+	std::sort(
+		rTypeStatistics.GetData(),
+		rTypeStatistics.GetData() + rTypeStatistics.GetSize(),
+		TypeStatisticsCompare() );
+}
+
+/// Write a report of the recorded statistics to the trace output.
+///
+/// The report lists the statistics of each asset type followed by the slowest assets, all sorted by load time.  Note
+/// that assets are loaded concurrently, so per-type load times can add up to more than the overall elapsed time.  The
+/// slowest assets are picked from the records kept, so older loads are not listed once the record limit is reached.
+///
+/// @param[in] assetCount  Maximum number of assets to list.
+void AssetLoadTelemetry::TraceReport( size_t assetCount ) const
+{
+	DynamicArray< Record > records;
+	GetRecords( records );
+
+	DynamicArray< TypeStatistics > typeStatistics;
+	GetTypeStatistics( typeStatistics );
+
+	m_lock.Lock();
+	uint64_t elapsedTicks = m_endTicks - m_startTicks;
+	m_lock.Unlock();
+
+	size_t recordCount = records.GetSize();
+	if( recordCount == 0 )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT( "Asset loading: No assets loaded.\n" ) );
+
+		return;
+	}
+
+	size_t loadCount = 0;
+	size_t bytesRead = 0;
+	size_t typeCount = typeStatistics.GetSize();
+	for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		loadCount += typeStatistics[ typeIndex ].loadCount;
+		bytesRead += typeStatistics[ typeIndex ].bytesRead;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "Asset loading: %" ) PRIuSZ TXT( " assets, %" ) PRIuSZ TXT( " bytes read, %.3f ms elapsed.\n" ),
+		loadCount,
+		bytesRead,
+		GetMilliseconds( elapsedTicks ) );
+
+	for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		const TypeStatistics& rTypeStatistics = typeStatistics[ typeIndex ];
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "  %s: %" ) PRIuSZ TXT( " loads (%" ) PRIuSZ TXT( " failed), %" ) PRIuSZ TXT( " bytes, %.3f ms " )
+			TXT( "total, %.3f ms max (preload %.3f, link %.3f, precache %.3f, finalize %.3f; deserialize %.3f).\n" ) ),
+			( rTypeStatistics.type.IsEmpty() ? TXT( "(none)" ) : *rTypeStatistics.type ),
+			rTypeStatistics.loadCount,
+			rTypeStatistics.errorCount,
+			rTypeStatistics.bytesRead,
+			GetMilliseconds( rTypeStatistics.totalTicks ),
+			GetMilliseconds( rTypeStatistics.maxTicks ),
+			GetMilliseconds( rTypeStatistics.stageTicks[ STAGE_PRELOAD ] ),
+			GetMilliseconds( rTypeStatistics.stageTicks[ STAGE_LINK ] ),
+			GetMilliseconds( rTypeStatistics.stageTicks[ STAGE_PRECACHE ] ),
+			GetMilliseconds( rTypeStatistics.stageTicks[ STAGE_FINALIZE ] ),
+			GetMilliseconds( rTypeStatistics.deserializeTicks ) );
+	}
+
+	std::sort( records.GetData(), records.GetData() + recordCount, RecordCompare() );
+
+	size_t reportCount = Min( assetCount, recordCount );
+	if( reportCount != 0 )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT( "Slowest asset loads:\n" ) );
+	}
+
+	for( size_t recordIndex = 0; recordIndex < reportCount; ++recordIndex )
+	{
+		const Record& rRecord = records[ recordIndex ];
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "  %s (%s): %.3f ms (preload %.3f, link %.3f, precache %.3f, finalize %.3f; deserialize %.3f), " )
+			TXT( "%" ) PRIuSZ TXT( " bytes%s.\n" ) ),
+			*rRecord.path.ToString(),
+			( rRecord.type.IsEmpty() ? TXT( "(none)" ) : *rRecord.type ),
+			GetMilliseconds( rRecord.GetTotalTicks() ),
+			GetMilliseconds( rRecord.GetStageTicks( STAGE_PRELOAD ) ),
+			GetMilliseconds( rRecord.GetStageTicks( STAGE_LINK ) ),
+			GetMilliseconds( rRecord.GetStageTicks( STAGE_PRECACHE ) ),
+			GetMilliseconds( rRecord.GetStageTicks( STAGE_FINALIZE ) ),
+			GetMilliseconds( rRecord.deserializeTicks ),
+			rRecord.bytesRead,
+			( rRecord.bError ? TXT( ", failed" ) : TXT( "" ) ) );
+	}
+}
+
+/// Write the recorded statistics to a file in the Trace Event format (viewable in chrome://tracing or Perfetto).
+///
+/// Each asset load record kept is written as an asynchronous event, with a nested event for each load stage.
+///
+/// @param[in] rFilePath  Path of the file to write.
+///
+/// @return  True if the file was written successfully, false if not.
+bool AssetLoadTelemetry::WriteTraceFile( const FilePath& rFilePath ) const
+{
+	DynamicArray< Record > records;
+	GetRecords( records );
+
+	size_t recordCount = records.GetSize();
+
+	uint64_t startTicks = ( recordCount != 0 ? records[ 0 ].queuedTicks : 0 );
+	for( size_t recordIndex = 1; recordIndex < recordCount; ++recordIndex )
+	{
+		startTicks = Min( startTicks, records[ recordIndex ].queuedTicks );
+	}
+
+	String json( TXT( "{\n\t\"traceEvents\": [\n\t\t{ \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, " )
+		TXT( "\"args\": { \"name\": \"Asset Loading\" } }" ) );
+
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		const Record& rRecord = records[ recordIndex ];
+		const char* pCategory = ( rRecord.type.IsEmpty() ? TXT( "none" ) : *rRecord.type );
+		String path = rRecord.path.ToString();
+
+		AppendTraceEvent( json, *path, pCategory, true, recordIndex, rRecord.queuedTicks - startTicks );
+
+		for( size_t stageIndex = 0; stageIndex < STAGE_MAX; ++stageIndex )
+		{
+			EStage stage = static_cast< EStage >( stageIndex );
+			const char* pStageName = GetStageName( stage );
+			AppendTraceEvent( json, pStageName, pCategory, true, recordIndex, rRecord.GetStageStartTicks( stage ) - startTicks );
+			AppendTraceEvent( json, pStageName, pCategory, false, recordIndex, rRecord.stageEndTicks[ stage ] - startTicks );
+		}
+
+		// Attach the I/O statistics to the end of the load event.
+		char args[ 128 ];
+		StringPrint(
+			args,
+			TXT( "{ \"bytesRead\": %" ) PRIuSZ TXT( ", \"deserializeMs\": %.3f, \"error\": %s }" ),
+			rRecord.bytesRead,
+			GetMilliseconds( rRecord.deserializeTicks ),
+			( rRecord.bError ? TXT( "true" ) : TXT( "false" ) ) );
+
+		AppendTraceEvent( json, *path, pCategory, false, recordIndex, rRecord.stageEndTicks[ STAGE_LAST ] - startTicks, args );
+	}
+
+	json += TXT( "\n\t]\n}\n" );
+
+	FileStream* pTraceStream = FileStream::OpenFileStream( rFilePath, FileStream::MODE_WRITE, true );
+	bool bSuccess = ( pTraceStream && pTraceStream->Write( json.GetData(), 1, json.GetSize() ) == json.GetSize() );
+	delete pTraceStream;
+
+	if( !bSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "AssetLoadTelemetry: Failed to write trace file \"%s\".\n" ),
+			rFilePath.c_str() );
+	}
+
+	return bSuccess;
+}
+
+/// Get the display name of a load stage.
+///
+/// @param[in] stage  Load stage.
+///
+/// @return  Stage name.
+const tchar_t* AssetLoadTelemetry::GetStageName( EStage stage )
+{
+	static const tchar_t* const stageNames[ STAGE_MAX ] =
+	{
+		TXT( "Preload" ),
+		TXT( "Link" ),
+		TXT( "Precache" ),
+		TXT( "Finalize" )
+	};
+
+	HELIUM_ASSERT( static_cast< size_t >( stage ) < static_cast< size_t >( STAGE_MAX ) );
+
+	return stageNames[ stage ];
+}
+
+/// Get whether one asset load should be listed before another.
+///
+/// @param[in] rRecord0  First asset load record.
+/// @param[in] rRecord1  Second asset load record.
+///
+/// @return  True if the first asset took longer to load than the second, false if not.
+bool AssetLoadTelemetry::RecordCompare::operator()( const Record& rRecord0, const Record& rRecord1 ) const
+{
+	return ( rRecord0.GetTotalTicks() > rRecord1.GetTotalTicks() );
+}
+
+/// Get whether the statistics for one asset type should be listed before another.
+///
+/// @param[in] rStatistics0  First type statistics.
+/// @param[in] rStatistics1  Second type statistics.
+///
+/// @return  True if the first type took longer to load in total than the second, false if not.
+bool AssetLoadTelemetry::TypeStatisticsCompare::operator()(
+	const TypeStatistics& rStatistics0,
+	const TypeStatistics& rStatistics1 ) const
+{
+	return ( rStatistics0.totalTicks > rStatistics1.totalTicks );
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Platform/Locks.h"
+#include "Foundation/DynamicArray.h"
+#include "Foundation/FilePath.h"
+#include "Foundation/Name.h"
+#include "Engine/AssetPath.h"
+
+namespace Helium
+{
+	/// Timing and I/O statistics for the assets loaded through the AssetLoader.
+	///
+	/// The asset loader adds a record for each asset it loads holding the time at which the load was requested, the time
+	/// at which each load stage finished, and the number of bytes read and time spent deserializing as reported by the
+	/// package loader.  Records are also aggregated by asset type as they are added.  Gathering this information costs a
+	/// handful of timer reads and a brief lock per asset, so it is always enabled.
+	///
+	/// Only the most recent records are kept, up to a fixed limit, so memory use stays bounded no matter how long the
+	/// application runs.  The per-type statistics and overall totals still cover every load since the last Reset().
+	///
+	/// A typical use is to call Reset() before loading a level and TraceReport() or WriteTraceFile() once it has loaded.
+	/// GameSystem::LoadScene() does this automatically.
+	///
+	/// Adding records is thread-safe.
+	class HELIUM_ENGINE_API AssetLoadTelemetry : NonCopyable
+	{
+	public:
+		/// Default number of assets listed by TraceReport().
+		static const size_t DEFAULT_REPORT_ASSET_COUNT = 20;
+		/// Default maximum number of load records kept.
+		static const size_t DEFAULT_RECORD_LIMIT = 4096;
+
+		/// Load stages.
+		enum EStage
+		{
+			STAGE_FIRST   =  0,
+			STAGE_INVALID = -1,
+
+			/// Reading and deserializing the object through its package loader.
+			STAGE_PRELOAD,
+			/// Linking object references.
+			STAGE_LINK,
+			/// Precaching resource data.
+			STAGE_PRECACHE,
+			/// Finalizing the load.
+			STAGE_FINALIZE,
+
+			STAGE_MAX,
+			STAGE_LAST = STAGE_MAX - 1
+		};
+
+		/// Statistics for a single asset load.
+		struct HELIUM_ENGINE_API Record
+		{
+			/// Asset path.
+			AssetPath path;
+			/// Asset type name (null if the asset failed to load).
+			Name type;
+
+			/// Tick count at which the load was requested.
+			uint64_t queuedTicks;
+			/// Tick count at which each load stage finished.
+			uint64_t stageEndTicks[ STAGE_MAX ];
+
+			/// Number of bytes read by the package loader.
+			size_t bytesRead;
+			/// Ticks spent deserializing the object.
+			uint64_t deserializeTicks;
+
+			/// True if an error occurred during the load.
+			bool bError;
+
+			/// @name Data Access
+			//@{
+			inline uint64_t GetStageStartTicks( EStage stage ) const;
+			inline uint64_t GetStageTicks( EStage stage ) const;
+			inline uint64_t GetTotalTicks() const;
+			//@}
+		};
+
+		/// Statistics aggregated for each asset type.
+		struct TypeStatistics
+		{
+			/// Asset type name.
+			Name type;
+
+			/// Number of assets loaded.
+			size_t loadCount;
+			/// Number of assets that failed to load.
+			size_t errorCount;
+
+			/// Total number of bytes read.
+			size_t bytesRead;
+			/// Total ticks spent deserializing.
+			uint64_t deserializeTicks;
+			/// Total ticks spent in each load stage (including time spent waiting on other assets).
+			uint64_t stageTicks[ STAGE_MAX ];
+			/// Total ticks from load request to completion.
+			uint64_t totalTicks;
+			/// Ticks from load request to completion of the slowest asset.
+			uint64_t maxTicks;
+		};
+
+		/// @name Construction/Destruction
+		//@{
+		explicit AssetLoadTelemetry( size_t recordLimit = DEFAULT_RECORD_LIMIT );
+		~AssetLoadTelemetry();
+		//@}
+
+		/// @name Recording
+		//@{
+		void AddRecord( const Record& rRecord );
+		void Reset();
+		//@}
+
+		/// @name Data Access
+		//@{
+		size_t GetRecordCount() const;
+		size_t GetDroppedRecordCount() const;
+		void GetRecords( DynamicArray< Record >& rRecords ) const;
+		void GetTypeStatistics( DynamicArray< TypeStatistics >& rTypeStatistics ) const;
+		//@}
+
+		/// @name Reporting
+		//@{
+		void TraceReport( size_t assetCount = DEFAULT_REPORT_ASSET_COUNT ) const;
+		bool WriteTraceFile( const FilePath& rFilePath ) const;
+		//@}
+
+		/// @name Static Utility Functions
+		//@{
+		static const tchar_t* GetStageName( EStage stage );
+		//@}
+
+	private:
+		/// Ordering of load records from slowest to fastest.
+		class RecordCompare
+		{
+		public:
+			/// @name Overloaded Operators
+			//@{
+			bool operator()( const Record& rRecord0, const Record& rRecord1 ) const;
+			//@}
+		};
+
+		/// Ordering of type statistics from slowest to fastest.
+		class TypeStatisticsCompare
+		{
+		public:
+			/// @name Overloaded Operators
+			//@{
+			bool operator()( const TypeStatistics& rStatistics0, const TypeStatistics& rStatistics1 ) const;
+			//@}
+		};
+
+		/// Lock protecting the records and type statistics.
+		mutable SpinLock m_lock;
+
+		/// Most recent asset load records (in order of completion, starting at m_oldestRecordIndex).
+		DynamicArray< Record > m_records;
+		/// Index of the oldest record in m_records.
+		size_t m_oldestRecordIndex;
+		/// Maximum number of records kept.
+		size_t m_recordLimit;
+		/// Number of records discarded to stay within the record limit since the last reset.
+		size_t m_droppedRecordCount;
+		/// Statistics for each asset type loaded.
+		DynamicArray< TypeStatistics > m_typeStatistics;
+
+		/// Earliest load request time of all records added since the last reset.
+		uint64_t m_startTicks;
+		/// Latest load completion time of all records added since the last reset.
+		uint64_t m_endTicks;
+	};
+}
+
+#include "Engine/AssetLoadTelemetry.inl"
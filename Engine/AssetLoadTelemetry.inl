@@ -0,0 +1,39 @@
+/// Get the tick count at which a load stage started.
+///
+/// @param[in] stage  Load stage.
+///
+/// @return  Tick count at which the previous stage finished (or the load was requested, for the first stage).
+///
+/// @see GetStageTicks()
+uint64_t Helium::AssetLoadTelemetry::Record::GetStageStartTicks( EStage stage ) const
+{
+	HELIUM_ASSERT( static_cast< size_t >( stage ) < static_cast< size_t >( STAGE_MAX ) );
+
+	return ( stage == STAGE_FIRST ? queuedTicks : stageEndTicks[ stage - 1 ] );
+}
+
+/// Get the number of ticks spent in a load stage.
+///
+/// This includes any time spent waiting on other assets or on file I/O during the stage.
+///
+/// @param[in] stage  Load stage.
+///
+/// @return  Ticks spent in the stage.
+///
+/// @see GetStageStartTicks(), GetTotalTicks()
+uint64_t Helium::AssetLoadTelemetry::Record::GetStageTicks( EStage stage ) const
+{
+	HELIUM_ASSERT( static_cast< size_t >( stage ) < static_cast< size_t >( STAGE_MAX ) );
+
+	return stageEndTicks[ stage ] - GetStageStartTicks( stage );
+}
+
+/// Get the number of ticks from the load request to the end of the load.
+///
+/// @return  Total load ticks.
+///
+/// @see GetStageTicks()
+uint64_t Helium::AssetLoadTelemetry::Record::GetTotalTicks() const
+{
+	return stageEndTicks[ STAGE_LAST ] - queuedTicks;
+}
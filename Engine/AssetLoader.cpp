@@ -2,7 +2,9 @@
 #include "Engine/AssetLoader.h"
 
 #include "Platform/Thread.h"
+#include "Platform/Timer.h"
 #include "Engine/Asset.h"
+#include "Engine/AsyncLoader.h"
 #include "Engine/PackageLoader.h"
 #include "Engine/FileLocations.h"
 
@@ -19,6 +21,9 @@ AssetTracker* AssetTracker::sm_pInstance = NULL;
 /// Constructor.
 AssetLoader::AssetLoader()
 : m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
+, m_stateChangeCount( 0 )
+, m_precacheWaitCompletionCount( 0 )
+, m_precacheWaitStateChangeCount( 0 )
 {
 }
 
@@ -101,6 +106,18 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 	pRequest->spObject = pAsset;
 	pRequest->forceReload = forceReload;
 
+	AssetLoadTelemetry::Record& rTelemetry = pRequest->telemetry;
+	rTelemetry.path = path;
+	rTelemetry.type.Clear();
+	rTelemetry.queuedTicks = Timer::GetTickCount();
+	for( size_t stageIndex = 0; stageIndex < AssetLoadTelemetry::STAGE_MAX; ++stageIndex )
+	{
+		rTelemetry.stageEndTicks[ stageIndex ] = 0;
+	}
+	rTelemetry.bytesRead = 0;
+	rTelemetry.deserializeTicks = 0;
+	rTelemetry.bError = false;
+
 	ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor requestAccessor;
 	if( m_loadRequestMap.Insert( requestAccessor, KeyValue< AssetPath, LoadRequest* >( path, pRequest ) ) )
 	{
@@ -171,6 +188,8 @@ bool AssetLoader::TryFinishLoad( size_t id, AssetPtr& rspObject )
 	int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
 	if( newRequestCount == 0 )
 	{
+		HELIUM_ASSERT( pRequest->waiters.IsEmpty() );
+
 		pRequest->spObject.Release();
 		pRequest->resolver.Clear();
 
@@ -195,6 +214,10 @@ bool AssetLoader::TryFinishLoad( size_t id, AssetPtr& rspObject )
 
 /// Block the current thread while waiting for an object load request or package pre-load request to complete.
 ///
+/// While waiting, this keeps ticking the loader so that any other load requests with work ready to run advance as
+/// well.  If a tick makes no progress, the thread sleeps until a pending file read completes (or a short timeout
+/// elapses, as progress can also come from other threads) instead of spinning.
+///
 /// Note that after a load request has completed, the request ID will no longer be valid.
 ///
 /// @param[in]  id         Load request ID.
@@ -204,10 +227,19 @@ bool AssetLoader::TryFinishLoad( size_t id, AssetPtr& rspObject )
 /// @see TryFinishLoad(), BeginLoadObject(), BeginPreloadPackage()
 void AssetLoader::FinishLoad( size_t id, AssetPtr& rspObject )
 {
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
 	while( !TryFinishLoad( id, rspObject ) )
 	{
+		int32_t completionCount = rAsyncLoader.GetCompletionCount();
+		int32_t stateChangeCount = m_stateChangeCount;
+
 		Tick();
-		Thread::Yield();
+
+		if( m_stateChangeCount == stateChangeCount )
+		{
+			rAsyncLoader.WaitForCompletion( completionCount, FINISH_LOAD_WAIT_TIMEOUT );
+		}
 	}
 }
 
@@ -263,65 +295,136 @@ bool AssetLoader::CacheObject( Asset* /*pObject*/, bool /*bEvictPlatformPreproce
 #endif  // HELIUM_TOOLS
 
 /// Update object loading.
+///
+/// Only load requests that are ready to make progress are updated.  A request that cannot advance is parked until
+/// whatever it is waiting on changes: requests waiting on other requests are woken when those requests advance,
+/// requests waiting on an object preload are woken by their package loader through WakeLoadRequest(), requests
+/// waiting on package preloading are checked once per package loader, and requests waiting on resource precaching are
+/// only checked again once file I/O has completed or another request has advanced.
 void AssetLoader::Tick()
 {
 	// Tick package loaders first.
 	TickPackageLoaders();
 
-	// Build the list of object load requests to update this tick, incrementing the request count on each to prevent
-	// them from being released while we don't have a lock on the request hash map.
-	//HELIUM_ASSERT( m_loadRequestTickArray.IsEmpty() );
-	/// List of load requests to update in the current tick.
-	DynamicArray< LoadRequest* > m_loadRequestTickArray;
-
-	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor loadRequestConstAccessor;
-	if( m_loadRequestMap.First( loadRequestConstAccessor ) )
+	// Wake requests whose package loaders have finished preloading.
+	PreloadWaitList preloadWaits;
 	{
-		do
-		{
-			LoadRequest* pRequest = loadRequestConstAccessor->Second();
-			HELIUM_ASSERT( pRequest );
-			AtomicIncrementUnsafe( pRequest->requestCount );
-			m_loadRequestTickArray.Add( pRequest );
+		Locker< PreloadWaitList, SpinLock >::Handle preloadWaitHandle( m_preloadWaits );
+		preloadWaitHandle->Swap( preloadWaits );
+	}
 
-			++loadRequestConstAccessor;
-		} while( loadRequestConstAccessor.IsValid() );
+	DynamicArray< LoadRequest* > wakeRequests;
+	preloadWaits.RemoveReady( wakeRequests );
+
+	{
+		Locker< PreloadWaitList, SpinLock >::Handle preloadWaitHandle( m_preloadWaits );
+		preloadWaitHandle->Merge( preloadWaits );
 	}
 
-	// Tick object load requests.
-	size_t loadRequestCount = m_loadRequestTickArray.GetSize();
-	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
+	WakeRequests( wakeRequests );
+	wakeRequests.Resize( 0 );
+
+	// Wake requests waiting on resource precaching if anything they could be waiting on has happened since they were
+	// last checked.
+	int32_t completionCount = AsyncLoader::GetStaticInstance().GetCompletionCount();
+	int32_t stateChangeCount = m_stateChangeCount;
+	if( completionCount != m_precacheWaitCompletionCount || stateChangeCount != m_precacheWaitStateChangeCount )
 	{
-		LoadRequest* pRequest = m_loadRequestTickArray[ requestIndex ];
-		HELIUM_ASSERT( pRequest );
+		m_precacheWaitCompletionCount = completionCount;
+		m_precacheWaitStateChangeCount = stateChangeCount;
 
-		//HELIUM_TRACE( TraceLevels::Info, TXT(  "Ticking pRequest %s %x\n"), *pRequest->path.ToString(), pRequest->stateFlags );
+		{
+			Locker< DynamicArray< LoadRequest* >, SpinLock >::Handle precacheWaitHandle( m_precacheWaits );
+			precacheWaitHandle->Swap( wakeRequests );
+		}
 
-		TickLoadRequest( pRequest );
+		WakeRequests( wakeRequests );
+	}
 
-		int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
-		if( newRequestCount == 0 )
+	// Update ready requests one stage at a time, so requests woken up by requests advancing in an earlier stage are
+	// updated within the same tick.
+	DynamicArray< LoadRequest* > tickRequests;
+	for( size_t stageIndex = 0; stageIndex < LOAD_STAGE_MAX; ++stageIndex )
+	{
 		{
-			ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
-			if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
-			{
-				pRequest = loadRequestAccessor->Second();
-				HELIUM_ASSERT( pRequest );
-				if( pRequest->requestCount == 0 )
-				{
-					HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+			Locker< DynamicArray< LoadRequest* >, SpinLock >::Handle readyQueueHandle( m_readyQueues[ stageIndex ] );
+			readyQueueHandle->Swap( tickRequests );
+		}
 
-					pRequest->spObject.Release();
-					pRequest->resolver.Clear();
+		size_t tickRequestCount = tickRequests.GetSize();
+		for( size_t requestIndex = 0; requestIndex < tickRequestCount; ++requestIndex )
+		{
+			LoadRequest* pRequest = tickRequests[ requestIndex ];
+			HELIUM_ASSERT( pRequest );
 
-					m_loadRequestMap.Remove( loadRequestAccessor );
-					m_loadRequestPool.Release( pRequest );
-				}
-			}
+			// Clear the queued flag first so that anything waking the request from here on queues it again.
+			AtomicAndRelease( pRequest->stateFlags, ~LOAD_FLAG_QUEUED );
+
+			TickLoadRequest( pRequest );
+
+			// Release the reference held by the ready queue.
+			ReleaseLoadRequest( pRequest );
 		}
+
+		tickRequests.Resize( 0 );
 	}
+}
 
-	//m_loadRequestTickArray.Resize( 0 );
+/// Queue the load request for the given object for an update on the next tick.
+///
+/// Package loaders call this once an object load request they were given can be finished through
+/// PackageLoader::TryFinishLoadObject(), as the asset loader does not check on requests waiting on their package
+/// loader otherwise.  This can be called from any thread, and does nothing if no request for the object exists.
+///
+/// @param[in] path  Asset path.
+void AssetLoader::WakeLoadRequest( AssetPath path )
+{
+	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor requestConstAccessor;
+	if( m_loadRequestMap.Find( requestConstAccessor, path ) )
+	{
+		LoadRequest* pRequest = requestConstAccessor->Second();
+		HELIUM_ASSERT( pRequest );
+		QueueLoadRequest( pRequest );
+	}
+}
+
+/// Add the amount of data read and the time spent deserializing an object to the load telemetry of the request for
+/// the object.
+///
+/// Package loaders call this as they finish preloading an object, before waking its load request.  This can be called
+/// from any thread, and does nothing if no request for the object exists.
+///
+/// @param[in] path              Asset path.
+/// @param[in] bytesRead         Number of bytes read.
+/// @param[in] deserializeTicks  Ticks spent deserializing the object.
+///
+/// @see GetLoadTelemetry()
+void AssetLoader::RecordPreloadStatistics( AssetPath path, size_t bytesRead, uint64_t deserializeTicks )
+{
+	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor requestConstAccessor;
+	if( m_loadRequestMap.Find( requestConstAccessor, path ) )
+	{
+		LoadRequest* pRequest = requestConstAccessor->Second();
+		HELIUM_ASSERT( pRequest );
+		pRequest->telemetry.bytesRead += bytesRead;
+		pRequest->telemetry.deserializeTicks += deserializeTicks;
+	}
+}
+
+/// Get the load timing and I/O statistics gathered for each completed load request.
+///
+/// @return  Load telemetry.
+AssetLoadTelemetry& AssetLoader::GetLoadTelemetry()
+{
+	return m_loadTelemetry;
+}
+
+/// Get the load timing and I/O statistics gathered for each completed load request.
+///
+/// @return  Load telemetry.
+const AssetLoadTelemetry& AssetLoader::GetLoadTelemetry() const
+{
+	return m_loadTelemetry;
 }
 
 /// Get the global object loader instance.
@@ -374,6 +477,8 @@ void AssetLoader::OnLoadComplete( const AssetPath & /*path*/, Asset* /*pObject*/
 
 /// Update the given load request.
 ///
+/// If the request cannot complete, it is left waiting on whatever blocked it (see Tick()).
+///
 /// @param[in] pRequest  Load request to update.
 ///
 /// @return  True if the load request has completed, false if it still requires time to process.
@@ -381,93 +486,98 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
 
-	// Update preloading.
-	bool bLockedTick = false;
+	if( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED )
+	{
+		return true;
+	}
+
+	// Only one thread may update a request at a time.  If another thread is already updating this one, queue it to
+	// be checked again, as the other thread may have already looked at whatever woke the request up.
+	if( AtomicOrAcquire( pRequest->stateFlags, LOAD_FLAG_IN_TICK ) & LOAD_FLAG_IN_TICK )
+	{
+		QueueLoadRequest( pRequest );
 
-#define LOCK_TICK() \
-	if( !bLockedTick ) \
-	{ \
-	if( AtomicOrAcquire( pRequest->stateFlags, LOAD_FLAG_IN_TICK ) & LOAD_FLAG_IN_TICK ) \
-	{ \
-	return false; \
-	} \
-	\
-	bLockedTick = true; \
+		return false;
 	}
 
-#define UNLOCK_TICK() AtomicAndRelease( pRequest->stateFlags, ~LOAD_FLAG_IN_TICK )
+	int32_t stateFlags = pRequest->stateFlags & ~( LOAD_FLAG_IN_TICK | LOAD_FLAG_QUEUED );
 
-	if( !( pRequest->stateFlags & LOAD_FLAG_PRELOADED ) )
+	bool bFinished = TickLoadStages( pRequest );
+
+	bool bAdvanced = ( ( pRequest->stateFlags & ~( LOAD_FLAG_IN_TICK | LOAD_FLAG_QUEUED ) ) != stateFlags );
+
+	AtomicAndRelease( pRequest->stateFlags, ~LOAD_FLAG_IN_TICK );
+
+	if( bAdvanced )
 	{
-		LOCK_TICK();
+		AtomicIncrementRelease( m_stateChangeCount );
+
+		// Requests waiting on this one may now be able to make progress.
+		WakeWaiters( pRequest );
+	}
+
+	return bFinished;
+}
+
+/// Run each stage of the load process for the given load request until one of them blocks.
+///
+/// @param[in] pRequest  Load request to update (must be locked for ticking).
+///
+/// @return  True if the load request has completed, false if it still requires time to process.
+bool AssetLoader::TickLoadStages( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->stateFlags & LOAD_FLAG_IN_TICK );
 
+	if( !( pRequest->stateFlags & LOAD_FLAG_PRELOADED ) )
+	{
 		if( !TickPreload( pRequest ) )
 		{
-			UNLOCK_TICK();
-
 			return false;
 		}
-		else
-		{
-			HELIUM_ASSERT( !pRequest->spObject.Get() || (pRequest->spObject->GetFlags() & Asset::FLAG_PRELOADED) );
-		}
+
+		pRequest->telemetry.stageEndTicks[ AssetLoadTelemetry::STAGE_PRELOAD ] = Timer::GetTickCount();
+
+		HELIUM_ASSERT( !pRequest->spObject.Get() || (pRequest->spObject->GetFlags() & Asset::FLAG_PRELOADED) );
 	}
 
 	if( !( pRequest->stateFlags & LOAD_FLAG_LINKED ) )
 	{
-		LOCK_TICK();
-
 		if( !TickLink( pRequest ) )
 		{
-			UNLOCK_TICK();
-
 			return false;
 		}
-		else
-		{
-			HELIUM_ASSERT( !pRequest->spObject.Get() || pRequest->spObject->GetFlags() & Asset::FLAG_LINKED );
-		}
+
+		pRequest->telemetry.stageEndTicks[ AssetLoadTelemetry::STAGE_LINK ] = Timer::GetTickCount();
+
+		HELIUM_ASSERT( !pRequest->spObject.Get() || pRequest->spObject->GetFlags() & Asset::FLAG_LINKED );
 	}
 
 	if( !( pRequest->stateFlags & LOAD_FLAG_PRECACHED ) )
 	{
-		LOCK_TICK();
-
 		if( !TickPrecache( pRequest ) )
 		{
-			UNLOCK_TICK();
-
 			return false;
 		}
-		else
-		{
-			HELIUM_ASSERT( !pRequest->spObject.Get() || pRequest->spObject->GetFlags() & Asset::FLAG_PRECACHED );
-		}
+
+		pRequest->telemetry.stageEndTicks[ AssetLoadTelemetry::STAGE_PRECACHE ] = Timer::GetTickCount();
+
+		HELIUM_ASSERT( !pRequest->spObject.Get() || pRequest->spObject->GetFlags() & Asset::FLAG_PRECACHED );
 	}
 
 	if( !( pRequest->stateFlags & LOAD_FLAG_LOADED ) )
 	{
-		LOCK_TICK();
-
 		if( !TickFinalizeLoad( pRequest ) )
 		{
-			UNLOCK_TICK();
-
 			return false;
 		}
-		else
-		{
-			HELIUM_ASSERT( !pRequest->spObject.Get() ||  pRequest->spObject->GetFlags() & Asset::FLAG_LOADED );
-		}
-	}
 
-	if( bLockedTick )
-	{
-		UNLOCK_TICK();
+		pRequest->telemetry.stageEndTicks[ AssetLoadTelemetry::STAGE_FINALIZE ] = Timer::GetTickCount();
+
+		HELIUM_ASSERT( !pRequest->spObject.Get() ||  pRequest->spObject->GetFlags() & Asset::FLAG_LOADED );
 	}
 
-#undef LOCK_TICK
-#undef UNLOCK_TICK
+	RecordLoadTelemetry( pRequest );
 
 	return true;
 }
@@ -490,6 +600,8 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 		if( !pPackageLoader->TryFinishPreload() )
 		{
 			// Still waiting for package loader preload.
+			WaitOnPreload( pRequest );
+
 			return false;
 		}
 
@@ -534,7 +646,7 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 		pRequest->spObject );
 	if( !bFinished )
 	{
-		// Still waiting for object to load.
+		// Still waiting for object to load (the package loader will wake the request once it is ready).
 		return false;
 	}
 
@@ -558,8 +670,11 @@ bool AssetLoader::TickLink( LoadRequest* pRequest )
 
 	if ( pRequest->spObject.ReferencesObject() )
 	{
-		if( !pRequest->resolver.ReadyToApplyFixups() )
+		size_t pendingLoadRequestId;
+		if( !pRequest->resolver.ReadyToApplyFixups( pendingLoadRequestId ) )
 		{
+			WaitOnLoadRequest( pRequest, pendingLoadRequestId, LOAD_FLAG_PRELOADED );
+
 			return false;
 		}
 		
@@ -588,8 +703,11 @@ bool AssetLoader::TickPrecache( LoadRequest* pRequest )
 	if( pObject )
 	{
 		// TODO: SHouldn't this be in the linking phase?
-		if ( !pRequest->resolver.TryFinishPrecachingDependencies() )
+		size_t pendingLoadRequestId;
+		if ( !pRequest->resolver.TryFinishPrecachingDependencies( pendingLoadRequestId ) )
 		{
+			WaitOnLoadRequest( pRequest, pendingLoadRequestId, LOAD_FLAG_FULLY_LOADED );
+
 			return false;
 		}
 
@@ -623,6 +741,8 @@ bool AssetLoader::TickPrecache( LoadRequest* pRequest )
 
 			if( !pObject->TryFinishPrecacheResourceData() )
 			{
+				WaitOnPrecache( pRequest );
+
 				return false;
 			}
 		}
@@ -657,6 +777,285 @@ bool AssetLoader::TickFinalizeLoad( LoadRequest* pRequest )
 	return true;
 }
 
+/// Add the statistics of a completed load request to the load telemetry.
+///
+/// @param[in] pRequest  Load request that has completed (must be locked for ticking).
+void AssetLoader::RecordLoadTelemetry( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	AssetLoadTelemetry::Record& rTelemetry = pRequest->telemetry;
+
+	// Stages skipped due to errors end when the previous stage ended.
+	uint64_t stageEndTicks = rTelemetry.queuedTicks;
+	for( size_t stageIndex = 0; stageIndex < AssetLoadTelemetry::STAGE_MAX; ++stageIndex )
+	{
+		if( rTelemetry.stageEndTicks[ stageIndex ] == 0 )
+		{
+			rTelemetry.stageEndTicks[ stageIndex ] = stageEndTicks;
+		}
+
+		stageEndTicks = rTelemetry.stageEndTicks[ stageIndex ];
+	}
+
+	Asset* pObject = pRequest->spObject;
+	if( pObject )
+	{
+		const AssetType* pType = pObject->GetAssetType();
+		HELIUM_ASSERT( pType );
+		rTelemetry.type = pType->GetName();
+	}
+
+	rTelemetry.bError = ( ( pRequest->stateFlags & LOAD_FLAG_ERROR ) != 0 );
+
+	m_loadTelemetry.AddRecord( rTelemetry );
+}
+
+/// Queue a load request for an update on the next tick, unless it is already queued.
+///
+/// @param[in] pRequest  Load request to queue.
+void AssetLoader::QueueLoadRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	if( AtomicOrAcquire( pRequest->stateFlags, LOAD_FLAG_QUEUED ) & LOAD_FLAG_QUEUED )
+	{
+		return;
+	}
+
+	// The ready queue holds a reference to the request until the request has been updated.
+	AtomicIncrementRelease( pRequest->requestCount );
+
+	ELoadStage stage = GetLoadStage( pRequest->stateFlags );
+	Locker< DynamicArray< LoadRequest* >, SpinLock >::Handle readyQueueHandle( m_readyQueues[ stage ] );
+	readyQueueHandle->Push( pRequest );
+}
+
+/// Park a load request until another load request it depends on has advanced.
+///
+/// @param[in] pRequest       Load request to park (must be locked for ticking).
+/// @param[in] dependencyId   ID of the load request being waited on.
+/// @param[in] requiredFlags  Load flags the dependency needs to have set for the request to make progress.
+void AssetLoader::WaitOnLoadRequest( LoadRequest* pRequest, size_t dependencyId, int32_t requiredFlags )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( IsValid( dependencyId ) );
+
+	LoadRequest* pDependency = m_loadRequestPool.GetObject( dependencyId );
+	HELIUM_ASSERT( pDependency );
+
+	// Check the dependency again while holding its waiter lock, as it may have advanced (and woken its waiters) since
+	// the caller last looked at it.
+	pDependency->waiterLock.Lock();
+
+	if( ( pDependency->stateFlags & requiredFlags ) == requiredFlags )
+	{
+		pDependency->waiterLock.Unlock();
+		QueueLoadRequest( pRequest );
+
+		return;
+	}
+
+	AtomicIncrementRelease( pRequest->requestCount );
+	pDependency->waiters.Push( pRequest );
+
+	pDependency->waiterLock.Unlock();
+}
+
+/// Park a load request until its package loader has finished preloading.
+///
+/// @param[in] pRequest  Load request to park (must be locked for ticking).
+void AssetLoader::WaitOnPreload( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->pPackageLoader );
+
+	AtomicIncrementRelease( pRequest->requestCount );
+
+	Locker< PreloadWaitList, SpinLock >::Handle preloadWaitHandle( m_preloadWaits );
+	preloadWaitHandle->Add( pRequest );
+}
+
+/// Park a load request until resource precaching may have made progress.
+///
+/// @param[in] pRequest  Load request to park (must be locked for ticking).
+void AssetLoader::WaitOnPrecache( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	AtomicIncrementRelease( pRequest->requestCount );
+
+	Locker< DynamicArray< LoadRequest* >, SpinLock >::Handle precacheWaitHandle( m_precacheWaits );
+	precacheWaitHandle->Push( pRequest );
+}
+
+/// Queue all load requests waiting on the given load request for an update.
+///
+/// @param[in] pRequest  Load request that has advanced.
+void AssetLoader::WakeWaiters( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	DynamicArray< LoadRequest* > waiters;
+
+	pRequest->waiterLock.Lock();
+	pRequest->waiters.Swap( waiters );
+	pRequest->waiterLock.Unlock();
+
+	WakeRequests( waiters );
+}
+
+/// Queue parked load requests for an update, releasing the references held on them while they were parked.
+///
+/// @param[in] rRequests  Load requests to wake.
+void AssetLoader::WakeRequests( const DynamicArray< LoadRequest* >& rRequests )
+{
+	size_t requestCount = rRequests.GetSize();
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		LoadRequest* pRequest = rRequests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+
+		QueueLoadRequest( pRequest );
+		ReleaseLoadRequest( pRequest );
+	}
+}
+
+/// Release a reference to a load request, freeing the request if no references remain.
+///
+/// @param[in] pRequest  Load request to release.
+void AssetLoader::ReleaseLoadRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
+	if( newRequestCount != 0 )
+	{
+		return;
+	}
+
+	ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
+	if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
+	{
+		pRequest = loadRequestAccessor->Second();
+		HELIUM_ASSERT( pRequest );
+		if( pRequest->requestCount == 0 )
+		{
+			HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+			HELIUM_ASSERT( pRequest->waiters.IsEmpty() );
+
+			pRequest->spObject.Release();
+			pRequest->resolver.Clear();
+
+			m_loadRequestMap.Remove( loadRequestAccessor );
+			m_loadRequestPool.Release( pRequest );
+		}
+	}
+}
+
+/// Get the load stage a load request is in.
+///
+/// @param[in] stateFlags  Load request state flags.
+///
+/// @return  Current load stage.
+AssetLoader::ELoadStage AssetLoader::GetLoadStage( int32_t stateFlags )
+{
+	if( !( stateFlags & LOAD_FLAG_PRELOADED ) )
+	{
+		return LOAD_STAGE_PRELOAD;
+	}
+
+	if( !( stateFlags & LOAD_FLAG_LINKED ) )
+	{
+		return LOAD_STAGE_LINK;
+	}
+
+	if( !( stateFlags & LOAD_FLAG_PRECACHED ) )
+	{
+		return LOAD_STAGE_PRECACHE;
+	}
+
+	return LOAD_STAGE_FINALIZE;
+}
+
+/// Add a load request to the list.
+///
+/// @param[in] pRequest  Load request waiting on its package loader.
+void AssetLoader::PreloadWaitList::Add( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	PackageLoader* pPackageLoader = pRequest->pPackageLoader;
+	HELIUM_ASSERT( pPackageLoader );
+
+	size_t packageLoaderCount = m_packageLoaders.GetSize();
+	for( size_t packageLoaderIndex = 0; packageLoaderIndex < packageLoaderCount; ++packageLoaderIndex )
+	{
+		if( m_packageLoaders[ packageLoaderIndex ] == pPackageLoader )
+		{
+			m_requests[ packageLoaderIndex ].Push( pRequest );
+
+			return;
+		}
+	}
+
+	m_packageLoaders.Push( pPackageLoader );
+	m_requests.New()->Push( pRequest );
+}
+
+/// Move all load requests from another list into this list.
+///
+/// @param[in] rOther  List to merge (cleared on return).
+void AssetLoader::PreloadWaitList::Merge( PreloadWaitList& rOther )
+{
+	size_t otherPackageLoaderCount = rOther.m_packageLoaders.GetSize();
+	for( size_t otherIndex = 0; otherIndex < otherPackageLoaderCount; ++otherIndex )
+	{
+		const DynamicArray< LoadRequest* >& rOtherRequests = rOther.m_requests[ otherIndex ];
+
+		size_t requestCount = rOtherRequests.GetSize();
+		for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+		{
+			Add( rOtherRequests[ requestIndex ] );
+		}
+	}
+
+	rOther.m_packageLoaders.Resize( 0 );
+	rOther.m_requests.Resize( 0 );
+}
+
+/// Remove the load requests for all package loaders that have finished preloading.
+///
+/// @param[out] rReadyRequests  Array to which the removed load requests are appended.
+void AssetLoader::PreloadWaitList::RemoveReady( DynamicArray< LoadRequest* >& rReadyRequests )
+{
+	size_t packageLoaderIndex = m_packageLoaders.GetSize();
+	while( packageLoaderIndex != 0 )
+	{
+		--packageLoaderIndex;
+
+		PackageLoader* pPackageLoader = m_packageLoaders[ packageLoaderIndex ];
+		HELIUM_ASSERT( pPackageLoader );
+		if( pPackageLoader->TryFinishPreload() )
+		{
+			const DynamicArray< LoadRequest* >& rRequests = m_requests[ packageLoaderIndex ];
+			rReadyRequests.AddArray( rRequests.GetData(), rRequests.GetSize() );
+
+			m_packageLoaders.Remove( packageLoaderIndex );
+			m_requests.Remove( packageLoaderIndex );
+		}
+	}
+}
+
+/// Swap the contents of this list with another list.
+///
+/// @param[in] rOther  List with which to swap.
+void AssetLoader::PreloadWaitList::Swap( PreloadWaitList& rOther )
+{
+	m_packageLoaders.Swap( rOther.m_packageLoaders );
+	m_requests.Swap( rOther.m_requests );
+}
+
 #if HELIUM_TOOLS
 
 void AssetLoader::EnumerateRootPackages( DynamicArray< AssetPath > &packagePaths )
@@ -675,6 +1074,17 @@ int64_t AssetLoader::GetAssetFileTimestamp( const AssetPath &path )
 	return pLoader->GetAssetFileSystemTimestamp( path );
 }
 
+const FilePath &AssetLoader::GetAssetFilePath( const AssetPath &path )
+{
+	Package *pPackage = Asset::Find<Package>( path.GetParent() );
+	HELIUM_ASSERT( pPackage );
+
+	PackageLoader *pLoader = pPackage->GetLoader();
+	HELIUM_ASSERT( pLoader );
+
+	return pLoader->GetAssetFileSystemPath( path );
+}
+
 #endif
 
 bool Helium::AssetIdentifier::Identify( const Reflect::ObjectPtr& object, Name* identity )
@@ -737,7 +1147,7 @@ bool Helium::AssetResolver::Resolve( const Name& identity, Reflect::ObjectPtr& p
 	return false;
 }
 
-bool Helium::AssetResolver::ReadyToApplyFixups()
+bool Helium::AssetResolver::ReadyToApplyFixups( size_t& rPendingLoadRequestId )
 {
 	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
 		iter != m_Fixups.End(); ++iter)
@@ -747,6 +1157,7 @@ bool Helium::AssetResolver::ReadyToApplyFixups()
 
 		if ( !( pRequest->stateFlags & AssetLoader::LOAD_FLAG_PRELOADED ) )
 		{
+			rPendingLoadRequestId = iter->m_LoadRequestId;
 			return false;
 		}
 	}
@@ -778,7 +1189,7 @@ void Helium::AssetResolver::Clear()
 	m_Fixups.Clear();
 }
 
-bool Helium::AssetResolver::TryFinishPrecachingDependencies()
+bool Helium::AssetResolver::TryFinishPrecachingDependencies( size_t& rPendingLoadRequestId )
 {
 	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
 		iter != m_Fixups.End(); ++iter)
@@ -788,6 +1199,7 @@ bool Helium::AssetResolver::TryFinishPrecachingDependencies()
 			AssetPtr asset;
 			if( !AssetLoader::GetStaticInstance()->TryFinishLoad( iter->m_LoadRequestId, asset ) )
 			{
+				rPendingLoadRequestId = iter->m_LoadRequestId;
 				return false;
 			}
 		
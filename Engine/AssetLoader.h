@@ -2,11 +2,13 @@
 
 #include "Engine/Engine.h"
 
+#include "Platform/Locks.h"
 #include "Reflect/Translator.h"
 #include "Foundation/ConcurrentHashMap.h"
 #include "Foundation/ObjectPool.h"
 #include "Engine/AssetPath.h"
 #include "Engine/Asset.h"
+#include "Engine/AssetLoadTelemetry.h"
 
 #define HELIUM_ASSET_CACHE_NAME TXT( "Asset" )
 #define HELIUM_CONFIG_CACHE_NAME TXT( "Config" )
@@ -28,9 +30,9 @@ namespace Helium
 		virtual bool Resolve( const Name& identity, Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass );
 
 		// Called by AssetLoader
-		bool ReadyToApplyFixups();
+		bool ReadyToApplyFixups( size_t& rPendingLoadRequestId );
 		void ApplyFixups();
-		bool TryFinishPrecachingDependencies();
+		bool TryFinishPrecachingDependencies( size_t& rPendingLoadRequestId );
 		void Clear();
 
 		// Internal fixups that must be completed
@@ -61,6 +63,8 @@ namespace Helium
 	public:
 		/// Number of request objects to allocate in each block of the request pool.
 		static const size_t LOAD_REQUEST_POOL_BLOCK_SIZE = 64;
+		/// Maximum time (in milliseconds) FinishLoad() sleeps waiting on file I/O before ticking again.
+		static const uint32_t FINISH_LOAD_WAIT_TIMEOUT = 1;
 
 		friend AssetIdentifier;
 		friend AssetResolver;
@@ -93,9 +97,19 @@ namespace Helium
 		virtual void EnumerateRootPackages( DynamicArray< AssetPath > &packagePaths );
 
 		static int64_t GetAssetFileTimestamp( const AssetPath &path );
+		static const FilePath &GetAssetFilePath( const AssetPath &path );
 #endif
 
 		virtual void Tick();
+
+		void WakeLoadRequest( AssetPath path );
+		void RecordPreloadStatistics( AssetPath path, size_t bytesRead, uint64_t deserializeTicks );
+		//@}
+
+		/// @name Load Telemetry
+		//@{
+		AssetLoadTelemetry& GetLoadTelemetry();
+		const AssetLoadTelemetry& GetLoadTelemetry() const;
 		//@}
 
 		/// @name Static Access
@@ -132,6 +146,27 @@ namespace Helium
 
 			/// Set if ticking is in progress.
 			LOAD_FLAG_IN_TICK = 1 << 6,
+			/// Set while the request is in one of the ready queues.
+			LOAD_FLAG_QUEUED = 1 << 7,
+		};
+
+		/// Load process stages, each with its own queue of requests that are ready to make progress.
+		enum ELoadStage
+		{
+			LOAD_STAGE_FIRST   =  0,
+			LOAD_STAGE_INVALID = -1,
+
+			/// Preloading the object through its package loader.
+			LOAD_STAGE_PRELOAD,
+			/// Linking object references.
+			LOAD_STAGE_LINK,
+			/// Precaching resource data.
+			LOAD_STAGE_PRECACHE,
+			/// Finalizing the load.
+			LOAD_STAGE_FINALIZE,
+
+			LOAD_STAGE_MAX,
+			LOAD_STAGE_LAST = LOAD_STAGE_MAX - 1
 		};
 
 		/// Asset load request information.
@@ -156,12 +191,52 @@ namespace Helium
 			AssetResolver resolver;
 
 			bool forceReload;
+
+			/// Load requests waiting for this request to advance (each holding a reference to its request).
+			DynamicArray< LoadRequest* > waiters;
+			/// Lock protecting the list of waiting load requests.
+			SpinLock waiterLock;
+
+			/// Load timing and I/O statistics.
+			AssetLoadTelemetry::Record telemetry;
+		};
+
+		/// Load requests waiting for their package loaders to finish preloading, grouped by package loader.
+		class PreloadWaitList
+		{
+		public:
+			void Add( LoadRequest* pRequest );
+			void Merge( PreloadWaitList& rOther );
+			void RemoveReady( DynamicArray< LoadRequest* >& rReadyRequests );
+			void Swap( PreloadWaitList& rOther );
+
+		private:
+			/// Package loaders being waited on.
+			DynamicArray< PackageLoader* > m_packageLoaders;
+			/// Load requests waiting on each package loader.
+			DynamicArray< DynamicArray< LoadRequest* > > m_requests;
 		};
 
 		/// Load request hash map.
 		ConcurrentHashMap< AssetPath, LoadRequest* > m_loadRequestMap;
 		/// Load request pool.
 		ObjectPool< LoadRequest > m_loadRequestPool;
+		/// Incremented each time a tick advances the state of a load request.
+		volatile int32_t m_stateChangeCount;
+
+		/// Load requests ready to make progress, queued by the stage they are in.
+		Locker< DynamicArray< LoadRequest* >, SpinLock > m_readyQueues[ LOAD_STAGE_MAX ];
+		/// Load requests waiting for their package loaders to finish preloading.
+		Locker< PreloadWaitList, SpinLock > m_preloadWaits;
+		/// Load requests waiting for resource precaching to complete.
+		Locker< DynamicArray< LoadRequest* >, SpinLock > m_precacheWaits;
+		/// Async loader completion count as of the last time the requests waiting on resource precaching were checked.
+		volatile int32_t m_precacheWaitCompletionCount;
+		/// State change count as of the last time the requests waiting on resource precaching were checked.
+		volatile int32_t m_precacheWaitStateChangeCount;
+
+		/// Load timing and I/O statistics for completed load requests.
+		AssetLoadTelemetry m_loadTelemetry;
 
 		/// Singleton instance.
 		static AssetLoader* sm_pInstance;
@@ -180,10 +255,26 @@ namespace Helium
 		/// @name Load Process Updating
 		//@{
 		bool TickLoadRequest( LoadRequest* pRequest );
+		bool TickLoadStages( LoadRequest* pRequest );
 		bool TickPreload( LoadRequest* pRequest );
 		bool TickLink( LoadRequest* pRequest );
 		bool TickPrecache( LoadRequest* pRequest );
 		bool TickFinalizeLoad( LoadRequest* pRequest );
+
+		void RecordLoadTelemetry( LoadRequest* pRequest );
+		//@}
+
+		/// @name Load Request Scheduling
+		//@{
+		void QueueLoadRequest( LoadRequest* pRequest );
+		void WaitOnLoadRequest( LoadRequest* pRequest, size_t dependencyId, int32_t requiredFlags );
+		void WaitOnPreload( LoadRequest* pRequest );
+		void WaitOnPrecache( LoadRequest* pRequest );
+		void WakeWaiters( LoadRequest* pRequest );
+		void WakeRequests( const DynamicArray< LoadRequest* >& rRequests );
+		void ReleaseLoadRequest( LoadRequest* pRequest );
+
+		static ELoadStage GetLoadStage( int32_t stateFlags );
 		//@}
 	};
 
@@ -4,15 +4,97 @@
 #include "Engine/FileLocations.h"
 #include "Foundation/FileStream.h"
 
+#include <algorithm>
+
+#if HELIUM_OS_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <climits>
+#include <ctime>
+#include <unistd.h>
+#elif HELIUM_OS_WIN
+#include <windows.h>
+#if _WIN32_WINNT >= 0x0602 && defined( _MSC_VER )
+#pragma comment( lib, "Synchronization.lib" )
+#endif
+#endif
+
 using namespace Helium;
 
+namespace
+{
+	/// Block the calling thread while a value is equal to the given expected value.
+	///
+	/// This may return spuriously (or after yielding only, on platforms without an address-based wait), so callers
+	/// must recheck the value and loop as needed.
+	///
+	/// @param[in] rValue               Value to watch.
+	/// @param[in] expectedValue        Value to wait on; the call returns immediately if the value differs from this.
+	/// @param[in] timeoutMilliseconds  Maximum time to wait, or an invalid value to wait indefinitely.
+	///
+	/// @see WakeValueWaiters()
+	void WaitOnValue( volatile int32_t& rValue, int32_t expectedValue, uint32_t timeoutMilliseconds )
+	{
+#if HELIUM_OS_LINUX
+		struct timespec timeout;
+		struct timespec* pTimeout = NULL;
+		if( IsValid( timeoutMilliseconds ) )
+		{
+			timeout.tv_sec = timeoutMilliseconds / 1000;
+			timeout.tv_nsec = static_cast< long >( timeoutMilliseconds % 1000 ) * 1000000;
+			pTimeout = &timeout;
+		}
+
+		syscall(
+			SYS_futex,
+			const_cast< int32_t* >( &rValue ),
+			FUTEX_WAIT_PRIVATE,
+			expectedValue,
+			pTimeout,
+			NULL,
+			0 );
+#elif HELIUM_OS_WIN && _WIN32_WINNT >= 0x0602
+		WaitOnAddress(
+			const_cast< int32_t* >( &rValue ),
+			&expectedValue,
+			sizeof( expectedValue ),
+			( IsValid( timeoutMilliseconds ) ? timeoutMilliseconds : INFINITE ) );
+#else
+		HELIUM_UNREF( rValue );
+		HELIUM_UNREF( expectedValue );
+		HELIUM_UNREF( timeoutMilliseconds );
+
+		Thread::Yield();
+#endif
+	}
+
+	/// Wake all threads blocked in WaitOnValue() on the given value.
+	///
+	/// @param[in] rValue  Value being watched.
+	///
+	/// @see WaitOnValue()
+	void WakeValueWaiters( volatile int32_t& rValue )
+	{
+#if HELIUM_OS_LINUX
+		syscall( SYS_futex, const_cast< int32_t* >( &rValue ), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0 );
+#elif HELIUM_OS_WIN && _WIN32_WINNT >= 0x0602
+		WakeByAddressAll( const_cast< int32_t* >( &rValue ) );
+#else
+		HELIUM_UNREF( rValue );
+#endif
+	}
+}
+
 AsyncLoader* AsyncLoader::sm_pInstance = NULL;
 
 /// Constructor.
 AsyncLoader::AsyncLoader()
 	: m_requestPool( REQUEST_POOL_BLOCK_SIZE )
-	, m_pThread( NULL )
-	, m_pWorker( NULL )
+	, m_pendingCount( 0 )
+	, m_completionCount( 0 )
+	, m_completionWaiterCount( 0 )
+	, m_openFileStreamCount( 0 )
+	, m_backend( BACKEND_INVALID )
 {
 }
 
@@ -24,20 +106,66 @@ AsyncLoader::~AsyncLoader()
 
 /// Initialize the async loader.
 ///
+/// @param[in] workerCount  Number of I/O worker threads to start when using the thread backend (at least one worker
+///                         is always started).
+/// @param[in] backend      Preferred I/O backend.  The thread backend is the default; BACKEND_IO_RING has to be asked
+///                         for explicitly, and the thread backend is used instead if io_uring is not available.
+///
 /// @return  True if initialization was sucessful, false if not.
 ///
-/// @see Shutdown()
-bool AsyncLoader::Initialize()
+/// @see Shutdown(), GetBackend()
+bool AsyncLoader::Initialize( uint32_t workerCount, EBackend backend )
 {
+	HELIUM_ASSERT( static_cast< size_t >( backend ) < static_cast< size_t >( BACKEND_MAX ) );
+
 	Shutdown();
 
-	// Start up the async loading thread.
-	m_pWorker = new LoadWorker;
-	HELIUM_ASSERT( m_pWorker );
+	if( backend == BACKEND_IO_RING )
+	{
+		// A single thread keeps the whole submission queue busy, so it gets the entire open file budget.
+		IoRingWorker* pWorker = IoRingWorker::Create( *this, FILE_STREAM_LIMIT );
+		if( pWorker )
+		{
+			m_workers.Push( pWorker );
+
+			RunnableThread* pThread = new RunnableThread( pWorker );
+			HELIUM_ASSERT( pThread );
+			m_threads.Push( pThread );
+			HELIUM_VERIFY( pThread->Start( TXT( "AsyncLoader - io_uring file loading" ) ) );
 
-	m_pThread = new RunnableThread( m_pWorker );
-	HELIUM_ASSERT( m_pThread );
-	HELIUM_VERIFY( m_pThread->Start( TXT( "AsyncLoader - file loading" ) ) );
+			m_backend = BACKEND_IO_RING;
+
+			return true;
+		}
+
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "AsyncLoader::Initialize(): io_uring is not available, falling back to worker threads.\n" ) );
+	}
+
+	m_backend = BACKEND_THREADS;
+
+	if( workerCount == 0 )
+	{
+		workerCount = 1;
+	}
+
+	// Start up the async loading threads, splitting the open file stream budget between them.
+	size_t fileStreamLimit = Max< size_t >( FILE_STREAM_LIMIT / workerCount, 1 );
+
+	m_workers.Reserve( workerCount );
+	m_threads.Reserve( workerCount );
+	for( uint32_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		LoadWorker* pWorker = new LoadWorker( *this, fileStreamLimit );
+		HELIUM_ASSERT( pWorker );
+		m_workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		m_threads.Push( pThread );
+		HELIUM_VERIFY( pThread->Start( TXT( "AsyncLoader - file loading" ) ) );
+	}
 
 	return true;
 }
@@ -47,45 +175,113 @@ bool AsyncLoader::Initialize()
 /// @see Initialize()
 void AsyncLoader::Shutdown()
 {
-	if( m_pWorker )
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
 	{
-		m_pWorker->Stop();
+		m_workers[ workerIndex ]->Stop();
 	}
 
-	if( m_pThread )
+	size_t threadCount = m_threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
 	{
-		m_pThread->Join();
-		delete m_pThread;
-		m_pThread = NULL;
+		RunnableThread* pThread = m_threads[ threadIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
 	}
 
-	delete m_pWorker;
-	m_pWorker = NULL;
+	m_threads.Clear();
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		delete m_workers[ workerIndex ];
+	}
+
+	m_workers.Clear();
+
+	m_backend = BACKEND_INVALID;
 }
 
 /// Queue an async load request.
 ///
-/// @param[in] pBuffer    Buffer in which to load data.
-/// @param[in] rFileName  FilePath name of the file from which to load.
-/// @param[in] offset     Byte offset within the file from which to load.
-/// @param[in] size       Number of bytes to read.
-/// @param[in] priority   Load priority.
+/// @param[in] pBuffer           Buffer in which to load data.
+/// @param[in] rFileName         FilePath name of the file from which to load.
+/// @param[in] offset            Byte offset within the file from which to load.
+/// @param[in] size              Number of bytes to read.
+/// @param[in] priority          Load priority.
+/// @param[in] pCompletionQueue  Optional queue onto which the completion cookie is pushed once the request has been
+///                              processed (see QueueCompressedRequest()).
+/// @param[in] completionCookie  Value to push onto the completion queue.
 ///
 /// @return  ID identifying the load request if queued successfully, invalid index if the request queue failed.
 ///
-/// @see SyncRequest(), TrySyncRequest()
+/// @see QueueCompressedRequest(), SyncRequest(), TrySyncRequest()
 size_t AsyncLoader::QueueRequest(
 	void* pBuffer,
 	const String& rFileName,
 	uint64_t offset,
 	size_t size,
-	EPriority priority )
+	EPriority priority,
+	CompletionQueue* pCompletionQueue,
+	size_t completionCookie )
+{
+	return QueueCompressedRequest(
+		pBuffer,
+		size,
+		rFileName,
+		offset,
+		size,
+		Compression::CODEC_NONE,
+		priority,
+		pCompletionQueue,
+		completionCookie );
+}
+
+/// Queue an async load request for compressed data.
+///
+/// The compressed data is read into a temporary buffer and decompressed into the output buffer by the loader, so the
+/// work of decompression is spread across the load worker threads (or the JobPool, when using the io_uring backend)
+/// rather than falling on the thread that syncs the request.
+///
+/// @param[in] pBuffer           Buffer in which to store the decompressed data.
+/// @param[in] bufferSize        Size of the output buffer.  If the decompressed data is larger than this, only the
+///                              leading part of the data that fits in the buffer is stored.
+/// @param[in] rFileName         FilePath name of the file from which to load.
+/// @param[in] offset            Byte offset within the file from which to load.
+/// @param[in] size              Number of bytes of compressed data to read.
+/// @param[in] codec             Codec with which the data is compressed (CODEC_NONE to read the data into the buffer
+///                              as-is).
+/// @param[in] priority          Load priority.
+/// @param[in] pCompletionQueue  Optional queue onto which the completion cookie is pushed by the thread completing the
+///                              request, allowing the owner to act on finished requests only instead of polling
+///                              every request it has in flight.  The cookie is pushed just before the request is
+///                              flagged as processed, so TrySyncRequest() may briefly still fail for it.  The queue
+///                              must remain valid until the request has been synced.
+/// @param[in] completionCookie  Value to push onto the completion queue.
+///
+/// @return  ID identifying the load request if queued successfully, invalid index if the request queue failed.  The
+///          number of bytes reported as read for the request is the number of decompressed bytes stored, or zero if
+///          the data could not be decompressed.
+///
+/// @see QueueRequest(), SyncRequest(), TrySyncRequest()
+size_t AsyncLoader::QueueCompressedRequest(
+	void* pBuffer,
+	size_t bufferSize,
+	const String& rFileName,
+	uint64_t offset,
+	size_t size,
+	Compression::ECodec codec,
+	EPriority priority,
+	CompletionQueue* pCompletionQueue,
+	size_t completionCookie )
 {
 	HELIUM_ASSERT( pBuffer );
+	HELIUM_ASSERT( static_cast< size_t >( codec ) < static_cast< size_t >( Compression::CODEC_MAX ) );
+	HELIUM_ASSERT( codec != Compression::CODEC_NONE || bufferSize == size );
 	HELIUM_ASSERT( static_cast< size_t >( priority ) < static_cast< size_t >( PRIORITY_MAX ) );
 
-	// Make sure the load worker is running.
-	if( !m_pWorker )
+	// Make sure the load workers are running.
+	if( m_workers.IsEmpty() )
 	{
 		return Invalid< size_t >();
 	}
@@ -99,10 +295,39 @@ size_t AsyncLoader::QueueRequest(
 	pRequest->size = size;
 	pRequest->priority = priority;
 
+	pRequest->codec = codec;
+	pRequest->bufferSize = bufferSize;
+	pRequest->pReadBuffer = NULL;
+
+	pRequest->pCompletionQueue = pCompletionQueue;
+	pRequest->completionCookie = completionCookie;
+
 	pRequest->bytesRead = 0;
-	AtomicExchangeRelease( pRequest->processedCounter, 0 );
+	AtomicExchangeRelease( pRequest->processedCounter, REQUEST_STATE_PENDING );
+
+	{
+		// Prevent access to the load queue while an exclusive write lock is held.
+		ScopeReadLock nonExclusiveLock( m_writeLock );
+
+		AtomicIncrementAcquire( m_pendingCount );
 
-	m_pWorker->QueueRequest( pRequest );
+		Locker< RequestQueue, SpinLock >::Handle handle( m_requestQueue );
+		handle->Push( pRequest );
+	}
+
+	// Wake one idle worker, if any.  Workers that are busy will pick up the request once they finish their current
+	// batch.
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		LoadWorker* pWorker = m_workers[ workerIndex ];
+		if( AtomicCompareExchangeAcquire( pWorker->m_idleCounter, 0, 1 ) == 1 )
+		{
+			pWorker->WakeUp();
+
+			break;
+		}
+	}
 
 	size_t requestIndex = m_requestPool.GetIndex( pRequest );
 	HELIUM_ASSERT( IsValid( requestIndex ) );
@@ -128,9 +353,18 @@ size_t AsyncLoader::SyncRequest( size_t id )
 	Request* pRequest = m_requestPool.GetObject( id );
 	HELIUM_ASSERT( pRequest );
 
-	while( pRequest->processedCounter == 0 )
+	// Flag that we are about to block so that the worker completing the request knows to wake us up, then sleep until
+	// the request has been processed.
+	int32_t state = AtomicCompareExchangeAcquire(
+		pRequest->processedCounter,
+		REQUEST_STATE_WAITED,
+		REQUEST_STATE_PENDING );
+	if( state != REQUEST_STATE_PROCESSED )
 	{
-		Thread::Yield();
+		while( pRequest->processedCounter == REQUEST_STATE_WAITED )
+		{
+			WaitOnValue( pRequest->processedCounter, REQUEST_STATE_WAITED, Invalid< uint32_t >() );
+		}
 	}
 
 	size_t bytesRead = pRequest->bytesRead;
@@ -158,7 +392,7 @@ bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
 
 	Request* pRequest = m_requestPool.GetObject( id );
 	HELIUM_ASSERT( pRequest );
-	if( pRequest->processedCounter == 0 )
+	if( pRequest->processedCounter != REQUEST_STATE_PROCESSED )
 	{
 		return false;
 	}
@@ -169,16 +403,84 @@ bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
 	return true;
 }
 
+/// Cancel a load request if it has not yet been picked up by a worker thread, releasing the request information if
+/// it was cancelled.
+///
+/// If cancellation succeeds, the given ID will no longer be valid and the request buffer will not be touched.  If the
+/// request is already in progress or has completed, it is left untouched and SyncRequest() or TrySyncRequest() must
+/// still be called for it.
+///
+/// @param[in] id  Request ID.
+///
+/// @return  True if the request was cancelled and released, false if it was already in progress or complete.
+///
+/// @see QueueRequest(), SyncRequest(), TrySyncRequest()
+bool AsyncLoader::CancelRequest( size_t id )
+{
+	HELIUM_ASSERT( IsValid( id ) );
+
+	Request* pRequest = m_requestPool.GetObject( id );
+	HELIUM_ASSERT( pRequest );
+
+	bool bRemoved;
+	{
+		Locker< RequestQueue, SpinLock >::Handle handle( m_requestQueue );
+		bRemoved = handle->Remove( pRequest );
+	}
+
+	if( !bRemoved )
+	{
+		return false;
+	}
+
+	AtomicDecrementRelease( m_pendingCount );
+	m_requestPool.Release( pRequest );
+	SignalCompletion();
+
+	return true;
+}
+
 /// Block the current thread until all pending load requests have completed.
 ///
 /// Note that this does not release any requests.  SyncRequest() or TrySyncRequest() must still be called for all
 /// pending requests in order to free any associated resources.
 void AsyncLoader::Flush()
 {
-	if( m_pWorker )
+	for( ; ; )
+	{
+		int32_t completionCount = m_completionCount;
+		if( m_pendingCount == 0 )
+		{
+			break;
+		}
+
+		WaitForCompletion( completionCount );
+	}
+}
+
+/// Block the current thread until the completion count changes from the given value.
+///
+/// Every request that completes or is cancelled advances the completion count, so this can be used to sleep until any
+/// outstanding request has finished.  If no requests are pending, this returns immediately.
+///
+/// The typical usage pattern is to sample GetCompletionCount(), check whether the work being waited on is done, and if
+/// not call this function with the sampled count; as a request completing between the two calls changes the count, no
+/// wake-up can be missed.  This may return spuriously, and callers should recheck their wait condition afterward.
+///
+/// @param[in] completionCount      Completion count previously returned by GetCompletionCount().
+/// @param[in] timeoutMilliseconds  Maximum time to wait, or an invalid value to wait indefinitely.
+///
+/// @see GetCompletionCount()
+void AsyncLoader::WaitForCompletion( int32_t completionCount, uint32_t timeoutMilliseconds )
+{
+	if( m_completionCount != completionCount || m_pendingCount == 0 )
 	{
-		m_pWorker->Flush();
+		return;
 	}
+
+	AtomicIncrementAcquire( m_completionWaiterCount );
+	WaitOnValue( m_completionCount, completionCount, timeoutMilliseconds );
+	AtomicDecrementRelease( m_completionWaiterCount );
 }
 
 /// Lock async loading for writing to files that may be in use.
@@ -186,9 +488,22 @@ void AsyncLoader::Flush()
 /// @see Unlock()
 void AsyncLoader::Lock()
 {
-	if( m_pWorker )
+	// Prevent other threads from queueing requests or writing out data while we have a write lock.
+	m_writeLock.LockWrite();
+
+	Flush();
+
+	// Workers close their cached file streams once they run out of requests.  Wait for that so that the files can be
+	// rewritten safely.
+	for( ; ; )
 	{
-		m_pWorker->Lock();
+		int32_t openFileStreamCount = m_openFileStreamCount;
+		if( openFileStreamCount == 0 )
+		{
+			break;
+		}
+
+		WaitOnValue( m_openFileStreamCount, openFileStreamCount, Invalid< uint32_t >() );
 	}
 }
 
@@ -197,10 +512,7 @@ void AsyncLoader::Lock()
 /// @see Lock()
 void AsyncLoader::Unlock()
 {
-	if( m_pWorker )
-	{
-		m_pWorker->Unlock();
-	}
+	m_writeLock.UnlockWrite();
 }
 
 /// Get the singleton AsyncLoader instance, creating it if necessary.
@@ -232,138 +544,588 @@ void AsyncLoader::DestroyStaticInstance()
 	}
 }
 
-/// Constructor.
-AsyncLoader::LoadWorker::LoadWorker()
-	: m_wakeUpCondition( false, false )
-	, m_stopCounter( 0 )
-	, m_processingCounter( 0 )
+/// Pop the next batch of requests to process.
+///
+/// @param[out] rBatch      Highest priority pending request followed by other pending requests of the same priority
+///                         against the same file, or empty if no requests are pending.
+/// @param[in]  batchLimit  Maximum number of requests to pop.
+void AsyncLoader::PopRequestBatch( DynamicArray< Request* >& rBatch, size_t batchLimit )
 {
+	Locker< RequestQueue, SpinLock >::Handle handle( m_requestQueue );
+
+	handle->PopBatch( rBatch, batchLimit );
 }
 
-/// Destructor.
-AsyncLoader::LoadWorker::~LoadWorker()
+/// Get whether any load requests are waiting in the queue to be picked up by a worker.
+///
+/// @return  True if the request queue is not empty, false if it is.
+bool AsyncLoader::HasQueuedRequests()
 {
+	Locker< RequestQueue, SpinLock >::Handle handle( m_requestQueue );
+
+	return !handle->IsEmpty();
 }
 
-/// Execute the async loading work.
-void AsyncLoader::LoadWorker::Run()
+/// Sort predicate ordering load requests by ascending file offset.
+///
+/// @param[in] pRequest0  First request to compare.
+/// @param[in] pRequest1  Second request to compare.
+///
+/// @return  True if the first request starts before the second request, false if not.
+bool AsyncLoader::CompareRequestOffsets( const Request* pRequest0, const Request* pRequest1 )
 {
-	BufferedStream* pBufferedStream = new BufferedStream;
-	HELIUM_ASSERT( pBufferedStream );
+	return ( pRequest0->offset < pRequest1->offset );
+}
 
-	while( m_stopCounter == 0 )
+/// Perform the reads for a batch of load requests against the same file and flag them as processed.
+///
+/// Requests are read in ascending offset order through a cached file stream.  Runs of requests whose ranges are
+/// contiguous, overlapping, or separated by no more than READ_COALESCE_GAP_LIMIT bytes are serviced with a single read
+/// (up to READ_COALESCE_SIZE_LIMIT bytes) into a scratch buffer, and each request's range is then copied out of it.  A
+/// request that cannot be merged with its neighbors is read directly into its own buffer.
+///
+/// @param[in] rBatch       Requests to process (all for the same file).  The batch is sorted by offset.
+/// @param[in] rFileCache   Open file stream cache to use.
+/// @param[in] rReadBuffer  Scratch buffer for coalesced reads, reused across calls.
+void AsyncLoader::ProcessRequestBatch(
+	DynamicArray< Request* >& rBatch,
+	FileHandleCache& rFileCache,
+	DynamicArray< uint8_t >& rReadBuffer )
+{
+	size_t requestCount = rBatch.GetSize();
+	HELIUM_ASSERT( requestCount != 0 );
+
+	std::sort( rBatch.GetData(), rBatch.GetData() + requestCount, CompareRequestOffsets );
+
+	FileStream* pFileStream = rFileCache.Acquire( rBatch[ 0 ]->fileName );
+
+	uint64_t position = Invalid< uint64_t >();
+	size_t requestIndex = 0;
+	while( requestIndex < requestCount )
 	{
-		AtomicExchangeAcquire( m_processingCounter, 1 );
+		// Extend the read over the following requests as long as they start close enough to its current end.
+		Request* pFirstRequest = rBatch[ requestIndex ];
+		HELIUM_ASSERT( pFirstRequest );
 
-		Request* pRequest;
+		uint64_t spanOffset = pFirstRequest->offset;
+		uint64_t spanEnd = spanOffset + pFirstRequest->size;
+		size_t spanEndIndex = requestIndex + 1;
+		for( ; spanEndIndex < requestCount; ++spanEndIndex )
 		{
-			Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-			pRequest = handle->IsEmpty() ? NULL : handle->Pop();
-		}
-		if( !pRequest )
-		{
-			// Queue is empty, so sleep until notified.
-			AtomicExchangeRelease( m_processingCounter, 0 );
-			m_wakeUpCondition.Wait();
+			const Request* pNextRequest = rBatch[ spanEndIndex ];
+			HELIUM_ASSERT( pNextRequest );
 
-			continue;
+			uint64_t nextEnd = Max( spanEnd, pNextRequest->offset + pNextRequest->size );
+			if( pNextRequest->offset > spanEnd + READ_COALESCE_GAP_LIMIT ||
+				nextEnd - spanOffset > READ_COALESCE_SIZE_LIMIT )
+			{
+				break;
+			}
+
+			spanEnd = nextEnd;
 		}
 
-		HELIUM_ASSERT( pRequest );
+		size_t spanSize = static_cast< size_t >( spanEnd - spanOffset );
+		bool bCoalesced = ( spanEndIndex - requestIndex > 1 );
 
-		FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
+		size_t spanBytesRead = 0;
 		if( !pFileStream )
 		{
-			SetInvalid( pRequest->bytesRead );
+			SetInvalid( spanBytesRead );
 		}
 		else
 		{
-			pRequest->bytesRead = 0;
+			if( position != spanOffset )
+			{
+				int64_t offset = pFileStream->Seek( spanOffset, SeekOrigins::Begin );
+				position = static_cast< uint64_t >( offset );
+			}
 
-			pBufferedStream->Open( pFileStream );
-			int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::Begin );
-			if( static_cast< uint64_t >( offset ) == pRequest->offset )
+			if( position == spanOffset )
 			{
-				pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
+				void* pDestination;
+				if( bCoalesced )
+				{
+					rReadBuffer.Resize( spanSize );
+					pDestination = rReadBuffer.GetData();
+				}
+				else
+				{
+					pDestination = PrepareRequestRead( pFirstRequest );
+				}
+
+				spanBytesRead = pFileStream->Read( pDestination, 1, spanSize );
+
+				// A short read leaves the stream position uncertain, so force a seek for the next read.
+				if( spanBytesRead == spanSize )
+				{
+					position += spanBytesRead;
+				}
+				else
+				{
+					SetInvalid( position );
+				}
 			}
+		}
 
-			pBufferedStream->Open( NULL );
+		for( ; requestIndex < spanEndIndex; ++requestIndex )
+		{
+			Request* pRequest = rBatch[ requestIndex ];
 
-			delete pFileStream;
+			size_t bytesRead = spanBytesRead;
+			if( bCoalesced && IsValid( spanBytesRead ) )
+			{
+				// Hand each request whatever part of its range the read reached, as a direct read would have.
+				size_t requestStart = static_cast< size_t >( pRequest->offset - spanOffset );
+				bytesRead = ( spanBytesRead > requestStart ? Min( spanBytesRead - requestStart, pRequest->size ) : 0 );
+				MemoryCopy( PrepareRequestRead( pRequest ), rReadBuffer.GetData() + requestStart, bytesRead );
+			}
+
+			CompleteRequest( pRequest, DecodeRequest( pRequest, bytesRead ) );
 		}
+	}
+}
 
-		AtomicExchangeRelease( pRequest->processedCounter, 1 );
+/// Get the buffer into which the file data for a request should be read, allocating a temporary buffer for the
+/// compressed data of compressed requests.
+///
+/// @param[in] pRequest  Request about to be read.
+///
+/// @return  Read destination buffer.
+///
+/// @see DecodeRequest()
+void* AsyncLoader::PrepareRequestRead( Request* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
 
-		Thread::Yield();
+	if( pRequest->codec == Compression::CODEC_NONE )
+	{
+		return pRequest->pBuffer;
 	}
 
-	AtomicExchangeRelease( m_processingCounter, 0 );
+	HELIUM_ASSERT( !pRequest->pReadBuffer );
+	pRequest->pReadBuffer = DefaultAllocator().Allocate( pRequest->size );
+	HELIUM_ASSERT( pRequest->pReadBuffer );
 
-	delete pBufferedStream;
+	return pRequest->pReadBuffer;
 }
 
-/// Request the load worker to stop processing and return at the next possible opportunity.
-void AsyncLoader::LoadWorker::Stop()
+/// Decompress the file data read for a request into its output buffer, if the request is for compressed data, and
+/// release the temporary read buffer.
+///
+/// @param[in] pRequest   Request that has been read.
+/// @param[in] bytesRead  Number of bytes read from the file, or an invalid index if the file could not be opened.
+///
+/// @return  Number of bytes to report as read for the request.
+///
+/// @see PrepareRequestRead()
+size_t AsyncLoader::DecodeRequest( Request* pRequest, size_t bytesRead )
 {
-	AtomicExchangeRelease( m_stopCounter, 1 );
-	m_wakeUpCondition.Signal();
+	HELIUM_ASSERT( pRequest );
+
+	if( pRequest->codec == Compression::CODEC_NONE || IsInvalid( bytesRead ) )
+	{
+		return bytesRead;
+	}
+
+	void* pReadBuffer = pRequest->pReadBuffer;
+	pRequest->pReadBuffer = NULL;
+
+	size_t decodedSize = 0;
+	if( bytesRead == pRequest->size )
+	{
+		decodedSize = Compression::Decompress(
+			pRequest->codec,
+			pReadBuffer,
+			bytesRead,
+			pRequest->pBuffer,
+			pRequest->bufferSize );
+	}
+
+	if( IsInvalid( decodedSize ) || ( decodedSize == 0 && pRequest->bufferSize != 0 ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			( TXT( "AsyncLoader: Failed to decompress %" ) PRIuSZ TXT( " bytes (%s) read from \"%s\" at offset %" )
+			PRIu64 TXT( " (%" ) PRIuSZ TXT( " bytes read).\n" ) ),
+			pRequest->size,
+			Compression::GetCodecName( pRequest->codec ),
+			*pRequest->fileName,
+			pRequest->offset,
+			bytesRead );
+
+		decodedSize = 0;
+	}
+
+	DefaultAllocator().Free( pReadBuffer );
+
+	return decodedSize;
 }
 
-/// Queue an async load request.
+/// JobPool callback decompressing a single request from a DecodeBatch and flagging it as processed.
+///
+/// @param[in] pData      DecodeBatch instance.
+/// @param[in] itemIndex  Index of the request to decompress.
+void AsyncLoader::DecodeBatchJob( void* pData, size_t itemIndex )
+{
+	DecodeBatch* pBatch = static_cast< DecodeBatch* >( pData );
+	HELIUM_ASSERT( pBatch );
+
+	Request* pRequest = pBatch->ppRequests[ itemIndex ];
+	HELIUM_ASSERT( pRequest );
+
+	AsyncLoader* pLoader = pBatch->pLoader;
+	HELIUM_ASSERT( pLoader );
+	pLoader->CompleteRequest( pRequest, pLoader->DecodeRequest( pRequest, pRequest->bytesRead ) );
+}
+
+/// Store the result of a load request and flag it as processed.
 ///
-/// @param[in] pRequest  Request to queue.  Note that the @c processedCounter value should be set to 0 prior to
-///                      calling this function (the worker thread will set it to 1 once the request has been
-///                      processed).
+/// Note that the request may be released by another thread as soon as this is called.
 ///
-/// @see Flush()
-void AsyncLoader::LoadWorker::QueueRequest( Request* pRequest )
+/// @param[in] pRequest   Request that has been processed.
+/// @param[in] bytesRead  Number of bytes read, or an invalid index if the file could not be opened.
+void AsyncLoader::CompleteRequest( Request* pRequest, size_t bytesRead )
 {
 	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( pRequest->processedCounter == 0 );
 
-	// Prevent access to the load queue while an exclusive write lock is held.
-	ScopeReadLock nonExclusiveLock( m_writeLock );
+	pRequest->bytesRead = bytesRead;
+	AtomicDecrementRelease( m_pendingCount );
 
+	// Notify the completion queue before flagging the request as processed, as the owner of the queue is free to
+	// release it once the request has been synced.
+	CompletionQueue* pCompletionQueue = pRequest->pCompletionQueue;
+	if( pCompletionQueue )
 	{
-		Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-		handle->Push( pRequest );
+		CompletionQueue::Handle handle( *pCompletionQueue );
+		handle->Push( pRequest->completionCookie );
 	}
 
-	m_wakeUpCondition.Signal();
+	// Waking a thread blocked in SyncRequest() after the request has been flagged is safe even if the request has
+	// already been released and reused, as the waiter rechecks the request state.
+	int32_t state = AtomicExchangeRelease( pRequest->processedCounter, REQUEST_STATE_PROCESSED );
+	if( state == REQUEST_STATE_WAITED )
+	{
+		WakeValueWaiters( pRequest->processedCounter );
+	}
+
+	SignalCompletion();
 }
 
-/// Block the current thread until all pending load requests have completed.
+/// Advance the completion count and wake any threads blocked in WaitForCompletion().
+void AsyncLoader::SignalCompletion()
+{
+	AtomicIncrementRelease( m_completionCount );
+	if( m_completionWaiterCount != 0 )
+	{
+		WakeValueWaiters( m_completionCount );
+	}
+}
+
+/// Constructor.
+AsyncLoader::RequestQueue::RequestQueue()
+{
+	for( size_t priorityIndex = 0; priorityIndex < PRIORITY_MAX; ++priorityIndex )
+	{
+		m_headIndices[ priorityIndex ] = 0;
+	}
+}
+
+/// Add a request to the end of the queue for its priority.
+///
+/// @param[in] pRequest  Request to queue.
+void AsyncLoader::RequestQueue::Push( Request* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( static_cast< size_t >( pRequest->priority ) < static_cast< size_t >( PRIORITY_MAX ) );
+
+	m_requests[ pRequest->priority ].Push( pRequest );
+}
+
+/// Remove the oldest request of the highest priority that has requests pending.
+///
+/// @return  Request removed from the queue, or null if the queue is empty.
+AsyncLoader::Request* AsyncLoader::RequestQueue::Pop()
+{
+	for( size_t priorityIndex = PRIORITY_MAX; priorityIndex-- > 0; )
+	{
+		DynamicArray< Request* >& rRequests = m_requests[ priorityIndex ];
+		size_t& rHeadIndex = m_headIndices[ priorityIndex ];
+		if( rHeadIndex >= rRequests.GetSize() )
+		{
+			continue;
+		}
+
+		Request* pRequest = rRequests[ rHeadIndex ];
+		++rHeadIndex;
+
+		// Reclaim the popped entries once the queue drains, or once they make up most of the array.
+		if( rHeadIndex >= rRequests.GetSize() )
+		{
+			rRequests.Resize( 0 );
+			rHeadIndex = 0;
+		}
+		else if( rHeadIndex >= 64 && rHeadIndex * 2 >= rRequests.GetSize() )
+		{
+			rRequests.Remove( 0, rHeadIndex );
+			rHeadIndex = 0;
+		}
+
+		return pRequest;
+	}
+
+	return NULL;
+}
+
+/// Pop the highest priority request, along with any other requests of the same priority against the same file.
 ///
-/// @see QueueRequest()
-void AsyncLoader::LoadWorker::Flush()
+/// @param[out] rBatch      Array to fill with the popped requests (left empty if the queue is empty).
+/// @param[in]  batchLimit  Maximum number of requests to pop.
+void AsyncLoader::RequestQueue::PopBatch( DynamicArray< Request* >& rBatch, size_t batchLimit )
 {
-	bool isEmpty;
+	HELIUM_ASSERT( batchLimit != 0 );
+
+	rBatch.Resize( 0 );
+
+	Request* pFirstRequest = Pop();
+	if( !pFirstRequest )
 	{
-		Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-		isEmpty = handle->IsEmpty();
+		return;
 	}
 
-	while( m_processingCounter != 0 && !isEmpty )
+	rBatch.Push( pFirstRequest );
+
+	// Pull out the remaining requests for the same file, keeping the rest of the queue in order.
+	DynamicArray< Request* >& rRequests = m_requests[ pFirstRequest->priority ];
+	size_t headIndex = m_headIndices[ pFirstRequest->priority ];
+	size_t requestCount = rRequests.GetSize();
+	size_t keptCount = headIndex;
+	for( size_t requestIndex = headIndex; requestIndex < requestCount; ++requestIndex )
 	{
-		Thread::Yield();
+		Request* pRequest = rRequests[ requestIndex ];
+		if( rBatch.GetSize() < batchLimit && pRequest->fileName == pFirstRequest->fileName )
+		{
+			rBatch.Push( pRequest );
+		}
+		else
+		{
+			rRequests[ keptCount ] = pRequest;
+			++keptCount;
+		}
+	}
+
+	rRequests.Resize( keptCount );
+	if( keptCount == headIndex )
+	{
+		rRequests.Resize( 0 );
+		m_headIndices[ pFirstRequest->priority ] = 0;
 	}
 }
 
-/// Acquire an exclusive lock for writing to files and flush the async loader queue.
+/// Get whether the queue is empty.
 ///
-/// @see Unlock()
-void AsyncLoader::LoadWorker::Lock()
+/// @return  True if no requests are queued, false if any are.
+bool AsyncLoader::RequestQueue::IsEmpty() const
 {
-	// Prevent other threads from queueing requests or writing out data while we have a write lock.
-	m_writeLock.LockWrite();
+	for( size_t priorityIndex = 0; priorityIndex < PRIORITY_MAX; ++priorityIndex )
+	{
+		if( m_headIndices[ priorityIndex ] < m_requests[ priorityIndex ].GetSize() )
+		{
+			return false;
+		}
+	}
 
-	Flush();
+	return true;
 }
 
-/// Release an exclusive lock for writing to files.
+/// Remove a specific request from the queue.
 ///
-/// @see Lock()
-void AsyncLoader::LoadWorker::Unlock()
+/// @param[in] pRequest  Request to remove.
+///
+/// @return  True if the request was found in the queue and removed, false if it was not queued.
+bool AsyncLoader::RequestQueue::Remove( Request* pRequest )
 {
-	m_writeLock.UnlockWrite();
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( static_cast< size_t >( pRequest->priority ) < static_cast< size_t >( PRIORITY_MAX ) );
+
+	DynamicArray< Request* >& rRequests = m_requests[ pRequest->priority ];
+	size_t requestCount = rRequests.GetSize();
+	for( size_t requestIndex = m_headIndices[ pRequest->priority ]; requestIndex < requestCount; ++requestIndex )
+	{
+		if( rRequests[ requestIndex ] == pRequest )
+		{
+			rRequests.Remove( requestIndex );
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// Constructor.
+///
+/// @param[in] streamLimit       Maximum number of file streams to keep open at once.
+/// @param[in] rOpenStreamCount  Counter to update as file streams are opened and closed.
+AsyncLoader::FileHandleCache::FileHandleCache( size_t streamLimit, volatile int32_t& rOpenStreamCount )
+	: m_streamLimit( streamLimit )
+	, m_rOpenStreamCount( rOpenStreamCount )
+	, m_useCounter( 0 )
+{
+	HELIUM_ASSERT( streamLimit != 0 );
+	m_entries.Reserve( streamLimit );
+}
+
+/// Destructor.
+AsyncLoader::FileHandleCache::~FileHandleCache()
+{
+	Clear();
+}
+
+/// Get an open read stream for the given file, opening it (and closing the least recently used stream if the cache
+/// is full) if necessary.
+///
+/// @param[in] rFileName  Name of the file to read.
+///
+/// @return  File stream, or null if the file could not be opened.  The stream remains owned by the cache.
+FileStream* AsyncLoader::FileHandleCache::Acquire( const String& rFileName )
+{
+	++m_useCounter;
+
+	size_t entryCount = m_entries.GetSize();
+	size_t leastRecentIndex = 0;
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		Entry& rEntry = m_entries[ entryIndex ];
+		if( rEntry.fileName == rFileName )
+		{
+			rEntry.lastUse = m_useCounter;
+
+			return rEntry.pStream;
+		}
+
+		if( rEntry.lastUse < m_entries[ leastRecentIndex ].lastUse )
+		{
+			leastRecentIndex = entryIndex;
+		}
+	}
+
+	FileStream* pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_READ );
+	if( !pStream )
+	{
+		return NULL;
+	}
+
+	if( entryCount >= m_streamLimit )
+	{
+		Entry& rEntry = m_entries[ leastRecentIndex ];
+		delete rEntry.pStream;
+		rEntry.fileName = rFileName;
+		rEntry.pStream = pStream;
+		rEntry.lastUse = m_useCounter;
+	}
+	else
+	{
+		Entry* pEntry = m_entries.New();
+		HELIUM_ASSERT( pEntry );
+		pEntry->fileName = rFileName;
+		pEntry->pStream = pStream;
+		pEntry->lastUse = m_useCounter;
+
+		AtomicIncrementRelease( m_rOpenStreamCount );
+	}
+
+	return pStream;
+}
+
+/// Close all cached file streams.
+void AsyncLoader::FileHandleCache::Clear()
+{
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		delete m_entries[ entryIndex ].pStream;
+		AtomicDecrementRelease( m_rOpenStreamCount );
+	}
+
+	m_entries.Clear();
+}
+
+/// Constructor.
+///
+/// @param[in] rLoader          Loader whose request queue this worker will service.
+/// @param[in] fileStreamLimit  Maximum number of file streams this worker may keep open.
+AsyncLoader::LoadWorker::LoadWorker( AsyncLoader& rLoader, size_t fileStreamLimit )
+	: m_rLoader( rLoader )
+	, m_wakeUpCondition( false, false )
+	, m_fileStreamLimit( fileStreamLimit )
+	, m_stopCounter( 0 )
+	, m_idleCounter( 0 )
+{
+}
+
+/// Destructor.
+AsyncLoader::LoadWorker::~LoadWorker()
+{
+}
+
+/// Execute the async loading work.
+void AsyncLoader::LoadWorker::Run()
+{
+	FileHandleCache fileCache( m_fileStreamLimit, m_rLoader.m_openFileStreamCount );
+
+	DynamicArray< Request* > batch;
+	batch.Reserve( REQUEST_BATCH_LIMIT );
+	DynamicArray< uint8_t > readBuffer;
+
+	while( m_stopCounter == 0 )
+	{
+		m_rLoader.PopRequestBatch( batch, REQUEST_BATCH_LIMIT );
+		if( batch.IsEmpty() )
+		{
+			// Queue is empty, so close our file streams (the files may be written to before the next request) and
+			// sleep until notified.
+			fileCache.Clear();
+			WaitForRequests();
+
+			continue;
+		}
+
+		m_rLoader.ProcessRequestBatch( batch, fileCache, readBuffer );
+	}
+}
+
+/// Request the load worker to stop processing and return at the next possible opportunity.
+void AsyncLoader::LoadWorker::Stop()
+{
+	AtomicExchangeRelease( m_stopCounter, 1 );
+	m_wakeUpCondition.Signal();
+}
+
+/// Sleep until requests are queued or the worker is asked to stop.
+///
+/// The worker is flagged as idle while it sleeps, so that QueueRequest() only needs to wake a single worker.  The queue
+/// is checked again after raising the flag, as a request queued just before then would not have woken this worker.
+/// Workers close their file streams before calling this, so AsyncLoader::Lock() is also woken if it is waiting for the
+/// last stream to close.
+void AsyncLoader::LoadWorker::WaitForRequests()
+{
+	if( m_rLoader.m_openFileStreamCount == 0 )
+	{
+		WakeValueWaiters( m_rLoader.m_openFileStreamCount );
+	}
+
+	AtomicExchange( m_idleCounter, 1 );
+	if( m_stopCounter == 0 && !m_rLoader.HasQueuedRequests() )
+	{
+		m_wakeUpCondition.Wait();
+	}
+
+	AtomicExchangeRelease( m_idleCounter, 0 );
+}
+
+/// Wake up the load worker if it is waiting for requests to be queued.
+void AsyncLoader::LoadWorker::WakeUp()
+{
+	m_wakeUpCondition.Signal();
 }
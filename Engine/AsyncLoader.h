@@ -9,6 +9,7 @@
 #include "Foundation/String.h"
 
 #include "Engine/Engine.h"
+#include "Engine/Compression.h"
 
 #ifdef _MSC_VER
 #pragma warning( push )
@@ -21,6 +22,8 @@
 
 namespace Helium
 {
+	class FileStream;
+
 	/// Async loading manager.
 	class HELIUM_ENGINE_API AsyncLoader : NonCopyable
 	{
@@ -29,6 +32,16 @@ namespace Helium
 		static const size_t REQUEST_POOL_BLOCK_SIZE = 128;
 		/// Maximum number of open file streams.
 		static const size_t FILE_STREAM_LIMIT = 16;
+		/// Default number of I/O worker threads.
+		static const uint32_t DEFAULT_WORKER_COUNT = 2;
+		/// Maximum number of requests against the same file that a worker will pick up and process together.
+		static const size_t REQUEST_BATCH_LIMIT = 64;
+		/// Largest gap between two requests against the same file that is read through rather than seeked over.
+		static const size_t READ_COALESCE_GAP_LIMIT = 4 * 1024;
+		/// Maximum number of bytes covered by a single coalesced read.
+		static const size_t READ_COALESCE_SIZE_LIMIT = 1024 * 1024;
+		/// Number of reads kept in flight by the io_uring backend.
+		static const uint32_t IO_RING_QUEUE_DEPTH = 128;
 
 		/// Load request priority.
 		enum EPriority
@@ -44,19 +57,46 @@ namespace Helium
 			PRIORITY_LAST = PRIORITY_MAX - 1
 		};
 
+		/// I/O backend used to service load requests.
+		enum EBackend
+		{
+			BACKEND_FIRST   =  0,
+			BACKEND_INVALID = -1,
+
+			/// Worker threads performing blocking reads.
+			BACKEND_THREADS,
+			/// Single thread submitting batched reads through io_uring (Linux only).
+			BACKEND_IO_RING,
+
+			BACKEND_MAX,
+			BACKEND_LAST = BACKEND_MAX - 1
+		};
+
+		/// Queue into which the completion cookies of requests queued with it are pushed as the requests complete.
+		typedef Locker< DynamicArray< size_t >, SpinLock > CompletionQueue;
+
 		/// @name Initialization
 		//@{
-		bool Initialize();
+		bool Initialize( uint32_t workerCount = DEFAULT_WORKER_COUNT, EBackend backend = BACKEND_THREADS );
 		void Shutdown();
+
+		inline uint32_t GetWorkerCount() const;
+		inline EBackend GetBackend() const;
 		//@}
 
 		/// @name Load Request Management
 		//@{
 		size_t QueueRequest(
 			void* pBuffer, const String& rFileName, uint64_t offset, size_t size,
-			EPriority priority = PRIORITY_NORMAL );
+			EPriority priority = PRIORITY_NORMAL, CompletionQueue* pCompletionQueue = NULL,
+			size_t completionCookie = 0 );
+		size_t QueueCompressedRequest(
+			void* pBuffer, size_t bufferSize, const String& rFileName, uint64_t offset, size_t size,
+			Compression::ECodec codec, EPriority priority = PRIORITY_NORMAL,
+			CompletionQueue* pCompletionQueue = NULL, size_t completionCookie = 0 );
 		size_t SyncRequest( size_t id );
 		bool TrySyncRequest( size_t id, size_t& rBytesRead );
+		bool CancelRequest( size_t id );
 
 		void Flush();
 
@@ -64,6 +104,12 @@ namespace Helium
 		void Unlock();
 		//@}
 
+		/// @name Completion Waiting
+		//@{
+		inline int32_t GetCompletionCount() const;
+		void WaitForCompletion( int32_t completionCount, uint32_t timeoutMilliseconds = Invalid< uint32_t >() );
+		//@}
+
 		/// @name Static Access
 		//@{
 		static AsyncLoader& GetStaticInstance();
@@ -85,19 +131,95 @@ namespace Helium
 			/// Priority.
 			EPriority priority;
 
+			/// Codec with which the file data is compressed.
+			Compression::ECodec codec;
+			/// Size of the output buffer (compressed requests only; decompressed data is truncated to fit).
+			size_t bufferSize;
+			/// Buffer holding the compressed file data until it has been decompressed (compressed requests only).
+			void* pReadBuffer;
+
+			/// Queue to notify when this request completes (may be null).
+			CompletionQueue* pCompletionQueue;
+			/// Value pushed onto the completion queue.
+			size_t completionCookie;
+
 			/// Number of bytes read.
 			volatile size_t bytesRead;
-			/// Set to a non-zero value once this request has been processed.
+			/// Set to REQUEST_STATE_PROCESSED once this request has been processed.
 			volatile int32_t processedCounter;
 		};
 
+		/// Request processing states.
+		enum ERequestState
+		{
+			/// Request is queued or in progress.
+			REQUEST_STATE_PENDING,
+			/// Request has been processed.
+			REQUEST_STATE_PROCESSED,
+			/// Request is queued or in progress, and a thread is blocked in SyncRequest() waiting for it.
+			REQUEST_STATE_WAITED
+		};
+
+		/// Queue of pending load requests, popped in strict priority order and first-in, first-out order within each
+		/// priority level.
+		class RequestQueue
+		{
+		public:
+			RequestQueue();
+
+			void Push( Request* pRequest );
+			Request* Pop();
+			void PopBatch( DynamicArray< Request* >& rBatch, size_t batchLimit );
+			bool Remove( Request* pRequest );
+
+			bool IsEmpty() const;
+
+		private:
+			/// Queued requests for each priority (entries before the matching head index have already been popped).
+			DynamicArray< Request* > m_requests[ PRIORITY_MAX ];
+			/// Index of the next request to pop for each priority.
+			size_t m_headIndices[ PRIORITY_MAX ];
+		};
+
+		/// Least-recently-used cache of open file streams, owned by a single worker thread.
+		class FileHandleCache : NonCopyable
+		{
+		public:
+			FileHandleCache( size_t streamLimit, volatile int32_t& rOpenStreamCount );
+			~FileHandleCache();
+
+			FileStream* Acquire( const String& rFileName );
+			void Clear();
+
+		private:
+			/// Cached file stream.
+			struct Entry
+			{
+				/// Name of the file opened.
+				String fileName;
+				/// Open file stream.
+				FileStream* pStream;
+				/// Use counter value as of the last time this entry was acquired.
+				uint64_t lastUse;
+			};
+
+			/// Cached file streams.
+			DynamicArray< Entry > m_entries;
+			/// Maximum number of file streams to keep open.
+			size_t m_streamLimit;
+			/// Count of file streams open across all caches, updated as streams are opened and closed.
+			volatile int32_t& m_rOpenStreamCount;
+			/// Counter incremented on each acquire, used to find the least recently used entry.
+			uint64_t m_useCounter;
+		};
+
 		/// Async loading thread runnable.
 		class LoadWorker : public Runnable
 		{
 		public:
 			/// @name Construction/Destruction
 			//@{
-			LoadWorker();
+			LoadWorker( AsyncLoader& rLoader, size_t fileStreamLimit );
 			virtual ~LoadWorker();
 			//@}
 
@@ -109,39 +231,109 @@ namespace Helium
 			/// @name External Thread Control
 			//@{
 			void Stop();
+			void WakeUp();
 			//@}
 
-			/// @name External Request Queue Control
+		protected:
+			/// Loader that owns the request queues serviced by this worker.
+			AsyncLoader& m_rLoader;
+			/// Condition used to wake up the worker thread when load requests are queued (or when it should shut down).
+			Condition m_wakeUpCondition;
+			/// Maximum number of file streams this worker may keep open.
+			size_t m_fileStreamLimit;
+
+			/// Non-zero if this thread should stop when next possible, zero if it should continue.
+			volatile int32_t m_stopCounter;
+			/// Non-zero while this thread is waiting for requests and has not yet been picked to be woken up.
+			volatile int32_t m_idleCounter;
+
+			/// @name Worker Support
 			//@{
-			void QueueRequest( Request* pRequest );
-			void Flush();
+			void WaitForRequests();
+			//@}
 
-			void Lock();
-			void Unlock();
+			friend class AsyncLoader;
+		};
+
+		/// Async loading thread runnable submitting reads through an io_uring instance instead of reading one
+		/// request at a time.
+		class IoRingWorker : public LoadWorker
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			static IoRingWorker* Create( AsyncLoader& rLoader, size_t fileStreamLimit );
+			virtual ~IoRingWorker();
+			//@}
+
+			/// @name Runnable Interface
+			//@{
+			virtual void Run();
 			//@}
 
 		private:
-			/// Async load request queue.
-			Locker< DynamicArray< Request* >, SpinLock > m_requestQueue;
-			/// Condition used to wake up the worker thread when load requests are queued (or when it should shut down).
-			Condition m_wakeUpCondition;
+			/// Submission and completion ring state (platform-specific).
+			struct Ring;
 
-			/// Read-write lock used for synchronization of external file writes.
-			ReadWriteLock m_writeLock;
+			/// Ring state.
+			Ring* m_pRing;
 
-			/// Non-zero if this thread should stop when next possible, zero if it should continue.
-			volatile int32_t m_stopCounter;
-			/// Non-zero if this thread is currently processing a load request.
-			volatile int32_t m_processingCounter;
+			/// @name Construction/Destruction
+			//@{
+			IoRingWorker( AsyncLoader& rLoader, size_t fileStreamLimit, Ring* pRing );
+
+			static void ReleaseRing( Ring* pRing );
+			//@}
+		};
+
+		/// Compressed requests read by the io_uring backend, to be decompressed in parallel using the JobPool.
+		struct DecodeBatch
+		{
+			/// Loader owning the requests.
+			AsyncLoader* pLoader;
+			/// Requests to decompress (each holding the number of bytes read in its bytesRead member).
+			Request* const* ppRequests;
 		};
 
 		/// Pool of async load request objects.
 		ObjectPool< Request > m_requestPool;
 
-		/// Async loading thread.
-		RunnableThread* m_pThread;
-		/// Async loading thread worker.
-		LoadWorker* m_pWorker;
+		/// Pending request queue.
+		Locker< RequestQueue, SpinLock > m_requestQueue;
+		/// Number of requests queued or in progress.
+		volatile int32_t m_pendingCount;
+		/// Number of requests completed or cancelled so far (wraps around).
+		volatile int32_t m_completionCount;
+		/// Number of threads blocked in WaitForCompletion().
+		volatile int32_t m_completionWaiterCount;
+
+		/// Read-write lock used for synchronization of external file writes.
+		ReadWriteLock m_writeLock;
+		/// Number of file streams held open by the workers.
+		volatile int32_t m_openFileStreamCount;
+
+		/// Backend servicing load requests.
+		EBackend m_backend;
+
+		/// Async loading threads.
+		DynamicArray< RunnableThread* > m_threads;
+		/// Async loading thread workers.
+		DynamicArray< LoadWorker* > m_workers;
+
+		/// @name Worker Support
+		//@{
+		void PopRequestBatch( DynamicArray< Request* >& rBatch, size_t batchLimit );
+		bool HasQueuedRequests();
+		void ProcessRequestBatch(
+			DynamicArray< Request* >& rBatch, FileHandleCache& rFileCache, DynamicArray< uint8_t >& rReadBuffer );
+		void* PrepareRequestRead( Request* pRequest );
+		size_t DecodeRequest( Request* pRequest, size_t bytesRead );
+		void CompleteRequest( Request* pRequest, size_t bytesRead );
+		void SignalCompletion();
+
+		static bool CompareRequestOffsets( const Request* pRequest0, const Request* pRequest1 );
+		static void DecodeBatchJob( void* pData, size_t itemIndex );
+		//@}
 
 		/// Singleton instance.
 		static AsyncLoader* sm_pInstance;
@@ -153,3 +345,5 @@ namespace Helium
 		//@}
 	};
 }
+
+#include "Engine/AsyncLoader.inl"
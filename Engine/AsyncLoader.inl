@@ -0,0 +1,31 @@
+namespace Helium
+{
+	/// Get the number of I/O worker threads servicing load requests.
+	///
+	/// @return  Number of worker threads (zero if the loader has not been initialized).
+	uint32_t AsyncLoader::GetWorkerCount() const
+	{
+		return static_cast< uint32_t >( m_workers.GetSize() );
+	}
+
+	/// Get the number of requests completed or cancelled so far.
+	///
+	/// This is intended for use with WaitForCompletion(): sample the count, check whether the work being waited on is
+	/// done, and if not, wait for the count to change.
+	///
+	/// @return  Current completion count (wraps around).
+	///
+	/// @see WaitForCompletion()
+	int32_t AsyncLoader::GetCompletionCount() const
+	{
+		return m_completionCount;
+	}
+
+	/// Get the I/O backend servicing load requests.
+	///
+	/// @return  Backend in use (BACKEND_INVALID if the loader has not been initialized).
+	AsyncLoader::EBackend AsyncLoader::GetBackend() const
+	{
+		return m_backend;
+	}
+}
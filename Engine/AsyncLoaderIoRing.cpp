@@ -0,0 +1,632 @@
+#include "EnginePch.h"
+#include "Engine/AsyncLoader.h"
+
+#include "Engine/JobPool.h"
+
+#if HELIUM_OS_LINUX
+// Kernel headers older than io_uring lack this header, in which case only the thread backend is built.
+#if defined( __has_include )
+#if __has_include( <linux/io_uring.h> )
+#include <linux/io_uring.h>
+#define HELIUM_HAVE_IO_URING_HEADER 1
+#endif
+#endif
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#endif
+
+using namespace Helium;
+
+#if HELIUM_HAVE_IO_URING_HEADER && defined( __NR_io_uring_setup )
+
+/// Submission and completion ring state.
+struct AsyncLoader::IoRingWorker::Ring
+{
+	/// In-flight read.
+	struct Slot
+	{
+		/// Request being read.
+		Request* pRequest;
+		/// Read destination.
+		struct iovec destination;
+	};
+
+	/// Ring file descriptor.
+	int ringDescriptor;
+
+	/// Mapped submission queue ring.
+	void* pSubmissionRing;
+	/// Size of the mapped submission queue ring.
+	size_t submissionRingSize;
+	/// Mapped completion queue ring (may alias the submission queue ring).
+	void* pCompletionRing;
+	/// Size of the mapped completion queue ring.
+	size_t completionRingSize;
+	/// Mapped submission queue entries.
+	struct io_uring_sqe* pEntries;
+	/// Size of the mapped submission queue entries.
+	size_t entriesSize;
+
+	/// @name Submission Queue
+	//@{
+	unsigned* pSubmissionHead;
+	unsigned* pSubmissionTail;
+	unsigned submissionMask;
+	unsigned* pSubmissionArray;
+	//@}
+
+	/// @name Completion Queue
+	//@{
+	unsigned* pCompletionHead;
+	unsigned* pCompletionTail;
+	unsigned completionMask;
+	struct io_uring_cqe* pCompletions;
+	//@}
+
+	/// Number of submission queue entries.
+	uint32_t entryCount;
+	/// In-flight reads, indexed by the completion user data.
+	DynamicArray< Slot > slots;
+	/// Indices of the slots available for new reads.
+	DynamicArray< uint32_t > freeSlots;
+};
+
+namespace
+{
+	/// Least-recently-used cache of open file descriptors, the io_uring counterpart to
+	/// AsyncLoader::FileHandleCache.
+	class FileDescriptorCache : NonCopyable
+	{
+	public:
+		/// Constructor.
+		///
+		/// @param[in] descriptorLimit   Maximum number of file descriptors to keep open at once.
+		/// @param[in] rOpenStreamCount  Counter to update as files are opened and closed.
+		FileDescriptorCache( size_t descriptorLimit, volatile int32_t& rOpenStreamCount )
+			: m_descriptorLimit( descriptorLimit )
+			, m_rOpenStreamCount( rOpenStreamCount )
+			, m_useCounter( 0 )
+		{
+			HELIUM_ASSERT( descriptorLimit != 0 );
+			m_entries.Reserve( descriptorLimit );
+		}
+
+		/// Destructor.
+		~FileDescriptorCache()
+		{
+			Clear();
+		}
+
+		/// Get an open read-only descriptor for the given file, opening it (and closing the least recently used
+		/// descriptor if the cache is full) if necessary.
+		///
+		/// Reads already submitted against an evicted descriptor are unaffected, as the kernel holds its own
+		/// reference to the file once a read has been submitted.
+		///
+		/// @param[in] rFileName  Name of the file to read.
+		///
+		/// @return  File descriptor, or -1 if the file could not be opened.
+		int Acquire( const String& rFileName )
+		{
+			++m_useCounter;
+
+			size_t entryCount = m_entries.GetSize();
+			size_t leastRecentIndex = 0;
+			for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+			{
+				Entry& rEntry = m_entries[ entryIndex ];
+				if( rEntry.fileName == rFileName )
+				{
+					rEntry.lastUse = m_useCounter;
+
+					return rEntry.descriptor;
+				}
+
+				if( rEntry.lastUse < m_entries[ leastRecentIndex ].lastUse )
+				{
+					leastRecentIndex = entryIndex;
+				}
+			}
+
+			int descriptor = open( *rFileName, O_RDONLY | O_CLOEXEC );
+			if( descriptor == -1 )
+			{
+				return -1;
+			}
+
+			if( entryCount >= m_descriptorLimit )
+			{
+				Entry& rEntry = m_entries[ leastRecentIndex ];
+				close( rEntry.descriptor );
+				rEntry.fileName = rFileName;
+				rEntry.descriptor = descriptor;
+				rEntry.lastUse = m_useCounter;
+			}
+			else
+			{
+				Entry* pEntry = m_entries.New();
+				HELIUM_ASSERT( pEntry );
+				pEntry->fileName = rFileName;
+				pEntry->descriptor = descriptor;
+				pEntry->lastUse = m_useCounter;
+
+				AtomicIncrementRelease( m_rOpenStreamCount );
+			}
+
+			return descriptor;
+		}
+
+		/// Close all cached file descriptors.
+		void Clear()
+		{
+			size_t entryCount = m_entries.GetSize();
+			for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+			{
+				close( m_entries[ entryIndex ].descriptor );
+				AtomicDecrementRelease( m_rOpenStreamCount );
+			}
+
+			m_entries.Clear();
+		}
+
+	private:
+		/// Cached file descriptor.
+		struct Entry
+		{
+			/// Name of the file opened.
+			String fileName;
+			/// Open file descriptor.
+			int descriptor;
+			/// Use counter value as of the last time this entry was acquired.
+			uint64_t lastUse;
+		};
+
+		/// Cached file descriptors.
+		DynamicArray< Entry > m_entries;
+		/// Maximum number of file descriptors to keep open.
+		size_t m_descriptorLimit;
+		/// Count of files open across all workers, updated as descriptors are opened and closed.
+		volatile int32_t& m_rOpenStreamCount;
+		/// Counter incremented on each acquire, used to find the least recently used entry.
+		uint64_t m_useCounter;
+	};
+
+	/// Wrapper for the io_uring_enter() system call.
+	///
+	/// @param[in] ringDescriptor  Ring file descriptor.
+	/// @param[in] submitCount     Number of queued submission entries to submit.
+	/// @param[in] minComplete     Number of completions to wait for.
+	///
+	/// @return  Number of entries submitted, or a negated errno value on failure.
+	int EnterRing( int ringDescriptor, unsigned submitCount, unsigned minComplete )
+	{
+		unsigned flags = ( minComplete != 0 ? IORING_ENTER_GETEVENTS : 0 );
+		long result = syscall( __NR_io_uring_enter, ringDescriptor, submitCount, minComplete, flags, NULL, 0 );
+
+		return ( result < 0 ? -errno : static_cast< int >( result ) );
+	}
+}
+
+/// Create an io_uring worker, checking that io_uring is available on the running kernel.
+///
+/// @param[in] rLoader          Loader whose request queue this worker will service.
+/// @param[in] fileStreamLimit  Maximum number of files this worker may keep open.
+///
+/// @return  Worker instance, or null if io_uring could not be set up (in which case the caller should fall back to
+///          the thread backend).
+AsyncLoader::IoRingWorker* AsyncLoader::IoRingWorker::Create( AsyncLoader& rLoader, size_t fileStreamLimit )
+{
+	struct io_uring_params parameters;
+	MemoryZero( &parameters, sizeof( parameters ) );
+
+	// Setup fails with ENOSYS on kernels without io_uring, and with EPERM where it has been disabled (e.g. by a
+	// seccomp profile).
+	long ringDescriptor = syscall( __NR_io_uring_setup, IO_RING_QUEUE_DEPTH, &parameters );
+	if( ringDescriptor < 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "AsyncLoader: io_uring_setup() failed (errno %d).\n" ),
+			errno );
+
+		return NULL;
+	}
+
+	Ring* pRing = new Ring;
+	HELIUM_ASSERT( pRing );
+	pRing->ringDescriptor = static_cast< int >( ringDescriptor );
+	pRing->entryCount = parameters.sq_entries;
+
+	pRing->submissionRingSize = parameters.sq_off.array + parameters.sq_entries * sizeof( unsigned );
+	pRing->completionRingSize = parameters.cq_off.cqes + parameters.cq_entries * sizeof( struct io_uring_cqe );
+	pRing->entriesSize = parameters.sq_entries * sizeof( struct io_uring_sqe );
+
+	// Newer kernels map both rings with a single mapping.
+	bool bSingleMapping = ( parameters.features & IORING_FEAT_SINGLE_MMAP ) != 0;
+	if( bSingleMapping )
+	{
+		pRing->submissionRingSize = Max( pRing->submissionRingSize, pRing->completionRingSize );
+		pRing->completionRingSize = pRing->submissionRingSize;
+	}
+
+	pRing->pSubmissionRing = mmap(
+		NULL, pRing->submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pRing->ringDescriptor,
+		IORING_OFF_SQ_RING );
+	pRing->pCompletionRing = ( bSingleMapping ? pRing->pSubmissionRing : mmap(
+		NULL, pRing->completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pRing->ringDescriptor,
+		IORING_OFF_CQ_RING ) );
+	pRing->pEntries = static_cast< struct io_uring_sqe* >( mmap(
+		NULL, pRing->entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pRing->ringDescriptor,
+		IORING_OFF_SQES ) );
+	if( pRing->pSubmissionRing == MAP_FAILED ||
+		pRing->pCompletionRing == MAP_FAILED ||
+		pRing->pEntries == MAP_FAILED )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "AsyncLoader: Failed to map io_uring queues.\n" ) );
+
+		ReleaseRing( pRing );
+
+		return NULL;
+	}
+
+	uint8_t* pSubmissionRing = static_cast< uint8_t* >( pRing->pSubmissionRing );
+	pRing->pSubmissionHead = reinterpret_cast< unsigned* >( pSubmissionRing + parameters.sq_off.head );
+	pRing->pSubmissionTail = reinterpret_cast< unsigned* >( pSubmissionRing + parameters.sq_off.tail );
+	pRing->submissionMask = *reinterpret_cast< unsigned* >( pSubmissionRing + parameters.sq_off.ring_mask );
+	pRing->pSubmissionArray = reinterpret_cast< unsigned* >( pSubmissionRing + parameters.sq_off.array );
+
+	uint8_t* pCompletionRing = static_cast< uint8_t* >( pRing->pCompletionRing );
+	pRing->pCompletionHead = reinterpret_cast< unsigned* >( pCompletionRing + parameters.cq_off.head );
+	pRing->pCompletionTail = reinterpret_cast< unsigned* >( pCompletionRing + parameters.cq_off.tail );
+	pRing->completionMask = *reinterpret_cast< unsigned* >( pCompletionRing + parameters.cq_off.ring_mask );
+	pRing->pCompletions = reinterpret_cast< struct io_uring_cqe* >( pCompletionRing + parameters.cq_off.cqes );
+
+	// The completion queue is at least as large as the submission queue, and no more reads than there are
+	// submission entries are ever in flight, so the completion queue cannot overflow.
+	HELIUM_ASSERT( parameters.cq_entries >= parameters.sq_entries );
+	pRing->slots.Resize( pRing->entryCount );
+	pRing->freeSlots.Reserve( pRing->entryCount );
+	for( uint32_t slotIndex = pRing->entryCount; slotIndex-- > 0; )
+	{
+		pRing->slots[ slotIndex ].pRequest = NULL;
+		pRing->freeSlots.Push( slotIndex );
+	}
+
+	IoRingWorker* pWorker = new IoRingWorker( rLoader, fileStreamLimit, pRing );
+	HELIUM_ASSERT( pWorker );
+
+	return pWorker;
+}
+
+/// Constructor.
+///
+/// @param[in] rLoader          Loader whose request queue this worker will service.
+/// @param[in] fileStreamLimit  Maximum number of files this worker may keep open.
+/// @param[in] pRing            Ring state (ownership is transferred to this worker).
+AsyncLoader::IoRingWorker::IoRingWorker( AsyncLoader& rLoader, size_t fileStreamLimit, Ring* pRing )
+	: LoadWorker( rLoader, fileStreamLimit )
+	, m_pRing( pRing )
+{
+	HELIUM_ASSERT( pRing );
+}
+
+/// Destructor.
+AsyncLoader::IoRingWorker::~IoRingWorker()
+{
+	ReleaseRing( m_pRing );
+}
+
+/// Execute the async loading work.
+///
+/// Pending requests are popped in batches (one file at a time, sorted by offset) and submitted with a single system
+/// call per batch until the submission queue is full, after which the thread blocks until reads complete.  If the ring
+/// stops working, the reads in flight are failed and the worker carries on with blocking reads instead.
+void AsyncLoader::IoRingWorker::Run()
+{
+	Ring& rRing = *m_pRing;
+
+	FileDescriptorCache descriptorCache( m_fileStreamLimit, m_rLoader.m_openFileStreamCount );
+
+	DynamicArray< Request* > batch;
+	batch.Reserve( REQUEST_BATCH_LIMIT );
+
+	DynamicArray< Request* > decodeRequests;
+
+	uint32_t inFlightCount = 0;
+	bool bRingFailed = false;
+
+	// Reads already submitted must be waited on even when stopping, as the kernel still writes to their buffers.
+	while( m_stopCounter == 0 || inFlightCount != 0 )
+	{
+		// Top up the submission queue with pending requests.
+		while( m_stopCounter == 0 && inFlightCount < rRing.entryCount )
+		{
+			m_rLoader.PopRequestBatch( batch, Min< size_t >( REQUEST_BATCH_LIMIT, rRing.entryCount - inFlightCount ) );
+
+			size_t requestCount = batch.GetSize();
+			if( requestCount == 0 )
+			{
+				break;
+			}
+
+			int descriptor = descriptorCache.Acquire( batch[ 0 ]->fileName );
+			if( descriptor == -1 )
+			{
+				for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+				{
+					m_rLoader.CompleteRequest( batch[ requestIndex ], Invalid< size_t >() );
+				}
+
+				continue;
+			}
+
+			// Submit in offset order to give the block layer the best chance of merging adjacent reads.
+			std::sort( batch.GetData(), batch.GetData() + requestCount, CompareRequestOffsets );
+
+			unsigned tail = *rRing.pSubmissionTail;
+			for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+			{
+				Request* pRequest = batch[ requestIndex ];
+				HELIUM_ASSERT( pRequest );
+				HELIUM_ASSERT( pRequest->size <= static_cast< size_t >( INT32_MAX ) );
+
+				HELIUM_ASSERT( !rRing.freeSlots.IsEmpty() );
+				uint32_t slotIndex = rRing.freeSlots.GetLast();
+				rRing.freeSlots.Pop();
+
+				Ring::Slot& rSlot = rRing.slots[ slotIndex ];
+				rSlot.pRequest = pRequest;
+				rSlot.destination.iov_base = m_rLoader.PrepareRequestRead( pRequest );
+				rSlot.destination.iov_len = pRequest->size;
+
+				unsigned entryIndex = tail & rRing.submissionMask;
+				struct io_uring_sqe* pEntry = &rRing.pEntries[ entryIndex ];
+				MemoryZero( pEntry, sizeof( *pEntry ) );
+				pEntry->opcode = IORING_OP_READV;
+				pEntry->fd = descriptor;
+				pEntry->off = pRequest->offset;
+				pEntry->addr = reinterpret_cast< uintptr_t >( &rSlot.destination );
+				pEntry->len = 1;
+				pEntry->user_data = slotIndex;
+
+				rRing.pSubmissionArray[ entryIndex ] = entryIndex;
+				++tail;
+			}
+
+			__atomic_store_n( rRing.pSubmissionTail, tail, __ATOMIC_RELEASE );
+			inFlightCount += static_cast< uint32_t >( requestCount );
+
+			// Submit the batch right away; the descriptor cache may close this file once another file is opened.
+			unsigned submitCount = static_cast< unsigned >( requestCount );
+			while( submitCount != 0 )
+			{
+				int result = EnterRing( rRing.ringDescriptor, submitCount, 0 );
+				if( result >= 0 )
+				{
+					submitCount -= static_cast< unsigned >( result );
+				}
+				else if( result == -EINTR || result == -EAGAIN || result == -EBUSY )
+				{
+					Thread::Yield();
+				}
+				else
+				{
+					HELIUM_TRACE(
+						TraceLevels::Error,
+						TXT( "AsyncLoader: io_uring_enter() failed to submit reads (errno %d).\n" ),
+						-result );
+
+					// Take back the entries the kernel has not consumed and fail their requests.
+					unsigned head = __atomic_load_n( rRing.pSubmissionHead, __ATOMIC_ACQUIRE );
+					for( unsigned unsubmitted = head; unsubmitted != tail; ++unsubmitted )
+					{
+						uint32_t slotIndex = static_cast< uint32_t >(
+							rRing.pEntries[ rRing.pSubmissionArray[ unsubmitted & rRing.submissionMask ] ].user_data );
+						Request* pRequest = rRing.slots[ slotIndex ].pRequest;
+						m_rLoader.CompleteRequest( pRequest, m_rLoader.DecodeRequest( pRequest, 0 ) );
+						rRing.slots[ slotIndex ].pRequest = NULL;
+						rRing.freeSlots.Push( slotIndex );
+						--inFlightCount;
+					}
+
+					__atomic_store_n( rRing.pSubmissionTail, head, __ATOMIC_RELEASE );
+					submitCount = 0;
+				}
+			}
+		}
+
+		if( inFlightCount == 0 )
+		{
+			if( m_stopCounter != 0 )
+			{
+				break;
+			}
+
+			// Queue is empty, so close our files (they may be written to before the next request) and sleep until
+			// notified.
+			descriptorCache.Clear();
+			WaitForRequests();
+
+			continue;
+		}
+
+		// Wait for at least one read to finish, then complete everything that has.
+		unsigned head = *rRing.pCompletionHead;
+		unsigned tail = __atomic_load_n( rRing.pCompletionTail, __ATOMIC_ACQUIRE );
+		if( head == tail )
+		{
+			int result = EnterRing( rRing.ringDescriptor, 0, 1 );
+			if( result < 0 && result != -EINTR && result != -EAGAIN )
+			{
+				// Retrying would spin on the same error forever.
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					( TXT( "AsyncLoader: io_uring_enter() failed to wait for reads (errno %d), falling back to " )
+					TXT( "blocking reads.\n" ) ),
+					-result );
+
+				bRingFailed = true;
+
+				break;
+			}
+
+			tail = __atomic_load_n( rRing.pCompletionTail, __ATOMIC_ACQUIRE );
+		}
+
+		for( ; head != tail; ++head )
+		{
+			const struct io_uring_cqe& rCompletion = rRing.pCompletions[ head & rRing.completionMask ];
+			uint32_t slotIndex = static_cast< uint32_t >( rCompletion.user_data );
+			HELIUM_ASSERT( slotIndex < rRing.entryCount );
+
+			// As with the thread backend, failed reads report zero bytes read.
+			size_t bytesRead = ( rCompletion.res < 0 ? 0 : static_cast< size_t >( rCompletion.res ) );
+			Request* pRequest = rRing.slots[ slotIndex ].pRequest;
+			HELIUM_ASSERT( pRequest );
+			rRing.slots[ slotIndex ].pRequest = NULL;
+			if( pRequest->codec == Compression::CODEC_NONE )
+			{
+				m_rLoader.CompleteRequest( pRequest, bytesRead );
+			}
+			else
+			{
+				pRequest->bytesRead = bytesRead;
+				decodeRequests.Push( pRequest );
+			}
+
+			rRing.freeSlots.Push( slotIndex );
+			--inFlightCount;
+		}
+
+		__atomic_store_n( rRing.pCompletionHead, head, __ATOMIC_RELEASE );
+
+		// Decompress compressed data across the job pool threads rather than on this thread alone, which would hold
+		// up the submission of further reads.
+		if( !decodeRequests.IsEmpty() )
+		{
+			DecodeBatch decodeBatch;
+			decodeBatch.pLoader = &m_rLoader;
+			decodeBatch.ppRequests = decodeRequests.GetData();
+			JobPool::GetStaticInstance().Run( DecodeBatchJob, &decodeBatch, decodeRequests.GetSize() );
+
+			decodeRequests.Resize( 0 );
+		}
+	}
+
+	if( !bRingFailed )
+	{
+		return;
+	}
+
+	// Tear down the ring first, which has the kernel cancel any reads it still has queued, then fail the reads that
+	// were in flight (as with the thread backend, they report zero bytes read).
+	DynamicArray< Request* > failedRequests;
+	failedRequests.Reserve( inFlightCount );
+	for( uint32_t slotIndex = 0; slotIndex < rRing.entryCount; ++slotIndex )
+	{
+		if( rRing.slots[ slotIndex ].pRequest )
+		{
+			failedRequests.Push( rRing.slots[ slotIndex ].pRequest );
+		}
+	}
+
+	HELIUM_ASSERT( failedRequests.GetSize() == inFlightCount );
+
+	ReleaseRing( m_pRing );
+	m_pRing = NULL;
+
+	size_t failedCount = failedRequests.GetSize();
+	for( size_t requestIndex = 0; requestIndex < failedCount; ++requestIndex )
+	{
+		Request* pRequest = failedRequests[ requestIndex ];
+		m_rLoader.CompleteRequest( pRequest, m_rLoader.DecodeRequest( pRequest, 0 ) );
+	}
+
+	// Service the rest of the queue the same way as the thread backend.
+	descriptorCache.Clear();
+	LoadWorker::Run();
+}
+
+/// Unmap and close the resources held by a ring.
+///
+/// @param[in] pRing  Ring to release.
+void AsyncLoader::IoRingWorker::ReleaseRing( Ring* pRing )
+{
+	if( !pRing )
+	{
+		return;
+	}
+
+	if( pRing->pEntries != MAP_FAILED )
+	{
+		munmap( pRing->pEntries, pRing->entriesSize );
+	}
+
+	if( pRing->pCompletionRing != MAP_FAILED && pRing->pCompletionRing != pRing->pSubmissionRing )
+	{
+		munmap( pRing->pCompletionRing, pRing->completionRingSize );
+	}
+
+	if( pRing->pSubmissionRing != MAP_FAILED )
+	{
+		munmap( pRing->pSubmissionRing, pRing->submissionRingSize );
+	}
+
+	close( pRing->ringDescriptor );
+
+	delete pRing;
+}
+
+#else  // HELIUM_HAVE_IO_URING_HEADER && defined( __NR_io_uring_setup )
+
+/// Ring state (unused on platforms without io_uring).
+struct AsyncLoader::IoRingWorker::Ring
+{
+};
+
+/// Create an io_uring worker.
+///
+/// @param[in] rLoader          Loader whose request queue this worker will service.
+/// @param[in] fileStreamLimit  Maximum number of files this worker may keep open.
+///
+/// @return  Always null, as io_uring is not supported on this platform.
+AsyncLoader::IoRingWorker* AsyncLoader::IoRingWorker::Create( AsyncLoader& /*rLoader*/, size_t /*fileStreamLimit*/ )
+{
+	return NULL;
+}
+
+/// Constructor.
+AsyncLoader::IoRingWorker::IoRingWorker( AsyncLoader& rLoader, size_t fileStreamLimit, Ring* pRing )
+	: LoadWorker( rLoader, fileStreamLimit )
+	, m_pRing( pRing )
+{
+}
+
+/// Destructor.
+AsyncLoader::IoRingWorker::~IoRingWorker()
+{
+	ReleaseRing( m_pRing );
+}
+
+/// Release ring state.
+///
+/// @param[in] pRing  Ring to release.
+void AsyncLoader::IoRingWorker::ReleaseRing( Ring* pRing )
+{
+	delete pRing;
+}
+
+/// Execute the async loading work.
+void AsyncLoader::IoRingWorker::Run()
+{
+	HELIUM_ASSERT_MSG( false, TXT( "AsyncLoader::IoRingWorker::Run(): io_uring is not supported on this platform." ) );
+}
+
+#endif  // HELIUM_HAVE_IO_URING_HEADER && defined( __NR_io_uring_setup )
@@ -9,6 +9,17 @@
 #include "Engine/FileLocations.h"
 #include "Engine/AsyncLoader.h"
 
+#include <cstdio>
+
+#if HELIUM_OS_LINUX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#elif HELIUM_OS_WIN
+#include <windows.h>
+#endif
+
 #define USE_BSON_FOR_CACHE_FORMAT 0
 #define USE_JSON_FOR_CACHE_FORMAT 1
 
@@ -28,22 +39,90 @@ typedef Helium::Persist::ArchiveReaderMessagePack CacheArchiveReader;
 
 using namespace Helium;
 
+/// Compute the hash of an entry path string stored in an indexed TOC (64-bit FNV-1a, so that it is stable across runs
+/// and platforms).
+///
+/// @param[in] pString  Path string.
+/// @param[in] length   Number of characters in the path string.
+///
+/// @return  Path hash.
+static uint64_t ComputeTocPathHash( const char* pString, size_t length )
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for( size_t characterIndex = 0; characterIndex < length; ++characterIndex )
+	{
+		hash ^= static_cast< uint8_t >( pString[ characterIndex ] );
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+/// Reverse the byte order of a value in an indexed TOC in place.
+///
+/// @param[in,out] rValue  Value to byte swap.
+template< typename T >
+static void SwapTocValue( T& rValue )
+{
+	T value = rValue;
+	ReverseByteOrder( &rValue, &value, sizeof( T ) );
+}
+
+/// Get the first hash table bucket to probe for an entry in an indexed TOC.
+///
+/// @param[in] pathHash      Entry path hash.
+/// @param[in] subDataIndex  Entry sub-data index.
+/// @param[in] bucketMask    Hash table bucket mask.
+///
+/// @return  Index of the first bucket to probe.
+static uint32_t GetTocBucketIndex( uint64_t pathHash, uint32_t subDataIndex, uint32_t bucketMask )
+{
+	uint64_t hash = pathHash ^ ( static_cast< uint64_t >( subDataIndex ) * 0x9e3779b97f4a7c15ULL );
+
+	return static_cast< uint32_t >( hash ^ ( hash >> 32 ) ) & bucketMask;
+}
+
 /// TOC header magic number.
 static const uint32_t TOC_MAGIC = 0xcac4e70c;
 /// TOC header magic number (byte-swapped).
 static const uint32_t TOC_MAGIC_SWAPPED = 0x0ce7c4ca;
-/// Cache format version number.
-const uint32_t Cache::sm_Version = 0;
+/// Cache format version number (version 1 adds the TOC journal, version 2 the indexed TOC layout, version 3 per-entry
+/// compression).
+const uint32_t Cache::sm_Version = 3;
+/// First cache format version using the indexed TOC layout.
+static const uint32_t TOC_INDEXED_VERSION = 2;
+/// First cache format version storing the compressed size and codec of each entry.
+static const uint32_t TOC_COMPRESSION_VERSION = 3;
+/// Size of the indexed TOC header (magic, version, record count, bucket count, string table size, and padding).
+static const size_t TOC_INDEX_HEADER_SIZE = 6 * sizeof( uint32_t );
+/// Minimum number of hash table buckets in an indexed TOC.
+static const uint32_t TOC_MIN_BUCKET_COUNT = 16;
+/// Suffix appended to the cache and TOC file names for the temporary files written during compaction.
+static const char COMPACT_FILE_SUFFIX[] = TXT( ".compact" );
+/// Suffix appended to a TOC file name for the temporary file written before it replaces the TOC.
+static const char TOC_TEMP_FILE_SUFFIX[] = TXT( ".tmp" );
 
 /// Constructor.
 Cache::Cache()
 : m_name( NULL_NAME )
 , m_platform( PLATFORM_INVALID )
+, m_readMode( READ_MODE_INVALID )
 , m_bTocLoaded( false )
 , m_asyncLoadId( Invalid< size_t >() )
 , m_pTocBuffer( NULL )
 , m_tocSize( Invalid< uint32_t >() )
 , m_pEntryPool( NULL )
+, m_pTocIndexData( NULL )
+, m_tocMappedSize( 0 )
+, m_pTocRecords( NULL )
+, m_pTocBuckets( NULL )
+, m_pTocStrings( NULL )
+, m_tocRecordCount( 0 )
+, m_tocBucketMask( 0 )
+, m_journalRecordCount( 0 )
+, m_tocFileVersion( Invalid< uint32_t >() )
+, m_bBatchWrites( false )
+, m_batchEndOffset( 0 )
 {
 }
 
@@ -64,21 +143,43 @@ Cache::~Cache()
 /// @param[in] platform        Cache platform identifier.
 /// @param[in] pTocFileName    FilePath name of the table of contents file.
 /// @param[in] pCacheFileName  FilePath name of the cache file.
+/// @param[in] readMode        Mode to use for reading entry data.  READ_MODE_MAPPED falls back to READ_MODE_ASYNC on
+///                            platforms without memory-mapped cache support.
 ///
 /// @return  True if initialization was successful, false if not.
 ///
 /// @see Shutdown(), BeginLoadToc()
-bool Cache::Initialize( Name name, EPlatform platform, const char* pTocFileName, const char* pCacheFileName )
+bool Cache::Initialize(
+					   Name name,
+					   EPlatform platform,
+					   const char* pTocFileName,
+					   const char* pCacheFileName,
+					   EReadMode readMode )
 {
 	HELIUM_ASSERT( !name.IsEmpty() );
 	HELIUM_ASSERT( static_cast< size_t >( platform ) < static_cast< size_t >( PLATFORM_MAX ) );
 	HELIUM_ASSERT( pTocFileName );
 	HELIUM_ASSERT( pCacheFileName );
+	HELIUM_ASSERT( static_cast< size_t >( readMode ) < static_cast< size_t >( READ_MODE_MAX ) );
 
 	Shutdown();
 
 	m_name = name;
 	m_platform = platform;
+	m_readMode = readMode;
+
+#if !HELIUM_OS_LINUX
+	if( m_readMode == READ_MODE_MAPPED )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Cache::Initialize(): Memory-mapped reads are not supported on this platform for cache \"%s\".  " )
+			TXT( "Using async reads instead.\n" ),
+			*name );
+
+		m_readMode = READ_MODE_ASYNC;
+	}
+#endif
 
 	Status status;
 	status.Read( pTocFileName );
@@ -112,6 +213,9 @@ void Cache::Shutdown()
 {
 	m_name = NULL_NAME;
 	m_platform = PLATFORM_INVALID;
+	m_readMode = READ_MODE_INVALID;
+
+	UnmapCacheFile();
 
 	m_tocFileName.Clear();
 	m_cacheFileName.Clear();
@@ -128,8 +232,17 @@ void Cache::Shutdown()
 
 	m_bTocLoaded = false;
 
+	ReleaseTocIndex();
+
 	m_entries.Clear();
 	m_entryMap.Clear();
+	m_journalRecordCount = 0;
+	SetInvalid( m_tocFileVersion );
+
+	HELIUM_ASSERT_MSG( m_pendingWrites.IsEmpty(), TXT( "Cache shut down with batched writes still pending." ) );
+	m_bBatchWrites = false;
+	m_pendingWrites.Clear();
+	m_batchEndOffset = 0;
 
 	delete m_pEntryPool;
 	m_pEntryPool = NULL;
@@ -137,7 +250,8 @@ void Cache::Shutdown()
 
 /// Begin asynchronous loading of the cache table of contents.
 ///
-/// This must be called after calling Initialize() in order to begin using an existing cache.
+/// This must be called after calling Initialize() in order to begin using an existing cache.  When using
+/// READ_MODE_MAPPED, an indexed TOC file is memory-mapped and used in place, and loading completes immediately.
 ///
 /// @return  True if loading was started successfully, false if not.
 ///
@@ -171,6 +285,13 @@ bool Cache::BeginLoadToc()
 		return false;
 	}
 
+	if( m_readMode == READ_MODE_MAPPED && MapToc() )
+	{
+		m_bTocLoaded = true;
+
+		return true;
+	}
+
 	HELIUM_ASSERT( !m_pTocBuffer );
 	DefaultAllocator allocator;
 	m_pTocBuffer = static_cast< uint8_t* >( allocator.Allocate( m_tocSize ) );
@@ -216,7 +337,10 @@ bool Cache::TryFinishLoadToc()
 {
 	if( IsInvalid( m_asyncLoadId ) )
 	{
-		HELIUM_TRACE( TraceLevels::Warning, TXT( "Cache::TryFinishLoadToc(): Called without a TOC load in progress.\n" ) );
+		if( !m_bTocLoaded )
+		{
+			HELIUM_TRACE( TraceLevels::Warning, TXT( "Cache::TryFinishLoadToc(): Called without a TOC load in progress.\n" ) );
+		}
 
 		return true;
 	}
@@ -254,25 +378,19 @@ bool Cache::TryFinishLoadToc()
 			m_tocSize = static_cast< uint32_t >( bytesRead );
 		}
 
-		bool bFinalizeResult = FinalizeTocLoad();
+		bool bFinalizeResult = FinalizeTocLoad( m_pTocBuffer );
+
+		// Indexed TOCs are used in place, so the TOC index takes ownership of the load buffer.
+		if( m_pTocIndexData != m_pTocBuffer )
+		{
+			DefaultAllocator().Free( m_pTocBuffer );
+		}
 
-		DefaultAllocator().Free( m_pTocBuffer );
 		m_pTocBuffer = NULL;
 
 		if( !bFinalizeResult )
 		{
-			HELIUM_ASSERT( m_pEntryPool );
-
-			size_t entryCount = m_entries.GetSize();
-			for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
-			{
-				Entry* pEntry = m_entries[ entryIndex ];
-				HELIUM_ASSERT( pEntry );
-				m_pEntryPool->Release( pEntry );
-			}
-
-			m_entries.Clear();
-			m_entryMap.Clear();
+			ClearEntries();
 		}
 	}
 
@@ -308,29 +426,185 @@ void Cache::EnforceTocLoad()
 /// @return  Pointer to the cache entry for the given object path if found, null pointer if not found.
 const Cache::Entry* Cache::FindEntry( AssetPath path, uint32_t subDataIndex ) const
 {
-	EntryKey key;
-	key.path = path;
-	key.subDataIndex = subDataIndex;
+	return LookupEntry( path, subDataIndex );
+}
 
-	EntryMapType::ConstAccessor mapAccessor;
-	if( !m_entryMap.Find( mapAccessor, key ) )
+/// Get the information for the cache entry with the specified index.
+///
+/// @param[in] index  Asset entry index.
+///
+/// @return  Cache entry.
+///
+/// @see GetEntryCount()
+const Cache::Entry& Cache::GetEntry( uint32_t index ) const
+{
+	HELIUM_ASSERT( index < m_entries.GetSize() );
+
+	Entry* pEntry = m_entries[ index ];
+	if( !pEntry )
 	{
-		return NULL;
+		pEntry = MaterializeEntry( index );
 	}
 
-	Entry* pEntry = mapAccessor->Second();
 	HELIUM_ASSERT( pEntry );
 
-	return pEntry;
+	return *pEntry;
+}
+
+/// Get a pointer to the data for the given entry within the memory-mapped cache file.
+///
+/// The cache file is mapped on first use and remapped whenever an entry extends past the end of the current
+/// mapping.  A prefetch of the pages spanning the entry is issued before returning, so callers can defer touching the
+/// data to give the read-ahead time to complete.  The returned pointer remains valid until the cache is shut down.
+///
+/// @param[in] rEntry  Cache entry.
+///
+/// @return  Pointer to the entry data if it could be mapped, null if not or if the entry is compressed (in which case
+///          the data should be read using BeginReadEntry() instead).
+///
+/// @see GetReadMode(), BeginReadEntry()
+const uint8_t* Cache::GetMappedEntryData( const Entry& rEntry )
+{
+	HELIUM_ASSERT( m_readMode == READ_MODE_MAPPED );
+
+	if( rEntry.codec != Compression::CODEC_NONE )
+	{
+		return NULL;
+	}
+
+#if HELIUM_OS_LINUX
+	uint64_t entryEnd = rEntry.offset + rEntry.size;
+
+	MutexScopeLock scopeLock( m_mappedViewLock );
+
+	if( m_mappedViews.IsEmpty() || entryEnd > m_mappedViews.GetLast().size )
+	{
+		if( !MapCacheFile() || entryEnd > m_mappedViews.GetLast().size )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				( TXT( "Cache::GetMappedEntryData(): Entry \"%s\" (%" ) PRIu32 TXT( " bytes @ offset %" ) PRIu64
+				TXT( ") lies outside of the mapped cache file \"%s\".\n" ) ),
+				*rEntry.path.ToString(),
+				rEntry.size,
+				rEntry.offset,
+				*m_cacheFileName );
+
+			return NULL;
+		}
+	}
+
+	const uint8_t* pEntryData = m_mappedViews.GetLast().pData + rEntry.offset;
+
+	if( rEntry.size != 0 )
+	{
+		static const uintptr_t pageMask = static_cast< uintptr_t >( sysconf( _SC_PAGESIZE ) ) - 1;
+		uintptr_t prefetchStart = reinterpret_cast< uintptr_t >( pEntryData ) & ~pageMask;
+		uintptr_t prefetchEnd = reinterpret_cast< uintptr_t >( pEntryData ) + rEntry.size;
+		madvise( reinterpret_cast< void* >( prefetchStart ), prefetchEnd - prefetchStart, MADV_WILLNEED );
+	}
+
+	return pEntryData;
+#else
+	HELIUM_UNREF( rEntry );
+
+	return NULL;
+#endif
+}
+
+/// Begin an asynchronous read of the data for the given entry, decompressing it if necessary.
+///
+/// @param[in] rEntry            Cache entry.
+/// @param[in] pBuffer           Buffer in which to store the entry data.  This must be at least as large as the entry
+///                              size or the given maximum load size, whichever is smaller.
+/// @param[in] loadSizeMax       Maximum number of bytes to load.  If the entry is larger than this, only the leading
+///                              part of the entry data is loaded.
+/// @param[in] pCompletionQueue  Optional queue to notify when the read completes (see
+///                              AsyncLoader::QueueCompressedRequest()).
+/// @param[in] completionCookie  Value to push onto the completion queue.
+///
+/// @return  AsyncLoader request ID, or an invalid index if the request failed to be queued.  The number of bytes
+///          reported as read by the request is the number of bytes of entry data stored in the buffer.
+///
+/// @see ReadEntry()
+size_t Cache::BeginReadEntry(
+	const Entry& rEntry,
+	void* pBuffer,
+	size_t loadSizeMax,
+	AsyncLoader::CompletionQueue* pCompletionQueue,
+	size_t completionCookie ) const
+{
+	HELIUM_ASSERT( pBuffer );
+
+	size_t loadSize = Min< size_t >( rEntry.size, loadSizeMax );
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	if( rEntry.codec == Compression::CODEC_NONE )
+	{
+		return rLoader.QueueRequest(
+			pBuffer,
+			m_cacheFileName,
+			rEntry.offset,
+			loadSize,
+			AsyncLoader::PRIORITY_NORMAL,
+			pCompletionQueue,
+			completionCookie );
+	}
+
+	return rLoader.QueueCompressedRequest(
+		pBuffer,
+		loadSize,
+		m_cacheFileName,
+		rEntry.offset,
+		rEntry.storedSize,
+		rEntry.codec,
+		AsyncLoader::PRIORITY_NORMAL,
+		pCompletionQueue,
+		completionCookie );
+}
+
+/// Read the data for the given entry, blocking until the read has completed.
+///
+/// @param[in] rEntry       Cache entry.
+/// @param[in] pBuffer      Buffer in which to store the entry data.  This must be at least as large as the entry size or
+///                         the given maximum load size, whichever is smaller.
+/// @param[in] loadSizeMax  Maximum number of bytes to load.
+///
+/// @return  Number of bytes of entry data stored in the buffer, or an invalid index if the read failed to be issued or
+///          the cache file could not be opened.
+///
+/// @see BeginReadEntry()
+size_t Cache::ReadEntry( const Entry& rEntry, void* pBuffer, size_t loadSizeMax ) const
+{
+	size_t loadId = BeginReadEntry( rEntry, pBuffer, loadSizeMax );
+	if( IsInvalid( loadId ) )
+	{
+		return Invalid< size_t >();
+	}
+
+	return AsyncLoader::GetStaticInstance().SyncRequest( loadId );
 }
 
 /// Add or update an entry in the cache.
 ///
+/// New data is always written to the end of the cache file, and the entry is recorded by appending a journal record to
+/// the TOC file rather than rewriting the entire TOC.  The previous data for the entry is left intact, so a crash
+/// before the journal record is written leaves the TOC describing valid data.  Space left behind by replaced data is
+/// not reclaimed until Compact() is called.
+///
+/// If either the data or the journal record cannot be written, the in-memory entry is left as it was and false is
+/// returned.
+///
+/// If a codec is given, the data is stored compressed unless compression fails to make it any smaller.  Compressed
+/// entries cannot be accessed in place through GetMappedEntryData(), and must be read using BeginReadEntry() or
+/// ReadEntry().
+///
 /// @param[in] path          Asset path.
 /// @param[in] subDataIndex  Sub-data index associated with the cached data.
 /// @param[in] pData         Data to cache.
 /// @param[in] timestamp     Timestamp value to associate with the entry in the cache.
 /// @param[in] size          Number of bytes to cache.
+/// @param[in] codec         Codec with which to compress the data in the cache file.
 ///
 /// @return  True if the cache was updated successfully, false if not.
 bool Cache::CacheEntry(
@@ -338,14 +612,52 @@ bool Cache::CacheEntry(
 					   uint32_t subDataIndex,
 					   const void* pData,
 					   int64_t timestamp,
-					   uint32_t size )
+					   uint32_t size,
+					   Compression::ECodec codec )
 {
 	HELIUM_ASSERT( pData || size == 0 );
+	HELIUM_ASSERT( static_cast< size_t >( codec ) < static_cast< size_t >( Compression::CODEC_MAX ) );
 
-	Status status;
-	status.Read( m_cacheFileName.GetData() );
-	int64_t cacheFileSize = status.m_Size;
-	uint64_t entryOffset = ( cacheFileSize == -1 ? 0 : static_cast< uint64_t >( cacheFileSize ) );
+	// Compress the data up front, falling back to storing it as-is if that does not save any space.
+	const void* pStoredData = pData;
+	uint32_t storedSize = size;
+
+	DynamicArray< uint8_t > compressedData;
+	if( codec != Compression::CODEC_NONE && size != 0 )
+	{
+		compressedData.Resize( Compression::GetMaxCompressedSize( codec, size ) );
+		size_t compressedSize = Compression::Compress(
+			codec,
+			pData,
+			size,
+			compressedData.GetData(),
+			compressedData.GetSize() );
+		if( IsValid( compressedSize ) && compressedSize < size )
+		{
+			pStoredData = compressedData.GetData();
+			storedSize = static_cast< uint32_t >( compressedSize );
+		}
+		else
+		{
+			codec = Compression::CODEC_NONE;
+		}
+	}
+	else
+	{
+		codec = Compression::CODEC_NONE;
+	}
+
+	// Make sure any existing record for the entry in an indexed TOC has been turned into an entry we can update.
+	LookupEntry( path, subDataIndex );
+
+	uint64_t entryOffset = m_batchEndOffset;
+	if( !m_bBatchWrites )
+	{
+		Status status;
+		status.Read( m_cacheFileName.GetData() );
+		int64_t cacheFileSize = status.m_Size;
+		entryOffset = ( cacheFileSize == -1 ? 0 : static_cast< uint64_t >( cacheFileSize ) );
+	}
 
 	HELIUM_ASSERT( m_pEntryPool );
 	Entry* pEntryUpdate = m_pEntryPool->Allocate();
@@ -355,10 +667,14 @@ bool Cache::CacheEntry(
 	pEntryUpdate->path = path;
 	pEntryUpdate->subDataIndex = subDataIndex;
 	pEntryUpdate->size = size;
+	pEntryUpdate->storedSize = storedSize;
+	pEntryUpdate->codec = codec;
 
 	uint64_t originalOffset = 0;
 	int64_t originalTimestamp = 0;
 	uint32_t originalSize = 0;
+	uint32_t originalStoredSize = 0;
+	Compression::ECodec originalCodec = Compression::CODEC_NONE;
 
 	EntryKey key;
 	key.path = path;
@@ -384,18 +700,40 @@ bool Cache::CacheEntry(
 		originalOffset = pEntryUpdate->offset;
 		originalTimestamp = pEntryUpdate->timestamp;
 		originalSize = pEntryUpdate->size;
+		originalStoredSize = pEntryUpdate->storedSize;
+		originalCodec = pEntryUpdate->codec;
 
-		if( originalSize < size )
-		{
-			pEntryUpdate->offset = entryOffset;
-		}
-		else
-		{
-			entryOffset = originalOffset;
-		}
-
+		// Data is always appended rather than written over the data it replaces, so the previous data stays intact
+		// (and valid for any mapped views) until the TOC record for the update has been written.  Space left behind
+		// is reclaimed by Compact().
+		pEntryUpdate->offset = entryOffset;
 		pEntryUpdate->timestamp = timestamp;
 		pEntryUpdate->size = size;
+		pEntryUpdate->storedSize = storedSize;
+		pEntryUpdate->codec = codec;
+	}
+
+	if( m_bBatchWrites )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "Cache: Batching \"%s\" for \"%s\" (%" ) PRIu32 TXT( " bytes, %" ) PRIu32 TXT( " stored (%s) @ " )
+			TXT( "offset %" ) PRIu64 TXT( ").\n" ) ),
+			*path.ToString(),
+			*m_cacheFileName,
+			size,
+			storedSize,
+			Compression::GetCodecName( codec ),
+			entryOffset );
+
+		PendingWrite* pPendingWrite = m_pendingWrites.New();
+		HELIUM_ASSERT( pPendingWrite );
+		pPendingWrite->offset = entryOffset;
+		pPendingWrite->data.AddArray( static_cast< const uint8_t* >( pStoredData ), storedSize );
+
+		m_batchEndOffset = entryOffset + storedSize;
+
+		return true;
 	}
 
 	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
@@ -415,10 +753,13 @@ bool Cache::CacheEntry(
 	{
 		HELIUM_TRACE(
 			TraceLevels::Info,
-			TXT( "Cache: Caching \"%s\" to \"%s\" (%" ) PRIu32 TXT( " bytes @ offset %" ) PRIu64 TXT( ").\n" ),
+			( TXT( "Cache: Caching \"%s\" to \"%s\" (%" ) PRIu32 TXT( " bytes, %" ) PRIu32 TXT( " stored (%s) @ " )
+			TXT( "offset %" ) PRIu64 TXT( ").\n" ) ),
 			*path.ToString(),
 			*m_cacheFileName,
 			size,
+			storedSize,
+			Compression::GetCodecName( codec ),
 			entryOffset );
 
 		uint64_t seekOffset = static_cast< uint64_t >( pCacheStream->Seek(
@@ -428,170 +769,395 @@ bool Cache::CacheEntry(
 		{
 			HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Cache file offset seek failed.\n" ) );
 
-			if( bNewEntry )
-			{
-				m_entries.Pop();
-				m_entryMap.Remove( entryAccessor );
-				m_pEntryPool->Release( pEntryUpdate );
-			}
-			else
-			{
-				pEntryUpdate->offset = originalOffset;
-				pEntryUpdate->timestamp = originalTimestamp;
-				pEntryUpdate->size = originalSize;
-			}
-
 			bCacheSuccess = false;
 		}
 		else
 		{
-			size_t writeSize = pCacheStream->Write( pData, 1, size );
-			if( writeSize != size )
+			size_t writeSize = pCacheStream->Write( pStoredData, 1, storedSize );
+			if( writeSize != storedSize )
 			{
 				HELIUM_TRACE(
 					TraceLevels::Error,
 					( TXT( "Cache: Failed to write %" ) PRIu32 TXT( " bytes to cache \"%s\" (%" ) PRIuSZ
 					TXT( " bytes written).\n" ) ),
-					size,
+					storedSize,
 					*m_cacheFileName,
 					writeSize );
 
-				if( bNewEntry )
-				{
-					m_entries.Pop();
-					m_entryMap.Remove( entryAccessor );
-					m_pEntryPool->Release( pEntryUpdate );
-				}
-				else
-				{
-					pEntryUpdate->offset = originalOffset;
-					pEntryUpdate->timestamp = originalTimestamp;
-					pEntryUpdate->size = originalSize;
-				}
-
 				bCacheSuccess = false;
 			}
-			else
-			{
-				HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *m_tocFileName );
-
-				FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, true );
-				if( !pTocStream )
-				{
-					HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
-				}
-				else
-				{
-					BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
-					HELIUM_ASSERT( pBufferedStream );
-
-					pBufferedStream->Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 );
-					pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 );
-
-					uint32_t entryCount = static_cast< uint32_t >( m_entries.GetSize() );
-					pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 );
-
-					String entryPath;
-					uint_fast32_t entryCountFast = entryCount;
-					for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
-					{
-						Entry* pEntry = m_entries[ entryIndex ];
-						HELIUM_ASSERT( pEntry );
-
-						pEntry->path.ToString( entryPath );
-						HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
-						uint16_t pathSize = static_cast< uint16_t >( entryPath.GetSize() );
-						pBufferedStream->Write( &pathSize, sizeof( pathSize ), 1 );
-
-						pBufferedStream->Write( *entryPath, sizeof( char ), pathSize );
-
-						pBufferedStream->Write( &pEntry->subDataIndex, sizeof( pEntry->subDataIndex ), 1 );
-
-						pBufferedStream->Write( &pEntry->offset, sizeof( pEntry->offset ), 1 );
-						pBufferedStream->Write( &pEntry->timestamp, sizeof( pEntry->timestamp ), 1 );
-						pBufferedStream->Write( &pEntry->size, sizeof( pEntry->size ), 1 );
-					}
-
-					delete pBufferedStream;
-					delete pTocStream;
-				}
-			}
 		}
 
 		delete pCacheStream;
 	}
 
+	if( bCacheSuccess && !AppendTocRecord( *pEntryUpdate ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache: Failed to record \"%s\" in TOC \"%s\".\n" ),
+			*path.ToString(),
+			*m_tocFileName );
+
+		bCacheSuccess = false;
+	}
+
+	// Restore the in-memory entry on failure so that it still matches the TOC file (any data appended to the cache
+	// file is simply unreferenced).
+	if( !bCacheSuccess )
+	{
+		if( bNewEntry )
+		{
+			m_entries.Pop();
+			m_entryMap.Remove( entryAccessor );
+			m_pEntryPool->Release( pEntryUpdate );
+		}
+		else
+		{
+			pEntryUpdate->offset = originalOffset;
+			pEntryUpdate->timestamp = originalTimestamp;
+			pEntryUpdate->size = originalSize;
+			pEntryUpdate->storedSize = originalStoredSize;
+			pEntryUpdate->codec = originalCodec;
+		}
+	}
+
 	rLoader.Unlock();
 
 	return bCacheSuccess;
 }
 
-/// Finalize the TOC loading process.
+/// Begin holding entry updates in memory instead of writing them to disk as they are made.
 ///
-/// Note that this does not free any resources on a failed load (the caller is responsible for such clean-up work).
+/// While batching, CacheEntry() appends entry data to an in-memory list and updates the in-memory TOC only.  The data
+/// is written to the cache file with a single sequential pass, followed by a single full TOC write, once
+/// EndBatchWrites() is called.  Entries added or updated while batching must not be read until then.
 ///
-/// @return  True if the TOC load was successful, false if not.
-bool Cache::FinalizeTocLoad()
+/// @see EndBatchWrites(), IsBatchingWrites()
+void Cache::BeginBatchWrites()
 {
-	HELIUM_ASSERT( m_pTocBuffer );
+	HELIUM_ASSERT( m_pEntryPool );
 
-	const uint8_t* pTocCurrent = m_pTocBuffer;
-	const uint8_t* pTocMax = pTocCurrent + m_tocSize;
+	if( m_bBatchWrites )
+	{
+		return;
+	}
 
-	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+	Status status;
+	status.Read( m_cacheFileName.GetData() );
+	m_batchEndOffset = ( status.m_Size == -1 ? 0 : static_cast< uint64_t >( status.m_Size ) );
 
-	// Validate the TOC header.
-	uint32_t magic;
-	if( !CheckedTocRead( MemoryCopy, magic, TXT( "the header magic" ), pTocCurrent, pTocMax ) )
+	m_bBatchWrites = true;
+}
+
+/// Write out all entry updates made since BeginBatchWrites() was called, and stop batching writes.
+///
+/// @return  True if all pending data and the TOC were written successfully, false if not.  On failure, the TOC file
+///          on disk is left as it was before the batch (any data appended to the cache file is simply unreferenced).
+///
+/// @see BeginBatchWrites(), IsBatchingWrites()
+bool Cache::EndBatchWrites()
+{
+	if( !m_bBatchWrites )
 	{
-		return false;
+		return true;
 	}
 
-	LOAD_VALUE_CALLBACK* pLoadFunction = NULL;
-	if( magic == TOC_MAGIC )
-	{
-		HELIUM_TRACE(
-			TraceLevels::Info,
-			TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" identified (no byte swapping).\n" ),
-			*m_tocFileName );
+	m_bBatchWrites = false;
 
-		pLoadFunction = MemoryCopy;
-	}
-	else if( magic == TOC_MAGIC_SWAPPED )
+	if( m_pendingWrites.IsEmpty() )
 	{
-		HELIUM_TRACE(
-			TraceLevels::Info,
-			TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" identified (byte swapping is necessary).\n" ),
-			*m_tocFileName );
-		HELIUM_TRACE(
-			TraceLevels::Warning,
-			( TXT( "Cache::TryFinishLoadToc(): Cache for TOC \"%s\" uses byte swapping, which may incur " )
-			TXT( "performance penalties.\n" ) ),
-			*m_tocFileName );
+		return true;
+	}
 
-		pLoadFunction = ReverseByteOrder;
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	rLoader.Lock();
+
+	bool bSuccess = false;
+	uint64_t bytesWritten = 0;
+
+	FileStream* pCacheStream = FileStream::OpenFileStream( m_cacheFileName, FileStream::MODE_WRITE, false );
+	if( !pCacheStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open cache \"%s\" for writing.\n" ), *m_cacheFileName );
 	}
 	else
 	{
-		HELIUM_TRACE(
-			TraceLevels::Error,
-			TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" has invalid file magic.\n" ),
-			*m_tocFileName );
+		// Pending data is contiguous, so it can be written in a single sequential pass.
+		uint64_t startOffset = m_pendingWrites[ 0 ].offset;
+		bSuccess = ( static_cast< uint64_t >( pCacheStream->Seek(
+			static_cast< int64_t >( startOffset ),
+			SeekOrigins::Begin ) ) == startOffset );
+		if( !bSuccess )
+		{
+			HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Cache file offset seek failed.\n" ) );
+		}
+		else
+		{
+			BufferedStream* pBufferedStream = new BufferedStream( pCacheStream );
+			HELIUM_ASSERT( pBufferedStream );
 
-		return false;
+			size_t pendingWriteCount = m_pendingWrites.GetSize();
+			for( size_t writeIndex = 0; bSuccess && writeIndex < pendingWriteCount; ++writeIndex )
+			{
+				const PendingWrite& rPendingWrite = m_pendingWrites[ writeIndex ];
+				HELIUM_ASSERT( rPendingWrite.offset == startOffset + bytesWritten );
+
+				size_t writeSize = rPendingWrite.data.GetSize();
+				bSuccess = ( pBufferedStream->Write( rPendingWrite.data.GetData(), 1, writeSize ) == writeSize );
+				bytesWritten += writeSize;
+			}
+
+			delete pBufferedStream;
+
+			if( !bSuccess )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					TXT( "Cache: Failed to write batched entry data to cache \"%s\".\n" ),
+					*m_cacheFileName );
+			}
+		}
+
+		delete pCacheStream;
 	}
 
-	uint32_t version;
-	if( !CheckedTocRead( pLoadFunction, version, TXT( "the cache version number" ), pTocCurrent, pTocMax ) )
+	if( bSuccess )
 	{
-		return false;
+		bSuccess = WriteToc( m_tocFileName );
+		if( bSuccess )
+		{
+			m_tocFileVersion = sm_Version;
+		}
 	}
 
-	if( version > sm_Version )
+	rLoader.Unlock();
+
+	if( bSuccess )
 	{
 		HELIUM_TRACE(
-			TraceLevels::Error,
-			( TXT( "Cache::FinalizeTocLoad(): Cache version number (%" ) PRIu32 TXT( ") exceeds the maximum " )
+			TraceLevels::Info,
+			TXT( "Cache: Wrote %" ) PRIuSZ TXT( " batched entries (%" ) PRIu64 TXT( " bytes) to cache \"%s\".\n" ),
+			m_pendingWrites.GetSize(),
+			bytesWritten,
+			*m_cacheFileName );
+	}
+
+	m_pendingWrites.Clear();
+
+	return bSuccess;
+}
+
+/// Get usage statistics for the cache file.
+///
+/// @param[out] rStats  Cache statistics.
+///
+/// @see Compact()
+void Cache::GetStats( Stats& rStats ) const
+{
+	Status status;
+	status.Read( m_cacheFileName.GetData() );
+	rStats.cacheFileSize = ( status.m_Size == -1 ? 0 : static_cast< uint64_t >( status.m_Size ) );
+
+	rStats.liveBytes = 0;
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		const Entry* pEntry = m_entries[ entryIndex ];
+		if( pEntry )
+		{
+			rStats.liveBytes += pEntry->storedSize;
+		}
+		else
+		{
+			HELIUM_ASSERT( entryIndex < m_tocRecordCount );
+			rStats.liveBytes += m_pTocRecords[ entryIndex ].storedSize;
+		}
+	}
+
+	rStats.orphanedBytes = ( rStats.cacheFileSize > rStats.liveBytes ? rStats.cacheFileSize - rStats.liveBytes : 0 );
+	rStats.entryCount = static_cast< uint32_t >( entryCount );
+	rStats.journalRecordCount = m_journalRecordCount;
+}
+
+/// Reclaim space in the cache file left behind by replaced entry data, and fold the TOC journal into a full TOC.
+///
+/// Live entry data is copied contiguously into a new cache file in the order in which entries were first added to
+/// the cache (which follows the order in which they were first requested during cooking and loading), and a new TOC
+/// is written alongside it.  Both files replace the originals only once they have been written in full.  Any
+/// memory-mapped views of the previous cache file remain valid until the cache is shut down.
+///
+/// @return  True if compaction was successful, false if not (in which case the cache is left unchanged).
+///
+/// @see GetStats()
+bool Cache::Compact()
+{
+	HELIUM_ASSERT( m_pEntryPool );
+	HELIUM_ASSERT( !m_bBatchWrites );
+
+	Stats stats;
+	GetStats( stats );
+
+	if( !MaterializeAllEntries() )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to read all entries of cache \"%s\".\n" ), *m_cacheFileName );
+
+		return false;
+	}
+
+	String compactCacheFileName( m_cacheFileName );
+	compactCacheFileName += COMPACT_FILE_SUFFIX;
+	String compactTocFileName( m_tocFileName );
+	compactTocFileName += COMPACT_FILE_SUFFIX;
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	rLoader.Lock();
+
+	DynamicArray< uint64_t > offsets;
+	bool bSuccess = WriteCompactedCacheFile( compactCacheFileName, offsets );
+	if( bSuccess )
+	{
+		// Write the new TOC with the compacted offsets, then restore the current offsets until the new files are in
+		// place.
+		size_t entryCount = m_entries.GetSize();
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			Entry* pEntry = m_entries[ entryIndex ];
+			HELIUM_ASSERT( pEntry );
+			Swap( pEntry->offset, offsets[ entryIndex ] );
+		}
+
+		uint32_t journalRecordCount = m_journalRecordCount;
+		bSuccess = WriteToc( compactTocFileName );
+		m_journalRecordCount = journalRecordCount;
+
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			Swap( m_entries[ entryIndex ]->offset, offsets[ entryIndex ] );
+		}
+	}
+
+	if( bSuccess )
+	{
+		bSuccess = ReplaceExistingFile( compactCacheFileName, m_cacheFileName ) &&
+			ReplaceExistingFile( compactTocFileName, m_tocFileName );
+	}
+
+	if( bSuccess )
+	{
+		size_t entryCount = m_entries.GetSize();
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			m_entries[ entryIndex ]->offset = offsets[ entryIndex ];
+		}
+
+		m_journalRecordCount = 0;
+		m_tocFileVersion = sm_Version;
+
+		// All entries have been created from the TOC index, and its offsets are now out of date.
+		ReleaseTocIndex();
+
+		MutexScopeLock scopeLock( m_mappedViewLock );
+		if( !m_mappedViews.IsEmpty() )
+		{
+			MapCacheFile( true );
+		}
+	}
+	else
+	{
+		FilePath( compactCacheFileName.GetData() ).Delete();
+		FilePath( compactTocFileName.GetData() ).Delete();
+	}
+
+	rLoader.Unlock();
+
+	if( bSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "Cache: Compacted cache \"%s\" from %" ) PRIu64 TXT( " to %" ) PRIu64 TXT( " bytes (%" ) PRIu32
+			TXT( " journal records folded).\n" ) ),
+			*m_cacheFileName,
+			stats.cacheFileSize,
+			stats.liveBytes,
+			stats.journalRecordCount );
+	}
+	else
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to compact cache \"%s\".\n" ), *m_cacheFileName );
+	}
+
+	return bSuccess;
+}
+
+/// Finalize the TOC loading process.
+///
+/// Note that this does not free any resources on a failed load (the caller is responsible for such clean-up work).
+/// If the TOC uses the indexed layout, the TOC index references the given data on success, and it must remain valid
+/// until ReleaseTocIndex() is called.
+///
+/// @param[in] pTocData  TOC file contents (m_tocSize bytes).
+///
+/// @return  True if the TOC load was successful, false if not.
+bool Cache::FinalizeTocLoad( const uint8_t* pTocData )
+{
+	HELIUM_ASSERT( pTocData );
+
+	const uint8_t* pTocCurrent = pTocData;
+	const uint8_t* pTocMax = pTocCurrent + m_tocSize;
+
+	// Validate the TOC header.
+	uint32_t magic;
+	if( !CheckedTocRead( MemoryCopy, magic, TXT( "the header magic" ), pTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
+
+	LOAD_VALUE_CALLBACK* pLoadFunction = NULL;
+	if( magic == TOC_MAGIC )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" identified (no byte swapping).\n" ),
+			*m_tocFileName );
+
+		pLoadFunction = MemoryCopy;
+	}
+	else if( magic == TOC_MAGIC_SWAPPED )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" identified (byte swapping is necessary).\n" ),
+			*m_tocFileName );
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			( TXT( "Cache::TryFinishLoadToc(): Cache for TOC \"%s\" uses byte swapping, which may incur " )
+			TXT( "performance penalties.\n" ) ),
+			*m_tocFileName );
+
+		pLoadFunction = ReverseByteOrder;
+	}
+	else
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" has invalid file magic.\n" ),
+			*m_tocFileName );
+
+		return false;
+	}
+
+	uint32_t version;
+	if( !CheckedTocRead( pLoadFunction, version, TXT( "the cache version number" ), pTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
+
+	if( version > sm_Version )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			( TXT( "Cache::FinalizeTocLoad(): Cache version number (%" ) PRIu32 TXT( ") exceeds the maximum " )
 			TXT( "supported version (%" ) PRIu32 TXT( ").\n" ) ),
 			version,
 			sm_Version );
@@ -599,131 +1165,988 @@ bool Cache::FinalizeTocLoad()
 		return false;
 	}
 
-	// Read the numbers of entries in the cache.
-	uint32_t entryCount;
-	bool bReadResult = CheckedTocRead(
-		pLoadFunction,
-		entryCount,
-		TXT( "the number of entries in the cache" ),
-		pTocCurrent,
-		pTocMax );
-	if( !bReadResult )
+	if( version >= TOC_INDEXED_VERSION && version < TOC_COMPRESSION_VERSION )
+	{
+		// The fixed-size records of indexed TOCs are used in place, so older record layouts cannot be read.
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			( TXT( "Cache::FinalizeTocLoad(): TOC \"%s\" uses an outdated indexed layout (version %" ) PRIu32
+			TXT( ").  The cache will be rebuilt.\n" ) ),
+			*m_tocFileName,
+			version );
+
+		return false;
+	}
+
+	EntryKey key;
+	Entry entry;
+
+	if( version >= TOC_INDEXED_VERSION )
+	{
+		if( !FinalizeIndexedTocLoad( pTocData, pLoadFunction == ReverseByteOrder, pTocCurrent, pTocMax ) )
+		{
+			return false;
+		}
+	}
+	else
+	{
+		// Read the numbers of entries in the cache.
+		uint32_t entryCount;
+		bool bReadResult = CheckedTocRead(
+			pLoadFunction,
+			entryCount,
+			TXT( "the number of entries in the cache" ),
+			pTocCurrent,
+			pTocMax );
+		if( !bReadResult )
+		{
+			return false;
+		}
+
+		uint_fast32_t entryCountFast = entryCount;
+		m_entries.Reserve( entryCountFast );
+		for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
+		{
+			if( !ReadTocEntry( pLoadFunction, version, key, entry, pTocCurrent, pTocMax ) )
+			{
+				return false;
+			}
+
+			EntryMapType::ConstAccessor entryAccessor;
+			if( m_entryMap.Find( entryAccessor, key ) )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					( TXT( "Cache::FinalizeTocLoad(): Duplicate entry found for AssetPath \"%s\", sub-data %" ) PRIu32
+					TXT( ".\n" ) ),
+					*key.path.ToString(),
+					key.subDataIndex );
+
+				return false;
+			}
+
+			Entry* pEntry = m_pEntryPool->Allocate();
+			HELIUM_ASSERT( pEntry );
+			*pEntry = entry;
+
+			m_entries.Add( pEntry );
+
+			HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
+		}
+	}
+
+	// Replay the journal records appended since the TOC was last fully written.  Each record either adds a new entry
+	// or supersedes an earlier record for the same entry.  A truncated record at the end of the file (from an
+	// interrupted write) is discarded along with anything following it.
+	m_journalRecordCount = 0;
+	while( pTocCurrent < pTocMax )
+	{
+		if( !ReadTocEntry( pLoadFunction, version, key, entry, pTocCurrent, pTocMax ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				( TXT( "Cache::FinalizeTocLoad(): Discarding truncated journal record %" ) PRIu32 TXT( " in TOC " )
+				TXT( "\"%s\".\n" ) ),
+				m_journalRecordCount,
+				*m_tocFileName );
+
+			break;
+		}
+
+		++m_journalRecordCount;
+
+		Entry* pEntry = LookupEntry( key.path, key.subDataIndex );
+		if( pEntry )
+		{
+			pEntry->offset = entry.offset;
+			pEntry->timestamp = entry.timestamp;
+			pEntry->size = entry.size;
+			pEntry->storedSize = entry.storedSize;
+			pEntry->codec = entry.codec;
+		}
+		else
+		{
+			pEntry = m_pEntryPool->Allocate();
+			HELIUM_ASSERT( pEntry );
+			*pEntry = entry;
+
+			m_entries.Add( pEntry );
+
+			EntryMapType::Accessor entryAccessor;
+			HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
+		}
+	}
+
+	m_tocFileVersion = version;
+
+	return true;
+}
+
+/// Read a single entry record from the TOC.
+///
+/// @param[in]  pLoadFunction  Function to use for reading values.
+/// @param[in]  version        Cache format version of the TOC.
+/// @param[out] rKey           Key of the entry read.
+/// @param[out] rEntry         Entry information read.
+/// @param[in]  rpTocCurrent   Pointer to the current offset within the TOC file buffer.
+/// @param[in]  pTocMax        Pointer to the end of the TOC file buffer.
+///
+/// @return  True if the record was read successfully, false if not.
+bool Cache::ReadTocEntry(
+						 LOAD_VALUE_CALLBACK* pLoadFunction,
+						 uint32_t version,
+						 EntryKey& rKey,
+						 Entry& rEntry,
+						 const uint8_t*& rpTocCurrent,
+						 const uint8_t* pTocMax )
+{
+	uint16_t entryPathSize;
+	bool bReadResult = CheckedTocRead(
+		pLoadFunction,
+		entryPathSize,
+		TXT( "entry AssetPath string size" ),
+		rpTocCurrent,
+		pTocMax );
+	if( !bReadResult )
+	{
+		return false;
+	}
+
+	uint_fast16_t entryPathSizeFast = entryPathSize;
+
+	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+	StackMemoryHeap<>::Marker stackMarker( rStackHeap );
+	char* pPathString = static_cast< char* >( rStackHeap.Allocate( sizeof( char ) * ( entryPathSizeFast + 1 ) ) );
+	HELIUM_ASSERT( pPathString );
+	pPathString[ entryPathSizeFast ] = TXT( '\0' );
+
+	for( uint_fast16_t characterIndex = 0; characterIndex < entryPathSizeFast; ++characterIndex )
+	{
+		bReadResult = CheckedTocRead(
+			pLoadFunction,
+			pPathString[ characterIndex ],
+			TXT( "entry AssetPath string character" ),
+			rpTocCurrent,
+			pTocMax );
+		if( !bReadResult )
+		{
+			return false;
+		}
+	}
+
+	if( !rEntry.path.Set( pPathString ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::FinalizeTocLoad(): Failed to set AssetPath for entry \"%s\".\n" ),
+			pPathString );
+
+		return false;
+	}
+
+	if( !CheckedTocRead( pLoadFunction, rEntry.subDataIndex, TXT( "entry sub-data index" ), rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
+
+	if( !CheckedTocRead( pLoadFunction, rEntry.offset, TXT( "entry offset" ), rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
+
+	if( !CheckedTocRead( pLoadFunction, rEntry.timestamp, TXT( "entry timestamp" ), rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
+
+	if( !CheckedTocRead( pLoadFunction, rEntry.size, TXT( "entry size" ), rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
+
+	rEntry.storedSize = rEntry.size;
+	rEntry.codec = Compression::CODEC_NONE;
+	if( version >= TOC_COMPRESSION_VERSION )
+	{
+		uint8_t codec;
+		if( !CheckedTocRead( pLoadFunction, rEntry.storedSize, TXT( "entry stored size" ), rpTocCurrent, pTocMax ) ||
+			!CheckedTocRead( pLoadFunction, codec, TXT( "entry codec" ), rpTocCurrent, pTocMax ) )
+		{
+			return false;
+		}
+
+		if( codec >= Compression::CODEC_MAX )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::FinalizeTocLoad(): Invalid codec for entry \"%s\".\n" ),
+				pPathString );
+
+			return false;
+		}
+
+		rEntry.codec = static_cast< Compression::ECodec >( codec );
+	}
+
+	rKey.path = rEntry.path;
+	rKey.subDataIndex = rEntry.subDataIndex;
+
+	return true;
+}
+
+/// Set up the TOC index for a TOC using the indexed layout.
+///
+/// @param[in] pTocData      TOC file contents.
+/// @param[in] bSwapBytes    True if the TOC was written in the opposite byte order of the current platform.
+/// @param[in] rpTocCurrent  Pointer to the current offset within the TOC data (just past the version number), updated
+///                          to point past the index on success.
+/// @param[in] pTocMax       Pointer to the end of the TOC data.
+///
+/// @return  True if the TOC index was set up successfully, false if not.
+bool Cache::FinalizeIndexedTocLoad(
+								   const uint8_t* pTocData,
+								   bool bSwapBytes,
+								   const uint8_t*& rpTocCurrent,
+								   const uint8_t* pTocMax )
+{
+	LOAD_VALUE_CALLBACK* pLoadFunction = ( bSwapBytes ? ReverseByteOrder : MemoryCopy );
+
+	uint32_t recordCount;
+	uint32_t bucketCount;
+	uint32_t stringTableSize;
+	uint32_t padding;
+	if( !CheckedTocRead( pLoadFunction, recordCount, TXT( "the number of entries in the cache" ), rpTocCurrent, pTocMax ) ||
+		!CheckedTocRead( pLoadFunction, bucketCount, TXT( "the number of hash table buckets" ), rpTocCurrent, pTocMax ) ||
+		!CheckedTocRead( pLoadFunction, stringTableSize, TXT( "the string table size" ), rpTocCurrent, pTocMax ) ||
+		!CheckedTocRead( pLoadFunction, padding, TXT( "the header padding" ), rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
+
+	HELIUM_ASSERT( rpTocCurrent == pTocData + TOC_INDEX_HEADER_SIZE );
+
+	if( bucketCount < TOC_MIN_BUCKET_COUNT || ( bucketCount & ( bucketCount - 1 ) ) != 0 || bucketCount <= recordCount )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::FinalizeTocLoad(): Invalid hash table bucket count (%" ) PRIu32 TXT( ") in TOC \"%s\".\n" ),
+			bucketCount,
+			*m_tocFileName );
+
+		return false;
+	}
+
+	uint64_t indexSize =
+		static_cast< uint64_t >( recordCount ) * sizeof( TocRecord ) +
+		static_cast< uint64_t >( bucketCount ) * sizeof( uint32_t ) +
+		stringTableSize;
+	if( indexSize > static_cast< uint64_t >( pTocMax - rpTocCurrent ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::FinalizeTocLoad(): Not enough bytes in TOC \"%s\" for the entry index.\n" ),
+			*m_tocFileName );
+
+		return false;
+	}
+
+	if( bSwapBytes )
+	{
+		// Indexed TOCs are used in place, so they can only be byte swapped when loaded into our own buffer.
+		if( pTocData != m_pTocBuffer )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::FinalizeTocLoad(): Byte-swapped TOC \"%s\" cannot be used in place.\n" ),
+				*m_tocFileName );
+
+			return false;
+		}
+
+		TocRecord* pRecords = reinterpret_cast< TocRecord* >( m_pTocBuffer + TOC_INDEX_HEADER_SIZE );
+		for( uint32_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+		{
+			TocRecord& rRecord = pRecords[ recordIndex ];
+			SwapTocValue( rRecord.pathHash );
+			SwapTocValue( rRecord.offset );
+			SwapTocValue( rRecord.timestamp );
+			SwapTocValue( rRecord.subDataIndex );
+			SwapTocValue( rRecord.size );
+			SwapTocValue( rRecord.storedSize );
+			SwapTocValue( rRecord.codec );
+			SwapTocValue( rRecord.pathOffset );
+			SwapTocValue( rRecord.pathSize );
+		}
+
+		uint32_t* pBuckets = reinterpret_cast< uint32_t* >( pRecords + recordCount );
+		for( uint32_t bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex )
+		{
+			SwapTocValue( pBuckets[ bucketIndex ] );
+		}
+	}
+
+	const TocRecord* pRecords = reinterpret_cast< const TocRecord* >( rpTocCurrent );
+	const uint32_t* pBuckets = reinterpret_cast< const uint32_t* >( pRecords + recordCount );
+	const char* pStrings = reinterpret_cast< const char* >( pBuckets + bucketCount );
+
+	// Validate the index once up front so that lookups do not need to.
+	for( uint32_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		const TocRecord& rRecord = pRecords[ recordIndex ];
+		if( static_cast< uint64_t >( rRecord.pathOffset ) + rRecord.pathSize > stringTableSize ||
+			rRecord.pathSize >= UINT16_MAX )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::FinalizeTocLoad(): Invalid path string for entry %" ) PRIu32 TXT( " in TOC \"%s\".\n" ),
+				recordIndex,
+				*m_tocFileName );
+
+			return false;
+		}
+
+		if( rRecord.codec >= static_cast< uint32_t >( Compression::CODEC_MAX ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::FinalizeTocLoad(): Invalid codec for entry %" ) PRIu32 TXT( " in TOC \"%s\".\n" ),
+				recordIndex,
+				*m_tocFileName );
+
+			return false;
+		}
+	}
+
+	for( uint32_t bucketIndex = 0; bucketIndex < bucketCount; ++bucketIndex )
+	{
+		if( pBuckets[ bucketIndex ] > recordCount )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::FinalizeTocLoad(): Invalid hash table bucket %" ) PRIu32 TXT( " in TOC \"%s\".\n" ),
+				bucketIndex,
+				*m_tocFileName );
+
+			return false;
+		}
+	}
+
+	m_pTocIndexData = pTocData;
+	m_pTocRecords = pRecords;
+	m_pTocBuckets = pBuckets;
+	m_pTocStrings = pStrings;
+	m_tocRecordCount = recordCount;
+	m_tocBucketMask = bucketCount - 1;
+
+	// Entries are only created for records as they are accessed.
+	m_entries.Resize( recordCount );
+	MemoryZero( m_entries.GetData(), recordCount * sizeof( Entry* ) );
+
+	rpTocCurrent += indexSize;
+
+	return true;
+}
+
+/// Memory-map the TOC file and use it in place, if it uses the indexed layout in the native byte order.
+///
+/// @return  True if the TOC was mapped and loaded (successfully or not), false if it should be loaded through the
+///          AsyncLoader instead.
+bool Cache::MapToc()
+{
+#if HELIUM_OS_LINUX
+	if( m_tocSize < TOC_INDEX_HEADER_SIZE )
+	{
+		return false;
+	}
+
+	int fileDescriptor = open( *m_tocFileName, O_RDONLY );
+	if( fileDescriptor == -1 )
+	{
+		return false;
+	}
+
+	void* pData = mmap( NULL, m_tocSize, PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+	close( fileDescriptor );
+	if( pData == MAP_FAILED )
+	{
+		return false;
+	}
+
+	// Legacy and byte-swapped TOCs need to be parsed or modified, so leave them to the regular loading path.
+	const uint32_t* pHeader = static_cast< const uint32_t* >( pData );
+	if( pHeader[ 0 ] != TOC_MAGIC || pHeader[ 1 ] < TOC_INDEXED_VERSION )
+	{
+		munmap( pData, m_tocSize );
+
+		return false;
+	}
+
+	HELIUM_TRACE( TraceLevels::Info, TXT( "Cache::MapToc(): Mapped TOC file \"%s\".\n" ), *m_tocFileName );
+
+	m_tocMappedSize = m_tocSize;
+	if( !FinalizeTocLoad( static_cast< const uint8_t* >( pData ) ) )
+	{
+		ClearEntries();
+	}
+
+	if( m_pTocIndexData != pData )
+	{
+		munmap( pData, m_tocSize );
+		m_tocMappedSize = 0;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+/// Release the TOC index data.
+///
+/// All entries for indexed TOC records must either have been created or be discarded along with the index.
+void Cache::ReleaseTocIndex()
+{
+	if( m_pTocIndexData )
+	{
+		if( m_tocMappedSize != 0 )
+		{
+#if HELIUM_OS_LINUX
+			munmap( const_cast< uint8_t* >( m_pTocIndexData ), m_tocMappedSize );
+#endif
+		}
+		else
+		{
+			DefaultAllocator().Free( const_cast< uint8_t* >( m_pTocIndexData ) );
+		}
+	}
+
+	m_pTocIndexData = NULL;
+	m_tocMappedSize = 0;
+	m_pTocRecords = NULL;
+	m_pTocBuckets = NULL;
+	m_pTocStrings = NULL;
+	m_tocRecordCount = 0;
+	m_tocBucketMask = 0;
+}
+
+/// Release all cache entries and the TOC index.
+void Cache::ClearEntries()
+{
+	HELIUM_ASSERT( m_pEntryPool );
+
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
 	{
-		return false;
+		Entry* pEntry = m_entries[ entryIndex ];
+		if( pEntry )
+		{
+			m_pEntryPool->Release( pEntry );
+		}
 	}
 
-	// Load the entry information.
+	m_entries.Clear();
+	m_entryMap.Clear();
+	m_journalRecordCount = 0;
+	SetInvalid( m_tocFileVersion );
+
+	ReleaseTocIndex();
+}
+
+/// Find the entry with the given path and sub-data index, creating it from its indexed TOC record if necessary.
+///
+/// @param[in] path          Asset path.
+/// @param[in] subDataIndex  Sub-data index associated with the cached data.
+///
+/// @return  Cache entry if found, null if not.
+Cache::Entry* Cache::LookupEntry( AssetPath path, uint32_t subDataIndex ) const
+{
 	EntryKey key;
+	key.path = path;
+	key.subDataIndex = subDataIndex;
 
-	uint_fast32_t entryCountFast = entryCount;
-	m_entries.Reserve( entryCountFast );
-	for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
+	EntryMapType::ConstAccessor mapAccessor;
+	if( m_entryMap.Find( mapAccessor, key ) )
 	{
-		uint16_t entryPathSize;
-		bReadResult = CheckedTocRead(
-			pLoadFunction,
-			entryPathSize,
-			TXT( "entry AssetPath string size" ),
-			pTocCurrent,
-			pTocMax );
-		if( !bReadResult )
+		Entry* pEntry = mapAccessor->Second();
+		HELIUM_ASSERT( pEntry );
+
+		return pEntry;
+	}
+
+	if( !m_pTocRecords )
+	{
+		return NULL;
+	}
+
+	String pathString;
+	path.ToString( pathString );
+	size_t pathSize = pathString.GetSize();
+	uint64_t pathHash = ComputeTocPathHash( *pathString, pathSize );
+
+	// The hash table is never more than half full, so probing always ends at an empty bucket.
+	uint32_t bucketIndex = GetTocBucketIndex( pathHash, subDataIndex, m_tocBucketMask );
+	for( ; ; )
+	{
+		uint32_t recordSlot = m_pTocBuckets[ bucketIndex ];
+		if( recordSlot == 0 )
 		{
-			return false;
+			return NULL;
+		}
+
+		const TocRecord& rRecord = m_pTocRecords[ recordSlot - 1 ];
+		if( rRecord.pathHash == pathHash &&
+			rRecord.subDataIndex == subDataIndex &&
+			rRecord.pathSize == pathSize &&
+			MemoryCompare( m_pTocStrings + rRecord.pathOffset, *pathString, pathSize ) == 0 )
+		{
+			return MaterializeEntry( recordSlot - 1 );
 		}
 
-		uint_fast16_t entryPathSizeFast = entryPathSize;
+		bucketIndex = ( bucketIndex + 1 ) & m_tocBucketMask;
+	}
+}
+
+/// Get the entry for an indexed TOC record, creating it (and decoding its path) if it has not been accessed yet.
+///
+/// @param[in] recordIndex  Indexed TOC record index.
+///
+/// @return  Cache entry, or null if the entry path could not be decoded.
+Cache::Entry* Cache::MaterializeEntry( uint32_t recordIndex ) const
+{
+	HELIUM_ASSERT( recordIndex < m_tocRecordCount );
+	HELIUM_ASSERT( m_pEntryPool );
+
+	MutexScopeLock scopeLock( m_entryLock );
+
+	Entry* pEntry = m_entries[ recordIndex ];
+	if( pEntry )
+	{
+		return pEntry;
+	}
+
+	const TocRecord& rRecord = m_pTocRecords[ recordIndex ];
+
+	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+	StackMemoryHeap<>::Marker stackMarker( rStackHeap );
+	char* pPathString = static_cast< char* >( rStackHeap.Allocate( sizeof( char ) * ( rRecord.pathSize + 1 ) ) );
+	HELIUM_ASSERT( pPathString );
+	MemoryCopy( pPathString, m_pTocStrings + rRecord.pathOffset, rRecord.pathSize );
+	pPathString[ rRecord.pathSize ] = TXT( '\0' );
+
+	AssetPath path;
+	if( !path.Set( pPathString ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache: Failed to set AssetPath \"%s\" for entry %" ) PRIu32 TXT( " in TOC \"%s\".\n" ),
+			pPathString,
+			recordIndex,
+			*m_tocFileName );
+
+		return NULL;
+	}
+
+	pEntry = m_pEntryPool->Allocate();
+	HELIUM_ASSERT( pEntry );
+	pEntry->offset = rRecord.offset;
+	pEntry->timestamp = rRecord.timestamp;
+	pEntry->path = path;
+	pEntry->subDataIndex = rRecord.subDataIndex;
+	pEntry->size = rRecord.size;
+	pEntry->storedSize = rRecord.storedSize;
+	pEntry->codec = static_cast< Compression::ECodec >( rRecord.codec );
+
+	EntryKey key;
+	key.path = path;
+	key.subDataIndex = rRecord.subDataIndex;
+
+	EntryMapType::Accessor entryAccessor;
+	HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
+
+	m_entries[ recordIndex ] = pEntry;
 
-		StackMemoryHeap<>::Marker stackMarker( rStackHeap );
-		char* pPathString = static_cast< char* >( rStackHeap.Allocate(
-			sizeof( char ) * ( entryPathSizeFast + 1 ) ) );
-		HELIUM_ASSERT( pPathString );
-		pPathString[ entryPathSizeFast ] = TXT( '\0' );
+	return pEntry;
+}
 
-		for( uint_fast16_t characterIndex = 0; characterIndex < entryPathSizeFast; ++characterIndex )
+/// Create entries for all indexed TOC records that have not been accessed yet.
+///
+/// @return  True if all entries are available, false if any entry paths could not be decoded.
+bool Cache::MaterializeAllEntries()
+{
+	bool bResult = true;
+	for( uint32_t recordIndex = 0; recordIndex < m_tocRecordCount; ++recordIndex )
+	{
+		if( !m_entries[ recordIndex ] && !MaterializeEntry( recordIndex ) )
 		{
-			bReadResult = CheckedTocRead(
-				pLoadFunction,
-				pPathString[ characterIndex ],
-				TXT( "entry AssetPath string character" ),
-				pTocCurrent,
-				pTocMax );
-			if( !bReadResult )
-			{
-				return false;
-			}
+			bResult = false;
 		}
+	}
 
-		AssetPath entryPath;
-		if( !entryPath.Set( pPathString ) )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				TXT( "Cache::FinalizeTocLoad(): Failed to set AssetPath for entry %" ) PRIuFAST16 TXT( ".\n" ),
-				entryIndex );
+	return bResult;
+}
 
-			return false;
+/// Write out the full TOC in the indexed layout, with no journal records.
+///
+/// The indexed layout consists of a header, an array of fixed-size TocRecord structures, an open-addressing hash table
+/// of record indices keyed on the path hash and sub-data index, and a string table holding the entry paths.  This is
+/// written in the native byte order so that it can be used in place once loaded or mapped.
+///
+/// The TOC is written to a temporary file that only replaces the given file once it has been written in full, so an
+/// existing TOC (which may be memory-mapped) is never modified in place.  Entries are created for all indexed TOC
+/// records beforehand, after which the TOC index is released.
+///
+/// @param[in] rTocFileName  Name of the TOC file to write.
+///
+/// @return  True if the TOC was written successfully, false if not.
+bool Cache::WriteToc( const String& rTocFileName )
+{
+	HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Writing TOC file \"%s\".\n" ), *rTocFileName );
+
+	if( !MaterializeAllEntries() )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to read all entries for TOC \"%s\".\n" ), *rTocFileName );
+
+		return false;
+	}
+
+	// Every record now has an entry, so the index (and any mapping of the TOC file) is no longer needed.
+	ReleaseTocIndex();
+
+	// Build the records and string table.
+	uint32_t recordCount = static_cast< uint32_t >( m_entries.GetSize() );
+
+	DynamicArray< TocRecord > records;
+	DynamicArray< char > strings;
+	records.Reserve( recordCount );
+
+	String entryPath;
+	for( uint32_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		const Entry* pEntry = m_entries[ recordIndex ];
+		HELIUM_ASSERT( pEntry );
+
+		pEntry->path.ToString( entryPath );
+		size_t pathSize = entryPath.GetSize();
+
+		TocRecord record;
+		record.pathHash = ComputeTocPathHash( *entryPath, pathSize );
+		record.offset = pEntry->offset;
+		record.timestamp = pEntry->timestamp;
+		record.subDataIndex = pEntry->subDataIndex;
+		record.size = pEntry->size;
+		record.storedSize = pEntry->storedSize;
+		record.codec = static_cast< uint32_t >( pEntry->codec );
+		record.pathOffset = static_cast< uint32_t >( strings.GetSize() );
+		record.pathSize = static_cast< uint32_t >( pathSize );
+		records.Push( record );
+
+		strings.AddArray( *entryPath, pathSize );
+	}
+
+	// Build the hash table, keeping it at most half full.
+	uint32_t bucketCount = TOC_MIN_BUCKET_COUNT;
+	while( bucketCount < recordCount * 2 )
+	{
+		bucketCount *= 2;
+	}
+
+	uint32_t bucketMask = bucketCount - 1;
+
+	DynamicArray< uint32_t > buckets;
+	buckets.Resize( bucketCount );
+	MemoryZero( buckets.GetData(), bucketCount * sizeof( uint32_t ) );
+	for( uint32_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		const TocRecord& rRecord = records[ recordIndex ];
+		uint32_t bucketIndex = GetTocBucketIndex( rRecord.pathHash, rRecord.subDataIndex, bucketMask );
+		while( buckets[ bucketIndex ] != 0 )
+		{
+			bucketIndex = ( bucketIndex + 1 ) & bucketMask;
 		}
 
-		uint32_t entrySubDataIndex;
-		bReadResult = CheckedTocRead(
-			pLoadFunction,
-			entrySubDataIndex,
-			TXT( "entry sub-data index" ),
-			pTocCurrent,
-			pTocMax );
-		if( !bReadResult )
+		buckets[ bucketIndex ] = recordIndex + 1;
+	}
+
+	String tempTocFileName( rTocFileName );
+	tempTocFileName += TOC_TEMP_FILE_SUFFIX;
+
+	FileStream* pTocStream = FileStream::OpenFileStream( tempTocFileName, FileStream::MODE_WRITE, true );
+	if( !pTocStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *tempTocFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	uint32_t stringTableSize = static_cast< uint32_t >( strings.GetSize() );
+	uint32_t padding = 0;
+
+	bool bSuccess =
+		pBufferedStream->Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 ) == 1 &&
+		pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 ) == 1 &&
+		pBufferedStream->Write( &recordCount, sizeof( recordCount ), 1 ) == 1 &&
+		pBufferedStream->Write( &bucketCount, sizeof( bucketCount ), 1 ) == 1 &&
+		pBufferedStream->Write( &stringTableSize, sizeof( stringTableSize ), 1 ) == 1 &&
+		pBufferedStream->Write( &padding, sizeof( padding ), 1 ) == 1 &&
+		pBufferedStream->Write( records.GetData(), sizeof( TocRecord ), recordCount ) == recordCount &&
+		pBufferedStream->Write( buckets.GetData(), sizeof( uint32_t ), bucketCount ) == bucketCount &&
+		pBufferedStream->Write( strings.GetData(), sizeof( char ), stringTableSize ) == stringTableSize;
+
+	delete pBufferedStream;
+	delete pTocStream;
+
+	// Buffered data is only flushed once the stream is closed, so make sure all of it actually reached the file.
+	if( bSuccess )
+	{
+		int64_t expectedSize = static_cast< int64_t >(
+			TOC_INDEX_HEADER_SIZE +
+			sizeof( TocRecord ) * recordCount +
+			sizeof( uint32_t ) * bucketCount +
+			stringTableSize );
+
+		Status status;
+		bSuccess = ( status.Read( tempTocFileName.GetData() ) && status.m_Size == expectedSize );
+	}
+
+	if( !bSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to write TOC \"%s\".\n" ), *tempTocFileName );
+	}
+	else
+	{
+		bSuccess = ReplaceExistingFile( tempTocFileName, rTocFileName );
+	}
+
+	if( !bSuccess )
+	{
+		FilePath( tempTocFileName.GetData() ).Delete();
+
+		return false;
+	}
+
+	m_journalRecordCount = 0;
+
+	return true;
+}
+
+/// Record an added or updated entry in the TOC file by appending a journal record to it.
+///
+/// If the TOC file does not exist yet or uses an older format version, the full TOC is written instead.
+///
+/// @param[in] rEntry  Entry to record.
+///
+/// @return  True if the TOC was updated successfully, false if not.
+bool Cache::AppendTocRecord( const Entry& rEntry )
+{
+	// Journal records must use the same format version as the rest of the TOC file, so rewrite the entire TOC if it
+	// does not exist yet or was written by an older version.
+	Status status;
+	status.Read( m_tocFileName.GetData() );
+	if( status.m_Size <= 0 || m_tocFileVersion != sm_Version )
+	{
+		if( !WriteToc( m_tocFileName ) )
 		{
 			return false;
 		}
 
-		key.path = entryPath;
-		key.subDataIndex = entrySubDataIndex;
+		m_tocFileVersion = sm_Version;
+
+		return true;
+	}
+
+	FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, false );
+	if( !pTocStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
+
+		return false;
+	}
+
+	bool bResult = ( pTocStream->Seek( 0, SeekOrigins::End ) == status.m_Size );
+	if( !bResult )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: TOC file \"%s\" offset seek failed.\n" ), *m_tocFileName );
+	}
+	else
+	{
+		BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
+		HELIUM_ASSERT( pBufferedStream );
+
+		String entryPath;
+		WriteTocEntry( *pBufferedStream, rEntry, entryPath );
+
+		delete pBufferedStream;
+
+		++m_journalRecordCount;
+	}
+
+	delete pTocStream;
+
+	return bResult;
+}
+
+/// Write the data for all live entries contiguously to a new cache file.
+///
+/// @param[in]  rCacheFileName  Name of the cache file to write.
+/// @param[out] rOffsets        Offset of each entry (in entry index order) within the new cache file.
+///
+/// @return  True if the cache file was written successfully, false if not.
+bool Cache::WriteCompactedCacheFile( const String& rCacheFileName, DynamicArray< uint64_t >& rOffsets )
+{
+	FileStream* pSourceStream = FileStream::OpenFileStream( m_cacheFileName, FileStream::MODE_READ );
+	if( !pSourceStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open cache \"%s\" for reading.\n" ), *m_cacheFileName );
+
+		return false;
+	}
+
+	FileStream* pDestinationStream = FileStream::OpenFileStream( rCacheFileName, FileStream::MODE_WRITE, true );
+	if( !pDestinationStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open cache \"%s\" for writing.\n" ), *rCacheFileName );
+		delete pSourceStream;
+
+		return false;
+	}
+
+	bool bResult = true;
+
+	DynamicArray< uint8_t > entryData;
+	uint64_t offset = 0;
+
+	size_t entryCount = m_entries.GetSize();
+	rOffsets.Reserve( entryCount );
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		const Entry* pEntry = m_entries[ entryIndex ];
+		HELIUM_ASSERT( pEntry );
+
+		entryData.Resize( pEntry->storedSize );
 
-		EntryMapType::ConstAccessor entryAccessor;
-		if( m_entryMap.Find( entryAccessor, key ) )
+		int64_t seekOffset = pSourceStream->Seek( static_cast< int64_t >( pEntry->offset ), SeekOrigins::Begin );
+		if( static_cast< uint64_t >( seekOffset ) != pEntry->offset ||
+			pSourceStream->Read( entryData.GetData(), 1, pEntry->storedSize ) != pEntry->storedSize )
 		{
 			HELIUM_TRACE(
 				TraceLevels::Error,
-				( TXT( "Cache::FinalizeTocLoad(): Duplicate entry found for AssetPath \"%s\", sub-data %" ) PRIu32
-				TXT( ".\n" ) ),
-				pPathString,
-				entrySubDataIndex );
+				( TXT( "Cache: Failed to read %" ) PRIu32 TXT( " bytes for \"%s\" from cache \"%s\" at offset %" )
+				PRIu64 TXT( ".\n" ) ),
+				pEntry->storedSize,
+				*pEntry->path.ToString(),
+				*m_cacheFileName,
+				pEntry->offset );
 
-			return false;
+			bResult = false;
+
+			break;
 		}
 
-		uint64_t entryOffset;
-		if( !CheckedTocRead( pLoadFunction, entryOffset, TXT( "entry offset" ), pTocCurrent, pTocMax ) )
+		if( pDestinationStream->Write( entryData.GetData(), 1, pEntry->storedSize ) != pEntry->storedSize )
 		{
-			return false;
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache: Failed to write %" ) PRIu32 TXT( " bytes to cache \"%s\".\n" ),
+				pEntry->storedSize,
+				*rCacheFileName );
+
+			bResult = false;
+
+			break;
 		}
 
-		int64_t entryTimestamp;
-		if( !CheckedTocRead( pLoadFunction, entryTimestamp, TXT( "entry timestamp" ), pTocCurrent, pTocMax ) )
+		rOffsets.Push( offset );
+		offset += pEntry->storedSize;
+	}
+
+	delete pDestinationStream;
+	delete pSourceStream;
+
+	return bResult;
+}
+
+/// Map the current contents of the cache file into memory, replacing the current view (if any) if the file has grown.
+///
+/// The caller must hold the mapped view lock.
+///
+/// @param[in] bForceRemap  True to always replace the current view (i.e. after the cache file has been replaced).
+///
+/// @return  True if the cache file was mapped successfully, false if not.
+bool Cache::MapCacheFile( bool bForceRemap )
+{
+#if HELIUM_OS_LINUX
+	int fileDescriptor = open( *m_cacheFileName, O_RDONLY );
+	if( fileDescriptor == -1 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::MapCacheFile(): Failed to open cache file \"%s\".\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	bool bResult = false;
+
+	struct stat fileStatus;
+	if( fstat( fileDescriptor, &fileStatus ) == 0 && fileStatus.st_size > 0 )
+	{
+		size_t fileSize = static_cast< size_t >( fileStatus.st_size );
+		if( !bForceRemap && !m_mappedViews.IsEmpty() && fileSize <= m_mappedViews.GetLast().size )
 		{
-			return false;
+			// The file has not grown, so the current view already covers all of it.
+			close( fileDescriptor );
+
+			return true;
 		}
 
-		uint32_t entrySize;
-		if( !CheckedTocRead( pLoadFunction, entrySize, TXT( "entry size" ), pTocCurrent, pTocMax ) )
+		void* pData = mmap( NULL, fileSize, PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+		if( pData != MAP_FAILED )
 		{
-			return false;
+			MappedView view;
+			view.pData = static_cast< const uint8_t* >( pData );
+			view.size = fileSize;
+			m_mappedViews.Push( view );
+
+			bResult = true;
+		}
+		else
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::MapCacheFile(): Failed to map %" ) PRIuSZ TXT( " bytes of cache file \"%s\".\n" ),
+				fileSize,
+				*m_cacheFileName );
 		}
+	}
 
-		Entry* pEntry = m_pEntryPool->Allocate();
-		HELIUM_ASSERT( pEntry );
-		pEntry->path = entryPath;
-		pEntry->subDataIndex = entrySubDataIndex;
-		pEntry->offset = entryOffset;
-		pEntry->timestamp = entryTimestamp;
-		pEntry->size = entrySize;
+	// The mapping remains valid after the file descriptor has been closed.
+	close( fileDescriptor );
+
+	return bResult;
+#else
+	return false;
+#endif
+}
 
-		m_entries.Add( pEntry );
+/// Release all memory-mapped views of the cache file.
+void Cache::UnmapCacheFile()
+{
+	MutexScopeLock scopeLock( m_mappedViewLock );
 
-		HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
+#if HELIUM_OS_LINUX
+	size_t viewCount = m_mappedViews.GetSize();
+	for( size_t viewIndex = 0; viewIndex < viewCount; ++viewIndex )
+	{
+		const MappedView& rView = m_mappedViews[ viewIndex ];
+		munmap( const_cast< uint8_t* >( rView.pData ), rView.size );
 	}
+#endif
 
-	return true;
+	m_mappedViews.Clear();
 }
 
 /// Read a value from the cache TOC, check the TOC bounds in the process.
@@ -766,6 +2189,56 @@ bool Cache::CheckedTocRead(
 	return true;
 }
 
+/// Write a single entry record to a TOC stream.
+///
+/// @param[in] rStream      Stream to which the record should be written.
+/// @param[in] rEntry       Entry to write.
+/// @param[in] rPathBuffer  Scratch string buffer for the entry path.
+void Cache::WriteTocEntry( Stream& rStream, const Entry& rEntry, String& rPathBuffer )
+{
+	rEntry.path.ToString( rPathBuffer );
+	HELIUM_ASSERT( rPathBuffer.GetSize() < UINT16_MAX );
+	uint16_t pathSize = static_cast< uint16_t >( rPathBuffer.GetSize() );
+	rStream.Write( &pathSize, sizeof( pathSize ), 1 );
+
+	rStream.Write( *rPathBuffer, sizeof( char ), pathSize );
+
+	rStream.Write( &rEntry.subDataIndex, sizeof( rEntry.subDataIndex ), 1 );
+
+	rStream.Write( &rEntry.offset, sizeof( rEntry.offset ), 1 );
+	rStream.Write( &rEntry.timestamp, sizeof( rEntry.timestamp ), 1 );
+	rStream.Write( &rEntry.size, sizeof( rEntry.size ), 1 );
+
+	uint8_t codec = static_cast< uint8_t >( rEntry.codec );
+	rStream.Write( &rEntry.storedSize, sizeof( rEntry.storedSize ), 1 );
+	rStream.Write( &codec, sizeof( codec ), 1 );
+}
+
+/// Replace a file with another, removing the source file.
+///
+/// @param[in] rSourceFileName       Name of the file to move.
+/// @param[in] rDestinationFileName  Name of the file to replace.
+///
+/// @return  True if the file was replaced successfully, false if not.
+bool Cache::ReplaceExistingFile( const String& rSourceFileName, const String& rDestinationFileName )
+{
+#if HELIUM_OS_WIN
+	bool bResult = ( MoveFileExA( *rSourceFileName, *rDestinationFileName, MOVEFILE_REPLACE_EXISTING ) != FALSE );
+#else
+	bool bResult = ( rename( *rSourceFileName, *rDestinationFileName ) == 0 );
+#endif
+	if( !bResult )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache: Failed to replace \"%s\" with \"%s\".\n" ),
+			*rDestinationFileName,
+			*rSourceFileName );
+	}
+
+	return bResult;
+}
+
 /// Equality comparison.
 ///
 /// @param[in] rOther  Entry key with which to compare.
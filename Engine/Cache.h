@@ -3,13 +3,19 @@
 #include "Engine/Engine.h"
 #include "Reflect/Translator.h"
 
+#include "Platform/Locks.h"
+
 #include "Foundation/ConcurrentHashMap.h"
 #include "Foundation/ObjectPool.h"
 #include "Engine/AssetPath.h"
+#include "Engine/AsyncLoader.h"
+#include "Engine/Compression.h"
 #include "Reflect/Object.h"
 
 namespace Helium
 {
+	class Stream;
+
 	/// Serialization cache interface.
 	class HELIUM_ENGINE_API Cache : NonCopyable
 	{
@@ -33,13 +39,29 @@ namespace Helium
 			PLATFORM_LAST = PLATFORM_MAX - 1
 		};
 
+		/// Cache data read modes.
+		enum EReadMode
+		{
+			READ_MODE_FIRST   =  0,
+			READ_MODE_INVALID = -1,
+
+			/// Entry data is read into heap buffers using the AsyncLoader.
+			READ_MODE_ASYNC,
+			/// The cache file is memory-mapped and entry data is accessed in place.
+			READ_MODE_MAPPED,
+
+			READ_MODE_MAX,
+			READ_MODE_LAST = READ_MODE_MAX - 1
+		};
+
 		/// Cache entry information.  Note that the members of this struct are organized as such so as to reduce memory
 		/// overhead from padding each value.
 		struct Entry
 		{
 			/// Entry offset.
 			uint64_t offset;
-			/// Entry timestamp.
+			/// Entry timestamp (an opaque value compared to test whether the entry is up-to-date, such as a hash of
+			/// the inputs from which the entry was built).
 			int64_t timestamp;
 
 			/// Entry path name.
@@ -47,8 +69,28 @@ namespace Helium
 			/// Sub-data index.
 			uint32_t subDataIndex;
 
-			/// Entry size.
+			/// Entry size (uncompressed).
 			uint32_t size;
+			/// Size of the entry data as stored in the cache file.
+			uint32_t storedSize;
+			/// Codec with which the entry data is compressed in the cache file.
+			Compression::ECodec codec;
+		};
+
+		/// Cache file usage statistics.
+		struct Stats
+		{
+			/// Size of the cache file, in bytes.
+			uint64_t cacheFileSize;
+			/// Number of bytes in the cache file referenced by live entries.
+			uint64_t liveBytes;
+			/// Number of bytes in the cache file no longer referenced by any entry (reclaimed by Compact()).
+			uint64_t orphanedBytes;
+
+			/// Number of live entries.
+			uint32_t entryCount;
+			/// Number of journal records appended to the TOC since it was last fully written.
+			uint32_t journalRecordCount;
 		};
 
 		/// @name Construction/Destruction
@@ -59,7 +101,9 @@ namespace Helium
 
 		/// @name Initialization
 		//@{
-		bool Initialize( Name name, EPlatform platform, const char* pTocFileName, const char* pCacheFileName );
+		bool Initialize(
+			Name name, EPlatform platform, const char* pTocFileName, const char* pCacheFileName,
+			EReadMode readMode = READ_MODE_ASYNC );
 		void Shutdown();
 		//@}
 
@@ -76,15 +120,37 @@ namespace Helium
 		//@{
 		inline Name GetName() const;
 		inline EPlatform GetPlatform() const;
+		inline EReadMode GetReadMode() const;
 
 		inline const String& GetTocFileName() const;
 		inline const String& GetCacheFileName() const;
 
 		inline uint32_t GetEntryCount() const;
-		inline const Entry& GetEntry( uint32_t index ) const;
+		const Entry& GetEntry( uint32_t index ) const;
 		const Entry* FindEntry( AssetPath path, uint32_t subDataIndex ) const;
+		const uint8_t* GetMappedEntryData( const Entry& rEntry );
+
+		size_t BeginReadEntry(
+			const Entry& rEntry, void* pBuffer, size_t loadSizeMax = Invalid< size_t >(),
+			AsyncLoader::CompletionQueue* pCompletionQueue = NULL, size_t completionCookie = 0 ) const;
+		size_t ReadEntry( const Entry& rEntry, void* pBuffer, size_t loadSizeMax = Invalid< size_t >() ) const;
 
-		bool CacheEntry( AssetPath path, uint32_t subDataIndex, const void* pData, int64_t timestamp, uint32_t size );
+		bool CacheEntry(
+			AssetPath path, uint32_t subDataIndex, const void* pData, int64_t timestamp, uint32_t size,
+			Compression::ECodec codec = Compression::CODEC_NONE );
+		//@}
+
+		/// @name Batched Writing
+		//@{
+		void BeginBatchWrites();
+		bool EndBatchWrites();
+		inline bool IsBatchingWrites() const;
+		//@}
+
+		/// @name Maintenance
+		//@{
+		void GetStats( Stats& rStats ) const;
+		bool Compact();
 		//@}
 
 #if HELIUM_TOOLS
@@ -124,10 +190,54 @@ namespace Helium
 		/// Cache entry hash map type.
 		typedef ConcurrentHashMap< EntryKey, Entry*, EntryKeyHash > EntryMapType;
 
+		/// Fixed-size entry record in an indexed TOC.  Records are used in place from the TOC data, and are only
+		/// converted to Entry instances (decoding the path string) when first looked up.
+		struct TocRecord
+		{
+			/// Hash of the entry path string.
+			uint64_t pathHash;
+			/// Entry offset.
+			uint64_t offset;
+			/// Entry timestamp.
+			int64_t timestamp;
+			/// Sub-data index.
+			uint32_t subDataIndex;
+			/// Entry size (uncompressed).
+			uint32_t size;
+			/// Size of the entry data as stored in the cache file.
+			uint32_t storedSize;
+			/// Codec with which the entry data is compressed in the cache file.
+			uint32_t codec;
+			/// Offset of the entry path string within the TOC string table.
+			uint32_t pathOffset;
+			/// Length of the entry path string.
+			uint32_t pathSize;
+		};
+
+		/// Entry data waiting to be written to the cache file while batching writes.
+		struct PendingWrite
+		{
+			/// Cache file offset at which to write the data.
+			uint64_t offset;
+			/// Data to write (as stored in the cache file).
+			DynamicArray< uint8_t > data;
+		};
+
+		/// Memory-mapped view of the cache file.
+		struct MappedView
+		{
+			/// Start of the mapped data.
+			const uint8_t* pData;
+			/// Size of the mapped data, in bytes.
+			size_t size;
+		};
+
 		/// Cache name.
 		Name m_name;
 		/// Cache platform.
 		EPlatform m_platform;
+		/// Cache data read mode.
+		EReadMode m_readMode;
 
 		/// Table of contents file name.
 		String m_tocFileName;
@@ -147,14 +257,70 @@ namespace Helium
 
 		/// Cache entry pool.
 		ObjectPool< Entry >* m_pEntryPool;
-		/// Cache entry information.
-		DynamicArray< Entry* > m_entries;
-		/// Entry lookup hash map.
-		EntryMapType m_entryMap;
+		/// Cache entry information (entries for indexed TOC records are null until first accessed).
+		mutable DynamicArray< Entry* > m_entries;
+		/// Entry lookup hash map (only contains entries that have been accessed or added since the TOC was loaded).
+		mutable EntryMapType m_entryMap;
+		/// Synchronization for creating entries from indexed TOC records.
+		mutable Mutex m_entryLock;
+
+		/// Indexed TOC data (the TOC load buffer or a memory-mapped view of the TOC file), or null if the TOC was
+		/// loaded from a legacy format or has been released.
+		const uint8_t* m_pTocIndexData;
+		/// Size of the TOC mapping if the indexed TOC data is memory-mapped, zero if it is heap-allocated.
+		size_t m_tocMappedSize;
+		/// Indexed TOC entry records.
+		const TocRecord* m_pTocRecords;
+		/// Indexed TOC hash table buckets (record index plus one, or zero for an empty bucket).
+		const uint32_t* m_pTocBuckets;
+		/// Indexed TOC path string table.
+		const char* m_pTocStrings;
+		/// Number of indexed TOC entry records.
+		uint32_t m_tocRecordCount;
+		/// Indexed TOC hash table bucket mask (bucket count minus one).
+		uint32_t m_tocBucketMask;
+		/// Number of journal records following the full entry list in the TOC file.
+		uint32_t m_journalRecordCount;
+		/// Format version of the TOC file on disk (invalid if unknown), which journal records must match.
+		uint32_t m_tocFileVersion;
+
+		/// True if entry data and TOC updates are being held in memory until EndBatchWrites() is called.
+		bool m_bBatchWrites;
+		/// Entry data waiting to be written to the cache file, in offset order.
+		DynamicArray< PendingWrite > m_pendingWrites;
+		/// Offset of the end of the cache file once all pending data has been written.
+		uint64_t m_batchEndOffset;
+
+		/// Views of the cache file mapped when using READ_MODE_MAPPED (the last view is the current one; views
+		/// replaced after the cache file has grown are kept until shutdown, as loads may still reference them).
+		DynamicArray< MappedView > m_mappedViews;
+		/// Mapped view access synchronization.
+		Mutex m_mappedViewLock;
 
 		/// @name Loading Utility Functions
 		//@{
-		bool FinalizeTocLoad();
+		bool FinalizeTocLoad( const uint8_t* pTocData );
+		bool FinalizeIndexedTocLoad(
+			const uint8_t* pTocData, bool bSwapBytes, const uint8_t*& rpTocCurrent, const uint8_t* pTocMax );
+		bool ReadTocEntry(
+			LOAD_VALUE_CALLBACK* pLoadFunction, uint32_t version, EntryKey& rKey, Entry& rEntry,
+			const uint8_t*& rpTocCurrent, const uint8_t* pTocMax );
+		bool MapToc();
+		void ReleaseTocIndex();
+		void ClearEntries();
+
+		Entry* LookupEntry( AssetPath path, uint32_t subDataIndex ) const;
+		Entry* MaterializeEntry( uint32_t recordIndex ) const;
+		bool MaterializeAllEntries();
+		bool MapCacheFile( bool bForceRemap = false );
+		void UnmapCacheFile();
+		//@}
+
+		/// @name Saving Utility Functions
+		//@{
+		bool WriteToc( const String& rTocFileName );
+		bool AppendTocRecord( const Entry& rEntry );
+		bool WriteCompactedCacheFile( const String& rCacheFileName, DynamicArray< uint64_t >& rOffsets );
 		//@}
 
 		/// @name Private Static Utility Functions
@@ -162,6 +328,8 @@ namespace Helium
 		template< typename T > static bool CheckedTocRead(
 			LOAD_VALUE_CALLBACK* pLoadFunction, T& rValue, const char* pDescription, const uint8_t*& rpTocCurrent,
 			const uint8_t* pTocMax );
+		static void WriteTocEntry( Stream& rStream, const Entry& rEntry, String& rPathBuffer );
+		static bool ReplaceExistingFile( const String& rSourceFileName, const String& rDestinationFileName );
 		//@}
 	};
 }
@@ -24,6 +24,16 @@ Helium::Cache::EPlatform Helium::Cache::GetPlatform() const
     return m_platform;
 }
 
+/// Get the mode used for reading cache entry data.
+///
+/// @return  Cache read mode.
+///
+/// @see GetMappedEntryData()
+Helium::Cache::EReadMode Helium::Cache::GetReadMode() const
+{
+    return m_readMode;
+}
+
 /// Get the path name of the cache table of contents file.
 ///
 /// @return  TOC file path name.
@@ -57,19 +67,12 @@ uint32_t Helium::Cache::GetEntryCount() const
     return static_cast< uint32_t >( entryCount );
 }
 
-/// Get the information for the cache entry with the specified index.
-///
-/// @param[in] index  Asset entry index.
+/// Get whether entry writes are currently being batched.
 ///
-/// @return  Asset entry information.
+/// @return  True if writes are held in memory until EndBatchWrites() is called, false if they are written immediately.
 ///
-/// @see GetEntryCount()
-const Helium::Cache::Entry& Helium::Cache::GetEntry( uint32_t index ) const
+/// @see BeginBatchWrites(), EndBatchWrites()
+bool Helium::Cache::IsBatchingWrites() const
 {
-    HELIUM_ASSERT( index < m_entries.GetSize() );
-
-    Entry* pEntry = m_entries[ index ];
-    HELIUM_ASSERT( pEntry );
-
-    return *pEntry;
+    return m_bBatchWrites;
 }
@@ -11,8 +11,10 @@ using namespace Helium;
 CacheManager* CacheManager::sm_pInstance = NULL;
 
 /// Constructor.
-CacheManager::CacheManager( const FilePath& rBaseDirectory )
-	: m_cachePool( CACHE_POOL_BLOCK_SIZE )
+CacheManager::CacheManager( const FilePath& rBaseDirectory, Cache::EReadMode readMode )
+	: m_readMode( readMode )
+	, m_cachePool( CACHE_POOL_BLOCK_SIZE )
+	, m_bBatchWrites( false )
 {
 	m_platformDataDirectories[ Cache::PLATFORM_PC ] = rBaseDirectory.c_str();
 	m_platformDataDirectories[ Cache::PLATFORM_PC ] += TXT( "DataPC/" );
@@ -72,7 +74,7 @@ Cache* CacheManager::GetCache( Name name, Cache::EPlatform platform )
 
 	cacheFileName += TXT( "." ) HELIUM_CACHE_EXTENSION;
 
-	if( !pCache->Initialize( name, platform, *tocFileName, *cacheFileName ) )
+	if( !pCache->Initialize( name, platform, *tocFileName, *cacheFileName, m_readMode ) )
 	{
 		HELIUM_TRACE( TraceLevels::Error, TXT( "CacheManager: Failed to initialize cache \"%s\".\n" ), *name );
 
@@ -89,10 +91,80 @@ Cache* CacheManager::GetCache( Name name, Cache::EPlatform platform )
 		pCache = cacheAccessor->Second();
 		HELIUM_ASSERT( pCache );
 	}
+	else
+	{
+		MutexScopeLock scopeLock( m_cacheListLock );
+		m_caches.Push( pCache );
+		if( m_bBatchWrites )
+		{
+			pCache->EnforceTocLoad();
+			pCache->BeginBatchWrites();
+		}
+	}
 
 	return pCache;
 }
 
+/// Make all caches, including those created later on, hold their entry updates in memory until EndBatchWrites() is
+/// called, so that each cache file and TOC is written once instead of once per entry.
+///
+/// @see EndBatchWrites(), Cache::BeginBatchWrites()
+void CacheManager::BeginBatchWrites()
+{
+	MutexScopeLock scopeLock( m_cacheListLock );
+
+	m_bBatchWrites = true;
+
+	size_t cacheCount = m_caches.GetSize();
+	for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+	{
+		Cache* pCache = m_caches[ cacheIndex ];
+		HELIUM_ASSERT( pCache );
+		pCache->EnforceTocLoad();
+		pCache->BeginBatchWrites();
+	}
+}
+
+/// Write out all entry updates batched since BeginBatchWrites() was called, and stop batching writes.
+///
+/// @param[out] pFailedCacheFiles  If not null, the file names of the caches that failed to be written are appended to
+///                                this array.
+///
+/// @return  True if all caches were written successfully, false if writing any cache failed.
+///
+/// @see BeginBatchWrites(), Cache::EndBatchWrites()
+bool CacheManager::EndBatchWrites( DynamicArray< String >* pFailedCacheFiles )
+{
+	MutexScopeLock scopeLock( m_cacheListLock );
+
+	m_bBatchWrites = false;
+
+	bool bSuccess = true;
+
+	size_t cacheCount = m_caches.GetSize();
+	for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+	{
+		Cache* pCache = m_caches[ cacheIndex ];
+		HELIUM_ASSERT( pCache );
+		if( !pCache->EndBatchWrites() )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "CacheManager: Failed to write batched updates to cache \"%s\".\n" ),
+				*pCache->GetCacheFileName() );
+
+			if( pFailedCacheFiles )
+			{
+				pFailedCacheFiles->Push( pCache->GetCacheFileName() );
+			}
+
+			bSuccess = false;
+		}
+	}
+
+	return bSuccess;
+}
+
 /// Get the cache data directory for the specified platform.
 ///
 /// @param[in] platform  Target platform, or Cache::PLATFORM_INVALID name to use the current platform.
@@ -116,13 +188,16 @@ const String& CacheManager::GetPlatformDataDirectory( Cache::EPlatform platform
 /// before calling GetStaticInstance().  This function should be called once and
 /// only once.
 ///
+/// @param[in] rBaseDirectory  Base directory under which platform cache data directories are located.
+/// @param[in] readMode        Mode with which caches should read their entry data.
+///
 /// @return  Reference to the CacheManager instance.
 ///
 /// @see DestroyStaticInstance()
-bool CacheManager::InitializeStaticInstance( const FilePath& rBaseDirectory )
+bool CacheManager::InitializeStaticInstance( const FilePath& rBaseDirectory, Cache::EReadMode readMode )
 {
 	HELIUM_ASSERT( sm_pInstance == NULL );
-	sm_pInstance = new CacheManager( rBaseDirectory );
+	sm_pInstance = new CacheManager( rBaseDirectory, readMode );
 	HELIUM_ASSERT( sm_pInstance );
 
 	return sm_pInstance != NULL;
@@ -23,6 +23,12 @@ namespace Helium
 		Cache* GetCache( Name name, Cache::EPlatform platform = Cache::PLATFORM_INVALID );
 		//@}
 
+		/// @name Batched Writing
+		//@{
+		void BeginBatchWrites();
+		bool EndBatchWrites( DynamicArray< String >* pFailedCacheFiles = NULL );
+		//@}
+
 		/// @name Filesystem Information
 		//@{
 		const String& GetPlatformDataDirectory( Cache::EPlatform platform = Cache::PLATFORM_INVALID );
@@ -30,7 +36,8 @@ namespace Helium
 
 		/// @name Static Access
 		//@{
-		static bool InitializeStaticInstance( const FilePath& rBaseDirectory );
+		static bool InitializeStaticInstance(
+			const FilePath& rBaseDirectory, Cache::EReadMode readMode = Cache::READ_MODE_ASYNC );
 		static CacheManager& GetStaticInstance();
 		static void DestroyStaticInstance();
 		//@}
@@ -43,18 +50,26 @@ namespace Helium
 	private:
 		/// Platform cache data directories.
 		String m_platformDataDirectories[ Cache::PLATFORM_MAX ];
+		/// Read mode with which caches are initialized.
+		Cache::EReadMode m_readMode;
 
 		/// Cache object pool.
 		ObjectPool< Cache > m_cachePool;
 		/// Cache lookup tables.
 		ConcurrentHashMap< Name, Cache* > m_cacheMaps[ Cache::PLATFORM_MAX ];
+		/// All cache instances, in creation order.
+		DynamicArray< Cache* > m_caches;
+		/// Synchronization for the cache list and batch state.
+		Mutex m_cacheListLock;
+		/// True if caches should batch their writes until EndBatchWrites() is called.
+		bool m_bBatchWrites;
 
 		/// Singleton instance.
 		static CacheManager* sm_pInstance;
 
 		/// @name Construction/Destruction
 		//@{
-		CacheManager( const FilePath& rBaseDirectory );
+		CacheManager( const FilePath& rBaseDirectory, Cache::EReadMode readMode );
 		~CacheManager();
 		//@}
 	};
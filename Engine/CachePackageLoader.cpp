@@ -1,10 +1,12 @@
 #include "EnginePch.h"
 #include "Engine/CachePackageLoader.h"
 
+#include "Platform/Timer.h"
 #include "Engine/Asset.h"
 #include "Engine/AssetLoader.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/CacheManager.h"
+#include "Engine/JobPool.h"
 #include "Engine/Resource.h"
 
 using namespace Helium;
@@ -13,6 +15,8 @@ using namespace Helium;
 CachePackageLoader::CachePackageLoader()
 : m_pCache( NULL )
 , m_bFinishedCacheTocLoad( false )
+, m_bParallelDeserialization( true )
+, m_deserializeTicks( 0 )
 , m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
 {
 }
@@ -82,6 +86,16 @@ void CachePackageLoader::Shutdown()
 
 	m_loadRequests.Clear();
 
+	// All reads have been synced, so nothing else will be pushed onto the completion queue.
+	{
+		AsyncLoader::CompletionQueue::Handle completedReadHandle( m_completedReadQueue );
+		completedReadHandle->Clear();
+	}
+
+	m_readyRequestIds.Clear();
+	m_tickRequestIds.Clear();
+	m_deserializeRequests.Clear();
+
 	m_pCache = NULL;
 	m_bFinishedCacheTocLoad = false;
 }
@@ -147,6 +161,7 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 
 		SetInvalid( pRequest->asyncLoadId );
 		pRequest->pAsyncLoadBuffer = NULL;
+		pRequest->pCacheData = NULL;
 		pRequest->pSerializedData = NULL;
 		pRequest->pPropertyStreamEnd = NULL;
 		pRequest->pPersistentResourceStreamEnd = NULL;
@@ -209,6 +224,7 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	HELIUM_ASSERT( !pRequest->spObject );
 	SetInvalid( pRequest->asyncLoadId );
 	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->pCacheData = NULL;
 	pRequest->pSerializedData = NULL;
 	pRequest->pPropertyStreamEnd = NULL;
 	pRequest->pPersistentResourceStreamEnd = NULL;
@@ -219,10 +235,15 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	HELIUM_ASSERT( !pRequest->spOwner );
 	SetInvalid( pRequest->templateLinkIndex );
 	SetInvalid( pRequest->ownerLinkIndex );
+	pRequest->bytesRead = 0;
+	pRequest->deserializeTicks = 0;
 	pRequest->forceReload = forceReload;
 
 	pRequest->flags = 0;
 
+	// Add the request up front, as its ID is used to notify us when its cache data read completes.
+	size_t requestId = m_loadRequests.Add( pRequest );
+
 	// If a fully-loaded object already exists with the same name, do not attempt to re-load the object (just mark
 	// the request as complete).
 	pRequest->spObject = Asset::FindObject( pEntry->path );
@@ -242,25 +263,39 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	{
 		HELIUM_ASSERT( !pObject || !pObject->GetAnyFlagSet( Asset::FLAG_LOADED | Asset::FLAG_LINKED ) );
 
-		HELIUM_TRACE(
-			TraceLevels::Debug,
-			TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
-			*path.ToString() );
+		// Resolve the property data directly within the mapped cache file if possible (the prefetch issued for the
+		// entry pages is given until the next tick to complete), otherwise read it into a buffer asynchronously.
+		if( m_pCache->GetReadMode() == Cache::READ_MODE_MAPPED )
+		{
+			pRequest->pCacheData = m_pCache->GetMappedEntryData( *pEntry );
+			if( pRequest->pCacheData )
+			{
+				pRequest->flags |= LOAD_FLAG_MAPPED;
+				m_readyRequestIds.Push( requestId );
+			}
+		}
 
-		size_t entrySize = pEntry->size;
-		pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
-		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
-
-		AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
-		pRequest->asyncLoadId = rLoader.QueueRequest(
-			pRequest->pAsyncLoadBuffer,
-			m_pCache->GetCacheFileName(),
-			pEntry->offset,
-			entrySize );
-		HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
-	}
+		if( !pRequest->pCacheData )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
+				*path.ToString() );
 
-	size_t requestId = m_loadRequests.Add( pRequest );
+			size_t entrySize = pEntry->size;
+			pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
+			HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+			pRequest->pCacheData = pRequest->pAsyncLoadBuffer;
+
+			pRequest->asyncLoadId = m_pCache->BeginReadEntry(
+				*pEntry,
+				pRequest->pAsyncLoadBuffer,
+				Invalid< size_t >(),
+				&m_completedReadQueue,
+				requestId );
+			HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+		}
+	}
 
 	HELIUM_TRACE(
 		TraceLevels::Debug,
@@ -330,6 +365,7 @@ bool CachePackageLoader::TryFinishLoadObject( size_t requestId, AssetPtr& rspObj
 
 	HELIUM_ASSERT( IsInvalid( pRequest->asyncLoadId ) );
 	HELIUM_ASSERT( !pRequest->pAsyncLoadBuffer );
+	HELIUM_ASSERT( !pRequest->pCacheData );
 
 	pRequest->spType.Release();
 	pRequest->spTemplate.Release();
@@ -351,45 +387,123 @@ bool CachePackageLoader::TryFinishLoadObject( size_t requestId, AssetPtr& rspObj
 }
 
 /// Update this package loader.
+///
+/// Only load requests with work to do are updated: those whose cache data reads have completed since the last tick
+/// (as reported through the async loader completion queue), those reading directly from the mapped cache file, and
+/// those that could not finish on a previous tick.  Requests still waiting on I/O are not touched.
+///
+/// Objects ready to be deserialized are deserialized in parallel on the job pool, unless parallel deserialization has
+/// been disabled.  Object creation and link table resolution, which register objects and start loads through the asset
+/// loader, are only done on the calling thread.
+///
+/// @see SetParallelDeserialization()
 void CachePackageLoader::Tick()
 {
-	// Process pending load requests.
-	size_t loadRequestSize = m_loadRequests.GetSize();
-	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestSize; ++loadRequestIndex )
 	{
-		if( !m_loadRequests.IsElementValid( loadRequestIndex ) )
+		AsyncLoader::CompletionQueue::Handle completedReadHandle( m_completedReadQueue );
+		m_readyRequestIds.AddArray( completedReadHandle->GetData(), completedReadHandle->GetSize() );
+		completedReadHandle->Resize( 0 );
+	}
+
+	HELIUM_ASSERT( m_tickRequestIds.IsEmpty() );
+	m_tickRequestIds.Swap( m_readyRequestIds );
+
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
+	HELIUM_ASSERT( m_deserializeRequests.IsEmpty() );
+
+	size_t tickRequestCount = m_tickRequestIds.GetSize();
+	for( size_t tickRequestIndex = 0; tickRequestIndex < tickRequestCount; ++tickRequestIndex )
+	{
+		size_t requestId = m_tickRequestIds[ tickRequestIndex ];
+		HELIUM_ASSERT( m_loadRequests.IsElementValid( requestId ) );
+
+		LoadRequest* pRequest = m_loadRequests[ requestId ];
+		HELIUM_ASSERT( pRequest );
+
+		if( !TickLoadRequest( pRequest ) )
 		{
+			// Check again on the next tick.
+			m_readyRequestIds.Push( requestId );
+
 			continue;
 		}
 
-		LoadRequest* pRequest = m_loadRequests[ loadRequestIndex ];
-		HELIUM_ASSERT( pRequest );
-
 		if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
 		{
-			if( IsValid( pRequest->asyncLoadId ) )
-			{
-				if( !TickCacheLoad( pRequest ) )
-				{
-					continue;
-				}
-			}
+			// Object is ready to be deserialized.
+			m_deserializeRequests.Push( pRequest );
 
-			// Preloaded flag may be set if the cache load step failed.
-			if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
-			{
-				if( !TickDeserialize( pRequest ) )
-				{
-					continue;
-				}
-			}
+			continue;
 		}
 
 		HELIUM_ASSERT( IsInvalid( pRequest->asyncLoadId ) );
 		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer == NULL );
+		HELIUM_ASSERT( pRequest->pCacheData == NULL );
+
+		// Let the asset loader know the object can be picked up.
+		HELIUM_ASSERT( pRequest->pEntry );
+		pAssetLoader->RecordPreloadStatistics( pRequest->pEntry->path, pRequest->bytesRead, 0 );
+		pAssetLoader->WakeLoadRequest( pRequest->pEntry->path );
+	}
+
+	m_tickRequestIds.Resize( 0 );
+
+	size_t deserializeRequestCount = m_deserializeRequests.GetSize();
+	if( deserializeRequestCount != 0 )
+	{
+		uint64_t startTicks = Timer::GetTickCount();
+
+		if( m_bParallelDeserialization )
+		{
+			JobPool::GetStaticInstance().Run( &DeserializeJob, &m_deserializeRequests, deserializeRequestCount );
+		}
+		else
+		{
+			for( size_t requestIndex = 0; requestIndex < deserializeRequestCount; ++requestIndex )
+			{
+				DeserializeJob( &m_deserializeRequests, requestIndex );
+			}
+		}
+
+		m_deserializeTicks += Timer::GetTickCount() - startTicks;
+
+		for( size_t requestIndex = 0; requestIndex < deserializeRequestCount; ++requestIndex )
+		{
+			LoadRequest* pRequest = m_deserializeRequests[ requestIndex ];
+			HELIUM_ASSERT( pRequest );
+			HELIUM_ASSERT( pRequest->pEntry );
+
+			// Report the load statistics before the object is flagged as preloaded, as the asset loader may pick it up
+			// from another thread from then on.
+			pAssetLoader->RecordPreloadStatistics(
+				pRequest->pEntry->path,
+				pRequest->bytesRead,
+				pRequest->deserializeTicks );
+
+			FinishDeserialize( pRequest );
+
+			pAssetLoader->WakeLoadRequest( pRequest->pEntry->path );
+		}
+
+		m_deserializeRequests.Resize( 0 );
 	}
 }
 
+/// Set whether objects are deserialized in parallel on the job pool or one at a time on the thread calling Tick().
+///
+/// Parallel deserialization is enabled by default.  Disabling it is mainly useful for measuring how much the job pool
+/// speeds up loading, or for ruling out threading issues while debugging a load.
+///
+/// @param[in] bParallel  True to deserialize objects on the job pool, false to deserialize them serially.
+///
+/// @see GetParallelDeserialization(), GetDeserializeTicks()
+void CachePackageLoader::SetParallelDeserialization( bool bParallel )
+{
+	m_bParallelDeserialization = bParallel;
+}
+
 /// @copydoc PackageLoader::GetObjectCount()
 size_t CachePackageLoader::GetObjectCount() const
 {
@@ -409,6 +523,37 @@ AssetPath CachePackageLoader::GetAssetPath( size_t index ) const
 	return rEntry.path;
 }
 
+/// Update the load process for the given load request.
+///
+/// @param[in] pRequest  Load request.
+///
+/// @return  True if the object has been preloaded or is ready to be deserialized, false if the request is still
+///          waiting on its cache data read to be flagged as complete or on its template or owner objects to load.
+bool CachePackageLoader::TickLoadRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+
+	if( IsValid( pRequest->asyncLoadId ) || ( pRequest->flags & LOAD_FLAG_MAPPED ) )
+	{
+		if( !TickCacheLoad( pRequest ) )
+		{
+			return false;
+		}
+	}
+
+	// Preloaded flag may be set if the cache load step failed.
+	if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
+	{
+		if( !TickDeserialize( pRequest ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /// Tick the async loading of binary serialized data from the object cache for the given load request.
 ///
 /// @param[in] pRequest  Load request.
@@ -419,15 +564,24 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
 
-	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
-
 	size_t bytesRead = 0;
-	if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+	if( pRequest->flags & LOAD_FLAG_MAPPED )
 	{
-		return false;
+		HELIUM_ASSERT( pRequest->pEntry );
+		bytesRead = pRequest->pEntry->size;
+
+		pRequest->flags &= ~LOAD_FLAG_MAPPED;
 	}
+	else
+	{
+		AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+		if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+		{
+			return false;
+		}
 
-	SetInvalid( pRequest->asyncLoadId );
+		SetInvalid( pRequest->asyncLoadId );
+	}
 
 	if( bytesRead == 0 || IsInvalid( bytesRead ) )
 	{
@@ -440,7 +594,9 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 	}
 	else
 	{
-		uint8_t* pBufferEnd = pRequest->pAsyncLoadBuffer + bytesRead;
+		pRequest->bytesRead = bytesRead;
+
+		const uint8_t* pBufferEnd = pRequest->pCacheData + bytesRead;
 		pRequest->pPropertyStreamEnd = pBufferEnd;
 		pRequest->pPersistentResourceStreamEnd = pBufferEnd;
 
@@ -453,8 +609,7 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 
 	// An error occurred attempting to load the property data, so mark any existing object as fully loaded (nothing
 	// else will be done with the object itself from here on out).
-	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-	pRequest->pAsyncLoadBuffer = NULL;
+	ReleaseCacheData( pRequest );
 
 	Asset* pObject = pRequest->spObject;
 	if( pObject )
@@ -470,9 +625,13 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 
 /// Tick the object deserialization process for the given object load request.
 ///
+/// This waits on the template and owner objects and creates the object if necessary.  The serialized data itself is
+/// deserialized afterward by DeserializeObject().
+///
 /// @param[in] pRequest  Load request.
 ///
-/// @return  True if the deserialization process has completed, false if it still needs time to process.
+/// @return  True if the object is ready to be deserialized or has failed to load (in which case the request is
+///          flagged as preloaded), false if it still needs time to process.
 bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
@@ -511,8 +670,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				pObject->ConditionalFinalizeLoad();
 			}
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+			ReleaseCacheData( pRequest );
 
 			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -546,8 +704,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				pObject->ConditionalFinalizeLoad();
 			}
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+			ReleaseCacheData( pRequest );
 
 			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -581,8 +738,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 			pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
 			pObject->ConditionalFinalizeLoad();
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+			ReleaseCacheData( pRequest );
 
 			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -599,8 +755,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				TXT( "CachePackageLoader: Failed to create \"%s\" during loading.\n" ),
 				*pCacheEntry->path.ToString() );
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+			ReleaseCacheData( pRequest );
 
 			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -611,69 +766,48 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 		HELIUM_ASSERT( pObject );
 	}
 		
-	Reflect::ObjectPtr cached_object = Cache::ReadCacheObjectFromBuffer(
-		pRequest->pSerializedData, 
-		0, 
-		pRequest->pPropertyStreamEnd - pRequest->pSerializedData, 
-		pRequest->pResolver);
+	// Object is ready to be deserialized (see Tick()).
+	return true;
+}
+
+/// Finish the deserialization of an object once DeserializeObject() has been run for its load request.
+///
+/// This forwards any object references recorded during deserialization to the load request's resolver, which may
+/// begin loading other objects, so it must be called on the thread ticking the package loader.
+///
+/// @param[in] pRequest  Load request.
+void CachePackageLoader::FinishDeserialize( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+
+	Asset* pObject = pRequest->spObject;
+	HELIUM_ASSERT( pObject );
 
-	if (!cached_object.ReferencesObject())
+	if( pRequest->pResolver )
 	{
-		HELIUM_TRACE(
-			TraceLevels::Error,
-			TXT( "CachePackageLoader: Failed to deserialize object \"%s\".\n" ),
-			*pCacheEntry->path.ToString() );
+		pRequest->deferredResolver.Forward( pRequest->pResolver );
+	}
+
+	pRequest->deferredResolver.Clear();
+	pRequest->spCachedObject.Release();
+	pRequest->spCachedResourceObject.Release();
 
+	if( pRequest->flags & LOAD_FLAG_ERROR )
+	{
 		// Clear out object references (object can now be considered fully loaded as well).
 		// pmd - Not sure that we need to do this.. but if we do, just use this visitor
 		//ClearLinkIndicesFromObject clifo_visitor;
 		//pObject->Accept(clifo_visitor);
 		pObject->SetFlags( Asset::FLAG_LINKED );
 		pObject->ConditionalFinalizeLoad();
-
-		pRequest->flags |= LOAD_FLAG_ERROR;
-	}
-	else
-	{
-		cached_object->CopyTo(pObject);
-				
-		if( !pObject->IsDefaultTemplate() )
-		{
-			// Load persistent resource data.
-			Resource* pResource = Reflect::SafeCast< Resource >( pObject );
-			if( pResource )
-			{
-				Reflect::ObjectPtr cached_prd = Cache::ReadCacheObjectFromBuffer(
-					pRequest->pPropertyStreamEnd, 
-					0, 
-					(pRequest->pPersistentResourceStreamEnd - pRequest->pPropertyStreamEnd),
-					pRequest->pResolver);
-
-				if (!cached_prd.ReferencesObject())
-				{
-					HELIUM_TRACE(
-						TraceLevels::Error,
-						( TXT( "CachePackageLoader: Failed to deserialize persistent resource " )
-						TXT( "data for \"%s\".\n" ) ),
-						*pCacheEntry->path.ToString() );
-				}
-				else
-				{
-					pResource->LoadPersistentResourceObject(cached_prd);
-				}
-			}
-		}
 	}
 
-	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-	pRequest->pAsyncLoadBuffer = NULL;
+	ReleaseCacheData( pRequest );
 
 	pObject->SetFlags( Asset::FLAG_PRELOADED );
 
 	pRequest->flags |= LOAD_FLAG_PRELOADED;
-
-	// Asset is now preloaded.
-	return true;
 }
 
 /// Recursive function for resolving a package request.
@@ -707,6 +841,19 @@ void CachePackageLoader::ResolvePackage( AssetPtr& rspPackage, AssetPath package
 	rspPackage->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED | Asset::FLAG_LOADED );
 }
 
+/// Release the cached entry data held by a load request.
+///
+/// @param[in] pRequest  Load request data.
+void CachePackageLoader::ReleaseCacheData( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	// Mapped data is owned by the cache, so only async load buffers need to be freed.
+	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
+	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->pCacheData = NULL;
+}
+
 /// Deserialize the link tables for an object load.
 ///
 /// @param[in] pRequest  Load request data.
@@ -714,8 +861,8 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
 
-	uint8_t* pBufferCurrent = pRequest->pAsyncLoadBuffer;
-	uint8_t* pPropertyStreamEnd = pRequest->pPropertyStreamEnd;
+	const uint8_t* pBufferCurrent = pRequest->pCacheData;
+	const uint8_t* pPropertyStreamEnd = pRequest->pPropertyStreamEnd;
 	HELIUM_ASSERT( pBufferCurrent );
 	HELIUM_ASSERT( pPropertyStreamEnd );
 	HELIUM_ASSERT( pBufferCurrent <= pPropertyStreamEnd );
@@ -1060,3 +1207,132 @@ bool CachePackageLoader::DeserializeLinkTables( LoadRequest* pRequest )
 
 	return true;
 }
+
+/// Deserialize the property and persistent resource data for an object load.
+///
+/// This can be run on any thread, provided that no two threads process the same load request at once.  Each call
+/// reads through its own archive, and object references are recorded by the request's deferred resolver rather than
+/// resolved immediately.
+///
+/// @param[in] pRequest  Load request data.
+void CachePackageLoader::DeserializeObject( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	Asset* pObject = pRequest->spObject;
+	HELIUM_ASSERT( pObject );
+
+	const Cache::Entry* pCacheEntry = pRequest->pEntry;
+	HELIUM_ASSERT( pCacheEntry );
+
+	Reflect::ObjectResolver* pResolver = ( pRequest->pResolver ? &pRequest->deferredResolver : NULL );
+
+	pRequest->spCachedObject = Cache::ReadCacheObjectFromBuffer(
+		pRequest->pSerializedData,
+		0,
+		pRequest->pPropertyStreamEnd - pRequest->pSerializedData,
+		pResolver );
+
+	if( !pRequest->spCachedObject.ReferencesObject() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "CachePackageLoader: Failed to deserialize object \"%s\".\n" ),
+			*pCacheEntry->path.ToString() );
+
+		pRequest->flags |= LOAD_FLAG_ERROR;
+
+		return;
+	}
+
+	pRequest->spCachedObject->CopyTo( pObject );
+
+	if( !pObject->IsDefaultTemplate() )
+	{
+		// Load persistent resource data.
+		Resource* pResource = Reflect::SafeCast< Resource >( pObject );
+		if( pResource )
+		{
+			pRequest->spCachedResourceObject = Cache::ReadCacheObjectFromBuffer(
+				pRequest->pPropertyStreamEnd,
+				0,
+				( pRequest->pPersistentResourceStreamEnd - pRequest->pPropertyStreamEnd ),
+				pResolver );
+
+			if( !pRequest->spCachedResourceObject.ReferencesObject() )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					( TXT( "CachePackageLoader: Failed to deserialize persistent resource " )
+					TXT( "data for \"%s\".\n" ) ),
+					*pCacheEntry->path.ToString() );
+			}
+			else
+			{
+				pResource->LoadPersistentResourceObject( pRequest->spCachedResourceObject );
+			}
+		}
+	}
+}
+
+/// JobPool callback for deserializing a batch of objects.
+///
+/// @param[in] pData      Array of load requests to deserialize.
+/// @param[in] itemIndex  Index of the load request to process.
+void CachePackageLoader::DeserializeJob( void* pData, size_t itemIndex )
+{
+	DynamicArray< LoadRequest* >* pRequests = static_cast< DynamicArray< LoadRequest* >* >( pData );
+	HELIUM_ASSERT( pRequests );
+	HELIUM_ASSERT( itemIndex < pRequests->GetSize() );
+
+	LoadRequest* pRequest = ( *pRequests )[ itemIndex ];
+	HELIUM_ASSERT( pRequest );
+
+	uint64_t startTicks = Timer::GetTickCount();
+	DeserializeObject( pRequest );
+	pRequest->deserializeTicks = Timer::GetTickCount() - startTicks;
+}
+
+/// @copydoc Reflect::ObjectResolver::Resolve()
+bool CachePackageLoader::DeferredResolver::Resolve(
+	const Name& identity,
+	Reflect::ObjectPtr& pointer,
+	const Reflect::MetaClass* pointerClass )
+{
+	// Only object paths (which begin with '/') are resolved by the asset loader, everything else is left to the
+	// archive.
+	if( identity.IsEmpty() || ( *identity )[ 0 ] != '/' )
+	{
+		return false;
+	}
+
+	Reference* pReference = m_references.New();
+	HELIUM_ASSERT( pReference );
+	pReference->identity = identity;
+	pReference->pPointer = &pointer;
+	pReference->pPointerClass = pointerClass;
+
+	return true;
+}
+
+/// Pass all recorded object references on to another resolver.
+///
+/// @param[in] pResolver  Resolver to which references should be forwarded.
+void CachePackageLoader::DeferredResolver::Forward( Reflect::ObjectResolver* pResolver )
+{
+	HELIUM_ASSERT( pResolver );
+
+	size_t referenceCount = m_references.GetSize();
+	for( size_t referenceIndex = 0; referenceIndex < referenceCount; ++referenceIndex )
+	{
+		Reference& rReference = m_references[ referenceIndex ];
+		HELIUM_ASSERT( rReference.pPointer );
+		HELIUM_VERIFY( pResolver->Resolve( rReference.identity, *rReference.pPointer, rReference.pPointerClass ) );
+	}
+}
+
+/// Clear all recorded object references.
+void CachePackageLoader::DeferredResolver::Clear()
+{
+	m_references.Resize( 0 );
+}
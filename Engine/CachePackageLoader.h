@@ -37,6 +37,14 @@ namespace Helium
 		virtual void Tick();
 		//@}
 
+		/// @name Deserialization
+		//@{
+		void SetParallelDeserialization( bool bParallel );
+		inline bool GetParallelDeserialization() const;
+
+		inline uint64_t GetDeserializeTicks() const;
+		//@}
+
 		/// @name Data Access
 		//@{
 		virtual size_t GetObjectCount() const;
@@ -52,7 +60,45 @@ namespace Helium
 			/// Set once object preloading has completed.
 			LOAD_FLAG_PRELOADED = 1 << 0,
 			/// Set when an error has occurred in the load process.
-			LOAD_FLAG_ERROR = 1 << 1
+			LOAD_FLAG_ERROR = 1 << 1,
+			/// Set while entry data mapped from the cache file is waiting to be processed.
+			LOAD_FLAG_MAPPED = 1 << 2
+		};
+
+		/// Object resolver used while deserializing on a worker thread.
+		///
+		/// Resolving an object path begins a load through the asset loader, which is not safe to do from the worker
+		/// threads, so path references are only recorded during deserialization and forwarded to the load request's
+		/// resolver afterward on the thread ticking the package loader.
+		class DeferredResolver : public Reflect::ObjectResolver
+		{
+		public:
+			/// @name Reflect::ObjectResolver Interface
+			//@{
+			virtual bool Resolve(
+				const Name& identity, Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass );
+			//@}
+
+			/// @name Deferred Resolution
+			//@{
+			void Forward( Reflect::ObjectResolver* pResolver );
+			void Clear();
+			//@}
+
+		private:
+			/// Recorded object reference.
+			struct Reference
+			{
+				/// Object path identity.
+				Name identity;
+				/// Pointer to fix up.
+				Reflect::ObjectPtr* pPointer;
+				/// Class of the pointer to fix up.
+				const Reflect::MetaClass* pPointerClass;
+			};
+
+			/// Object references recorded during deserialization.
+			DynamicArray< Reference > m_references;
 		};
 
 		/// Asset load request data.
@@ -69,12 +115,14 @@ namespace Helium
 			size_t asyncLoadId;
 			/// Async load buffer.
 			uint8_t* pAsyncLoadBuffer;
+			/// Cached entry data (either the async load buffer or the entry within the mapped cache file).
+			const uint8_t* pCacheData;
 			/// Binary serialized object property data (immediately past the link table).
-			uint8_t* pSerializedData;
+			const uint8_t* pSerializedData;
 			/// End of the serialized property data.
-			uint8_t* pPropertyStreamEnd;
+			const uint8_t* pPropertyStreamEnd;
 			/// End of the serialized persistent resource data.
-			uint8_t* pPersistentResourceStreamEnd;
+			const uint8_t* pPersistentResourceStreamEnd;
 
 			/// Type link table (table stores type object instances).
 			DynamicArray< AssetTypePtr > typeLinkTable;
@@ -92,6 +140,18 @@ namespace Helium
 			/// Owner link reference.
 			uint32_t ownerLinkIndex;
 
+			/// Object deserialized from the property data (held until its references have been forwarded).
+			Reflect::ObjectPtr spCachedObject;
+			/// Object deserialized from the persistent resource data (held until its references have been forwarded).
+			Reflect::ObjectPtr spCachedResourceObject;
+			/// Resolver used for deserialization on the worker threads.
+			DeferredResolver deferredResolver;
+
+			/// Number of bytes of cache data read.
+			size_t bytesRead;
+			/// Ticks spent deserializing the object.
+			uint64_t deserializeTicks;
+
 			/// Load flags.
 			uint32_t flags;
 
@@ -102,22 +162,40 @@ namespace Helium
 		Cache* m_pCache;
 		/// True if we've synced the cache TOC load process.
 		bool m_bFinishedCacheTocLoad;
+		/// True if objects are deserialized in parallel on the job pool.
+		bool m_bParallelDeserialization;
+		/// Total wall-clock ticks spent deserializing objects during Tick().
+		uint64_t m_deserializeTicks;
 
 		/// Pending load requests.
 		SparseArray< LoadRequest* > m_loadRequests;
 		/// Load request pool.
 		ObjectPool< LoadRequest > m_loadRequestPool;
 
+		/// IDs of load requests whose cache data reads have completed (pushed by the async loading threads).
+		AsyncLoader::CompletionQueue m_completedReadQueue;
+		/// IDs of load requests to update on the next tick.
+		DynamicArray< size_t > m_readyRequestIds;
+		/// IDs of load requests being updated in the current tick.
+		DynamicArray< size_t > m_tickRequestIds;
+		/// Load requests ready to be deserialized in the current tick.
+		DynamicArray< LoadRequest* > m_deserializeRequests;
+
 		/// @name Load Ticking Functions
 		//@{
+		bool TickLoadRequest( LoadRequest* pRequest );
 		bool TickCacheLoad( LoadRequest* pRequest );
 		bool TickDeserialize( LoadRequest* pRequest );
+		void FinishDeserialize( LoadRequest* pRequest );
 		//@}
 
 		/// @name Static Private Utility Functions
 		//@{
 		static void ResolvePackage( AssetPtr& spPackage, AssetPath packagePath );
+		static void ReleaseCacheData( LoadRequest* pRequest );
 		static bool DeserializeLinkTables( LoadRequest* pRequest );
+		static void DeserializeObject( LoadRequest* pRequest );
+		static void DeserializeJob( void* pData, size_t itemIndex );
 		//@}
 	};
 }
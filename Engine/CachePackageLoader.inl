@@ -5,3 +5,23 @@ Helium::Cache* Helium::CachePackageLoader::GetCache() const
 {
     return m_pCache;
 }
+
+/// Get whether objects are deserialized in parallel on the job pool.
+///
+/// @return  True if objects are deserialized on the job pool, false if they are deserialized serially.
+///
+/// @see SetParallelDeserialization()
+bool Helium::CachePackageLoader::GetParallelDeserialization() const
+{
+    return m_bParallelDeserialization;
+}
+
+/// Get the total wall-clock time spent deserializing objects during Tick() since this loader was created.
+///
+/// @return  Deserialization time, in ticks.
+///
+/// @see SetParallelDeserialization()
+uint64_t Helium::CachePackageLoader::GetDeserializeTicks() const
+{
+    return m_deserializeTicks;
+}
@@ -0,0 +1,173 @@
+#include "EnginePch.h"
+#include "Engine/Compression.h"
+
+#include "zlib/zlib.h"
+
+using namespace Helium;
+
+/// Get the largest number of bytes that compressing a block of data can produce.
+///
+/// @param[in] codec       Compression codec.
+/// @param[in] sourceSize  Size of the uncompressed data, in bytes.
+///
+/// @return  Worst-case compressed size, in bytes.
+size_t Compression::GetMaxCompressedSize( ECodec codec, size_t sourceSize )
+{
+	HELIUM_ASSERT( static_cast< size_t >( codec ) < static_cast< size_t >( CODEC_MAX ) );
+
+	switch( codec )
+	{
+	case CODEC_ZLIB:
+		return static_cast< size_t >( compressBound( static_cast< uLong >( sourceSize ) ) );
+
+	default:
+		return sourceSize;
+	}
+}
+
+/// Compress a block of data.
+///
+/// @param[in]  codec            Compression codec.
+/// @param[in]  pSource          Data to compress.
+/// @param[in]  sourceSize       Number of bytes to compress.
+/// @param[out] pDestination     Buffer in which to store the compressed data.
+/// @param[in]  destinationSize  Size of the destination buffer, in bytes.  Compression is guaranteed to succeed if this
+///                              is at least the size returned by GetMaxCompressedSize().
+///
+/// @return  Number of bytes of compressed data, or an invalid index if compression failed.
+///
+/// @see Decompress(), GetMaxCompressedSize()
+size_t Compression::Compress(
+	ECodec codec,
+	const void* pSource,
+	size_t sourceSize,
+	void* pDestination,
+	size_t destinationSize )
+{
+	HELIUM_ASSERT( static_cast< size_t >( codec ) < static_cast< size_t >( CODEC_MAX ) );
+	HELIUM_ASSERT( pSource || sourceSize == 0 );
+	HELIUM_ASSERT( pDestination || destinationSize == 0 );
+
+	switch( codec )
+	{
+	case CODEC_NONE:
+		{
+			if( destinationSize < sourceSize )
+			{
+				return Invalid< size_t >();
+			}
+
+			MemoryCopy( pDestination, pSource, sourceSize );
+
+			return sourceSize;
+		}
+
+	case CODEC_ZLIB:
+		{
+			uLongf compressedSize = static_cast< uLongf >( destinationSize );
+			int result = compress2(
+				static_cast< Bytef* >( pDestination ),
+				&compressedSize,
+				static_cast< const Bytef* >( pSource ),
+				static_cast< uLong >( sourceSize ),
+				Z_BEST_COMPRESSION );
+			if( result != Z_OK )
+			{
+				return Invalid< size_t >();
+			}
+
+			return static_cast< size_t >( compressedSize );
+		}
+
+	default:
+		return Invalid< size_t >();
+	}
+}
+
+/// Decompress a block of data.
+///
+/// If the destination buffer is smaller than the uncompressed data, decompression stops once the buffer is full, so
+/// only the leading part of the data can be requested.
+///
+/// @param[in]  codec            Compression codec.
+/// @param[in]  pSource          Compressed data.
+/// @param[in]  sourceSize       Number of bytes of compressed data.
+/// @param[out] pDestination     Buffer in which to store the uncompressed data.
+/// @param[in]  destinationSize  Size of the destination buffer, in bytes.
+///
+/// @return  Number of bytes stored in the destination buffer, or an invalid index if the compressed data is corrupt.
+///
+/// @see Compress()
+size_t Compression::Decompress(
+	ECodec codec,
+	const void* pSource,
+	size_t sourceSize,
+	void* pDestination,
+	size_t destinationSize )
+{
+	HELIUM_ASSERT( static_cast< size_t >( codec ) < static_cast< size_t >( CODEC_MAX ) );
+	HELIUM_ASSERT( pSource || sourceSize == 0 );
+	HELIUM_ASSERT( pDestination || destinationSize == 0 );
+
+	switch( codec )
+	{
+	case CODEC_NONE:
+		{
+			size_t copySize = Min( sourceSize, destinationSize );
+			MemoryCopy( pDestination, pSource, copySize );
+
+			return copySize;
+		}
+
+	case CODEC_ZLIB:
+		{
+			z_stream stream;
+			MemoryZero( &stream, sizeof( stream ) );
+			stream.next_in = static_cast< Bytef* >( const_cast< void* >( pSource ) );
+			stream.avail_in = static_cast< uInt >( sourceSize );
+			stream.next_out = static_cast< Bytef* >( pDestination );
+			stream.avail_out = static_cast< uInt >( destinationSize );
+
+			if( inflateInit( &stream ) != Z_OK )
+			{
+				return Invalid< size_t >();
+			}
+
+			int result = inflate( &stream, Z_FINISH );
+			size_t decompressedSize = static_cast< size_t >( stream.total_out );
+			inflateEnd( &stream );
+
+			// Running out of output space is only an error if the destination buffer is not full.
+			bool bOutputFull = ( ( result == Z_OK || result == Z_BUF_ERROR ) && decompressedSize == destinationSize );
+			if( result != Z_STREAM_END && !bOutputFull )
+			{
+				return Invalid< size_t >();
+			}
+
+			return decompressedSize;
+		}
+
+	default:
+		return Invalid< size_t >();
+	}
+}
+
+/// Get the display name of a codec.
+///
+/// @param[in] codec  Compression codec.
+///
+/// @return  Codec name.
+const char* Compression::GetCodecName( ECodec codec )
+{
+	switch( codec )
+	{
+	case CODEC_NONE:
+		return TXT( "none" );
+
+	case CODEC_ZLIB:
+		return TXT( "zlib" );
+
+	default:
+		return TXT( "invalid" );
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Platform/Types.h"
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	/// Block compression of cached data.
+	class HELIUM_ENGINE_API Compression
+	{
+	public:
+		/// Compression codecs.
+		enum ECodec
+		{
+			CODEC_FIRST   =  0,
+			CODEC_INVALID = -1,
+
+			/// Data is stored uncompressed.
+			CODEC_NONE,
+			/// zlib (deflate) stream.
+			CODEC_ZLIB,
+
+			CODEC_MAX,
+			CODEC_LAST = CODEC_MAX - 1
+		};
+
+		/// @name Compression
+		//@{
+		static size_t GetMaxCompressedSize( ECodec codec, size_t sourceSize );
+		static size_t Compress(
+			ECodec codec, const void* pSource, size_t sourceSize, void* pDestination, size_t destinationSize );
+		static size_t Decompress(
+			ECodec codec, const void* pSource, size_t sourceSize, void* pDestination, size_t destinationSize );
+		//@}
+
+		/// @name Codec Information
+		//@{
+		static const char* GetCodecName( ECodec codec );
+		//@}
+	};
+}
@@ -0,0 +1,274 @@
+#include "EnginePch.h"
+#include "Engine/JobPool.h"
+
+#if HELIUM_OS_WIN
+# include <windows.h>
+#else
+# include <unistd.h>
+#endif
+
+using namespace Helium;
+
+JobPool* JobPool::sm_pInstance = NULL;
+
+/// Constructor.
+JobPool::JobPool()
+	: m_pFunction( NULL )
+	, m_pData( NULL )
+	, m_itemCount( 0 )
+	, m_nextItemIndex( 0 )
+	, m_pendingCount( 0 )
+	, m_busyCounter( 0 )
+	, m_stopCounter( 0 )
+	, m_completeCondition( false, false )
+{
+}
+
+/// Destructor.
+JobPool::~JobPool()
+{
+	Shutdown();
+}
+
+/// Initialize the job pool.
+///
+/// @param[in] workerCount  Number of worker threads to start.  If invalid, one worker is started for every
+///                         processor core except the one used by the calling thread.
+///
+/// @return  True if initialization was successful, false if not.
+///
+/// @see Shutdown()
+bool JobPool::Initialize( uint32_t workerCount )
+{
+	Shutdown();
+
+	if( IsInvalid( workerCount ) )
+	{
+		uint32_t processorCount = GetProcessorCount();
+		workerCount = ( processorCount > 1 ? processorCount - 1 : 0 );
+	}
+
+	AtomicExchangeRelease( m_stopCounter, 0 );
+
+	m_workers.Reserve( workerCount );
+	m_threads.Reserve( workerCount );
+	for( uint32_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		Worker* pWorker = new Worker( this );
+		HELIUM_ASSERT( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		if( !pThread->Start( TXT( "JobPool - worker" ) ) )
+		{
+			HELIUM_TRACE( TraceLevels::Error, TXT( "JobPool::Initialize(): Failed to start worker thread %" ) PRIu32 TXT( ".\n" ), workerIndex );
+
+			delete pThread;
+			delete pWorker;
+
+			Shutdown();
+
+			return false;
+		}
+
+		m_workers.Push( pWorker );
+		m_threads.Push( pThread );
+	}
+
+	return true;
+}
+
+/// Shut down the job pool, stopping all worker threads.
+///
+/// @see Initialize()
+void JobPool::Shutdown()
+{
+	HELIUM_ASSERT( m_busyCounter == 0 );
+
+	AtomicExchangeRelease( m_stopCounter, 1 );
+
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workers[ workerIndex ]->Wake();
+	}
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_threads[ workerIndex ]->Join();
+		delete m_threads[ workerIndex ];
+		delete m_workers[ workerIndex ];
+	}
+
+	m_threads.Clear();
+	m_workers.Clear();
+}
+
+/// Process a set of independent work items, blocking until all of them have completed.
+///
+/// The calling thread takes part in processing.  Items are handed out in increasing index order, but may complete in
+/// any order and on any thread, so callers that need deterministic results should write to per-item outputs and
+/// merge them afterwards.
+///
+/// @param[in] pFunction  Function to call for each item.
+/// @param[in] pData      Data to pass to the function.
+/// @param[in] itemCount  Number of items to process.
+void JobPool::Run( JobFunction pFunction, void* pData, size_t itemCount )
+{
+	HELIUM_ASSERT( pFunction );
+	HELIUM_ASSERT( itemCount <= static_cast< size_t >( INT32_MAX ) );
+
+	if( itemCount == 0 )
+	{
+		return;
+	}
+
+	// Fall back to running inline if there is nothing to gain from the workers or if another submission (possibly
+	// one that is calling us from a work item) already owns them.
+	if( itemCount == 1 || m_workers.IsEmpty() || AtomicCompareExchangeAcquire( m_busyCounter, 1, 0 ) != 0 )
+	{
+		for( size_t itemIndex = 0; itemIndex < itemCount; ++itemIndex )
+		{
+			pFunction( pData, itemIndex );
+		}
+
+		return;
+	}
+
+	size_t workerCount = m_workers.GetSize();
+
+	m_pFunction = pFunction;
+	m_pData = pData;
+	AtomicExchangeUnsafe( m_itemCount, static_cast< int32_t >( itemCount ) );
+	AtomicExchangeUnsafe( m_pendingCount, static_cast< int32_t >( itemCount + workerCount ) );
+	AtomicExchangeRelease( m_nextItemIndex, 0 );
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workers[ workerIndex ]->Wake();
+	}
+
+	ProcessItems();
+
+	// Exactly one signal is raised per submission, once every item is done and every worker has checked out, so the
+	// pool state can be safely reused as soon as this returns.
+	m_completeCondition.Wait();
+
+	m_pFunction = NULL;
+	m_pData = NULL;
+
+	AtomicExchangeRelease( m_busyCounter, 0 );
+}
+
+/// Get the number of processor cores available to this process.
+///
+/// @return  Processor core count (always at least one).
+uint32_t JobPool::GetProcessorCount()
+{
+#if HELIUM_OS_WIN
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo( &systemInfo );
+	uint32_t processorCount = static_cast< uint32_t >( systemInfo.dwNumberOfProcessors );
+#else
+	long processorCountResult = sysconf( _SC_NPROCESSORS_ONLN );
+	uint32_t processorCount = ( processorCountResult > 0 ? static_cast< uint32_t >( processorCountResult ) : 1 );
+#endif
+
+	return Max< uint32_t >( processorCount, 1 );
+}
+
+/// Get the singleton JobPool instance, creating it if necessary.
+///
+/// Note that the instance created has no worker threads (and so processes all work inline) until Initialize() is
+/// called.
+///
+/// @return  Reference to the JobPool instance.
+///
+/// @see DestroyStaticInstance()
+JobPool& JobPool::GetStaticInstance()
+{
+	if( !sm_pInstance )
+	{
+		sm_pInstance = new JobPool;
+		HELIUM_ASSERT( sm_pInstance );
+	}
+
+	return *sm_pInstance;
+}
+
+/// Destroy the singleton JobPool instance.
+///
+/// @see GetStaticInstance()
+void JobPool::DestroyStaticInstance()
+{
+	if( sm_pInstance )
+	{
+		sm_pInstance->Shutdown();
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
+
+/// Process work items from the current submission until none remain.
+void JobPool::ProcessItems()
+{
+	for( ; ; )
+	{
+		int32_t itemIndex = AtomicIncrementAcquire( m_nextItemIndex ) - 1;
+		if( itemIndex >= m_itemCount )
+		{
+			break;
+		}
+
+		m_pFunction( m_pData, static_cast< size_t >( itemIndex ) );
+
+		ReleasePending();
+	}
+}
+
+/// Decrement the pending counter for the current submission, signaling completion if it was the last one.
+void JobPool::ReleasePending()
+{
+	if( AtomicDecrementRelease( m_pendingCount ) == 0 )
+	{
+		m_completeCondition.Signal();
+	}
+}
+
+/// Constructor.
+///
+/// @param[in] pPool  Owning pool.
+JobPool::Worker::Worker( JobPool* pPool )
+	: m_pPool( pPool )
+	, m_wakeUpCondition( false, false )
+{
+	HELIUM_ASSERT( pPool );
+}
+
+/// Destructor.
+JobPool::Worker::~Worker()
+{
+}
+
+/// Process submissions until the pool shuts down.
+void JobPool::Worker::Run()
+{
+	for( ; ; )
+	{
+		m_wakeUpCondition.Wait();
+
+		if( m_pPool->m_stopCounter != 0 )
+		{
+			break;
+		}
+
+		m_pPool->ProcessItems();
+		m_pPool->ReleasePending();
+	}
+}
+
+/// Wake up the worker to process the current submission or to shut down.
+void JobPool::Worker::Wake()
+{
+	m_wakeUpCondition.Signal();
+}
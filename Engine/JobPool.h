@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/DynamicArray.h"
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	/// Pool of worker threads used to spread independent work items across processor cores.
+	///
+	/// Work is submitted as a callback plus an item count.  The calling thread takes part in processing the items
+	/// and blocks until all of them are done, so work items may freely reference data on the caller's stack.  If the
+	/// pool is not initialized, or is already busy with another submission, the items are processed serially on the
+	/// calling thread.
+	class HELIUM_ENGINE_API JobPool : NonCopyable
+	{
+	public:
+		/// Work item callback.  Called once for each item index in the range [0, itemCount).
+		typedef void ( *JobFunction )( void* pData, size_t itemIndex );
+
+		/// @name Initialization
+		//@{
+		bool Initialize( uint32_t workerCount = Invalid< uint32_t >() );
+		void Shutdown();
+		//@}
+
+		/// @name Job Execution
+		//@{
+		inline uint32_t GetWorkerCount() const;
+		inline uint32_t GetConcurrency() const;
+
+		void Run( JobFunction pFunction, void* pData, size_t itemCount );
+		//@}
+
+		/// @name Static Access
+		//@{
+		static uint32_t GetProcessorCount();
+
+		static JobPool& GetStaticInstance();
+		static void DestroyStaticInstance();
+		//@}
+
+	private:
+		/// Worker thread runnable.
+		class Worker : public Runnable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			explicit Worker( JobPool* pPool );
+			virtual ~Worker();
+			//@}
+
+			/// @name Runnable Interface
+			//@{
+			virtual void Run();
+			//@}
+
+			/// @name External Thread Control
+			//@{
+			void Wake();
+			//@}
+
+		private:
+			/// Owning pool.
+			JobPool* m_pPool;
+			/// Condition used to wake up the worker when work is submitted (or when it should shut down).
+			Condition m_wakeUpCondition;
+		};
+
+		/// Worker threads.
+		DynamicArray< RunnableThread* > m_threads;
+		/// Worker runnables.
+		DynamicArray< Worker* > m_workers;
+
+		/// Callback for the current submission.
+		JobFunction m_pFunction;
+		/// Callback data for the current submission.
+		void* m_pData;
+		/// Number of items in the current submission.
+		volatile int32_t m_itemCount;
+		/// Index of the next item to process.
+		volatile int32_t m_nextItemIndex;
+		/// Number of outstanding items plus workers that have not yet checked out of the current submission.
+		volatile int32_t m_pendingCount;
+
+		/// Non-zero while a submission is in progress.
+		volatile int32_t m_busyCounter;
+		/// Non-zero if the workers should stop.
+		volatile int32_t m_stopCounter;
+
+		/// Signaled when the last pending item or worker of a submission completes.
+		Condition m_completeCondition;
+
+		/// Singleton instance.
+		static JobPool* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		JobPool();
+		~JobPool();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		void ProcessItems();
+		void ReleasePending();
+		//@}
+	};
+}
+
+#include "Engine/JobPool.inl"
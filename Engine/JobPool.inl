@@ -0,0 +1,21 @@
+/// Get the number of worker threads owned by this pool.
+///
+/// @return  Number of worker threads.
+///
+/// @see GetConcurrency()
+uint32_t Helium::JobPool::GetWorkerCount() const
+{
+	return static_cast< uint32_t >( m_workers.GetSize() );
+}
+
+/// Get the number of threads that take part in running a submission (the workers plus the calling thread).
+///
+/// This is useful for sizing per-thread output buffers.
+///
+/// @return  Number of threads processing work items.
+///
+/// @see GetWorkerCount()
+uint32_t Helium::JobPool::GetConcurrency() const
+{
+	return GetWorkerCount() + 1;
+}
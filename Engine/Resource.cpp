@@ -12,7 +12,10 @@ using namespace Helium;
 
 /// Constructor.
 Resource::Resource()
+: m_residencyHandle( Invalid< size_t >() )
 {
+	m_residencyClient.m_pResource = this;
+
 #if HELIUM_TOOLS
 	for( size_t preprocessedDataIndex = 0;
 		preprocessedDataIndex < HELIUM_ARRAY_COUNT( m_preprocessedData );
@@ -26,6 +29,15 @@ Resource::Resource()
 /// Destructor.
 Resource::~Resource()
 {
+	HELIUM_ASSERT( IsInvalid( m_residencyHandle ) );
+}
+
+/// @copydoc Asset::RefCountPreDestroy()
+void Resource::RefCountPreDestroy()
+{
+	UnregisterResidency();
+
+	Base::RefCountPreDestroy();
 }
 
 /// Get the name of the resource cache to use for this resource.
@@ -131,12 +143,8 @@ size_t Resource::BeginLoadSubData( void* pBuffer, uint32_t subDataIndex, size_t
 		return Invalid< size_t >();
 	}
 
-	// Begin an asynchronous load.
-	size_t subDataSize = pCacheEntry->size;
-	size_t loadSize = Min( subDataSize, loadSizeMax );
-
-	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
-	size_t loadId = rAsyncLoader.QueueRequest( pBuffer, pCache->GetCacheFileName(), pCacheEntry->offset, loadSize );
+	// Begin an asynchronous load (decompressing the sub-data on the loader threads if it is stored compressed).
+	size_t loadId = pCache->BeginReadEntry( *pCacheEntry, pBuffer, loadSizeMax );
 
 	return loadId;
 }
@@ -166,3 +174,80 @@ bool Resource::TryFinishLoadSubData( size_t loadId )
 
 	return bFinished;
 }
+
+/// Start tracking the resident data of this resource with the ResourceResidencyManager.
+///
+/// If the resource is already being tracked, its data size is updated instead.  Resources that can release and
+/// reload their data on demand should override EvictResidentData() and RestoreResidentData(); resources that cannot
+/// should register themselves as pinned so that their memory is still accounted for.
+///
+/// @param[in] category  Budget category to which the resource data counts.
+/// @param[in] byteSize  Size of the resident data, in bytes.
+/// @param[in] bPinned   True if the resource data should never be evicted.
+///
+/// @see UnregisterResidency()
+void Resource::RegisterResidency( ResourceResidencyManager::ECategory category, size_t byteSize, bool bPinned )
+{
+	ResourceResidencyManager& rResidencyManager = ResourceResidencyManager::GetStaticInstance();
+
+	if( IsValid( m_residencyHandle ) )
+	{
+		rResidencyManager.SetSize( m_residencyHandle, byteSize );
+		rResidencyManager.SetPinned( m_residencyHandle, bPinned );
+
+		return;
+	}
+
+	const AssetType* pType = GetAssetType();
+	HELIUM_ASSERT( pType );
+
+	m_residencyHandle = rResidencyManager.Register( &m_residencyClient, category, pType->GetName(), byteSize, bPinned );
+}
+
+/// Stop tracking the resident data of this resource.
+///
+/// @see RegisterResidency()
+void Resource::UnregisterResidency()
+{
+	if( IsValid( m_residencyHandle ) )
+	{
+		ResourceResidencyManager::GetStaticInstance().Unregister( m_residencyHandle );
+		SetInvalid( m_residencyHandle );
+	}
+}
+
+/// Release the resident data of this resource when the residency manager needs to free memory.
+///
+/// The default implementation does nothing, so resources that do not override this should be registered as pinned.
+///
+/// @see RestoreResidentData(), RegisterResidency()
+void Resource::EvictResidentData()
+{
+}
+
+/// Restore resident data previously released by EvictResidentData().
+///
+/// This is called once per residency manager update after the resource has been used again, until it returns true.
+///
+/// @return  True if the resource data is resident again, false if restoring is still in progress.
+///
+/// @see EvictResidentData()
+bool Resource::RestoreResidentData()
+{
+	return true;
+}
+
+/// @copydoc ResidencyClient::EvictResidentData()
+void Resource::ResidencyClientAdapter::EvictResidentData()
+{
+	HELIUM_ASSERT( m_pResource );
+	m_pResource->EvictResidentData();
+}
+
+/// @copydoc ResidencyClient::RestoreResidentData()
+bool Resource::ResidencyClientAdapter::RestoreResidentData()
+{
+	HELIUM_ASSERT( m_pResource );
+
+	return m_pResource->RestoreResidentData();
+}
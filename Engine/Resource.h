@@ -3,6 +3,7 @@
 #include "Engine/Asset.h"
 
 #include "Engine/Cache.h"
+#include "Engine/ResourceResidencyManager.h"
 
 namespace Helium
 {
@@ -42,6 +43,17 @@ namespace Helium
 		virtual ~Resource();
 		//@}
 
+		/// @name Asset Interface
+		//@{
+		virtual void RefCountPreDestroy();
+		//@}
+
+		/// @name Residency Management
+		//@{
+		inline size_t GetResidencyHandle() const;
+		inline void TouchResidency() const;
+		//@}
+
 		/// @name Resource Serialization
 		//@{
 		virtual bool LoadPersistentResourceObject(Reflect::ObjectPtr &_object) { return false; }
@@ -68,7 +80,35 @@ namespace Helium
 		bool TryFinishLoadSubData( size_t loadId );
 		//@}
 
+		/// @name Residency Management, Protected
+		//@{
+		void RegisterResidency( ResourceResidencyManager::ECategory category, size_t byteSize, bool bPinned = false );
+		void UnregisterResidency();
+
+		virtual void EvictResidentData();
+		virtual bool RestoreResidentData();
+		//@}
+
 	private:
+		/// Forwards residency callbacks to the owning resource.
+		class ResidencyClientAdapter : public ResidencyClient
+		{
+		public:
+			/// Owning resource.
+			Resource* m_pResource;
+
+			/// @name Residency Callbacks
+			//@{
+			virtual void EvictResidentData();
+			virtual bool RestoreResidentData();
+			//@}
+		};
+
+		/// Residency manager client interface.
+		ResidencyClientAdapter m_residencyClient;
+		/// Handle of this resource in the residency manager (invalid if not registered).
+		size_t m_residencyHandle;
+
 #if HELIUM_TOOLS
 		/// In-memory preprocessed resource data for each platform.
 		PreprocessedData m_preprocessedData[ Cache::PLATFORM_MAX ];
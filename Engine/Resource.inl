@@ -1,3 +1,25 @@
+/// Get the handle of this resource in the ResourceResidencyManager.
+///
+/// @return  Residency handle, or an invalid index if the resource data is not being tracked.
+size_t Helium::Resource::GetResidencyHandle() const
+{
+    return m_residencyHandle;
+}
+
+/// Mark the data of this resource as used during the current frame.
+///
+/// If the data has been evicted, it will be restored during the next residency manager update.  This does nothing if
+/// the resource data is not being tracked.
+///
+/// @see ResourceResidencyManager::Touch()
+void Helium::Resource::TouchResidency() const
+{
+    if( IsValid( m_residencyHandle ) )
+    {
+        ResourceResidencyManager::GetStaticInstance().Touch( m_residencyHandle );
+    }
+}
+
 #if HELIUM_TOOLS
 /// Get the preprocessed resource data for the specified platform.
 ///
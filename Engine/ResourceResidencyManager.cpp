@@ -0,0 +1,447 @@
+#include "EnginePch.h"
+#include "Engine/ResourceResidencyManager.h"
+
+#include <algorithm>
+
+using namespace Helium;
+
+ResourceResidencyManager* ResourceResidencyManager::sm_pInstance = NULL;
+
+/// Destructor.
+ResidencyClient::~ResidencyClient()
+{
+}
+
+/// Constructor.
+ResourceResidencyManager::ResourceResidencyManager()
+: m_frameIndex( 0 )
+, m_evictionCount( 0 )
+, m_evictedBytes( 0 )
+, m_restoreCount( 0 )
+, m_restoredBytes( 0 )
+{
+	for( size_t categoryIndex = 0; categoryIndex < CATEGORY_MAX; ++categoryIndex )
+	{
+		m_budgets[ categoryIndex ] = 0;
+		m_residentBytes[ categoryIndex ] = 0;
+	}
+}
+
+/// Destructor.
+ResourceResidencyManager::~ResourceResidencyManager()
+{
+	HELIUM_ASSERT( m_entries.GetUsedSize() == 0 );
+}
+
+/// Register a client with resident data.
+///
+/// The client's data is assumed to be resident and is treated as having been used during the current frame.
+///
+/// @param[in] pClient   Client interface.  This must remain valid until the client is unregistered.
+/// @param[in] category  Budget category to which the client's data counts.
+/// @param[in] type      Name of the client's type, used for reporting.
+/// @param[in] byteSize  Size of the client's data, in bytes.
+/// @param[in] bPinned   True if the client's data should never be evicted.
+///
+/// @return  Handle for the client.
+///
+/// @see Unregister()
+size_t ResourceResidencyManager::Register(
+	ResidencyClient* pClient,
+	ECategory category,
+	Name type,
+	size_t byteSize,
+	bool bPinned )
+{
+	HELIUM_ASSERT( pClient );
+	HELIUM_ASSERT( static_cast< size_t >( category ) < static_cast< size_t >( CATEGORY_MAX ) );
+
+	Entry* pEntry = m_entries.New();
+	HELIUM_ASSERT( pEntry );
+	pEntry->pClient = pClient;
+	pEntry->byteSize = byteSize;
+	pEntry->typeIndex = GetTypeIndex( type );
+	pEntry->lastUseFrame = m_frameIndex;
+	pEntry->category = category;
+	pEntry->bResident = true;
+	pEntry->bPinned = bPinned;
+	pEntry->bRestoreRequested = false;
+
+	m_residentBytes[ category ] += byteSize;
+
+	TypeStatistics& rTypeStatistics = m_typeStatistics[ pEntry->typeIndex ];
+	++rTypeStatistics.clientCount;
+	++rTypeStatistics.residentCount;
+	rTypeStatistics.residentBytes += byteSize;
+
+	return m_entries.GetElementIndex( pEntry );
+}
+
+/// Unregister a client.
+///
+/// This must not be called from within the client's residency callbacks.
+///
+/// @param[in] handle  Handle of the client to unregister.
+///
+/// @see Register()
+void ResourceResidencyManager::Unregister( size_t handle )
+{
+	HELIUM_ASSERT( handle < m_entries.GetSize() );
+	HELIUM_ASSERT( m_entries.IsElementValid( handle ) );
+
+	Entry& rEntry = m_entries[ handle ];
+	TypeStatistics& rTypeStatistics = m_typeStatistics[ rEntry.typeIndex ];
+	HELIUM_ASSERT( rTypeStatistics.clientCount != 0 );
+	--rTypeStatistics.clientCount;
+
+	if( rEntry.bResident )
+	{
+		HELIUM_ASSERT( m_residentBytes[ rEntry.category ] >= rEntry.byteSize );
+		m_residentBytes[ rEntry.category ] -= rEntry.byteSize;
+
+		HELIUM_ASSERT( rTypeStatistics.residentCount != 0 );
+		--rTypeStatistics.residentCount;
+		rTypeStatistics.residentBytes -= rEntry.byteSize;
+	}
+
+	m_entries.Remove( handle );
+}
+
+/// Update the size of the data of a registered client.
+///
+/// @param[in] handle    Client handle.
+/// @param[in] byteSize  New data size, in bytes.
+///
+/// @see GetSize()
+void ResourceResidencyManager::SetSize( size_t handle, size_t byteSize )
+{
+	HELIUM_ASSERT( handle < m_entries.GetSize() );
+	HELIUM_ASSERT( m_entries.IsElementValid( handle ) );
+
+	Entry& rEntry = m_entries[ handle ];
+	if( rEntry.bResident )
+	{
+		HELIUM_ASSERT( m_residentBytes[ rEntry.category ] >= rEntry.byteSize );
+		m_residentBytes[ rEntry.category ] = m_residentBytes[ rEntry.category ] - rEntry.byteSize + byteSize;
+
+		TypeStatistics& rTypeStatistics = m_typeStatistics[ rEntry.typeIndex ];
+		rTypeStatistics.residentBytes = rTypeStatistics.residentBytes - rEntry.byteSize + byteSize;
+	}
+
+	rEntry.byteSize = byteSize;
+}
+
+/// Set whether a registered client is pinned.
+///
+/// Pinned clients count towards their category's budget, but their data is never evicted.
+///
+/// @param[in] handle   Client handle.
+/// @param[in] bPinned  True to pin the client's data, false to allow it to be evicted.
+///
+/// @see IsPinned()
+void ResourceResidencyManager::SetPinned( size_t handle, bool bPinned )
+{
+	HELIUM_ASSERT( handle < m_entries.GetSize() );
+	HELIUM_ASSERT( m_entries.IsElementValid( handle ) );
+
+	m_entries[ handle ].bPinned = bPinned;
+}
+
+/// Mark a registered client as used during the current frame.
+///
+/// If the client's data has been evicted, it will be asked to restore it during the next Update().
+///
+/// @param[in] handle  Client handle.
+///
+/// @return  True if the client's data is resident, false if it is not.
+///
+/// @see Update(), GetLastUseFrame()
+bool ResourceResidencyManager::Touch( size_t handle )
+{
+	HELIUM_ASSERT( handle < m_entries.GetSize() );
+	HELIUM_ASSERT( m_entries.IsElementValid( handle ) );
+
+	Entry& rEntry = m_entries[ handle ];
+	rEntry.lastUseFrame = m_frameIndex;
+	if( rEntry.bResident )
+	{
+		return true;
+	}
+
+	rEntry.bRestoreRequested = true;
+
+	return false;
+}
+
+/// Restore evicted clients that have been used, enforce the budget of each category, and advance to the next frame.
+///
+/// This should be called once per frame, after all usage for the frame has been recorded.
+///
+/// @see Touch(), SetBudget()
+void ResourceResidencyManager::Update()
+{
+	RestoreRequested();
+
+	for( size_t categoryIndex = 0; categoryIndex < CATEGORY_MAX; ++categoryIndex )
+	{
+		EnforceBudget( static_cast< ECategory >( categoryIndex ) );
+	}
+
+	++m_frameIndex;
+}
+
+/// Reset the eviction and restore statistics.
+///
+/// @see GetEvictionCount(), GetEvictedBytes(), GetRestoreCount(), GetRestoredBytes()
+void ResourceResidencyManager::ResetStatistics()
+{
+	m_evictionCount = 0;
+	m_evictedBytes = 0;
+	m_restoreCount = 0;
+	m_restoredBytes = 0;
+
+	size_t typeCount = m_typeStatistics.GetSize();
+	for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		TypeStatistics& rTypeStatistics = m_typeStatistics[ typeIndex ];
+		rTypeStatistics.evictionCount = 0;
+		rTypeStatistics.restoreCount = 0;
+	}
+}
+
+/// Write the current residency state and statistics to the trace output.
+void ResourceResidencyManager::TraceReport() const
+{
+	static const tchar_t* const categoryNames[ CATEGORY_MAX ] = { TXT( "GPU" ), TXT( "CPU" ) };
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "Resource residency (frame %" ) PRIu32 TXT( "): %" ) PRIuSZ TXT( " evictions (%" ) PRIuSZ
+		TXT( " bytes), %" ) PRIuSZ TXT( " restores (%" ) PRIuSZ TXT( " bytes).\n" ) ),
+		m_frameIndex,
+		m_evictionCount,
+		m_evictedBytes,
+		m_restoreCount,
+		m_restoredBytes );
+
+	for( size_t categoryIndex = 0; categoryIndex < CATEGORY_MAX; ++categoryIndex )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "  %s: %" ) PRIuSZ TXT( " bytes resident, budget %" ) PRIuSZ TXT( " bytes.\n" ),
+			categoryNames[ categoryIndex ],
+			m_residentBytes[ categoryIndex ],
+			m_budgets[ categoryIndex ] );
+	}
+
+	size_t typeCount = m_typeStatistics.GetSize();
+	for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		const TypeStatistics& rTypeStatistics = m_typeStatistics[ typeIndex ];
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "  %s: %" ) PRIuSZ TXT( "/%" ) PRIuSZ TXT( " resident (%" ) PRIuSZ TXT( " bytes), %" ) PRIuSZ
+			TXT( " evictions, %" ) PRIuSZ TXT( " restores.\n" ) ),
+			*rTypeStatistics.type,
+			rTypeStatistics.residentCount,
+			rTypeStatistics.clientCount,
+			rTypeStatistics.residentBytes,
+			rTypeStatistics.evictionCount,
+			rTypeStatistics.restoreCount );
+	}
+}
+
+/// Get the singleton ResourceResidencyManager instance, creating it if necessary.
+///
+/// @return  Reference to the ResourceResidencyManager instance.
+///
+/// @see DestroyStaticInstance()
+ResourceResidencyManager& ResourceResidencyManager::GetStaticInstance()
+{
+	if( !sm_pInstance )
+	{
+		sm_pInstance = new ResourceResidencyManager;
+		HELIUM_ASSERT( sm_pInstance );
+	}
+
+	return *sm_pInstance;
+}
+
+/// Destroy the singleton ResourceResidencyManager instance.
+///
+/// All clients must be unregistered prior to calling this.
+///
+/// @see GetStaticInstance()
+void ResourceResidencyManager::DestroyStaticInstance()
+{
+	delete sm_pInstance;
+	sm_pInstance = NULL;
+}
+
+/// Get the index of the statistics for a given type, adding them if necessary.
+///
+/// @param[in] type  Type name.
+///
+/// @return  Index of the type statistics.
+size_t ResourceResidencyManager::GetTypeIndex( Name type )
+{
+	size_t typeCount = m_typeStatistics.GetSize();
+	for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		if( m_typeStatistics[ typeIndex ].type == type )
+		{
+			return typeIndex;
+		}
+	}
+
+	TypeStatistics* pTypeStatistics = m_typeStatistics.New();
+	HELIUM_ASSERT( pTypeStatistics );
+	pTypeStatistics->type = type;
+	pTypeStatistics->clientCount = 0;
+	pTypeStatistics->residentCount = 0;
+	pTypeStatistics->residentBytes = 0;
+	pTypeStatistics->evictionCount = 0;
+	pTypeStatistics->restoreCount = 0;
+
+	return typeCount;
+}
+
+/// Ask each evicted client that has been used to restore its data.
+void ResourceResidencyManager::RestoreRequested()
+{
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		if( !m_entries.IsElementValid( entryIndex ) )
+		{
+			continue;
+		}
+
+		Entry& rEntry = m_entries[ entryIndex ];
+		if( !rEntry.bRestoreRequested )
+		{
+			continue;
+		}
+
+		HELIUM_ASSERT( !rEntry.bResident );
+		HELIUM_ASSERT( rEntry.pClient );
+		if( !rEntry.pClient->RestoreResidentData() )
+		{
+			continue;
+		}
+
+		rEntry.bResident = true;
+		rEntry.bRestoreRequested = false;
+
+		m_residentBytes[ rEntry.category ] += rEntry.byteSize;
+
+		TypeStatistics& rTypeStatistics = m_typeStatistics[ rEntry.typeIndex ];
+		++rTypeStatistics.residentCount;
+		rTypeStatistics.residentBytes += rEntry.byteSize;
+		++rTypeStatistics.restoreCount;
+
+		++m_restoreCount;
+		m_restoredBytes += rEntry.byteSize;
+	}
+}
+
+/// Evict the least recently used data in a category until it fits within its budget.
+///
+/// @param[in] category  Budget category.
+void ResourceResidencyManager::EnforceBudget( ECategory category )
+{
+	size_t budget = m_budgets[ category ];
+	if( budget == 0 || m_residentBytes[ category ] <= budget )
+	{
+		return;
+	}
+
+	m_evictionCandidates.Resize( 0 );
+
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		if( !m_entries.IsElementValid( entryIndex ) )
+		{
+			continue;
+		}
+
+		const Entry& rEntry = m_entries[ entryIndex ];
+		if( rEntry.category == category &&
+			rEntry.bResident &&
+			!rEntry.bPinned &&
+			rEntry.lastUseFrame != m_frameIndex )
+		{
+			m_evictionCandidates.Push( entryIndex );
+		}
+	}
+
+	size_t candidateCount = m_evictionCandidates.GetSize();
+	std::sort(
+		m_evictionCandidates.GetData(),
+		m_evictionCandidates.GetData() + candidateCount,
+		LruCompare( m_entries ) );
+
+	for( size_t candidateIndex = 0;
+		candidateIndex < candidateCount && m_residentBytes[ category ] > budget;
+		++candidateIndex )
+	{
+		Evict( m_evictionCandidates[ candidateIndex ] );
+	}
+}
+
+/// Evict the data of a registered client.
+///
+/// @param[in] entryIndex  Index of the client entry.
+void ResourceResidencyManager::Evict( size_t entryIndex )
+{
+	Entry& rEntry = m_entries[ entryIndex ];
+	HELIUM_ASSERT( rEntry.bResident );
+	HELIUM_ASSERT( !rEntry.bPinned );
+	HELIUM_ASSERT( rEntry.pClient );
+
+	rEntry.pClient->EvictResidentData();
+
+	rEntry.bResident = false;
+	rEntry.bRestoreRequested = false;
+
+	HELIUM_ASSERT( m_residentBytes[ rEntry.category ] >= rEntry.byteSize );
+	m_residentBytes[ rEntry.category ] -= rEntry.byteSize;
+
+	TypeStatistics& rTypeStatistics = m_typeStatistics[ rEntry.typeIndex ];
+	HELIUM_ASSERT( rTypeStatistics.residentCount != 0 );
+	--rTypeStatistics.residentCount;
+	rTypeStatistics.residentBytes -= rEntry.byteSize;
+	++rTypeStatistics.evictionCount;
+
+	++m_evictionCount;
+	m_evictedBytes += rEntry.byteSize;
+}
+
+/// Constructor.
+///
+/// @param[in] rEntries  Registered clients.
+ResourceResidencyManager::LruCompare::LruCompare( const SparseArray< Entry >& rEntries )
+: m_pEntries( &rEntries )
+{
+}
+
+/// Get whether one client was last used before another.
+///
+/// @param[in] entryIndex0  Index of the first client entry.
+/// @param[in] entryIndex1  Index of the second client entry.
+///
+/// @return  True if the first client was last used before the second, false if not.
+bool ResourceResidencyManager::LruCompare::operator()( size_t entryIndex0, size_t entryIndex1 ) const
+{
+	HELIUM_ASSERT( m_pEntries );
+
+	uint32_t lastUseFrame0 = ( *m_pEntries )[ entryIndex0 ].lastUseFrame;
+	uint32_t lastUseFrame1 = ( *m_pEntries )[ entryIndex1 ].lastUseFrame;
+	if( lastUseFrame0 != lastUseFrame1 )
+	{
+		return ( lastUseFrame0 < lastUseFrame1 );
+	}
+
+	return ( entryIndex0 < entryIndex1 );
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/Name.h"
+#include "Foundation/SparseArray.h"
+
+namespace Helium
+{
+	/// Interface for objects whose resident data can be released and restored by the ResourceResidencyManager.
+	class HELIUM_ENGINE_API ResidencyClient
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		virtual ~ResidencyClient();
+		//@}
+
+		/// @name Residency Callbacks
+		//@{
+		/// Release the resident data of this client.  The client itself remains registered with the manager, and may be
+		/// asked to restore its data once it is used again.
+		virtual void EvictResidentData() = 0;
+
+		/// Restore previously evicted data.  This is called once per update after an evicted client has been used, until
+		/// it returns true.
+		///
+		/// @return  True if the data is resident again, false if restoring is still in progress.
+		virtual bool RestoreResidentData() = 0;
+		//@}
+	};
+
+	/// Manager for keeping the resident data of resources within memory budgets.
+	///
+	/// Clients register the size of their resident data along with a budget category and a type name used for reporting.
+	/// Each frame, code that uses the data (i.e. the graphics scene for anything that was visible) touches the clients
+	/// it needs, and Update() then evicts the least recently used clients in each category that is over its budget.
+	/// Pinned clients are accounted for but never evicted, and clients used during the current frame are never evicted
+	/// either, so a category can remain over budget if everything in it is in use.  Evicted clients are restored on
+	/// demand the next time they are touched, with each restore counted as churn.
+	///
+	/// The manager is not thread-safe and should only be used from the main thread.
+	class HELIUM_ENGINE_API ResourceResidencyManager : NonCopyable
+	{
+	public:
+		/// Budget categories.
+		enum ECategory
+		{
+			CATEGORY_FIRST   =  0,
+			CATEGORY_INVALID = -1,
+
+			/// Data resident in GPU memory (textures, vertex and index buffers, etc.).
+			CATEGORY_GPU,
+			/// Data resident in main memory.
+			CATEGORY_CPU,
+
+			CATEGORY_MAX,
+			CATEGORY_LAST = CATEGORY_MAX - 1
+		};
+
+		/// Resident data statistics for a single resource type.
+		struct TypeStatistics
+		{
+			/// Type name.
+			Name type;
+			/// Number of registered clients of this type.
+			size_t clientCount;
+			/// Number of clients of this type with resident data.
+			size_t residentCount;
+			/// Total size of the resident data of this type, in bytes.
+			size_t residentBytes;
+			/// Number of times data of this type has been evicted.
+			size_t evictionCount;
+			/// Number of times data of this type has been restored after being evicted.
+			size_t restoreCount;
+		};
+
+		/// @name Construction/Destruction
+		//@{
+		ResourceResidencyManager();
+		~ResourceResidencyManager();
+		//@}
+
+		/// @name Client Registration
+		//@{
+		size_t Register( ResidencyClient* pClient, ECategory category, Name type, size_t byteSize, bool bPinned = false );
+		void Unregister( size_t handle );
+
+		void SetSize( size_t handle, size_t byteSize );
+		void SetPinned( size_t handle, bool bPinned );
+
+		inline bool IsResident( size_t handle ) const;
+		inline bool IsPinned( size_t handle ) const;
+		inline size_t GetSize( size_t handle ) const;
+		inline uint32_t GetLastUseFrame( size_t handle ) const;
+		//@}
+
+		/// @name Usage Tracking
+		//@{
+		bool Touch( size_t handle );
+
+		void Update();
+		inline uint32_t GetFrameIndex() const;
+		//@}
+
+		/// @name Budgets
+		//@{
+		inline void SetBudget( ECategory category, size_t byteSize );
+		inline size_t GetBudget( ECategory category ) const;
+		inline size_t GetResidentBytes( ECategory category ) const;
+		//@}
+
+		/// @name Statistics
+		//@{
+		inline size_t GetEvictionCount() const;
+		inline size_t GetEvictedBytes() const;
+		inline size_t GetRestoreCount() const;
+		inline size_t GetRestoredBytes() const;
+		inline const DynamicArray< TypeStatistics >& GetTypeStatistics() const;
+
+		void ResetStatistics();
+		void TraceReport() const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static ResourceResidencyManager& GetStaticInstance();
+		static void DestroyStaticInstance();
+		//@}
+
+	private:
+		/// Registered client.
+		struct Entry
+		{
+			/// Client interface.
+			ResidencyClient* pClient;
+			/// Size of the client's data, in bytes.
+			size_t byteSize;
+			/// Index of the type statistics for the client's type.
+			size_t typeIndex;
+			/// Frame index at which the client was last used.
+			uint32_t lastUseFrame;
+			/// Budget category.
+			ECategory category;
+			/// True if the client's data is currently resident.
+			bool bResident;
+			/// True if the client's data must never be evicted.
+			bool bPinned;
+			/// True if the client has been used since its data was evicted.
+			bool bRestoreRequested;
+		};
+
+		/// Least recently used ordering for eviction candidates.
+		class LruCompare
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			explicit LruCompare( const SparseArray< Entry >& rEntries );
+			//@}
+
+			/// @name Overloaded Operators
+			//@{
+			bool operator()( size_t entryIndex0, size_t entryIndex1 ) const;
+			//@}
+
+		private:
+			/// Registered clients.
+			const SparseArray< Entry >* m_pEntries;
+		};
+
+		/// Registered clients.
+		SparseArray< Entry > m_entries;
+		/// Statistics for each type of client registered.
+		DynamicArray< TypeStatistics > m_typeStatistics;
+		/// Scratch list of eviction candidates (kept around to avoid reallocation).
+		DynamicArray< size_t > m_evictionCandidates;
+
+		/// Budget for each category, in bytes (zero if unlimited).
+		size_t m_budgets[ CATEGORY_MAX ];
+		/// Total size of the resident data in each category, in bytes.
+		size_t m_residentBytes[ CATEGORY_MAX ];
+
+		/// Current frame index.
+		uint32_t m_frameIndex;
+
+		/// Number of evictions performed.
+		size_t m_evictionCount;
+		/// Total size of all data evicted, in bytes.
+		size_t m_evictedBytes;
+		/// Number of evicted clients that have been restored.
+		size_t m_restoreCount;
+		/// Total size of all data restored, in bytes.
+		size_t m_restoredBytes;
+
+		/// Singleton instance.
+		static ResourceResidencyManager* sm_pInstance;
+
+		/// @name Private Utility Functions
+		//@{
+		size_t GetTypeIndex( Name type );
+		void RestoreRequested();
+		void EnforceBudget( ECategory category );
+		void Evict( size_t entryIndex );
+		//@}
+	};
+}
+
+#include "Engine/ResourceResidencyManager.inl"
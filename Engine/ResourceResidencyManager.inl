@@ -0,0 +1,156 @@
+/// Get whether the data of a registered client is currently resident.
+///
+/// @param[in] handle  Client handle.
+///
+/// @return  True if the client's data is resident, false if it has been evicted.
+bool Helium::ResourceResidencyManager::IsResident( size_t handle ) const
+{
+	HELIUM_ASSERT( handle < m_entries.GetSize() && m_entries.IsElementValid( handle ) );
+
+	return m_entries[ handle ].bResident;
+}
+
+/// Get whether a registered client is pinned.
+///
+/// @param[in] handle  Client handle.
+///
+/// @return  True if the client's data is never evicted, false if not.
+///
+/// @see SetPinned()
+bool Helium::ResourceResidencyManager::IsPinned( size_t handle ) const
+{
+	HELIUM_ASSERT( handle < m_entries.GetSize() && m_entries.IsElementValid( handle ) );
+
+	return m_entries[ handle ].bPinned;
+}
+
+/// Get the size of the data of a registered client.
+///
+/// @param[in] handle  Client handle.
+///
+/// @return  Data size, in bytes.
+///
+/// @see SetSize()
+size_t Helium::ResourceResidencyManager::GetSize( size_t handle ) const
+{
+	HELIUM_ASSERT( handle < m_entries.GetSize() && m_entries.IsElementValid( handle ) );
+
+	return m_entries[ handle ].byteSize;
+}
+
+/// Get the index of the frame during which a registered client was last used.
+///
+/// @param[in] handle  Client handle.
+///
+/// @return  Frame index.
+///
+/// @see Touch(), GetFrameIndex()
+uint32_t Helium::ResourceResidencyManager::GetLastUseFrame( size_t handle ) const
+{
+	HELIUM_ASSERT( handle < m_entries.GetSize() && m_entries.IsElementValid( handle ) );
+
+	return m_entries[ handle ].lastUseFrame;
+}
+
+/// Get the index of the current frame.
+///
+/// @return  Current frame index.
+///
+/// @see Update()
+uint32_t Helium::ResourceResidencyManager::GetFrameIndex() const
+{
+	return m_frameIndex;
+}
+
+/// Set the memory budget for a category.
+///
+/// The budget is enforced during the next Update().
+///
+/// @param[in] category  Budget category.
+/// @param[in] byteSize  Budget, in bytes, or zero to leave the category unlimited.
+///
+/// @see GetBudget()
+void Helium::ResourceResidencyManager::SetBudget( ECategory category, size_t byteSize )
+{
+	HELIUM_ASSERT( static_cast< size_t >( category ) < static_cast< size_t >( CATEGORY_MAX ) );
+
+	m_budgets[ category ] = byteSize;
+}
+
+/// Get the memory budget for a category.
+///
+/// @param[in] category  Budget category.
+///
+/// @return  Budget, in bytes, or zero if the category is unlimited.
+///
+/// @see SetBudget()
+size_t Helium::ResourceResidencyManager::GetBudget( ECategory category ) const
+{
+	HELIUM_ASSERT( static_cast< size_t >( category ) < static_cast< size_t >( CATEGORY_MAX ) );
+
+	return m_budgets[ category ];
+}
+
+/// Get the total size of the resident data in a category.
+///
+/// @param[in] category  Budget category.
+///
+/// @return  Resident data size, in bytes.
+size_t Helium::ResourceResidencyManager::GetResidentBytes( ECategory category ) const
+{
+	HELIUM_ASSERT( static_cast< size_t >( category ) < static_cast< size_t >( CATEGORY_MAX ) );
+
+	return m_residentBytes[ category ];
+}
+
+/// Get the number of evictions performed since the statistics were last reset.
+///
+/// @return  Eviction count.
+///
+/// @see GetEvictedBytes(), ResetStatistics()
+size_t Helium::ResourceResidencyManager::GetEvictionCount() const
+{
+	return m_evictionCount;
+}
+
+/// Get the total size of the data evicted since the statistics were last reset.
+///
+/// @return  Evicted data size, in bytes.
+///
+/// @see GetEvictionCount(), ResetStatistics()
+size_t Helium::ResourceResidencyManager::GetEvictedBytes() const
+{
+	return m_evictedBytes;
+}
+
+/// Get the number of evicted clients restored since the statistics were last reset.
+///
+/// Each restore is data that was evicted but turned out to be needed again, so this is a measure of the churn caused
+/// by the current budgets.
+///
+/// @return  Restore count.
+///
+/// @see GetRestoredBytes(), ResetStatistics()
+size_t Helium::ResourceResidencyManager::GetRestoreCount() const
+{
+	return m_restoreCount;
+}
+
+/// Get the total size of the data restored since the statistics were last reset.
+///
+/// @return  Restored data size, in bytes.
+///
+/// @see GetRestoreCount(), ResetStatistics()
+size_t Helium::ResourceResidencyManager::GetRestoredBytes() const
+{
+	return m_restoredBytes;
+}
+
+/// Get the statistics for each type of client registered.
+///
+/// @return  Per-type statistics.
+const Helium::DynamicArray< Helium::ResourceResidencyManager::TypeStatistics >&
+	Helium::ResourceResidencyManager::GetTypeStatistics() const
+{
+	return m_typeStatistics;
+}
@@ -68,7 +68,10 @@ void ExampleGame::SpriteComponent::Render( Helium::BufferedDrawer &rBufferedDraw
 
 		m_Dirty = false;
 	}
-	
+
+	// Sprites are drawn outside of the graphics scene, so request full texture detail directly.
+	m_Texture->RequestScreenSize( static_cast<float32_t>( Max( m_Texture->GetWidth(), m_Texture->GetHeight() ) ) );
+
 	// Not really sure why I had to split this into two matrices but it works
 	Helium::Simd::Matrix44 matrix(
 		Helium::Simd::Matrix44::INIT_ROTATION_TRANSLATION, 
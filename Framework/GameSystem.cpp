@@ -1,13 +1,16 @@
 #include "FrameworkPch.h"
 #include "Framework/GameSystem.h"
 
+#include "Engine/AssetLoader.h"
 #include "Engine/AsyncLoader.h"
+#include "Engine/JobPool.h"
 #include "Engine/FileLocations.h"
 #include "Foundation/FilePath.h"
 #include "Reflect/Registry.h"
 #include "Platform/Timer.h"
 #include "Engine/Config.h"
 #include "Engine/CacheManager.h"
+#include "Engine/ResourceResidencyManager.h"
 #include "Framework/CommandLineInitialization.h"
 #include "Framework/MemoryHeapPreInitialization.h"
 #include "Framework/AssetLoaderInitialization.h"
@@ -87,6 +90,16 @@ bool GameSystem::Initialize(
 		return false;
 	}
 
+	// Start the worker threads used for parallel engine work.
+	bool bJobPoolInitSuccess = JobPool::GetStaticInstance().Initialize();
+	HELIUM_ASSERT( bJobPoolInitSuccess );
+	if( !bJobPoolInitSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "GameSystem::Initialize(): Job pool initialization failed.\n" ) );
+
+		return false;
+	}
+
 	//pmd - Initialize the cache manager
 	FilePath baseDirectory;
 	if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
@@ -212,8 +225,10 @@ void GameSystem::Shutdown()
 	Reflect::Cleanup();
 	AssetType::Shutdown();
 	Asset::Shutdown();
+	ResourceResidencyManager::DestroyStaticInstance();
 
 	AsyncLoader::DestroyStaticInstance();
+	JobPool::DestroyStaticInstance();
 
 	Reflect::ObjectRefCountSupport::Shutdown();
 
@@ -240,6 +255,8 @@ int32_t GameSystem::Run()
 
 		WorldManager& rWorldManager = WorldManager::GetStaticInstance();
 		rWorldManager.Update( m_Schedule );
+
+		ResourceResidencyManager::GetStaticInstance().Update();
 	}
 
 	m_bStopRunning = false;
@@ -267,8 +284,20 @@ GameSystem* GameSystem::CreateStaticInstance()
 	return pSystem;
 }
 
+/// Create a world for the given scene.
+///
+/// The asset load telemetry gathered since the previous scene was loaded (which covers loading this scene's
+/// definition) is written to the trace output and reset, so each report covers a single level load.
+///
+/// @param[in] pSceneDefinition  Scene to create a world for.
+///
+/// @return  Newly created world.
 World *GameSystem::LoadScene( SceneDefinition *pSceneDefinition )
 {
+	AssetLoadTelemetry& rLoadTelemetry = AssetLoader::GetStaticInstance()->GetLoadTelemetry();
+	rLoadTelemetry.TraceReport();
+	rLoadTelemetry.Reset();
+
 	WorldManager &rWorldManager = WorldManager::GetStaticInstance();
 
 	return rWorldManager.CreateWorld( pSceneDefinition );
@@ -11,6 +11,7 @@
 #endif
 
 #include "Graphics/RenderResourceManager.h"
+#include "Graphics/TextureStreamingManager.h"
 #include "Graphics/DynamicDrawer.h"
 
 using namespace Helium;
@@ -144,6 +145,8 @@ void Helium::RendererInitializationImpl::Shutdown()
 		Renderer::DestroyStaticInstance();
 	}
 
+	TextureStreamingManager::DestroyStaticInstance();
+
 	WindowManager* pWindowManager = WindowManager::GetStaticInstance();
 	if( pWindowManager )
 	{
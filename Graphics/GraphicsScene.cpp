@@ -21,6 +21,7 @@
 #include "Graphics/Material.h"
 #include "Graphics/RenderResourceManager.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureStreamingManager.h"
 #include "Framework/World.h"
 #include "Framework/Entity.h"
 #include "Framework/Slice.h"
@@ -192,6 +193,9 @@ void GraphicsScene::Update( World *pWorld )
     // Finish drawing with the scene's buffered drawer.
     m_sceneBufferedDrawer.EndDrawing();
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+    // Stream texture mip levels in and out based on the detail requested while drawing.
+    TextureStreamingManager::GetStaticInstance().Update();
 }
 
 /// Allocate a new scene view.
@@ -1191,6 +1195,50 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
         }
     }
 
+    // Record the use of each texture referenced by a visible sub-mesh so that the residency manager keeps the textures
+    // in view resident (and restores any that were evicted), and request the texture detail needed for the on-screen
+    // size of each sub-mesh's scene object (texture coordinate tiling is not taken into account).
+    const Simd::Vector3& rViewOrigin = rView.GetOrigin();
+    float32_t viewportWidth = static_cast< float32_t >( rView.GetViewportWidth() );
+    float32_t horizontalFov = rView.GetHorizontalFov();
+    float32_t projectionScale = 0.0f;
+    if( horizontalFov >= HELIUM_EPSILON )
+    {
+        projectionScale = viewportWidth / Tan( static_cast< float32_t >( HELIUM_DEG_TO_RAD ) * horizontalFov * 0.5f );
+    }
+
+    size_t visibleSubMeshCount = m_sceneObjectSubMeshIndices.GetSize();
+    for( size_t visibleSubMeshIndex = 0; visibleSubMeshIndex < visibleSubMeshCount; ++visibleSubMeshIndex )
+    {
+        size_t subMeshIndex = m_sceneObjectSubMeshIndices[ visibleSubMeshIndex ];
+        const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ subMeshIndex ];
+        Material* pMaterial = rSubMeshData.GetMaterial();
+        if( !pMaterial )
+        {
+            continue;
+        }
+
+        const Simd::Sphere& rObjectBounds = m_sceneObjects[ rSubMeshData.GetSceneObjectId() ].GetWorldSphere();
+        float32_t objectRadius = rObjectBounds.GetRadius();
+        float32_t screenSize = objectRadius * 2.0f;
+        if( projectionScale != 0.0f )
+        {
+            float32_t objectDistance = ( rObjectBounds.GetCenter() - rViewOrigin ).GetMagnitude();
+            screenSize = objectRadius / Max( objectDistance, objectRadius ) * projectionScale;
+        }
+
+        size_t materialTextureCount = pMaterial->GetTextureParameterCount();
+        for( size_t materialTextureIndex = 0; materialTextureIndex < materialTextureCount; ++materialTextureIndex )
+        {
+            Texture* pTexture = pMaterial->GetTextureParameter( materialTextureIndex ).value;
+            if( pTexture )
+            {
+                pTexture->TouchResidency();
+                pTexture->RequestScreenSize( screenSize );
+            }
+        }
+    }
+
     // Get the renderer interface and the main command proxy for the renderer.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
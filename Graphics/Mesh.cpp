@@ -214,6 +214,24 @@ bool Mesh::TryFinishPrecacheResourceData()
         m_spIndexBuffer->Unmap();
     }
 
+    // Scene objects hold their own references to the vertex and index buffers, so releasing ours would not free any
+    // memory.  The buffers are only tracked for accounting purposes.
+    size_t residentSize = 0;
+    if( m_spVertexBuffer )
+    {
+        residentSize += GetSubDataSize( 0 );
+    }
+
+    if( m_spIndexBuffer )
+    {
+        residentSize += GetSubDataSize( 1 );
+    }
+
+    if( residentSize != 0 )
+    {
+        RegisterResidency( ResourceResidencyManager::CATEGORY_GPU, residentSize, true );
+    }
+
     return true;
 }
 
@@ -247,6 +265,7 @@ bool Helium::Mesh::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
 {    
     m_spVertexBuffer.Release();
     m_spIndexBuffer.Release();
+    UnregisterResidency();
 
     HELIUM_ASSERT(_object.ReferencesObject());
     if (!_object.ReferencesObject())
@@ -42,6 +42,8 @@ void Texture::PopulateMetaType( Reflect::MetaStruct& comp )
 
 /// Get the render resource as a RTexture2d if this is a 2D texture.
 ///
+/// Implementations should mark the texture data as used during the current frame, as GetRenderResource() does.
+///
 /// @return  Pointer to the RTexture2d object for this texture if it is a 2D texture, null if it is not or if there
 ///          is no render resource allocated.
 RTexture2d* Texture::GetRenderResource2d() const
@@ -49,6 +51,17 @@ RTexture2d* Texture::GetRenderResource2d() const
     return NULL;
 }
 
+/// Request the mip level needed to draw this texture at a given size on screen during the current frame.
+///
+/// Texture types that support mip streaming use this to decide which mip levels to keep resident.  The default
+/// implementation does nothing.
+///
+/// @param[in] screenSize  Projected size of the texture on screen, in pixels.
+void Texture::RequestScreenSize( float32_t screenSize )
+{
+    HELIUM_UNREF( screenSize );
+}
+
 /// @copydoc Resource::GetCacheName()
 Name Texture::GetCacheName() const
 {
@@ -84,6 +84,11 @@ namespace Helium
         virtual Name GetCacheName() const;
         //@}
 
+        /// @name Mip Streaming
+        //@{
+        virtual void RequestScreenSize( float32_t screenSize );
+        //@}
+
         /// @name Static Utility Functions
         //@{
         inline static bool IsNormalMapCompression( ECompression compression );
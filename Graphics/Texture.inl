@@ -2,9 +2,16 @@ namespace Helium
 {
     /// Get the render resource for this texture.
     ///
+    /// Fetching the render resource marks the texture data as used during the current frame, so the data of a texture
+    /// that is drawn is restored if it has been evicted.
+    ///
     /// @return  Render resource pointer.  It's reference count is not automatically incremented.
+    ///
+    /// @see TouchResidency()
     RTexture* Texture::GetRenderResource() const
     {
+        TouchResidency();
+
         return m_spTexture;
     }
 
@@ -1,6 +1,7 @@
 #include "GraphicsPch.h"
 #include "Graphics/Texture2d.h"
 
+#include "Platform/Thread.h"
 #include "Rendering/RendererUtil.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/RTexture2d.h"
@@ -31,12 +32,29 @@ void Texture2d::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& c
 
 /// Constructor.
 Texture2d::Texture2d()
+: m_renderResourceSize( 0 )
+, m_loadingTextureSize( 0 )
+, m_residentMipIndex( Invalid< uint32_t >() )
+, m_loadingMipIndex( Invalid< uint32_t >() )
+, m_streamingHandle( Invalid< size_t >() )
+, m_bDiscardLoadingTexture( false )
 {
+    m_streamingClient.m_pTexture = this;
 }
 
 /// Destructor.
 Texture2d::~Texture2d()
 {
+    HELIUM_ASSERT( !m_spLoadingTexture );
+    HELIUM_ASSERT( IsInvalid( m_streamingHandle ) );
+}
+
+/// @copydoc Asset::RefCountPreDestroy()
+void Texture2d::RefCountPreDestroy()
+{
+    ReleaseRenderResources();
+
+    Base::RefCountPreDestroy();
 }
 
 /// @copydoc Asset::NeedsPrecacheResourceData()
@@ -46,9 +64,148 @@ bool Texture2d::NeedsPrecacheResourceData() const
 }
 
 /// @copydoc Asset::BeginPrecacheResourceData()
+///
+/// When texture streaming is enabled, only the smallest mip levels are loaded here; the texture streaming manager
+/// loads the rest as they are needed.
 bool Texture2d::BeginPrecacheResourceData()
+{
+    // Nothing is loaded without a renderer, so don't bring up the streaming manager (which is shut down along with the
+    // renderer).
+    if( !Renderer::GetStaticInstance() )
+    {
+        return true;
+    }
+
+    uint32_t firstMipIndex = TextureStreamingManager::GetStaticInstance().GetInitialMipIndex(
+        m_persistentResourceData.m_mipCount );
+
+    return BeginLoadMips( firstMipIndex );
+}
+
+/// @copydoc Asset::TryFinishPrecacheResourceData()
+bool Texture2d::TryFinishPrecacheResourceData()
+{
+    return TryFinishLoadMips();
+}
+
+bool Texture2d::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+{
+    ReleaseRenderResources();
+
+    HELIUM_ASSERT(_object.ReferencesObject());
+    if (!_object.ReferencesObject())
+    {
+        return false;
+    }
+
+    _object->CopyTo(&m_persistentResourceData);
+
+    return true;
+}
+
+/// @copydoc Texture::GetRenderResource2d()
+RTexture2d* Texture2d::GetRenderResource2d() const
+{
+    TouchResidency();
+
+    return static_cast< RTexture2d* >( m_spTexture.Get() );
+}
+
+/// @copydoc Texture::RequestScreenSize()
+void Texture2d::RequestScreenSize( float32_t screenSize )
+{
+    if( IsInvalid( m_streamingHandle ) )
+    {
+        return;
+    }
+
+    uint32_t baseLevelSize = Max( m_persistentResourceData.m_baseLevelWidth, m_persistentResourceData.m_baseLevelHeight );
+    uint32_t mipIndex = TextureStreamingManager::ComputeDesiredMipIndex(
+        baseLevelSize,
+        m_persistentResourceData.m_mipCount,
+        screenSize );
+
+    TextureStreamingManager::GetStaticInstance().RequestMipIndex( m_streamingHandle, mipIndex );
+}
+
+/// Begin loading a new render resource holding a different range of mip levels.
+///
+/// The current render resource remains in use until TryFinishStreamMips() reports that the new one has been loaded.
+///
+/// @param[in] firstMipIndex  Index of the most detailed mip level to load.
+///
+/// @return  True if loading was started, false if not.
+///
+/// @see TryFinishStreamMips(), IsStreamingMips()
+bool Texture2d::BeginStreamMips( uint32_t firstMipIndex )
+{
+    HELIUM_ASSERT( m_spTexture );
+    HELIUM_ASSERT( !m_spLoadingTexture );
+    HELIUM_ASSERT( firstMipIndex < m_persistentResourceData.m_mipCount );
+
+    if( firstMipIndex == m_residentMipIndex )
+    {
+        return false;
+    }
+
+    return ( BeginLoadMips( firstMipIndex ) && IsStreamingMips() );
+}
+
+/// Test for completion of mip levels being streamed, replacing the render resource once they have all loaded.
+///
+/// @return  True if streaming has completed (or nothing was being streamed), false if loads are still pending.
+///
+/// @see BeginStreamMips(), IsStreamingMips()
+bool Texture2d::TryFinishStreamMips()
+{
+    return TryFinishLoadMips();
+}
+
+/// @copydoc Resource::EvictResidentData()
+void Texture2d::EvictResidentData()
+{
+    m_spTexture.Release();
+    SetInvalid( m_residentMipIndex );
+
+    // Loads cannot be cancelled, so any mip levels still being streamed are dropped once they finish.
+    if( m_spLoadingTexture )
+    {
+        m_bDiscardLoadingTexture = true;
+    }
+}
+
+/// @copydoc Resource::RestoreResidentData()
+bool Texture2d::RestoreResidentData()
+{
+    if( m_bDiscardLoadingTexture && !TryFinishLoadMips() )
+    {
+        return false;
+    }
+
+    if( !m_spTexture && !m_spLoadingTexture )
+    {
+        // If the render resource cannot be recreated, leave the texture without one (as with a failed load) instead of
+        // retrying every frame.
+        if( !BeginPrecacheResourceData() )
+        {
+            return true;
+        }
+    }
+
+    return TryFinishLoadMips();
+}
+
+/// Create a render resource for a range of mip levels and begin loading their cached data into it.
+///
+/// @param[in] firstMipIndex  Index of the most detailed mip level to load.  All smaller mip levels are loaded as well.
+///
+/// @return  True if loading was started (or there is no renderer), false if the render resource could not be created.
+///
+/// @see TryFinishLoadMips()
+bool Texture2d::BeginLoadMips( uint32_t firstMipIndex )
 {
     HELIUM_ASSERT( m_renderResourceLoadIds.IsEmpty() );
+    HELIUM_ASSERT( !m_spLoadingTexture );
 
     Renderer* pRenderer = Renderer::GetStaticInstance();
     if ( !pRenderer )
@@ -61,10 +218,15 @@ bool Texture2d::BeginPrecacheResourceData()
     const uint32_t mipCount = m_persistentResourceData.m_mipCount;
     const int32_t pixelFormatIndex = m_persistentResourceData.m_pixelFormatIndex;
 
+    HELIUM_ASSERT( firstMipIndex < mipCount || firstMipIndex == 0 );
+    const uint32_t width = Max< uint32_t >( baseLevelWidth >> firstMipIndex, 1 );
+    const uint32_t height = Max< uint32_t >( baseLevelHeight >> firstMipIndex, 1 );
+    const uint32_t loadMipCount = mipCount - firstMipIndex;
+
     RTexture2d* pTexture2d = pRenderer->CreateTexture2d(
-        baseLevelWidth,
-        baseLevelHeight,
-        mipCount,
+        width,
+        height,
+        loadMipCount,
         static_cast< ERendererPixelFormat >( pixelFormatIndex ),
         RENDERER_BUFFER_USAGE_STATIC );
 
@@ -72,44 +234,50 @@ bool Texture2d::BeginPrecacheResourceData()
     {
         HELIUM_TRACE(
             TraceLevels::Error,
-            ( TXT( "Texture2d::BeginPrecacheResourceData(): Failed to create texture render " )
+            ( TXT( "Texture2d::BeginLoadMips(): Failed to create texture render " )
             TXT( "resource (width: %" ) PRIu32 TXT( "; height: %" ) PRIu32 TXT( "; mip count: %" )
             PRIu32 TXT( "; pixel format index: %" ) PRId32 TXT( ").\n" ) ),
-            baseLevelWidth,
-            baseLevelHeight,
-            mipCount,
+            width,
+            height,
+            loadMipCount,
             pixelFormatIndex );
 
         return false;
     }
 
-    m_spTexture = pTexture2d;
+    m_spLoadingTexture = pTexture2d;
+    m_loadingMipIndex = firstMipIndex;
+    m_loadingTextureSize = 0;
+    m_bDiscardLoadingTexture = false;
 
-    m_renderResourceLoadIds.Reserve( mipCount );
-    m_renderResourceLoadIds.Resize( mipCount );
+    m_renderResourceLoadIds.Reserve( loadMipCount );
+    m_renderResourceLoadIds.Resize( loadMipCount );
     m_renderResourceLoadIds.Trim();
 
     const ERendererPixelFormat format = static_cast< ERendererPixelFormat >( pixelFormatIndex );
     HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
 
-    for ( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    for ( uint32_t levelIndex = 0; levelIndex < loadMipCount; ++levelIndex )
     {
-        SetInvalid( m_renderResourceLoadIds[ mipIndex ] );
+        SetInvalid( m_renderResourceLoadIds[ levelIndex ] );
+
+        // Render resource levels map to the cached sub-data of the full mip chain, offset by the first mip level.
+        const uint32_t mipIndex = firstMipIndex + levelIndex;
 
         size_t pitch;
-        void* pMipData = pTexture2d->Map( mipIndex, pitch );
+        void* pMipData = pTexture2d->Map( levelIndex, pitch );
         HELIUM_ASSERT( pMipData );
-        if ( !pMipData )
+        if( !pMipData )
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
-                TXT( "Texture2d::BeginPrecacheResourceData(): Failed to lock mip level %" ) PRIu32 TXT( ".\n" ),
+                TXT( "Texture2d::BeginLoadMips(): Failed to lock mip level %" ) PRIu32 TXT( ".\n" ),
                 mipIndex );
 
             continue;
         }
 
-        uint32_t mipLevelHeight = pTexture2d->GetHeight( mipIndex );
+        uint32_t mipLevelHeight = pTexture2d->GetHeight( levelIndex );
         size_t rowCount = RendererUtil::PixelToBlockRowCount( mipLevelHeight, format );
         size_t mipLevelSize = pitch * rowCount;
 
@@ -117,37 +285,42 @@ bool Texture2d::BeginPrecacheResourceData()
 
         size_t loadId = BeginLoadSubData( pMipData, mipIndex, mipLevelSize );
         HELIUM_ASSERT( IsValid( loadId ) );
-        if ( IsInvalid( loadId ) )
+        if( IsInvalid( loadId ) )
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
-                ( TXT( "Texture2d::BeginPrecacheResourceData(): Failed to begin loading of cached data for mip " )
+                ( TXT( "Texture2d::BeginLoadMips(): Failed to begin loading of cached data for mip " )
                 TXT( "level %" ) PRIu32 TXT( ".\n" ) ),
                 mipIndex );
 
-            pTexture2d->Unmap( mipIndex );
+            pTexture2d->Unmap( levelIndex );
 
             continue;
         }
 
-        m_renderResourceLoadIds[ mipIndex ] = loadId;
+        m_renderResourceLoadIds[ levelIndex ] = loadId;
+        m_loadingTextureSize += mipLevelSize;
     }
 
     return true;
 }
 
-/// @copydoc Asset::TryFinishPrecacheResourceData()
-bool Texture2d::TryFinishPrecacheResourceData()
+/// Test for completion of the loads started by BeginLoadMips(), and make the loaded render resource current once they
+/// have all finished.
+///
+/// @return  True if loading has completed (or nothing was being loaded), false if loads are still pending.
+///
+/// @see BeginLoadMips()
+bool Texture2d::TryFinishLoadMips()
 {
-    // Check all pending load requests.
-    size_t loadRequestCount = m_renderResourceLoadIds.GetSize();
-    if( loadRequestCount == 0 )
+    RTexture2d* pTexture2d = m_spLoadingTexture;
+    if( !pTexture2d )
     {
         return true;
     }
 
-    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
-    HELIUM_ASSERT( pTexture2d );
+    // Check all pending load requests.
+    size_t loadRequestCount = m_renderResourceLoadIds.GetSize();
     HELIUM_ASSERT( loadRequestCount == pTexture2d->GetMipCount() );
 
     bool bHaveUnfinishedLoad = false;
@@ -178,26 +351,112 @@ bool Texture2d::TryFinishPrecacheResourceData()
 
     m_renderResourceLoadIds.Clear();
 
+    if( m_bDiscardLoadingTexture )
+    {
+        m_bDiscardLoadingTexture = false;
+        m_spLoadingTexture.Release();
+        SetInvalid( m_loadingMipIndex );
+
+        return true;
+    }
+
+    m_spTexture = pTexture2d;
+    m_residentMipIndex = m_loadingMipIndex;
+    m_renderResourceSize = m_loadingTextureSize;
+
+    m_spLoadingTexture.Release();
+    SetInvalid( m_loadingMipIndex );
+
+    RegisterResidency( ResourceResidencyManager::CATEGORY_GPU, m_renderResourceSize );
+
+    // Register for streaming the first time the texture is loaded, provided there are mip levels left to stream in.
+    TextureStreamingManager& rStreamingManager = TextureStreamingManager::GetStaticInstance();
+    const uint32_t mipCount = m_persistentResourceData.m_mipCount;
+    if( IsInvalid( m_streamingHandle ) && rStreamingManager.GetInitialMipIndex( mipCount ) != 0 )
+    {
+        DynamicArray< size_t > mipSizes;
+        mipSizes.Reserve( mipCount );
+        for( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+        {
+            size_t mipSize = GetSubDataSize( mipIndex );
+            mipSizes.Push( IsValid( mipSize ) ? mipSize : 0 );
+        }
+
+        m_streamingHandle = rStreamingManager.Register( &m_streamingClient, mipSizes );
+    }
+
     return true;
 }
 
-bool Texture2d::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+/// Release the render resource and stop tracking it, waiting for any loads in progress to finish first.
+void Texture2d::ReleaseRenderResources()
 {
-    m_spTexture.Release();
+    if( m_spLoadingTexture )
+    {
+        m_bDiscardLoadingTexture = true;
+        while( !TryFinishLoadMips() )
+        {
+            Thread::Yield();
+        }
+    }
 
-    HELIUM_ASSERT(_object.ReferencesObject());
-    if (!_object.ReferencesObject())
+    // The streaming manager detaches its textures when it is destroyed, so a valid handle implies it still exists;
+    // check anyway so that releasing textures during shutdown can never create a new instance.
+    if( IsValid( m_streamingHandle ) && TextureStreamingManager::HasStaticInstance() )
     {
-        return false;
+        TextureStreamingManager::GetStaticInstance().Unregister( m_streamingHandle );
     }
 
-    _object->CopyTo(&m_persistentResourceData);
+    SetInvalid( m_streamingHandle );
 
-    return true;
+    m_spTexture.Release();
+    SetInvalid( m_residentMipIndex );
+    UnregisterResidency();
 }
 
-/// @copydoc Texture::GetRenderResource2d()
-RTexture2d* Texture2d::GetRenderResource2d() const
+/// @copydoc TextureStreamingClient::GetResidentMipIndex()
+uint32_t Texture2d::StreamingClientAdapter::GetResidentMipIndex() const
 {
-    return static_cast< RTexture2d* >( m_spTexture.Get() );
+    HELIUM_ASSERT( m_pTexture );
+
+    return m_pTexture->GetResidentMipIndex();
+}
+
+/// @copydoc TextureStreamingClient::IsStreamingMips()
+bool Texture2d::StreamingClientAdapter::IsStreamingMips() const
+{
+    HELIUM_ASSERT( m_pTexture );
+
+    return m_pTexture->IsStreamingMips();
+}
+
+/// @copydoc TextureStreamingClient::GetStreamingMipIndex()
+uint32_t Texture2d::StreamingClientAdapter::GetStreamingMipIndex() const
+{
+    HELIUM_ASSERT( m_pTexture );
+
+    return m_pTexture->GetStreamingMipIndex();
+}
+
+/// @copydoc TextureStreamingClient::BeginStreamMips()
+bool Texture2d::StreamingClientAdapter::BeginStreamMips( uint32_t firstMipIndex )
+{
+    HELIUM_ASSERT( m_pTexture );
+
+    return m_pTexture->BeginStreamMips( firstMipIndex );
+}
+
+/// @copydoc TextureStreamingClient::TryFinishStreamMips()
+bool Texture2d::StreamingClientAdapter::TryFinishStreamMips()
+{
+    HELIUM_ASSERT( m_pTexture );
+
+    return m_pTexture->TryFinishStreamMips();
+}
+
+/// @copydoc TextureStreamingClient::DetachStreaming()
+void Texture2d::StreamingClientAdapter::DetachStreaming()
+{
+    HELIUM_ASSERT( m_pTexture );
+    SetInvalid( m_pTexture->m_streamingHandle );
 }
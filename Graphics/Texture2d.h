@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Graphics/Texture.h"
+#include "Graphics/TextureStreamingManager.h"
 
 namespace Helium
 {
+	HELIUM_DECLARE_RPTR( RTexture2d );
+
 	class Texture2d;
 	typedef Helium::StrongPtr< Texture2d > Texture2dPtr;
 	typedef Helium::StrongPtr< const Texture2d > ConstTexture2dPtr;
@@ -20,6 +23,11 @@ namespace Helium
 		virtual ~Texture2d();
 		//@}
 
+		/// @name Asset Interface
+		//@{
+		virtual void RefCountPreDestroy();
+		//@}
+
 		struct HELIUM_GRAPHICS_API PersistentResourceData : public Object
 		{
 			HELIUM_DECLARE_CLASS(Texture2d::PersistentResourceData, Reflect::Object);
@@ -56,9 +64,70 @@ namespace Helium
 		RTexture2d* GetRenderResource2d() const;
 		//@}
 
+		/// @name Mip Streaming
+		//@{
+		virtual void RequestScreenSize( float32_t screenSize );
+
+		inline uint32_t GetResidentMipIndex() const;
+		inline bool IsStreamingMips() const;
+		inline uint32_t GetStreamingMipIndex() const;
+
+		bool BeginStreamMips( uint32_t firstMipIndex );
+		bool TryFinishStreamMips();
+		//@}
+
+	protected:
+		/// @name Residency Management, Protected
+		//@{
+		virtual void EvictResidentData();
+		virtual bool RestoreResidentData();
+		//@}
+
 	private:
-		/// Async load IDs for cached texture data.
+		/// Forwards texture streaming callbacks to the owning texture.
+		class StreamingClientAdapter : public TextureStreamingClient
+		{
+		public:
+			/// Owning texture.
+			Texture2d* m_pTexture;
+
+			/// @name Streaming Callbacks
+			//@{
+			virtual uint32_t GetResidentMipIndex() const;
+			virtual bool IsStreamingMips() const;
+			virtual uint32_t GetStreamingMipIndex() const;
+			virtual bool BeginStreamMips( uint32_t firstMipIndex );
+			virtual bool TryFinishStreamMips();
+			virtual void DetachStreaming();
+			//@}
+		};
+
+		/// Texture streaming manager client interface.
+		StreamingClientAdapter m_streamingClient;
+
+		/// Render resource being loaded (replaces the current render resource once loaded).
+		RTexture2dPtr m_spLoadingTexture;
+		/// Async load IDs for cached texture data, one for each mip level of the render resource being loaded.
 		DynamicArray< size_t > m_renderResourceLoadIds;
+		/// Total size of the mip level data loaded into the render resource, in bytes.
+		size_t m_renderResourceSize;
+		/// Total size of the mip level data of the render resource being loaded, in bytes.
+		size_t m_loadingTextureSize;
+		/// Index of the first mip level of the texture held by the render resource (invalid if none).
+		uint32_t m_residentMipIndex;
+		/// Index of the first mip level of the texture held by the render resource being loaded (invalid if none).
+		uint32_t m_loadingMipIndex;
+		/// Handle of this texture in the texture streaming manager (invalid if not registered).
+		size_t m_streamingHandle;
+		/// True if the render resource being loaded should be released once its loads finish.
+		bool m_bDiscardLoadingTexture;
+
+		/// @name Private Utility Functions
+		//@{
+		bool BeginLoadMips( uint32_t firstMipIndex );
+		bool TryFinishLoadMips();
+		void ReleaseRenderResources();
+		//@}
 	};
 }
 
@@ -10,4 +10,34 @@ namespace Helium
 	{
 		return m_persistentResourceData.m_baseLevelHeight;
 	}
+
+	/// Get the first mip level held by the current render resource.
+	///
+	/// @return  Index of the most detailed resident mip level, or an invalid index if there is no render resource.
+	///
+	/// @see GetStreamingMipIndex()
+	uint32_t Helium::Texture2d::GetResidentMipIndex() const
+	{
+		return m_residentMipIndex;
+	}
+
+	/// Get whether a new range of mip levels is currently being loaded.
+	///
+	/// @return  True if mip levels are being streamed, false if not.
+	///
+	/// @see BeginStreamMips(), TryFinishStreamMips()
+	bool Helium::Texture2d::IsStreamingMips() const
+	{
+		return ( m_spLoadingTexture.Get() != NULL );
+	}
+
+	/// Get the first mip level held by the render resource currently being loaded.
+	///
+	/// @return  Index of the most detailed mip level being loaded, or an invalid index if nothing is being loaded.
+	///
+	/// @see GetResidentMipIndex(), IsStreamingMips()
+	uint32_t Helium::Texture2d::GetStreamingMipIndex() const
+	{
+		return m_loadingMipIndex;
+	}
 }
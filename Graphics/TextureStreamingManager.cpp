@@ -0,0 +1,320 @@
+#include "GraphicsPch.h"
+#include "Graphics/TextureStreamingManager.h"
+
+#include <algorithm>
+
+using namespace Helium;
+
+TextureStreamingManager* TextureStreamingManager::sm_pInstance = NULL;
+
+/// Destructor.
+TextureStreamingClient::~TextureStreamingClient()
+{
+}
+
+/// Constructor.
+TextureStreamingManager::TextureStreamingManager()
+: m_initialMipCount( DEFAULT_INITIAL_MIP_COUNT )
+, m_budget( 0 )
+, m_updateIndex( 0 )
+, m_targetBytes( 0 )
+, m_streamInCount( 0 )
+, m_streamOutCount( 0 )
+{
+}
+
+/// Destructor.
+TextureStreamingManager::~TextureStreamingManager()
+{
+    // Detach any textures still registered so that they do not try to unregister themselves later.
+    size_t entryCount = m_entries.GetSize();
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        if( m_entries.IsElementValid( entryIndex ) )
+        {
+            TextureStreamingClient* pClient = m_entries[ entryIndex ].pClient;
+            HELIUM_ASSERT( pClient );
+            pClient->DetachStreaming();
+        }
+    }
+}
+
+/// Register a texture for streaming.
+///
+/// @param[in] pClient    Texture to register.  This must remain valid until it is unregistered.
+/// @param[in] rMipSizes  Size of each mip level of the texture, in bytes.
+///
+/// @return  Handle for the texture.
+///
+/// @see Unregister()
+size_t TextureStreamingManager::Register( TextureStreamingClient* pClient, const DynamicArray< size_t >& rMipSizes )
+{
+    HELIUM_ASSERT( pClient );
+
+    Entry* pEntry = m_entries.New();
+    HELIUM_ASSERT( pEntry );
+    pEntry->pClient = pClient;
+    SetInvalid( pEntry->requestedMipIndex );
+    SetInvalid( pEntry->targetMipIndex );
+    pEntry->lastRequestUpdate = m_updateIndex;
+
+    // Store the size of each mip level along with all the smaller levels after it, plus a zero-sized entry for the end
+    // of the chain, so the size of any resident range is a single lookup.
+    size_t mipCount = rMipSizes.GetSize();
+    pEntry->tailSizes.Reserve( mipCount + 1 );
+    pEntry->tailSizes.Resize( mipCount + 1 );
+    pEntry->tailSizes[ mipCount ] = 0;
+    for( size_t mipIndex = mipCount; mipIndex != 0; --mipIndex )
+    {
+        pEntry->tailSizes[ mipIndex - 1 ] = pEntry->tailSizes[ mipIndex ] + rMipSizes[ mipIndex - 1 ];
+    }
+
+    return m_entries.GetElementIndex( pEntry );
+}
+
+/// Unregister a texture.
+///
+/// @param[in] handle  Handle of the texture to unregister.
+///
+/// @see Register()
+void TextureStreamingManager::Unregister( size_t handle )
+{
+    HELIUM_ASSERT( handle < m_entries.GetSize() );
+    HELIUM_ASSERT( m_entries.IsElementValid( handle ) );
+
+    m_entries.Remove( handle );
+}
+
+/// Request a mip level for a registered texture.
+///
+/// This should be called each frame for every texture in view.  If a texture is requested more than once in a frame,
+/// the most detailed mip level requested is used.
+///
+/// @param[in] handle    Texture handle.
+/// @param[in] mipIndex  Index of the most detailed mip level needed.
+///
+/// @see ComputeDesiredMipIndex(), Update()
+void TextureStreamingManager::RequestMipIndex( size_t handle, uint32_t mipIndex )
+{
+    HELIUM_ASSERT( handle < m_entries.GetSize() );
+    HELIUM_ASSERT( m_entries.IsElementValid( handle ) );
+
+    Entry& rEntry = m_entries[ handle ];
+    if( IsInvalid( rEntry.requestedMipIndex ) || mipIndex < rEntry.requestedMipIndex )
+    {
+        rEntry.requestedMipIndex = mipIndex;
+    }
+}
+
+/// Choose the resident mip levels of each texture based on the requests since the last update and the streaming
+/// budget, then begin and advance streaming as needed.
+///
+/// Textures that were not requested keep their current mip levels unless detail needs to be dropped to meet the
+/// budget.
+///
+/// @see RequestMipIndex()
+void TextureStreamingManager::Update()
+{
+    size_t targetBytes = 0;
+    m_budgetCandidates.Resize( 0 );
+
+    size_t entryCount = m_entries.GetSize();
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        if( !m_entries.IsElementValid( entryIndex ) )
+        {
+            continue;
+        }
+
+        Entry& rEntry = m_entries[ entryIndex ];
+        TextureStreamingClient* pClient = rEntry.pClient;
+        HELIUM_ASSERT( pClient );
+
+        // Textures without a render resource (i.e. evicted by the residency manager) have nothing to stream.
+        uint32_t residentMipIndex = pClient->GetResidentMipIndex();
+        if( IsInvalid( residentMipIndex ) )
+        {
+            SetInvalid( rEntry.requestedMipIndex );
+            SetInvalid( rEntry.targetMipIndex );
+
+            continue;
+        }
+
+        uint32_t mipCount = static_cast< uint32_t >( rEntry.tailSizes.GetSize() - 1 );
+        uint32_t initialMipIndex = GetInitialMipIndex( mipCount );
+
+        if( IsValid( rEntry.requestedMipIndex ) )
+        {
+            rEntry.targetMipIndex = Min( rEntry.requestedMipIndex, initialMipIndex );
+            rEntry.lastRequestUpdate = m_updateIndex;
+            SetInvalid( rEntry.requestedMipIndex );
+        }
+        else
+        {
+            rEntry.targetMipIndex = ( pClient->IsStreamingMips() ? pClient->GetStreamingMipIndex() : residentMipIndex );
+        }
+
+        HELIUM_ASSERT( rEntry.targetMipIndex < mipCount );
+        targetBytes += rEntry.tailSizes[ rEntry.targetMipIndex ];
+
+        if( rEntry.targetMipIndex < initialMipIndex )
+        {
+            m_budgetCandidates.Push( entryIndex );
+        }
+    }
+
+    // Drop detail from the least recently requested textures until the targeted mip levels fit within the budget.
+    if( m_budget != 0 && targetBytes > m_budget )
+    {
+        size_t candidateCount = m_budgetCandidates.GetSize();
+        std::sort(
+            m_budgetCandidates.GetData(),
+            m_budgetCandidates.GetData() + candidateCount,
+            LruCompare( m_entries ) );
+
+        for( size_t candidateIndex = 0; candidateIndex < candidateCount && targetBytes > m_budget; ++candidateIndex )
+        {
+            Entry& rEntry = m_entries[ m_budgetCandidates[ candidateIndex ] ];
+            uint32_t mipCount = static_cast< uint32_t >( rEntry.tailSizes.GetSize() - 1 );
+            uint32_t initialMipIndex = GetInitialMipIndex( mipCount );
+
+            while( rEntry.targetMipIndex < initialMipIndex && targetBytes > m_budget )
+            {
+                targetBytes -= rEntry.tailSizes[ rEntry.targetMipIndex ] - rEntry.tailSizes[ rEntry.targetMipIndex + 1 ];
+                ++rEntry.targetMipIndex;
+            }
+        }
+    }
+
+    m_targetBytes = targetBytes;
+
+    // Start streaming each texture whose resident mip levels do not match its target, and advance pending streams.
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        if( !m_entries.IsElementValid( entryIndex ) )
+        {
+            continue;
+        }
+
+        Entry& rEntry = m_entries[ entryIndex ];
+        if( IsInvalid( rEntry.targetMipIndex ) )
+        {
+            continue;
+        }
+
+        TextureStreamingClient* pClient = rEntry.pClient;
+        HELIUM_ASSERT( pClient );
+
+        if( !pClient->IsStreamingMips() )
+        {
+            uint32_t residentMipIndex = pClient->GetResidentMipIndex();
+            if( rEntry.targetMipIndex != residentMipIndex && pClient->BeginStreamMips( rEntry.targetMipIndex ) )
+            {
+                if( rEntry.targetMipIndex < residentMipIndex )
+                {
+                    ++m_streamInCount;
+                }
+                else
+                {
+                    ++m_streamOutCount;
+                }
+            }
+        }
+
+        if( pClient->IsStreamingMips() )
+        {
+            pClient->TryFinishStreamMips();
+        }
+    }
+
+    ++m_updateIndex;
+}
+
+/// Compute the mip level of a texture to use for a given on-screen size.
+///
+/// @param[in] baseLevelSize  Size of the largest dimension of the base mip level, in pixels.
+/// @param[in] mipCount       Number of mip levels in the texture.
+/// @param[in] screenSize     Projected size of the texture on screen, in pixels.
+///
+/// @return  Index of the smallest mip level that is still at least as large as the on-screen size.
+uint32_t TextureStreamingManager::ComputeDesiredMipIndex(
+    uint32_t baseLevelSize,
+    uint32_t mipCount,
+    float32_t screenSize )
+{
+    uint32_t mipIndex = 0;
+    while( mipIndex + 1 < mipCount &&
+        static_cast< float32_t >( baseLevelSize >> ( mipIndex + 1 ) ) >= screenSize )
+    {
+        ++mipIndex;
+    }
+
+    return mipIndex;
+}
+
+/// Get the singleton TextureStreamingManager instance, creating it if necessary.
+///
+/// @return  Reference to the TextureStreamingManager instance.
+///
+/// @see DestroyStaticInstance()
+TextureStreamingManager& TextureStreamingManager::GetStaticInstance()
+{
+    if( !sm_pInstance )
+    {
+        sm_pInstance = new TextureStreamingManager;
+        HELIUM_ASSERT( sm_pInstance );
+    }
+
+    return *sm_pInstance;
+}
+
+/// Get whether the singleton TextureStreamingManager instance currently exists.
+///
+/// @return  True if the instance has been created and not yet destroyed, false if not.
+///
+/// @see GetStaticInstance(), DestroyStaticInstance()
+bool TextureStreamingManager::HasStaticInstance()
+{
+    return ( sm_pInstance != NULL );
+}
+
+/// Destroy the singleton TextureStreamingManager instance.
+///
+/// Textures may still be registered, in which case they are detached from the manager and keep their current mip
+/// levels.  This should be called after the renderer has been destroyed, so that textures loaded or released later on
+/// do not create a new instance.
+///
+/// @see GetStaticInstance(), HasStaticInstance()
+void TextureStreamingManager::DestroyStaticInstance()
+{
+    delete sm_pInstance;
+    sm_pInstance = NULL;
+}
+
+/// Constructor.
+///
+/// @param[in] rEntries  Registered textures.
+TextureStreamingManager::LruCompare::LruCompare( const SparseArray< Entry >& rEntries )
+: m_pEntries( &rEntries )
+{
+}
+
+/// Get whether one texture should lose detail before another.
+///
+/// @param[in] entryIndex0  Index of the first texture entry.
+/// @param[in] entryIndex1  Index of the second texture entry.
+///
+/// @return  True if the first texture was last requested before the second, false if not.
+bool TextureStreamingManager::LruCompare::operator()( size_t entryIndex0, size_t entryIndex1 ) const
+{
+    HELIUM_ASSERT( m_pEntries );
+
+    uint32_t lastRequestUpdate0 = ( *m_pEntries )[ entryIndex0 ].lastRequestUpdate;
+    uint32_t lastRequestUpdate1 = ( *m_pEntries )[ entryIndex1 ].lastRequestUpdate;
+    if( lastRequestUpdate0 != lastRequestUpdate1 )
+    {
+        return ( lastRequestUpdate0 < lastRequestUpdate1 );
+    }
+
+    return ( entryIndex0 < entryIndex1 );
+}
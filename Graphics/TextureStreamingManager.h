@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/SparseArray.h"
+
+namespace Helium
+{
+    /// Interface for textures whose mip levels can be streamed by the TextureStreamingManager.
+    class HELIUM_GRAPHICS_API TextureStreamingClient
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        virtual ~TextureStreamingClient();
+        //@}
+
+        /// @name Streaming Callbacks
+        //@{
+        /// Get the first mip level currently resident.
+        ///
+        /// @return  Index of the most detailed resident mip level, or an invalid index if nothing is resident.
+        virtual uint32_t GetResidentMipIndex() const = 0;
+
+        /// Get whether a new range of mip levels is currently being loaded.
+        ///
+        /// @return  True if mip levels are being streamed, false if not.
+        virtual bool IsStreamingMips() const = 0;
+
+        /// Get the first mip level of the range currently being loaded.
+        ///
+        /// @return  Index of the most detailed mip level being loaded, or an invalid index if nothing is being loaded.
+        virtual uint32_t GetStreamingMipIndex() const = 0;
+
+        /// Begin loading a new range of mip levels.  The current mip levels must remain usable until
+        /// TryFinishStreamMips() reports that the new ones have been loaded.
+        ///
+        /// @param[in] firstMipIndex  Index of the most detailed mip level to load.
+        ///
+        /// @return  True if loading was started, false if not.
+        virtual bool BeginStreamMips( uint32_t firstMipIndex ) = 0;
+
+        /// Test for completion of the mip levels being streamed, making them resident once they have all loaded.
+        ///
+        /// @return  True if streaming has completed (or nothing was being streamed), false if loads are still pending.
+        virtual bool TryFinishStreamMips() = 0;
+
+        /// Called when the manager is destroyed while this client is still registered.  The client must forget its
+        /// handle and keep its current mip levels.
+        virtual void DetachStreaming() = 0;
+        //@}
+    };
+
+    /// Manager for streaming texture mip levels in and out based on their on-screen size.
+    ///
+    /// Textures initially load only their smallest mip levels (see GetInitialMipCount()).  While rendering, each texture
+    /// in view is asked for the mip level that matches its projected size on screen, and Update() then streams the
+    /// higher-resolution levels in (or drops them again once they are no longer needed).  If the mip levels requested
+    /// would exceed the streaming budget, detail is dropped from the least recently requested textures first.  The
+    /// initially loaded mip levels are never dropped, so they form a floor under the budget.
+    ///
+    /// Changing the resident mip range of a texture creates a new render resource for the new range and loads all of
+    /// its levels from the resource cache; the old render resource remains in use until the new one is ready.
+    ///
+    /// The manager is not thread-safe and should only be used from the main thread.
+    class HELIUM_GRAPHICS_API TextureStreamingManager : NonCopyable
+    {
+    public:
+        /// Default number of mip levels to load initially.
+        static const uint32_t DEFAULT_INITIAL_MIP_COUNT = 6;
+
+        /// @name Construction/Destruction
+        //@{
+        TextureStreamingManager();
+        ~TextureStreamingManager();
+        //@}
+
+        /// @name Texture Registration
+        //@{
+        size_t Register( TextureStreamingClient* pClient, const DynamicArray< size_t >& rMipSizes );
+        void Unregister( size_t handle );
+        //@}
+
+        /// @name Streaming
+        //@{
+        void RequestMipIndex( size_t handle, uint32_t mipIndex );
+
+        void Update();
+        //@}
+
+        /// @name Configuration
+        //@{
+        inline void SetInitialMipCount( uint32_t mipCount );
+        inline uint32_t GetInitialMipCount() const;
+        inline uint32_t GetInitialMipIndex( uint32_t mipCount ) const;
+
+        inline void SetBudget( size_t byteSize );
+        inline size_t GetBudget() const;
+        //@}
+
+        /// @name Statistics
+        //@{
+        inline size_t GetTargetBytes() const;
+        inline size_t GetStreamInCount() const;
+        inline size_t GetStreamOutCount() const;
+        //@}
+
+        /// @name Static Utility Functions
+        //@{
+        static uint32_t ComputeDesiredMipIndex( uint32_t baseLevelSize, uint32_t mipCount, float32_t screenSize );
+        //@}
+
+        /// @name Static Access
+        //@{
+        static TextureStreamingManager& GetStaticInstance();
+        static bool HasStaticInstance();
+        static void DestroyStaticInstance();
+        //@}
+
+    private:
+        /// Registered texture.
+        struct Entry
+        {
+            /// Client interface.
+            TextureStreamingClient* pClient;
+            /// Total size of all mip levels from each level to the end of the mip chain, in bytes.
+            DynamicArray< size_t > tailSizes;
+            /// Most detailed mip level requested since the last update (invalid if not requested).
+            uint32_t requestedMipIndex;
+            /// First mip level that should be resident after the current update.
+            uint32_t targetMipIndex;
+            /// Update index at which the texture was last requested.
+            uint32_t lastRequestUpdate;
+        };
+
+        /// Ordering for dropping detail when over budget.
+        class LruCompare
+        {
+        public:
+            /// @name Construction/Destruction
+            //@{
+            explicit LruCompare( const SparseArray< Entry >& rEntries );
+            //@}
+
+            /// @name Overloaded Operators
+            //@{
+            bool operator()( size_t entryIndex0, size_t entryIndex1 ) const;
+            //@}
+
+        private:
+            /// Registered textures.
+            const SparseArray< Entry >* m_pEntries;
+        };
+
+        /// Registered textures.
+        SparseArray< Entry > m_entries;
+        /// Scratch list of textures from which detail can be dropped (kept around to avoid reallocation).
+        DynamicArray< size_t > m_budgetCandidates;
+
+        /// Number of mip levels to load initially (zero to load all mip levels).
+        uint32_t m_initialMipCount;
+        /// Streaming budget, in bytes (zero if unlimited).
+        size_t m_budget;
+
+        /// Number of updates performed.
+        uint32_t m_updateIndex;
+
+        /// Total size of the mip levels targeted during the last update, in bytes.
+        size_t m_targetBytes;
+        /// Number of times more detailed mip levels have been streamed in.
+        size_t m_streamInCount;
+        /// Number of times mip levels have been dropped.
+        size_t m_streamOutCount;
+
+        /// Singleton instance.
+        static TextureStreamingManager* sm_pInstance;
+    };
+}
+
+#include "Graphics/TextureStreamingManager.inl"
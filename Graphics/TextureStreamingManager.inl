@@ -0,0 +1,87 @@
+namespace Helium
+{
+    /// Set the number of mip levels textures load initially.
+    ///
+    /// This only affects textures loaded after the call.
+    ///
+    /// @param[in] mipCount  Number of mip levels, or zero to load all mip levels (disabling streaming).
+    ///
+    /// @see GetInitialMipCount(), GetInitialMipIndex()
+    void TextureStreamingManager::SetInitialMipCount( uint32_t mipCount )
+    {
+        m_initialMipCount = mipCount;
+    }
+
+    /// Get the number of mip levels textures load initially.
+    ///
+    /// @return  Number of mip levels, or zero if all mip levels are loaded.
+    ///
+    /// @see SetInitialMipCount(), GetInitialMipIndex()
+    uint32_t TextureStreamingManager::GetInitialMipCount() const
+    {
+        return m_initialMipCount;
+    }
+
+    /// Get the most detailed mip level a texture loads initially.
+    ///
+    /// @param[in] mipCount  Number of mip levels in the texture.
+    ///
+    /// @return  Index of the first mip level to load.
+    ///
+    /// @see GetInitialMipCount()
+    uint32_t TextureStreamingManager::GetInitialMipIndex( uint32_t mipCount ) const
+    {
+        return ( m_initialMipCount != 0 && mipCount > m_initialMipCount ? mipCount - m_initialMipCount : 0 );
+    }
+
+    /// Set the streaming budget.
+    ///
+    /// @param[in] byteSize  Maximum total size of the resident mip levels of all streamed textures, in bytes, or zero
+    ///                      for no limit.
+    ///
+    /// @see GetBudget()
+    void TextureStreamingManager::SetBudget( size_t byteSize )
+    {
+        m_budget = byteSize;
+    }
+
+    /// Get the streaming budget.
+    ///
+    /// @return  Streaming budget, in bytes, or zero if there is no limit.
+    ///
+    /// @see SetBudget()
+    size_t TextureStreamingManager::GetBudget() const
+    {
+        return m_budget;
+    }
+
+    /// Get the total size of the mip levels targeted during the last update.
+    ///
+    /// This only exceeds the budget if the initially loaded mip levels of all textures do not fit within it.
+    ///
+    /// @return  Targeted mip level data size, in bytes.
+    size_t TextureStreamingManager::GetTargetBytes() const
+    {
+        return m_targetBytes;
+    }
+
+    /// Get the number of times more detailed mip levels have been streamed in.
+    ///
+    /// @return  Stream-in count.
+    ///
+    /// @see GetStreamOutCount()
+    size_t TextureStreamingManager::GetStreamInCount() const
+    {
+        return m_streamInCount;
+    }
+
+    /// Get the number of times mip levels have been dropped.
+    ///
+    /// @return  Stream-out count.
+    ///
+    /// @see GetStreamInCount()
+    size_t TextureStreamingManager::GetStreamOutCount() const
+    {
+        return m_streamOutCount;
+    }
+}
@@ -2,6 +2,7 @@
 #include "GraphicsJobs/GraphicsJobsInterface.h"
 
 #include "GraphicsTypes/VertexTypes.h"
+#include "GraphicsTypes/TransformBatch.h"
 
 namespace Helium
 {
@@ -10,12 +11,19 @@ namespace Helium
     /// @param[in] pContext  Context in which this job is running.
     void UpdateGraphicsSceneObjectBuffersJob::Run()
     {
+        // Number of scene objects gathered before transposing their matrices in one batch.
+        static const size_t BATCH_SIZE = 64;
+
         const GraphicsSceneObject* pSceneObjects = m_parameters.pSceneObjects;
         HELIUM_ASSERT( pSceneObjects );
 
         float32_t* const* ppConstantBufferData = m_parameters.ppConstantBufferData;
         HELIUM_ASSERT( ppConstantBufferData );
 
+        const Simd::Matrix44* batchMatrices[ BATCH_SIZE ];
+        float32_t* batchDestinations[ BATCH_SIZE ];
+        size_t batchCount = 0;
+
         uint_fast32_t sceneObjectCount = m_parameters.sceneObjectCount;
         for( uint_fast32_t sceneObjectIndex = 0;
              sceneObjectIndex < sceneObjectCount;
@@ -27,23 +35,20 @@ namespace Helium
                 continue;
             }
 
-            const GraphicsSceneObject& rSceneObject = *pSceneObjects;
-
-            const Simd::Matrix44& rTransform = rSceneObject.GetTransform();
-
-            // Transpose the matrix when loading into the constant buffer for proper interpretation by the shader.
-            *( pConstantBuffer++ ) = rTransform.GetElement( 0 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 4 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 8 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 12 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 1 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 5 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 9 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 13 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 2 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 6 );
-            *( pConstantBuffer++ ) = rTransform.GetElement( 10 );
-            *pConstantBuffer       = rTransform.GetElement( 14 );
+            batchMatrices[ batchCount ] = &pSceneObjects->GetTransform();
+            batchDestinations[ batchCount ] = pConstantBuffer;
+            ++batchCount;
+
+            if( batchCount == BATCH_SIZE )
+            {
+                // Transpose the matrices when loading into the constant buffers for proper interpretation by the
+                // shader.
+                StoreTransposedMatrices(
+                    batchMatrices, batchDestinations, batchCount, TransposedMatrixLayouts::Rows3x4 );
+                batchCount = 0;
+            }
         }
+
+        StoreTransposedMatrices( batchMatrices, batchDestinations, batchCount, TransposedMatrixLayouts::Rows3x4 );
     }
 }
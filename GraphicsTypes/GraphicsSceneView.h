@@ -84,6 +84,7 @@ namespace Helium
 		inline const Simd::Matrix44& GetInverseViewProjectionMatrix() const;
 
 		inline const Simd::Frustum& GetFrustum() const;
+		inline float32_t GetHorizontalFov() const;
 
 		inline RConstantBuffer* GetScreenSpaceVertexConstantBuffer() const;
 
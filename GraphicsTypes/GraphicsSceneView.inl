@@ -147,6 +147,16 @@ namespace Helium
         return m_frustum;
     }
 
+    /// Get the horizontal field-of-view angle.
+    ///
+    /// @return  Horizontal field-of-view angle, in degrees (zero for an orthographic projection).
+    ///
+    /// @see SetHorizontalFov()
+    float32_t GraphicsSceneView::GetHorizontalFov() const
+    {
+        return m_horizontalFov;
+    }
+
     /// Get the distance from the camera at which shadows should no longer be rendered.
     ///
     /// @return  Shadow cutoff distance.
@@ -0,0 +1,370 @@
+#include "GraphicsTypesPch.h"
+#include "GraphicsTypes/TransformBatch.h"
+
+using namespace Helium;
+
+namespace
+{
+#if HELIUM_SIMD_SSE
+    /// Four-wide SSE arithmetic.
+    struct SseOperations
+    {
+        typedef __m128 Register;
+
+        static HELIUM_FORCEINLINE Register Add( Register a, Register b ) { return _mm_add_ps( a, b ); }
+        static HELIUM_FORCEINLINE Register Subtract( Register a, Register b ) { return _mm_sub_ps( a, b ); }
+        static HELIUM_FORCEINLINE Register Multiply( Register a, Register b ) { return _mm_mul_ps( a, b ); }
+        static HELIUM_FORCEINLINE Register Splat( float32_t value ) { return _mm_set1_ps( value ); }
+    };
+
+    /// Transform rows for four transforms in structure-of-arrays form, with each register holding the same matrix
+    /// element for all four transforms.
+    struct TransformRows
+    {
+        /// Upper 3x3 block (rotation with scaling applied).
+        __m128 m_rotationScale[ 3 ][ 3 ];
+        /// Translation row.
+        __m128 m_translation[ 3 ];
+    };
+#else
+    /// Transform rows for a single transform.
+    struct TransformRows
+    {
+        /// Upper 3x3 block (rotation with scaling applied).
+        float32_t m_rotationScale[ 3 ][ 3 ];
+        /// Translation row.
+        float32_t m_translation[ 3 ];
+    };
+
+    /// Scalar arithmetic.
+    struct ScalarOperations
+    {
+        typedef float32_t Register;
+
+        static HELIUM_FORCEINLINE Register Add( Register a, Register b ) { return a + b; }
+        static HELIUM_FORCEINLINE Register Subtract( Register a, Register b ) { return a - b; }
+        static HELIUM_FORCEINLINE Register Multiply( Register a, Register b ) { return a * b; }
+        static HELIUM_FORCEINLINE Register Splat( float32_t value ) { return value; }
+    };
+#endif
+
+    /// Compute the upper 3x3 block of a row-vector transform matrix from a unit quaternion and uniform scale.
+    ///
+    /// Each register may hold any number of transforms laid out in structure-of-arrays form.
+    template< typename Operations >
+    HELIUM_FORCEINLINE void ComputeRotationScale(
+        typename Operations::Register x,
+        typename Operations::Register y,
+        typename Operations::Register z,
+        typename Operations::Register w,
+        typename Operations::Register scale,
+        typename Operations::Register ( &rRotationScale )[ 3 ][ 3 ] )
+    {
+        typedef typename Operations::Register Register;
+
+        Register x2 = Operations::Add( x, x );
+        Register y2 = Operations::Add( y, y );
+        Register z2 = Operations::Add( z, z );
+
+        Register xx = Operations::Multiply( x, x2 );
+        Register yy = Operations::Multiply( y, y2 );
+        Register zz = Operations::Multiply( z, z2 );
+        Register xy = Operations::Multiply( x, y2 );
+        Register xz = Operations::Multiply( x, z2 );
+        Register yz = Operations::Multiply( y, z2 );
+        Register wx = Operations::Multiply( w, x2 );
+        Register wy = Operations::Multiply( w, y2 );
+        Register wz = Operations::Multiply( w, z2 );
+
+        Register one = Operations::Splat( 1.0f );
+
+        rRotationScale[ 0 ][ 0 ] = Operations::Multiply( Operations::Subtract( one, Operations::Add( yy, zz ) ), scale );
+        rRotationScale[ 0 ][ 1 ] = Operations::Multiply( Operations::Add( xy, wz ), scale );
+        rRotationScale[ 0 ][ 2 ] = Operations::Multiply( Operations::Subtract( xz, wy ), scale );
+
+        rRotationScale[ 1 ][ 0 ] = Operations::Multiply( Operations::Subtract( xy, wz ), scale );
+        rRotationScale[ 1 ][ 1 ] = Operations::Multiply( Operations::Subtract( one, Operations::Add( xx, zz ) ), scale );
+        rRotationScale[ 1 ][ 2 ] = Operations::Multiply( Operations::Add( yz, wx ), scale );
+
+        rRotationScale[ 2 ][ 0 ] = Operations::Multiply( Operations::Add( xz, wy ), scale );
+        rRotationScale[ 2 ][ 1 ] = Operations::Multiply( Operations::Subtract( yz, wx ), scale );
+        rRotationScale[ 2 ][ 2 ] = Operations::Multiply( Operations::Subtract( one, Operations::Add( xx, yy ) ), scale );
+    }
+
+#if HELIUM_SIMD_SSE
+    /// Load four consecutive positions and rotations, transposed into structure-of-arrays form.
+    HELIUM_FORCEINLINE void LoadTransformsSse(
+        const Simd::Vector3* pPositions,
+        const Simd::Quat* pRotations,
+        __m128 ( &rRotation )[ 4 ],
+        __m128 ( &rTranslation )[ 3 ] )
+    {
+        rRotation[ 0 ] = pRotations[ 0 ].GetSimdVector();
+        rRotation[ 1 ] = pRotations[ 1 ].GetSimdVector();
+        rRotation[ 2 ] = pRotations[ 2 ].GetSimdVector();
+        rRotation[ 3 ] = pRotations[ 3 ].GetSimdVector();
+        _MM_TRANSPOSE4_PS( rRotation[ 0 ], rRotation[ 1 ], rRotation[ 2 ], rRotation[ 3 ] );
+
+        __m128 positionW = pPositions[ 3 ].GetSimdVector();
+        rTranslation[ 0 ] = pPositions[ 0 ].GetSimdVector();
+        rTranslation[ 1 ] = pPositions[ 1 ].GetSimdVector();
+        rTranslation[ 2 ] = pPositions[ 2 ].GetSimdVector();
+        _MM_TRANSPOSE4_PS( rTranslation[ 0 ], rTranslation[ 1 ], rTranslation[ 2 ], positionW );
+    }
+
+    /// Compute the transform rows for four consecutive transforms.
+    HELIUM_FORCEINLINE void ComputeRowsSse(
+        const Simd::Vector3* pPositions,
+        const Simd::Quat* pRotations,
+        const float32_t* pScales,
+        TransformRows& rRows )
+    {
+        __m128 rotation[ 4 ];
+        LoadTransformsSse( pPositions, pRotations, rotation, rRows.m_translation );
+
+        ComputeRotationScale< SseOperations >(
+            rotation[ 0 ],
+            rotation[ 1 ],
+            rotation[ 2 ],
+            rotation[ 3 ],
+            _mm_loadu_ps( pScales ),
+            rRows.m_rotationScale );
+    }
+
+    /// Writes transform rows to an array of Simd::Matrix44 instances.
+    class MatrixStore
+    {
+    public:
+        explicit MatrixStore( Simd::Matrix44* pMatrices )
+            : m_pMatrices( pMatrices )
+        {
+        }
+
+        HELIUM_FORCEINLINE void Store( const TransformRows& rRows, size_t firstIndex, size_t transformCount )
+        {
+            Simd::Matrix44* pMatrices = m_pMatrices + firstIndex;
+
+            for( size_t rowIndex = 0; rowIndex < 3; ++rowIndex )
+            {
+                __m128 transposed[ 4 ] =
+                {
+                    rRows.m_rotationScale[ rowIndex ][ 0 ],
+                    rRows.m_rotationScale[ rowIndex ][ 1 ],
+                    rRows.m_rotationScale[ rowIndex ][ 2 ],
+                    _mm_setzero_ps()
+                };
+                _MM_TRANSPOSE4_PS( transposed[ 0 ], transposed[ 1 ], transposed[ 2 ], transposed[ 3 ] );
+
+                for( size_t transformIndex = 0; transformIndex < transformCount; ++transformIndex )
+                {
+                    pMatrices[ transformIndex ].SetSimdVector( rowIndex, transposed[ transformIndex ] );
+                }
+            }
+
+            __m128 transposed[ 4 ] =
+            {
+                rRows.m_translation[ 0 ],
+                rRows.m_translation[ 1 ],
+                rRows.m_translation[ 2 ],
+                _mm_set1_ps( 1.0f )
+            };
+            _MM_TRANSPOSE4_PS( transposed[ 0 ], transposed[ 1 ], transposed[ 2 ], transposed[ 3 ] );
+
+            for( size_t transformIndex = 0; transformIndex < transformCount; ++transformIndex )
+            {
+                pMatrices[ transformIndex ].SetSimdVector( 3, transposed[ transformIndex ] );
+            }
+        }
+
+    private:
+        Simd::Matrix44* m_pMatrices;
+    };
+
+    /// Convert a batch of transforms, handing each group of computed rows to the given store.
+    template< typename StoreType >
+    void ConvertTransforms(
+        const Simd::Vector3* pPositions,
+        const Simd::Quat* pRotations,
+        const float32_t* pScales,
+        size_t transformCount,
+        StoreType& rStore )
+    {
+        size_t transformIndex = 0;
+
+        for( ; transformIndex + 4 <= transformCount; transformIndex += 4 )
+        {
+            TransformRows rows;
+            ComputeRowsSse( pPositions + transformIndex, pRotations + transformIndex, pScales + transformIndex, rows );
+            rStore.Store( rows, transformIndex, 4 );
+        }
+
+        // Pad the remaining transforms out to a full group by repeating the last one.
+        size_t remainingCount = transformCount - transformIndex;
+        if( remainingCount != 0 )
+        {
+            Simd::Vector3 positions[ 4 ];
+            Simd::Quat rotations[ 4 ];
+            float32_t scales[ 4 ];
+            for( size_t paddedIndex = 0; paddedIndex < 4; ++paddedIndex )
+            {
+                size_t sourceIndex = transformIndex + Min( paddedIndex, remainingCount - 1 );
+                positions[ paddedIndex ] = pPositions[ sourceIndex ];
+                rotations[ paddedIndex ] = pRotations[ sourceIndex ];
+                scales[ paddedIndex ] = pScales[ sourceIndex ];
+            }
+
+            TransformRows rows;
+            ComputeRowsSse( positions, rotations, scales, rows );
+            rStore.Store( rows, transformIndex, remainingCount );
+        }
+    }
+#else  // HELIUM_SIMD_SSE
+    /// Writes transform rows to an array of Simd::Matrix44 instances.
+    class MatrixStore
+    {
+    public:
+        explicit MatrixStore( Simd::Matrix44* pMatrices )
+            : m_pMatrices( pMatrices )
+        {
+        }
+
+        HELIUM_FORCEINLINE void Store( const TransformRows& rRows, size_t index )
+        {
+            Simd::Matrix44& rMatrix = m_pMatrices[ index ];
+            for( size_t rowIndex = 0; rowIndex < 3; ++rowIndex )
+            {
+                rMatrix.SetRow(
+                    rowIndex,
+                    Simd::Vector4(
+                        rRows.m_rotationScale[ rowIndex ][ 0 ],
+                        rRows.m_rotationScale[ rowIndex ][ 1 ],
+                        rRows.m_rotationScale[ rowIndex ][ 2 ],
+                        0.0f ) );
+            }
+
+            rMatrix.SetRow(
+                3,
+                Simd::Vector4( rRows.m_translation[ 0 ], rRows.m_translation[ 1 ], rRows.m_translation[ 2 ], 1.0f ) );
+        }
+
+    private:
+        Simd::Matrix44* m_pMatrices;
+    };
+
+    /// Convert a batch of transforms, handing each computed transform to the given store.
+    template< typename StoreType >
+    void ConvertTransforms(
+        const Simd::Vector3* pPositions,
+        const Simd::Quat* pRotations,
+        const float32_t* pScales,
+        size_t transformCount,
+        StoreType& rStore )
+    {
+        for( size_t transformIndex = 0; transformIndex < transformCount; ++transformIndex )
+        {
+            const Simd::Vector3& rPosition = pPositions[ transformIndex ];
+            const Simd::Quat& rRotation = pRotations[ transformIndex ];
+
+            TransformRows rows;
+            ComputeRotationScale< ScalarOperations >(
+                rRotation.m_x,
+                rRotation.m_y,
+                rRotation.m_z,
+                rRotation.m_w,
+                pScales[ transformIndex ],
+                rows.m_rotationScale );
+            rows.m_translation[ 0 ] = rPosition.m_x;
+            rows.m_translation[ 1 ] = rPosition.m_y;
+            rows.m_translation[ 2 ] = rPosition.m_z;
+
+            rStore.Store( rows, transformIndex );
+        }
+    }
+#endif  // HELIUM_SIMD_SSE
+}
+
+/// Build row-vector transform matrices from arrays of positions, rotations, and uniform scales.
+///
+/// The result for each transform matches Simd::Matrix44( Simd::Matrix44::INIT_ROTATION_TRANSLATION, rotation,
+/// position ) followed by ScaleLocal( scale ).
+///
+/// @param[in]  pPositions      Transform positions.
+/// @param[in]  pRotations      Transform rotations (unit quaternions).
+/// @param[in]  pScales         Transform uniform scales.
+/// @param[in]  transformCount  Number of transforms to convert.
+/// @param[out] pMatrices       Array of at least transformCount matrices in which to store the results.
+void Helium::BuildTransformMatrices(
+    const Simd::Vector3* pPositions,
+    const Simd::Quat* pRotations,
+    const float32_t* pScales,
+    size_t transformCount,
+    Simd::Matrix44* pMatrices )
+{
+    HELIUM_ASSERT( transformCount == 0 || ( pPositions && pRotations && pScales && pMatrices ) );
+
+    MatrixStore store( pMatrices );
+    ConvertTransforms( pPositions, pRotations, pScales, transformCount, store );
+}
+
+/// Store a single matrix transposed.
+///
+/// @param[in]  rMatrix       Matrix to store.
+/// @param[out] pDestination  Buffer in which to store the transposed matrix.
+/// @param[in]  layout        Layout in which to store the matrix.
+void Helium::StoreTransposedMatrix(
+    const Simd::Matrix44& rMatrix,
+    float32_t* pDestination,
+    TransposedMatrixLayout layout )
+{
+    HELIUM_ASSERT( pDestination );
+
+#if HELIUM_SIMD_SSE
+    __m128 row0 = rMatrix.GetSimdVector( 0 );
+    __m128 row1 = rMatrix.GetSimdVector( 1 );
+    __m128 row2 = rMatrix.GetSimdVector( 2 );
+    __m128 row3 = rMatrix.GetSimdVector( 3 );
+    _MM_TRANSPOSE4_PS( row0, row1, row2, row3 );
+
+    _mm_storeu_ps( pDestination, row0 );
+    _mm_storeu_ps( pDestination + 4, row1 );
+    _mm_storeu_ps( pDestination + 8, row2 );
+    if( layout == TransposedMatrixLayouts::Rows4x4 )
+    {
+        _mm_storeu_ps( pDestination + 12, row3 );
+    }
+#else
+    size_t rowCount = GetTransposedMatrixFloatCount( layout ) / 4;
+    for( size_t rowIndex = 0; rowIndex < rowCount; ++rowIndex )
+    {
+        *( pDestination++ ) = rMatrix.GetElement( rowIndex );
+        *( pDestination++ ) = rMatrix.GetElement( rowIndex + 4 );
+        *( pDestination++ ) = rMatrix.GetElement( rowIndex + 8 );
+        *( pDestination++ ) = rMatrix.GetElement( rowIndex + 12 );
+    }
+#endif
+}
+
+/// Store a batch of matrices transposed, each to its own destination.
+///
+/// The result for each matrix matches StoreTransposedMatrix().
+///
+/// @param[in]  ppMatrices      Matrices to store.
+/// @param[out] ppDestinations  Buffer in which to store each transposed matrix.
+/// @param[in]  matrixCount     Number of matrices to store.
+/// @param[in]  layout          Layout in which to store the matrices.
+///
+/// @see StoreTransposedMatrix()
+void Helium::StoreTransposedMatrices(
+    const Simd::Matrix44* const* ppMatrices,
+    float32_t* const* ppDestinations,
+    size_t matrixCount,
+    TransposedMatrixLayout layout )
+{
+    HELIUM_ASSERT( matrixCount == 0 || ( ppMatrices && ppDestinations ) );
+
+    for( size_t matrixIndex = 0; matrixIndex < matrixCount; ++matrixIndex )
+    {
+        HELIUM_ASSERT( ppMatrices[ matrixIndex ] );
+        StoreTransposedMatrix( *ppMatrices[ matrixIndex ], ppDestinations[ matrixIndex ], layout );
+    }
+}
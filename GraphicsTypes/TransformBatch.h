@@ -0,0 +1,43 @@
+#pragma once
+
+#include "GraphicsTypes/GraphicsTypes.h"
+
+#include "MathSimd/Vector3.h"
+#include "MathSimd/Quat.h"
+#include "MathSimd/Matrix44.h"
+
+namespace Helium
+{
+    /// Layouts in which transposed transform matrices can be written for shader consumption.
+    namespace TransposedMatrixLayouts
+    {
+        enum TransposedMatrixLayout
+        {
+            /// Three rows of four floats (translation in the last column, implicit [0 0 0 1] fourth row).
+            Rows3x4,
+            /// Full four rows of four floats.
+            Rows4x4,
+        };
+    }
+    typedef TransposedMatrixLayouts::TransposedMatrixLayout TransposedMatrixLayout;
+
+    /// @name Batch Transform Conversion
+    /// Conversion of contiguous position/rotation/uniform scale arrays into transform matrices.  Transforms are
+    /// processed four at a time with SSE and one at a time otherwise.  Existing matrices can also be transposed in
+    /// batches for shader consumption.
+    //@{
+    HELIUM_GRAPHICS_TYPES_API void BuildTransformMatrices(
+        const Simd::Vector3* pPositions, const Simd::Quat* pRotations, const float32_t* pScales, size_t transformCount,
+        Simd::Matrix44* pMatrices );
+
+    HELIUM_GRAPHICS_TYPES_API void StoreTransposedMatrix(
+        const Simd::Matrix44& rMatrix, float32_t* pDestination, TransposedMatrixLayout layout );
+    HELIUM_GRAPHICS_TYPES_API void StoreTransposedMatrices(
+        const Simd::Matrix44* const* ppMatrices, float32_t* const* ppDestinations, size_t matrixCount,
+        TransposedMatrixLayout layout );
+
+    inline size_t GetTransposedMatrixFloatCount( TransposedMatrixLayout layout );
+    //@}
+}
+
+#include "GraphicsTypes/TransformBatch.inl"
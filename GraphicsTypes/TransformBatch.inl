@@ -0,0 +1,12 @@
+namespace Helium
+{
+    /// Get the number of floats written for each matrix in a given transposed matrix layout.
+    ///
+    /// @param[in] layout  Transposed matrix layout.
+    ///
+    /// @return  Number of floats per matrix.
+    size_t GetTransposedMatrixFloatCount( TransposedMatrixLayout layout )
+    {
+        return ( layout == TransposedMatrixLayouts::Rows3x4 ? 12 : 16 );
+    }
+}
@@ -406,6 +406,7 @@ Helium.DoExampleMainProjectSettings = function(demoName)
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	if _OPTIONS[ "gfxapi" ] == "opengl" then
@@ -11,6 +11,8 @@
 #include "Engine/AssetLoader.h"
 #include "Engine/Resource.h"
 #include "Engine/Config.h"
+#include "Engine/JobPool.h"
+#include "PcSupport/ContentHash.h"
 #include "PcSupport/PlatformPreprocessor.h"
 #include "PcSupport/ResourceHandler.h"
 #include "Engine/PackageLoader.h"
@@ -21,6 +23,15 @@ AssetPreprocessor* AssetPreprocessor::sm_pInstance = NULL;
 
 /// Constructor.
 AssetPreprocessor::AssetPreprocessor()
+: m_resourceCodec( Compression::CODEC_NONE )
+, m_objectHitCount( 0 )
+, m_objectMissCount( 0 )
+, m_resourceHitCount( 0 )
+, m_resourceMissCount( 0 )
+, m_sharedResourceHitCount( 0 )
+#if HELIUM_TOOLS
+, m_bDeferResourcePreprocessing( false )
+#endif
 {
 	MemoryZero( m_pPlatformPreprocessors, sizeof( m_pPlatformPreprocessors ) );
 }
@@ -28,6 +39,16 @@ AssetPreprocessor::AssetPreprocessor()
 /// Destructor.
 AssetPreprocessor::~AssetPreprocessor()
 {
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "AssetPreprocessor: Object cache %" ) PRId32 TXT( " hits, %" ) PRId32 TXT( " misses; resource cache %" )
+		PRId32 TXT( " hits, %" ) PRId32 TXT( " misses (%" ) PRId32 TXT( " found in shared cache).\n" ) ),
+		m_objectHitCount,
+		m_objectMissCount,
+		m_resourceHitCount,
+		m_resourceMissCount,
+		m_sharedResourceHitCount );
+
 	for( size_t platformIndex = 0; platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ); ++platformIndex )
 	{
 		delete m_pPlatformPreprocessors[ platformIndex ];
@@ -50,10 +71,29 @@ void AssetPreprocessor::SetPlatformPreprocessor( Cache::EPlatform platform, Plat
 	m_pPlatformPreprocessors[ platform ] = pPreprocessor;
 }
 
+/// Set the codec with which to compress resource sub-data when caching it.
+///
+/// Compressed sub-data is decompressed by the AsyncLoader threads when loaded, trading CPU time for smaller cache files
+/// and less I/O.  Sub-data that does not shrink when compressed is always stored as-is.  Object data in the object
+/// cache is never compressed.
+///
+/// @param[in] codec  Resource sub-data compression codec (CODEC_NONE to disable compression).
+///
+/// @see GetResourceCompression()
+void AssetPreprocessor::SetResourceCompression( Compression::ECodec codec )
+{
+	HELIUM_ASSERT( static_cast< size_t >( codec ) < static_cast< size_t >( Compression::CODEC_MAX ) );
+
+	m_resourceCodec = codec;
+}
+
 /// Cache an object for all registered platforms.
 ///
+/// The object is only recached for platforms whose cache entry was not written from the same inputs.
+///
+/// @param[in] objectPath                              Path of the object to cache.
 /// @param[in] pObject                                 Asset to cache.
-/// @param[in] timestamp                               Asset timestamp.
+/// @param[in] inputHash                               Hash of the object's inputs (see ComputeInputHash()).
 /// @param[in] bEvictPlatformPreprocessedResourceData  If the object being cached is a Resource-based object,
 ///                                                    specifying true will free the raw preprocessed resource data
 ///                                                    for the current platform after caching, while false will keep
@@ -66,7 +106,7 @@ void AssetPreprocessor::SetPlatformPreprocessor( Cache::EPlatform platform, Plat
 bool AssetPreprocessor::CacheObject(
 	const AssetPath &objectPath,
 	Asset* pObject,
-	int64_t timestamp,
+	uint64_t inputHash,
 	bool bEvictPlatformPreprocessedResourceData )
 {
 #if HELIUM_TOOLS
@@ -121,12 +161,25 @@ bool AssetPreprocessor::CacheObject(
 		pCache->EnforceTocLoad();
 
 		// Don't recache the object if an up-to-date cache entry already exists for it.
+		int64_t timestamp = GetPlatformInputStamp( inputHash, static_cast< Cache::EPlatform >( platformIndex ) );
 		const Cache::Entry* pEntry = pCache->FindEntry( objectPath, 0 );
 		if( pEntry && pEntry->timestamp == timestamp )
 		{
+			AtomicIncrementRelease( m_objectHitCount );
+
 			continue;
 		}
 
+		// Resources whose preprocessing has been deferred are cached once preprocessed, so that their cache entries
+		// are never marked up-to-date without their resource data.
+		if( pResource && m_bDeferResourcePreprocessing &&
+			!pResource->GetPreprocessedData( static_cast< Cache::EPlatform >( platformIndex ) ).bLoaded )
+		{
+			continue;
+		}
+
+		AtomicIncrementRelease( m_objectMissCount );
+
 		HELIUM_TRACE(
 			TraceLevels::Info,
 			TXT( "AssetPreprocessor: Object \"%s\" is out of date.  Recaching...\n" ),
@@ -243,7 +296,8 @@ bool AssetPreprocessor::CacheObject(
 							static_cast< uint32_t >( subDataBufferIndex ),
 							rSubData.GetData(),
 							timestamp,
-							static_cast< uint32_t >( rSubData.GetSize() ) );
+							static_cast< uint32_t >( rSubData.GetSize() ),
+							m_resourceCodec );
 						if( !bCacheResult )
 						{
 							HELIUM_TRACE(
@@ -281,7 +335,7 @@ bool AssetPreprocessor::CacheObject(
 #else  // HELIUM_TOOLS
 
 	HELIUM_UNREF( pObject );
-	HELIUM_UNREF( timestamp );
+	HELIUM_UNREF( inputHash );
 	HELIUM_UNREF( bEvictPlatformPreprocessedResourceData );
 
 	return false;
@@ -291,10 +345,11 @@ bool AssetPreprocessor::CacheObject(
 
 /// Load data for the specified resource into memory, preprocessing it from source data if it is out-of-date.
 ///
-/// @param[in] pResource        Resource to load.
-/// @param[in] objectTimestamp  Timestamp of the object data stored on disk.  This will be combined with the source
-///                             asset timestamp to get the timestamp value with which to compare against the cached
-///                             data.
+/// Cached data is considered up-to-date if it was built from the same asset file and source file contents, using the
+/// same resource handler version (see ComputeInputHash()).
+///
+/// @param[in] resourcePath  Path of the resource to load.
+/// @param[in] pResource     Resource to load.
 void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resource* pResource )
 {
 #if HELIUM_TOOLS
@@ -331,13 +386,7 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 
 	sourceFilePath += baseResourcePath.ToFilePathString().GetData();
 
-	Helium::Status stat;
-	stat.Read( sourceFilePath );
-
-	int64_t sourceFileTimestamp = stat.m_ModifiedTime;
-	int64_t assetFileTimestamp = AssetLoader::GetAssetFileTimestamp( baseResourcePath );
-
-	int64_t timestamp = Max( assetFileTimestamp, sourceFileTimestamp );
+	uint64_t inputHash = ComputeInputHash( baseResourcePath, sourceFilePath, pResource );
 
 	// Check if data is loaded for each supported platform, attempting to load the data from the cache if it exists
 	// and is up-to-date.
@@ -370,6 +419,7 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 		HELIUM_ASSERT( pCache );
 		pCache->EnforceTocLoad();
 
+		int64_t timestamp = GetPlatformInputStamp( inputHash, static_cast< Cache::EPlatform >( platformIndex ) );
 		const Cache::Entry* pCacheEntry = pCache->FindEntry( resourcePath, 0 );
 		if( !pCacheEntry || pCacheEntry->timestamp != timestamp )
 		{
@@ -398,11 +448,28 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 	if( platformIndex >= HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ) )
 	{
 		// All supported platforms loaded successfully, so nothing else needs to be done.
+		AtomicIncrementRelease( m_resourceHitCount );
+
+		return;
+	}
+
+	AtomicIncrementRelease( m_resourceMissCount );
+
+	if( m_bDeferResourcePreprocessing )
+	{
+		DeferredResource* pDeferredResource = m_deferredResources.New();
+		HELIUM_ASSERT( pDeferredResource );
+		pDeferredResource->path = resourcePath;
+		pDeferredResource->spResource = pResource;
+		pDeferredResource->sourceFilePath = sourceFilePath.c_str();
+		pDeferredResource->inputHash = inputHash;
+		pDeferredResource->bSuccess = false;
+
 		return;
 	}
 
 	// Preprocess all resources for each supported platform.
-	if( !PreprocessResource( resourcePath, pResource, String( sourceFilePath.c_str() ) ) )
+	if( !PreprocessResource( resourcePath, pResource, String( sourceFilePath.c_str() ), inputHash ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
@@ -418,7 +485,335 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 }
 
 
+/// Compute the hash identifying the inputs from which an object or resource is cached.
+///
+/// The hash covers the contents of the asset file and the resource source file (if any), the version of the resource
+/// handler, and the cache layout version.  Unlike file timestamps, it does not change when files are touched or
+/// rewritten with identical contents, such as on a fresh checkout or branch switch.
+///
+/// @param[in] assetPath       Path of the asset whose asset file should be hashed.
+/// @param[in] sourceFilePath  Resource source file (empty if the asset has no source file).
+/// @param[in] pResource       Resource being cached, or null if the asset is not a resource.
+///
+/// @return  Input hash.
+///
+/// @see ComputeFileHash()
+uint64_t AssetPreprocessor::ComputeInputHash(
+	const AssetPath &assetPath,
+	const FilePath &sourceFilePath,
+	const Resource* pResource )
+{
+	ContentHash hash;
+	hash.Update( static_cast< uint64_t >( CACHE_VERSION ) );
+
 #if HELIUM_TOOLS
+	const FilePath& assetFilePath = AssetLoader::GetAssetFilePath( assetPath );
+	if( !assetFilePath.Get().empty() )
+	{
+		hash.Update( ComputeFileHash( assetFilePath ) );
+	}
+#else
+	HELIUM_UNREF( assetPath );
+#endif
+
+	if( !sourceFilePath.Get().empty() )
+	{
+		hash.Update( ComputeFileHash( sourceFilePath ) );
+	}
+
+	if( pResource )
+	{
+		ResourceHandler* pResourceHandler = ResourceHandler::FindResourceHandlerForType( pResource->GetAssetType() );
+		hash.Update( static_cast< uint64_t >( pResourceHandler ? pResourceHandler->GetVersion() : 0 ) );
+	}
+
+	return hash.GetValue();
+}
+
+/// Compute the hash of the contents of a file.
+///
+/// Hashes are remembered for the lifetime of the preprocessor and reused while the size and modification time of the
+/// file are unchanged, so files shared by several objects are only read once.
+///
+/// @param[in] filePath  File to hash.
+///
+/// @return  Hash of the file contents, or an invalid value if the file does not exist or could not be read.
+uint64_t AssetPreprocessor::ComputeFileHash( const FilePath &filePath )
+{
+	Status status;
+	if( !status.Read( filePath.Get().c_str() ) )
+	{
+		return Invalid< uint64_t >();
+	}
+
+	Name key( filePath.c_str() );
+
+	m_fileHashLock.Lock();
+
+	HashMap< Name, FileHash >::Iterator fileHashIterator = m_fileHashes.Find( key );
+	if( fileHashIterator != m_fileHashes.End() &&
+		fileHashIterator->Second().modifiedTime == status.m_ModifiedTime &&
+		fileHashIterator->Second().size == status.m_Size )
+	{
+		uint64_t hash = fileHashIterator->Second().hash;
+		m_fileHashLock.Unlock();
+
+		return hash;
+	}
+
+	m_fileHashLock.Unlock();
+
+	ContentHash contentHash;
+	if( !contentHash.UpdateFile( filePath ) )
+	{
+		return Invalid< uint64_t >();
+	}
+
+	FileHash fileHash;
+	fileHash.modifiedTime = status.m_ModifiedTime;
+	fileHash.size = status.m_Size;
+	fileHash.hash = contentHash.GetValue();
+
+	m_fileHashLock.Lock();
+
+	fileHashIterator = m_fileHashes.Find( key );
+	if( fileHashIterator != m_fileHashes.End() )
+	{
+		fileHashIterator->Second() = fileHash;
+	}
+	else
+	{
+		m_fileHashes.Insert( fileHashIterator, KeyValue< Name, FileHash >( key, fileHash ) );
+	}
+
+	m_fileHashLock.Unlock();
+
+	return fileHash.hash;
+}
+
+/// Get the cache hit and miss counts since the preprocessor was created or the counts were last reset.
+///
+/// @param[out] rStats  Cache hit and miss counts.
+///
+/// @see ResetStats()
+void AssetPreprocessor::GetStats( Stats& rStats ) const
+{
+	rStats.objectHits = static_cast< uint32_t >( m_objectHitCount );
+	rStats.objectMisses = static_cast< uint32_t >( m_objectMissCount );
+	rStats.resourceHits = static_cast< uint32_t >( m_resourceHitCount );
+	rStats.resourceMisses = static_cast< uint32_t >( m_resourceMissCount );
+	rStats.sharedResourceHits = static_cast< uint32_t >( m_sharedResourceHitCount );
+}
+
+/// Reset the cache hit and miss counts.
+///
+/// @see GetStats()
+void AssetPreprocessor::ResetStats()
+{
+	AtomicExchangeRelease( m_objectHitCount, 0 );
+	AtomicExchangeRelease( m_objectMissCount, 0 );
+	AtomicExchangeRelease( m_resourceHitCount, 0 );
+	AtomicExchangeRelease( m_resourceMissCount, 0 );
+	AtomicExchangeRelease( m_sharedResourceHitCount, 0 );
+}
+
+#if HELIUM_TOOLS
+
+/// Set whether resources that need preprocessing are queued instead of preprocessed as they are loaded.
+///
+/// Queued resources are preprocessed in bulk by PreprocessDeferredResources(), spreading the work across the job
+/// pool.  Until then, they have no preprocessed data in memory, and their objects are not cached.
+///
+/// @param[in] bDefer  True to defer resource preprocessing, false to preprocess resources as they are loaded.
+///
+/// @see GetDeferResourcePreprocessing(), PreprocessDeferredResources()
+void AssetPreprocessor::SetDeferResourcePreprocessing( bool bDefer )
+{
+	m_bDeferResourcePreprocessing = bDefer;
+}
+
+/// Preprocess all resources queued while resource preprocessing was deferred, and cache them.
+///
+/// Resources whose handlers are thread-safe are preprocessed concurrently on the job pool, and the rest one at a time
+/// on the calling thread.  Caching is done on the calling thread once all resources have been preprocessed.
+///
+/// @param[out] rFailedPaths  Paths of the resources that failed to be preprocessed or cached are appended to this.
+///
+/// @return  True if all queued resources were preprocessed and cached successfully, false if not.
+///
+/// @see SetDeferResourcePreprocessing()
+bool AssetPreprocessor::PreprocessDeferredResources( DynamicArray< AssetPath >& rFailedPaths )
+{
+	size_t resourceCount = m_deferredResources.GetSize();
+
+	m_deferredJobIndices.Resize( 0 );
+	m_deferredJobIndices.Reserve( resourceCount );
+
+	DynamicArray< size_t > serialIndices;
+	for( size_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex )
+	{
+		const AssetType* pResourceType = m_deferredResources[ resourceIndex ].spResource->GetAssetType();
+		HELIUM_ASSERT( pResourceType );
+		ResourceHandler* pResourceHandler = ResourceHandler::FindResourceHandlerForType( pResourceType );
+		if( pResourceHandler && pResourceHandler->IsThreadSafe() )
+		{
+			m_deferredJobIndices.Push( resourceIndex );
+		}
+		else
+		{
+			serialIndices.Push( resourceIndex );
+		}
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "AssetPreprocessor::PreprocessDeferredResources(): Preprocessing %" ) PRIuSZ TXT( " resources (%" )
+		PRIuSZ TXT( " concurrently).\n" ) ),
+		resourceCount,
+		m_deferredJobIndices.GetSize() );
+
+	JobPool::GetStaticInstance().Run( PreprocessDeferredResourceJob, this, m_deferredJobIndices.GetSize() );
+
+	size_t serialCount = serialIndices.GetSize();
+	for( size_t serialIndex = 0; serialIndex < serialCount; ++serialIndex )
+	{
+		DeferredResource& rDeferredResource = m_deferredResources[ serialIndices[ serialIndex ] ];
+		rDeferredResource.bSuccess = PreprocessResource(
+			rDeferredResource.path,
+			rDeferredResource.spResource,
+			rDeferredResource.sourceFilePath,
+			rDeferredResource.inputHash );
+	}
+
+	m_deferredJobIndices.Clear();
+
+	// Cache the preprocessed resources.  Resources that failed to preprocess have no data to cache, so their objects
+	// are left out-of-date to be retried next time.
+	bool bSuccess = true;
+	for( size_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex )
+	{
+		DeferredResource& rDeferredResource = m_deferredResources[ resourceIndex ];
+		if( rDeferredResource.bSuccess )
+		{
+			rDeferredResource.bSuccess = CacheObject(
+				rDeferredResource.path,
+				rDeferredResource.spResource,
+				rDeferredResource.inputHash,
+				true );
+		}
+
+		if( !rDeferredResource.bSuccess )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "AssetPreprocessor::PreprocessDeferredResources(): Failed to preprocess resource \"%s\".\n" ),
+				*rDeferredResource.path.ToString() );
+
+			rFailedPaths.Push( rDeferredResource.path );
+			bSuccess = false;
+		}
+	}
+
+	m_deferredResources.Clear();
+
+	return bSuccess;
+}
+
+/// Share preprocessed resource data with other workspaces through a content-addressed store on the local machine.
+///
+/// Resources that need to be preprocessed are first looked up in the store by the hash of their inputs, and the
+/// results of preprocessing are added to it, so workspaces with identical source data only preprocess it once.
+///
+/// @param[in] rDirectory  Store directory (may be used by any number of processes at once).
+/// @param[in] sizeLimit   Maximum total size of the store, in bytes.
+///
+/// This should not be called while resources are being loaded.
+///
+/// @return  True if the store was initialized successfully, false if not.
+///
+/// @see DisableSharedCache(), IsSharedCacheEnabled()
+bool AssetPreprocessor::EnableSharedCache( const FilePath& rDirectory, uint64_t sizeLimit )
+{
+	return m_sharedCache.Initialize( rDirectory, sizeLimit );
+}
+
+/// Stop sharing preprocessed resource data with other workspaces.
+///
+/// This should not be called while resources are being loaded.
+///
+/// @see EnableSharedCache(), IsSharedCacheEnabled()
+void AssetPreprocessor::DisableSharedCache()
+{
+	m_sharedCache.Shutdown();
+}
+
+/// Get the value stored as the timestamp of the cache entries for an object on a given platform.
+///
+/// This combines the input hash with the settings of the platform preprocessor (its byte order, shader profile count and
+/// version), so that changing those settings also invalidates the cached data.
+///
+/// @param[in] inputHash  Hash of the object's inputs.
+/// @param[in] platform   Target platform.
+///
+/// @return  Cache entry timestamp value.
+int64_t AssetPreprocessor::GetPlatformInputStamp( uint64_t inputHash, Cache::EPlatform platform ) const
+{
+	HELIUM_ASSERT( static_cast< size_t >( platform ) < static_cast< size_t >( Cache::PLATFORM_MAX ) );
+
+	PlatformPreprocessor* pPreprocessor = m_pPlatformPreprocessors[ platform ];
+	HELIUM_ASSERT( pPreprocessor );
+
+	ContentHash hash;
+	hash.Update( inputHash );
+	hash.Update( static_cast< uint64_t >( platform ) );
+	hash.Update( static_cast< uint64_t >( pPreprocessor->GetByteOrder() ) );
+	hash.Update( static_cast< uint64_t >( pPreprocessor->GetShaderProfileCount() ) );
+	hash.Update( static_cast< uint64_t >( pPreprocessor->GetVersion() ) );
+
+	return static_cast< int64_t >( hash.GetValue() );
+}
+
+/// Get the key of the shared preprocessing cache entry for a resource.
+///
+/// The key covers the platforms for which data is preprocessed along with their settings, as each entry holds the
+/// data for all of them.
+///
+/// @param[in] inputHash  Hash of the resource's inputs.
+///
+/// @return  Shared preprocessing cache key.
+uint64_t AssetPreprocessor::GetSharedCacheKey( uint64_t inputHash ) const
+{
+	ContentHash hash;
+	hash.Update( inputHash );
+
+	for( size_t platformIndex = 0; platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ); ++platformIndex )
+	{
+		if( m_pPlatformPreprocessors[ platformIndex ] )
+		{
+			hash.Update( static_cast< uint64_t >(
+				GetPlatformInputStamp( inputHash, static_cast< Cache::EPlatform >( platformIndex ) ) ) );
+		}
+	}
+
+	return hash.GetValue();
+}
+
+/// Job pool callback for preprocessing a deferred resource.
+///
+/// @param[in] pData      Asset preprocessor instance.
+/// @param[in] itemIndex  Index of the deferred resource in the job index list.
+void AssetPreprocessor::PreprocessDeferredResourceJob( void* pData, size_t itemIndex )
+{
+	AssetPreprocessor* pThis = static_cast< AssetPreprocessor* >( pData );
+	HELIUM_ASSERT( pThis );
+
+	DeferredResource& rDeferredResource = pThis->m_deferredResources[ pThis->m_deferredJobIndices[ itemIndex ] ];
+	rDeferredResource.bSuccess = pThis->PreprocessResource(
+		rDeferredResource.path,
+		rDeferredResource.spResource,
+		rDeferredResource.sourceFilePath,
+		rDeferredResource.inputHash );
+}
 
 /// Load the persistent resource data for the specified resource from the object cache.
 ///
@@ -742,6 +1137,8 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 		rSubDataBuffers.Reserve( subDataCount );
 		rSubDataBuffers.Resize( subDataCount );
 
+		DynamicArray< uint8_t > compressedData;
+
 		for( uint32_t subDataIndex = 0; subDataIndex < subDataCount; ++subDataIndex )
 		{
 			const Cache::Entry* pResourceCacheEntry = pResourceCache->FindEntry( path, subDataIndex );
@@ -778,21 +1175,31 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 			}
 
 			uint32_t subDataSize = pResourceCacheEntry->size;
+			uint32_t storedSize = pResourceCacheEntry->storedSize;
+			Compression::ECodec codec = pResourceCacheEntry->codec;
 
 			DynamicArray< uint8_t >& rSubData = rSubDataBuffers[ subDataIndex ];
 			rSubData.Reserve( subDataSize );
 			rSubData.Resize( subDataSize );
 			rSubData.Trim();
 
-			size_t bytesRead = pFileStream->Read( rSubData.GetData(), 1, subDataSize );
-			if( bytesRead != subDataSize )
+			// Compressed sub-data is read into a scratch buffer first and decompressed into place.
+			uint8_t* pReadBuffer = rSubData.GetData();
+			if( codec != Compression::CODEC_NONE )
+			{
+				compressedData.Resize( storedSize );
+				pReadBuffer = compressedData.GetData();
+			}
+
+			size_t bytesRead = pFileStream->Read( pReadBuffer, 1, storedSize );
+			if( bytesRead != storedSize )
 			{
 				HELIUM_TRACE(
 					TraceLevels::Error,
 					( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to read %" ) PRIu32
 					TXT( " bytes from cache \"%s\" for sub-data %" ) PRIu32 TXT( " of resource \"%s\" (only %" )
 					PRIuSZ TXT( " bytes read).\n" ) ),
-					subDataSize,
+					storedSize,
 					*resourceCacheName,
 					subDataIndex,
 					*path.ToString(),
@@ -802,6 +1209,31 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 
 				return false;
 			}
+
+			if( codec != Compression::CODEC_NONE )
+			{
+				size_t decompressedSize = Compression::Decompress(
+					codec,
+					pReadBuffer,
+					storedSize,
+					rSubData.GetData(),
+					subDataSize );
+				if( decompressedSize != subDataSize )
+				{
+					HELIUM_TRACE(
+						TraceLevels::Error,
+						( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to decompress sub-data %" ) PRIu32
+						TXT( " of resource \"%s\" from cache \"%s\" (%s).\n" ) ),
+						subDataIndex,
+						*path.ToString(),
+						*resourceCacheName,
+						Compression::GetCodecName( codec ) );
+
+					delete pFileStream;
+
+					return false;
+				}
+			}
 		}
 
 		delete pFileStream;
@@ -815,11 +1247,19 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 
 /// Preprocess a resource for all enabled platforms, storing the resource data in memory with the resource.
 ///
+/// If the shared preprocessing cache is enabled, the preprocessed data is loaded from it when available instead of
+/// running the resource handler, and added to it otherwise.
+///
 /// @param[in] pResource        Resource to preprocess.
 /// @param[in] rSourceFilePath  FilePath name of the source resource data file.
+/// @param[in] inputHash        Hash of the resource's inputs (see ComputeInputHash()).
 ///
 /// @return  True if preprocessing was successful, false if not.
-bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pResource, const String& rSourceFilePath )
+bool AssetPreprocessor::PreprocessResource(
+	const AssetPath &path,
+	Resource* pResource,
+	const String& rSourceFilePath,
+	uint64_t inputHash )
 {
 	HELIUM_ASSERT( pResource );
 	HELIUM_ASSERT( !pResource->IsDefaultTemplate() );
@@ -855,15 +1295,39 @@ bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pRe
 		return false;
 	}
 
-	// Preprocess and cache the resource for the each enabled platform.
-	if( !pResourceHandler->CacheResource( this, pResource, rSourceFilePath ) )
+	Resource::PreprocessedData* pPlatformData = &pResource->GetPreprocessedData( static_cast< Cache::EPlatform >( 0 ) );
+
+	// Check whether another workspace already preprocessed the resource from the same inputs.
+	bool bSharedCacheEnabled = m_sharedCache.IsInitialized();
+	uint64_t sharedCacheKey = ( bSharedCacheEnabled ? GetSharedCacheKey( inputHash ) : 0 );
+	bool bSharedCacheHit = ( bSharedCacheEnabled && m_sharedCache.Load( sharedCacheKey, pPlatformData ) );
+
+	if( bSharedCacheHit )
 	{
+		AtomicIncrementRelease( m_sharedResourceHitCount );
+
 		HELIUM_TRACE(
-			TraceLevels::Error,
-			TXT( "AssetPreprocessor::PreprocessResource(): Failed to preprocess resource \"%s\".\n" ),
+			TraceLevels::Info,
+			TXT( "AssetPreprocessor::PreprocessResource(): Loaded resource \"%s\" from the shared cache.\n" ),
 			*path.ToString() );
+	}
+	else
+	{
+		// Preprocess and cache the resource for the each enabled platform.
+		if( !pResourceHandler->CacheResource( this, pResource, rSourceFilePath ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "AssetPreprocessor::PreprocessResource(): Failed to preprocess resource \"%s\".\n" ),
+				*path.ToString() );
 
-		return false;
+			return false;
+		}
+
+		if( bSharedCacheEnabled )
+		{
+			m_sharedCache.Store( sharedCacheKey, pPlatformData );
+		}
 	}
 
 	// Reserialize the current platform's persistent resource data.
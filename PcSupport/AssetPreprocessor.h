@@ -2,7 +2,11 @@
 
 #include "PcSupport/PcSupport.h"
 
+#include "Platform/Locks.h"
+#include "Foundation/HashMap.h"
+
 #include "Engine/Cache.h"
+#include "PcSupport/SharedPreprocessCache.h"
 
 namespace Helium
 {
@@ -14,15 +18,40 @@ namespace Helium
     class HELIUM_PC_SUPPORT_API AssetPreprocessor : NonCopyable
     {
     public:
+        /// Version of the cached object and resource data layout.  This is part of every input hash, so increasing it
+        /// invalidates all previously cached data.
+        static const uint32_t CACHE_VERSION = 1;
+
+        /// Cache hit and miss counts.
+        struct Stats
+        {
+            /// Number of object cache entries found to be up-to-date.
+            uint32_t objectHits;
+            /// Number of object cache entries that were missing or out-of-date and had to be recached.
+            uint32_t objectMisses;
+            /// Number of resources loaded from up-to-date cached data.
+            uint32_t resourceHits;
+            /// Number of resources that had to be preprocessed.
+            uint32_t resourceMisses;
+            /// Number of resource misses whose preprocessed data was found in the shared preprocessing cache.
+            uint32_t sharedResourceHits;
+        };
+
         /// @name Platform Preprocessor Registration
         //@{
         void SetPlatformPreprocessor( Cache::EPlatform platform, PlatformPreprocessor* pPreprocessor );
         inline PlatformPreprocessor* GetPlatformPreprocessor( Cache::EPlatform platform ) const;
         //@}
 
+        /// @name Resource Compression
+        //@{
+        void SetResourceCompression( Compression::ECodec codec );
+        inline Compression::ECodec GetResourceCompression() const;
+        //@}
+
         /// @name Asset Caching
         //@{
-        bool CacheObject( const AssetPath &objectPath, Asset* pObject, int64_t timestamp, bool bEvictPlatformPreprocessedResourceData = true );
+        bool CacheObject( const AssetPath &objectPath, Asset* pObject, uint64_t inputHash, bool bEvictPlatformPreprocessedResourceData = true );
         //@}
 
         /// @name Resource Preprocessing
@@ -30,6 +59,36 @@ namespace Helium
         void LoadResourceData( const AssetPath &path, Resource* pResource );
         //@}
 
+#if HELIUM_TOOLS
+        /// @name Deferred Resource Preprocessing
+        //@{
+        void SetDeferResourcePreprocessing( bool bDefer );
+        inline bool GetDeferResourcePreprocessing() const;
+        inline size_t GetDeferredResourceCount() const;
+        bool PreprocessDeferredResources( DynamicArray< AssetPath >& rFailedPaths );
+        //@}
+
+        /// @name Shared Preprocessing Cache
+        //@{
+        bool EnableSharedCache(
+            const FilePath& rDirectory, uint64_t sizeLimit = SharedPreprocessCache::DEFAULT_SIZE_LIMIT );
+        void DisableSharedCache();
+        inline bool IsSharedCacheEnabled() const;
+        //@}
+#endif
+
+        /// @name Input Hashing
+        //@{
+        uint64_t ComputeInputHash( const AssetPath &assetPath, const FilePath &sourceFilePath, const Resource* pResource );
+        uint64_t ComputeFileHash( const FilePath &filePath );
+        //@}
+
+        /// @name Statistics
+        //@{
+        void GetStats( Stats& rStats ) const;
+        void ResetStats();
+        //@}
+
         /// @name Static Access
         //@{
         static AssetPreprocessor* CreateStaticInstance();
@@ -41,6 +100,63 @@ namespace Helium
     private:
         /// Platform-specific preprocessing support.
         PlatformPreprocessor* m_pPlatformPreprocessors[ Cache::PLATFORM_MAX ];
+        /// Codec with which to compress resource sub-data in the resource caches.
+        Compression::ECodec m_resourceCodec;
+
+        /// Cached file content hash.
+        struct FileHash
+        {
+            /// File modification time when hashed.
+            int64_t modifiedTime;
+            /// File size when hashed.
+            int64_t size;
+            /// Content hash.
+            uint64_t hash;
+        };
+
+        /// File content hashes computed so far, keyed by file path (reused while a file's size and modification time
+        /// are unchanged, so that files shared by several objects are only read once).
+        HashMap< Name, FileHash > m_fileHashes;
+        /// Lock for synchronizing access to the file hash map.
+        SpinLock m_fileHashLock;
+
+        /// Number of object cache entries found to be up-to-date.
+        volatile int32_t m_objectHitCount;
+        /// Number of object cache entries recached.
+        volatile int32_t m_objectMissCount;
+        /// Number of resources loaded from cached data.
+        volatile int32_t m_resourceHitCount;
+        /// Number of resources preprocessed.
+        volatile int32_t m_resourceMissCount;
+        /// Number of resources whose preprocessed data was found in the shared preprocessing cache.
+        volatile int32_t m_sharedResourceHitCount;
+
+#if HELIUM_TOOLS
+        /// Resource whose preprocessing has been deferred.
+        struct DeferredResource
+        {
+            /// Resource path.
+            AssetPath path;
+            /// Resource instance.
+            StrongPtr< Resource > spResource;
+            /// Source file path.
+            String sourceFilePath;
+            /// Hash of the resource's inputs.
+            uint64_t inputHash;
+            /// True if preprocessing succeeded.
+            bool bSuccess;
+        };
+
+        /// Preprocessed resource data store shared with other workspaces (if enabled).
+        SharedPreprocessCache m_sharedCache;
+
+        /// Resources queued for preprocessing by PreprocessDeferredResources().
+        DynamicArray< DeferredResource > m_deferredResources;
+        /// Indices of the deferred resources being preprocessed by the job pool.
+        DynamicArray< size_t > m_deferredJobIndices;
+        /// True if resources that need preprocessing are queued instead of preprocessed when loaded.
+        bool m_bDeferResourcePreprocessing;
+#endif
 
         /// Singleton instance.
         static AssetPreprocessor* sm_pInstance;
@@ -55,10 +171,16 @@ namespace Helium
         //@{
 #if HELIUM_TOOLS
         bool LoadCachedResourceData( const AssetPath &path, Resource* pResource, Cache::EPlatform platform );
-        bool PreprocessResource( const AssetPath &path, Resource* pResource, const String& rSourceFilePath );
+        bool PreprocessResource(
+            const AssetPath &path, Resource* pResource, const String& rSourceFilePath, uint64_t inputHash );
 
         uint32_t LoadPersistentResourceData(
             AssetPath resourcePath, Cache::EPlatform platform, DynamicArray< uint8_t >& rPersistentDataBuffer );
+
+        int64_t GetPlatformInputStamp( uint64_t inputHash, Cache::EPlatform platform ) const;
+        uint64_t GetSharedCacheKey( uint64_t inputHash ) const;
+
+        static void PreprocessDeferredResourceJob( void* pData, size_t itemIndex );
 #endif
         //@}
     };
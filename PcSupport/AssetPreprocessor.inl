@@ -13,4 +13,46 @@ namespace Helium
 
         return m_pPlatformPreprocessors[ platform ];
     }
+
+    /// Get the codec with which resource sub-data is compressed when cached.
+    ///
+    /// @return  Resource sub-data compression codec.
+    ///
+    /// @see SetResourceCompression()
+    Compression::ECodec AssetPreprocessor::GetResourceCompression() const
+    {
+        return m_resourceCodec;
+    }
+
+#if HELIUM_TOOLS
+    /// Get whether resources that need preprocessing are queued instead of preprocessed as they are loaded.
+    ///
+    /// @return  True if resource preprocessing is deferred, false if not.
+    ///
+    /// @see SetDeferResourcePreprocessing(), PreprocessDeferredResources()
+    bool AssetPreprocessor::GetDeferResourcePreprocessing() const
+    {
+        return m_bDeferResourcePreprocessing;
+    }
+
+    /// Get the number of resources queued for preprocessing.
+    ///
+    /// @return  Deferred resource count.
+    ///
+    /// @see PreprocessDeferredResources()
+    size_t AssetPreprocessor::GetDeferredResourceCount() const
+    {
+        return m_deferredResources.GetSize();
+    }
+
+    /// Get whether preprocessed resource data is shared with other workspaces through a shared preprocessing cache.
+    ///
+    /// @return  True if the shared preprocessing cache is enabled, false if not.
+    ///
+    /// @see EnableSharedCache(), DisableSharedCache()
+    bool AssetPreprocessor::IsSharedCacheEnabled() const
+    {
+        return m_sharedCache.IsInitialized();
+    }
+#endif
 }
@@ -0,0 +1,143 @@
+#include "PcSupportPch.h"
+#include "PcSupport/ContentHash.h"
+
+#include "Foundation/FileStream.h"
+
+using namespace Helium;
+
+/// Multiplier used to mix data into the hash (from MurmurHash64A).
+static const uint64_t HASH_MULTIPLIER = 0xc6a4a7935bd1e995ULL;
+/// Shift used to mix data into the hash.
+static const int HASH_SHIFT = 47;
+/// Initial hash value.
+static const uint64_t HASH_SEED = 0x8445d61a4e774912ULL;
+
+/// Size of the buffer used when hashing files, in bytes.
+static const size_t FILE_BUFFER_SIZE = 64 * 1024;
+
+/// Mix a block of eight bytes into a hash value.
+///
+/// @param[in] hash    Current hash value.
+/// @param[in] pBlock  Block to mix (read in little-endian byte order).
+///
+/// @return  Updated hash value.
+static uint64_t MixBlock( uint64_t hash, const uint8_t* pBlock )
+{
+	uint64_t block = 0;
+	for( size_t byteIndex = 0; byteIndex < 8; ++byteIndex )
+	{
+		block |= static_cast< uint64_t >( pBlock[ byteIndex ] ) << ( byteIndex * 8 );
+	}
+
+	block *= HASH_MULTIPLIER;
+	block ^= block >> HASH_SHIFT;
+	block *= HASH_MULTIPLIER;
+
+	hash ^= block;
+	hash *= HASH_MULTIPLIER;
+
+	return hash;
+}
+
+/// Constructor.
+ContentHash::ContentHash()
+: m_hash( HASH_SEED )
+, m_length( 0 )
+, m_pendingSize( 0 )
+{
+}
+
+/// Hash a block of data.
+///
+/// @param[in] pData  Data to hash.
+/// @param[in] size   Number of bytes to hash.
+void ContentHash::Update( const void* pData, size_t size )
+{
+	HELIUM_ASSERT( pData || size == 0 );
+
+	const uint8_t* pBytes = static_cast< const uint8_t* >( pData );
+	m_length += size;
+
+	// Complete any partial block left over from the previous update first.
+	if( m_pendingSize != 0 )
+	{
+		size_t copySize = Min( size, sizeof( m_pending ) - m_pendingSize );
+		MemoryCopy( m_pending + m_pendingSize, pBytes, copySize );
+		m_pendingSize += copySize;
+		pBytes += copySize;
+		size -= copySize;
+
+		if( m_pendingSize < sizeof( m_pending ) )
+		{
+			return;
+		}
+
+		m_hash = MixBlock( m_hash, m_pending );
+		m_pendingSize = 0;
+	}
+
+	while( size >= 8 )
+	{
+		m_hash = MixBlock( m_hash, pBytes );
+		pBytes += 8;
+		size -= 8;
+	}
+
+	MemoryCopy( m_pending, pBytes, size );
+	m_pendingSize = size;
+}
+
+/// Hash the contents of a file.
+///
+/// @param[in] rFilePath  Path of the file to hash.
+///
+/// @return  True if the file was hashed, false if it could not be opened.
+bool ContentHash::UpdateFile( const FilePath& rFilePath )
+{
+	FileStream* pStream = FileStream::OpenFileStream( rFilePath, FileStream::MODE_READ );
+	if( !pStream )
+	{
+		return false;
+	}
+
+	DynamicArray< uint8_t > buffer;
+	buffer.Resize( FILE_BUFFER_SIZE );
+
+	size_t bytesRead;
+	do
+	{
+		bytesRead = pStream->Read( buffer.GetData(), 1, FILE_BUFFER_SIZE );
+		Update( buffer.GetData(), bytesRead );
+	} while( bytesRead == FILE_BUFFER_SIZE );
+
+	delete pStream;
+
+	return true;
+}
+
+/// Get the hash of all data hashed so far.
+///
+/// This does not modify the hash state, so more data can still be hashed afterward.
+///
+/// @return  Hash value.
+uint64_t ContentHash::GetValue() const
+{
+	uint64_t hash = m_hash;
+
+	// Mix in the trailing bytes, padded with zeros, and the total length so that trailing zeros are significant.
+	if( m_pendingSize != 0 )
+	{
+		uint8_t block[ 8 ];
+		MemoryZero( block, sizeof( block ) );
+		MemoryCopy( block, m_pending, m_pendingSize );
+		hash = MixBlock( hash, block );
+	}
+
+	hash ^= m_length * HASH_MULTIPLIER;
+
+	hash ^= hash >> HASH_SHIFT;
+	hash *= HASH_MULTIPLIER;
+	hash ^= hash >> HASH_SHIFT;
+
+	return hash;
+}
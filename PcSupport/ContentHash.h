@@ -0,0 +1,43 @@
+#pragma once
+
+#include "PcSupport/PcSupport.h"
+
+#include "Foundation/FilePath.h"
+
+namespace Helium
+{
+	/// Incremental 64-bit hash of arbitrary data, used to identify preprocessed data by the contents of its inputs.
+	///
+	/// Data is mixed in eight bytes at a time, so hashing large source files is bound by I/O rather than by the hash
+	/// itself.  The result only depends on the sequence of bytes hashed, not on how they were split across calls to
+	/// Update(), and is the same on every platform.
+	class HELIUM_PC_SUPPORT_API ContentHash
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		ContentHash();
+		//@}
+
+		/// @name Hashing
+		//@{
+		void Update( const void* pData, size_t size );
+		inline void Update( uint64_t value );
+		bool UpdateFile( const FilePath& rFilePath );
+
+		uint64_t GetValue() const;
+		//@}
+
+	private:
+		/// Running hash value.
+		uint64_t m_hash;
+		/// Total number of bytes hashed.
+		uint64_t m_length;
+		/// Bytes not yet mixed into the hash (fewer than eight).
+		uint8_t m_pending[ 8 ];
+		/// Number of bytes in the pending buffer.
+		size_t m_pendingSize;
+	};
+}
+
+#include "PcSupport/ContentHash.inl"
@@ -0,0 +1,18 @@
+namespace Helium
+{
+	/// Hash a 64-bit value.
+	///
+	/// The value is hashed in little-endian byte order regardless of the platform byte order.
+	///
+	/// @param[in] value  Value to hash.
+	void ContentHash::Update( uint64_t value )
+	{
+		uint8_t bytes[ 8 ];
+		for( size_t byteIndex = 0; byteIndex < 8; ++byteIndex )
+		{
+			bytes[ byteIndex ] = static_cast< uint8_t >( value >> ( byteIndex * 8 ) );
+		}
+
+		Update( bytes, sizeof( bytes ) );
+	}
+}
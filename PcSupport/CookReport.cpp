@@ -0,0 +1,106 @@
+#include "PcSupportPch.h"
+#include "PcSupport/CookReport.h"
+
+using namespace Helium;
+
+/// Append a string to a JSON document as a quoted, escaped string value.
+///
+/// @param[in,out] rJson    JSON document.
+/// @param[in]     pString  String to append.
+static void AppendJsonString( String& rJson, const char* pString )
+{
+	rJson += TXT( '"' );
+	for( ; *pString; ++pString )
+	{
+		char character = *pString;
+		if( character == TXT( '"' ) || character == TXT( '\\' ) )
+		{
+			rJson += TXT( '\\' );
+			rJson += character;
+		}
+		else if( static_cast< unsigned char >( character ) < 0x20 )
+		{
+			char escape[ 8 ];
+			StringPrint( escape, TXT( "\\u%04x" ), static_cast< unsigned int >( character ) );
+			rJson += escape;
+		}
+		else
+		{
+			rJson += character;
+		}
+	}
+	rJson += TXT( '"' );
+}
+
+/// Constructor.
+CookReport::CookReport()
+	: packageCount( 0 )
+	, assetCount( 0 )
+	, preprocessedCount( 0 )
+	, seconds( 0.0f )
+{
+}
+
+/// Record a cook failure.
+///
+/// @param[in] rPath   Path of the asset or cache file that failed.
+/// @param[in] pStage  Stage at which the failure occurred.
+void CookReport::AddFailure( const String& rPath, const char* pStage )
+{
+	HELIUM_ASSERT( pStage );
+
+	CookFailure* pFailure = failures.New();
+	HELIUM_ASSERT( pFailure );
+	pFailure->path = rPath;
+	pFailure->pStage = pStage;
+}
+
+/// Record a cook failure.
+///
+/// @param[in] rPath   Path of the asset that failed.
+/// @param[in] pStage  Stage at which the failure occurred.
+void CookReport::AddFailure( const AssetPath& rPath, const char* pStage )
+{
+	AddFailure( rPath.ToString(), pStage );
+}
+
+/// Get the result of the cook, to be used as the process exit code.
+///
+/// @return  RESULT_SUCCESS if no failures were recorded, RESULT_FAILURE if any were.
+CookReport::EResult CookReport::GetResult() const
+{
+	return ( failures.IsEmpty() ? RESULT_SUCCESS : RESULT_FAILURE );
+}
+
+/// Build the machine-readable cook report.
+///
+/// @param[out] rJson  JSON report document.
+void CookReport::BuildJson( String& rJson ) const
+{
+	size_t failureCount = failures.GetSize();
+
+	char buffer[ 256 ];
+	StringPrint(
+		buffer,
+		( TXT( "{\n\t\"success\": %s,\n\t\"packages\": %" ) PRIuSZ TXT( ",\n\t\"assets\": %" ) PRIuSZ
+		TXT( ",\n\t\"preprocessed\": %" ) PRIuSZ TXT( ",\n\t\"seconds\": %.3f,\n\t\"failures\": [" ) ),
+		( failureCount == 0 ? TXT( "true" ) : TXT( "false" ) ),
+		packageCount,
+		assetCount,
+		preprocessedCount,
+		seconds );
+	rJson = buffer;
+
+	for( size_t failureIndex = 0; failureIndex < failureCount; ++failureIndex )
+	{
+		const CookFailure& rFailure = failures[ failureIndex ];
+
+		rJson += ( failureIndex == 0 ? TXT( "\n\t\t{ \"path\": " ) : TXT( ",\n\t\t{ \"path\": " ) );
+		AppendJsonString( rJson, *rFailure.path );
+		rJson += TXT( ", \"stage\": " );
+		AppendJsonString( rJson, rFailure.pStage );
+		rJson += TXT( " }" );
+	}
+
+	rJson += ( failureCount == 0 ? TXT( "]\n}\n" ) : TXT( "\n\t]\n}\n" ) );
+}
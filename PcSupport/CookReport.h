@@ -0,0 +1,62 @@
+#pragma once
+
+#include "PcSupport/PcSupport.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/String.h"
+#include "Engine/AssetPath.h"
+
+namespace Helium
+{
+	/// Cook failure record.
+	struct HELIUM_PC_SUPPORT_API CookFailure
+	{
+		/// Path of the asset or cache file that failed.
+		String path;
+		/// Stage at which the failure occurred ("enumerate", "load", "timeout", "preprocess", or "write").
+		const char* pStage;
+	};
+
+	/// Results of a headless cook, used to build its exit code and its machine-readable JSON report.
+	struct HELIUM_PC_SUPPORT_API CookReport
+	{
+		/// Cook exit codes.
+		enum EResult
+		{
+			/// Every asset was cooked successfully.
+			RESULT_SUCCESS = 0,
+			/// One or more assets failed to cook.
+			RESULT_FAILURE = 1,
+			/// Invalid usage, initialization failure, or the report could not be written.
+			RESULT_ERROR   = 2
+		};
+
+		/// Number of packages enumerated.
+		size_t packageCount;
+		/// Number of assets enumerated.
+		size_t assetCount;
+		/// Number of resources that needed preprocessing.
+		size_t preprocessedCount;
+		/// Total cook time, in seconds.
+		float32_t seconds;
+		/// Failures, in the order they occurred.
+		DynamicArray< CookFailure > failures;
+
+		/// @name Construction/Destruction
+		//@{
+		CookReport();
+		//@}
+
+		/// @name Failure Reporting
+		//@{
+		void AddFailure( const String& rPath, const char* pStage );
+		void AddFailure( const AssetPath& rPath, const char* pStage );
+		//@}
+
+		/// @name Results
+		//@{
+		EResult GetResult() const;
+		void BuildJson( String& rJson ) const;
+		//@}
+	};
+}
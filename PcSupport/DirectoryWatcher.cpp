@@ -0,0 +1,611 @@
+#include "PcSupportPch.h"
+#include "PcSupport/DirectoryWatcher.h"
+
+#include "Platform/Timer.h"
+#include "Foundation/DirectoryIterator.h"
+
+#if HELIUM_OS_LINUX
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+using namespace Helium;
+
+#if HELIUM_OS_LINUX
+/// Size of the buffer used for reading notifications, in bytes.
+static const size_t EVENT_BUFFER_SIZE = 64 * 1024;
+
+/// Events requested for each watched directory.
+static const uint32_t WATCH_EVENT_MASK =
+	IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR |
+	IN_EXCL_UNLINK;
+#endif
+
+/// Append a trailing separator to a directory path if it does not already end with one.
+///
+/// @param[in] rPath  Directory path.
+///
+/// @return  Directory path with a trailing separator.
+static std::string GetDirectoryPath( const std::string& rPath )
+{
+	if( !rPath.empty() && rPath[ rPath.size() - 1 ] != TXT( '/' ) )
+	{
+		return rPath + TXT( '/' );
+	}
+
+	return rPath;
+}
+
+/// Get whether a path is the same as, or lies within, a given directory.
+///
+/// @param[in] rPath       Path to test.
+/// @param[in] rDirectory  Directory path, including a trailing separator.
+///
+/// @return  True if the path lies within the directory, false if not.
+static bool IsInDirectory( const std::string& rPath, const std::string& rDirectory )
+{
+	return ( rPath.compare( 0, rDirectory.size(), rDirectory ) == 0 );
+}
+
+/// Constructor.
+DirectoryWatcher::DirectoryWatcher()
+: m_handle( -1 )
+, m_settleMilliseconds( DEFAULT_SETTLE_MILLISECONDS )
+{
+}
+
+/// Destructor.
+DirectoryWatcher::~DirectoryWatcher()
+{
+	Shutdown();
+}
+
+/// Initialize this watcher.
+///
+/// @param[in] settleMilliseconds  Time a file must be left alone before its changes are reported, in milliseconds.
+///
+/// @return  True if initialization was successful, false if not (including when native notifications are not
+///          supported on the current platform).
+///
+/// @see Shutdown()
+bool DirectoryWatcher::Initialize( uint32_t settleMilliseconds )
+{
+	Shutdown();
+
+	m_settleMilliseconds = settleMilliseconds;
+
+#if HELIUM_OS_LINUX
+	m_handle = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+	if( m_handle < 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "DirectoryWatcher: Failed to initialize inotify (error %d).\n" ),
+			errno );
+
+		m_handle = -1;
+
+		return false;
+	}
+
+	m_eventBuffer.Resize( EVENT_BUFFER_SIZE );
+
+	return true;
+#else
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "DirectoryWatcher: Native file change notifications are not supported on this platform.\n" ) );
+
+	return false;
+#endif
+}
+
+/// Shut down this watcher, removing all watches and discarding any changes that have not been reported.
+///
+/// @see Initialize()
+void DirectoryWatcher::Shutdown()
+{
+#if HELIUM_OS_LINUX
+	if( m_handle >= 0 )
+	{
+		close( m_handle );
+	}
+#endif
+
+	m_handle = -1;
+
+	m_watches.Clear();
+	m_pendingChanges.Clear();
+	m_pendingMoves.Clear();
+	m_eventBuffer.Clear();
+}
+
+/// Start watching a directory and all of its subdirectories.
+///
+/// @param[in] rDirectory  Directory to watch.
+///
+/// @return  True if the directory is being watched, false if not.
+///
+/// @see RemoveDirectory()
+bool DirectoryWatcher::AddDirectory( const FilePath& rDirectory )
+{
+	HELIUM_ASSERT( IsInitialized() );
+	if( !IsInitialized() )
+	{
+		return false;
+	}
+
+	std::string directory = GetDirectoryPath( rDirectory.Get() );
+
+	size_t watchCount = m_watches.GetSize();
+	for( size_t watchIndex = 0; watchIndex < watchCount; ++watchIndex )
+	{
+		if( m_watches[ watchIndex ].path == directory )
+		{
+			return true;
+		}
+	}
+
+	return AddWatchRecursive( directory, false );
+}
+
+/// Stop watching a directory and all of its subdirectories.
+///
+/// @param[in] rDirectory  Directory to stop watching.
+///
+/// @see AddDirectory()
+void DirectoryWatcher::RemoveDirectory( const FilePath& rDirectory )
+{
+	HELIUM_ASSERT( IsInitialized() );
+	if( !IsInitialized() )
+	{
+		return;
+	}
+
+	RemoveWatches( GetDirectoryPath( rDirectory.Get() ) );
+}
+
+/// Wait for file changes and retrieve the ones that have settled.
+///
+/// Changes are only reported once no further events have been seen for the same file for the settle period given to
+/// Initialize(), so callers should call this in a loop; changes that are still settling are kept for the next call.
+///
+/// @param[in]  timeoutMilliseconds  Maximum time to wait for new events, in milliseconds.  The wait is cut short to
+///                                  the settle period while changes are pending.
+/// @param[out] rChanges             Settled changes are appended to this array, in the order they were first seen.
+///
+/// @return  True if all changes were seen, false if events were lost because the notification queue overflowed, in
+///          which case the caller should rescan the watched directories itself.
+bool DirectoryWatcher::Poll( uint32_t timeoutMilliseconds, DynamicArray< Change >& rChanges )
+{
+	HELIUM_ASSERT( IsInitialized() );
+	if( !IsInitialized() )
+	{
+		return false;
+	}
+
+	bool bComplete = true;
+
+#if HELIUM_OS_LINUX
+	uint32_t waitMilliseconds = timeoutMilliseconds;
+	if( HasPendingChanges() && waitMilliseconds > m_settleMilliseconds )
+	{
+		waitMilliseconds = m_settleMilliseconds;
+	}
+
+	pollfd pollDescriptor;
+	pollDescriptor.fd = m_handle;
+	pollDescriptor.events = POLLIN;
+	pollDescriptor.revents = 0;
+
+	int pollResult = poll( &pollDescriptor, 1, static_cast< int >( waitMilliseconds ) );
+	if( pollResult > 0 )
+	{
+		bComplete = ReadEvents();
+	}
+#else
+	HELIUM_UNREF( timeoutMilliseconds );
+#endif
+
+	// Moves that were not paired by now either left the watched directories or had their other half lost.
+	uint64_t ticks = Timer::GetTickCount();
+	FlushPendingMoves( ticks, !bComplete );
+	FlushSettledChanges( ticks, rChanges );
+
+	return bComplete;
+}
+
+/// Add watches for a directory and all of its subdirectories.
+///
+/// @param[in] rDirectory    Directory path, including a trailing separator.
+/// @param[in] bReportFiles  True to report every file found as modified (used for directories that appear after
+///                          watching started, which may already contain files by the time they are watched).
+///
+/// @return  True if the directory was watched successfully, false if not.
+bool DirectoryWatcher::AddWatchRecursive( const std::string& rDirectory, bool bReportFiles )
+{
+#if HELIUM_OS_LINUX
+	int32_t descriptor = inotify_add_watch( m_handle, rDirectory.c_str(), WATCH_EVENT_MASK );
+	if( descriptor < 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "DirectoryWatcher: Failed to watch \"%s\" (error %d).\n" ),
+			rDirectory.c_str(),
+			errno );
+
+		return false;
+	}
+
+	// Watching the same directory twice returns the same descriptor, so just update its path.
+	size_t watchIndex = FindWatch( descriptor );
+	if( IsValid( watchIndex ) )
+	{
+		m_watches[ watchIndex ].path = rDirectory;
+	}
+	else
+	{
+		Watch* pWatch = m_watches.New();
+		HELIUM_ASSERT( pWatch );
+		pWatch->descriptor = descriptor;
+		pWatch->path = rDirectory;
+	}
+
+	uint64_t ticks = Timer::GetTickCount();
+
+	bool bSuccess = true;
+	for( DirectoryIterator directory( FilePath( rDirectory ) ); !directory.IsDone(); directory.Next() )
+	{
+		const DirectoryIteratorItem& item = directory.GetItem();
+		if( item.m_Path.IsDirectory() )
+		{
+			bSuccess &= AddWatchRecursive( GetDirectoryPath( item.m_Path.Get() ), bReportFiles );
+		}
+		else if( bReportFiles )
+		{
+			QueueChange( CHANGE_MODIFIED, item.m_Path.Get(), std::string(), false, ticks );
+		}
+	}
+
+	return bSuccess;
+#else
+	HELIUM_UNREF( rDirectory );
+	HELIUM_UNREF( bReportFiles );
+
+	return false;
+#endif
+}
+
+/// Remove the watches for a directory and all of its subdirectories.
+///
+/// @param[in] rDirectory  Directory path, including a trailing separator.
+void DirectoryWatcher::RemoveWatches( const std::string& rDirectory )
+{
+	size_t watchIndex = m_watches.GetSize();
+	while( watchIndex != 0 )
+	{
+		--watchIndex;
+
+		Watch& rWatch = m_watches[ watchIndex ];
+		if( IsInDirectory( rWatch.path, rDirectory ) )
+		{
+#if HELIUM_OS_LINUX
+			inotify_rm_watch( m_handle, rWatch.descriptor );
+#endif
+			m_watches.RemoveSwap( watchIndex );
+		}
+	}
+}
+
+/// Update the paths of the watches for a directory and all of its subdirectories after it has been moved.
+///
+/// @param[in] rOldDirectory  Previous directory path, including a trailing separator.
+/// @param[in] rNewDirectory  New directory path, including a trailing separator.
+void DirectoryWatcher::RenameWatches( const std::string& rOldDirectory, const std::string& rNewDirectory )
+{
+	size_t watchCount = m_watches.GetSize();
+	for( size_t watchIndex = 0; watchIndex < watchCount; ++watchIndex )
+	{
+		Watch& rWatch = m_watches[ watchIndex ];
+		if( IsInDirectory( rWatch.path, rOldDirectory ) )
+		{
+			rWatch.path = rNewDirectory + rWatch.path.substr( rOldDirectory.size() );
+		}
+	}
+}
+
+/// Find the watch with a given descriptor.
+///
+/// @param[in] descriptor  Watch descriptor.
+///
+/// @return  Index of the watch if found, an invalid index if not.
+size_t DirectoryWatcher::FindWatch( int32_t descriptor ) const
+{
+	size_t watchCount = m_watches.GetSize();
+	for( size_t watchIndex = 0; watchIndex < watchCount; ++watchIndex )
+	{
+		if( m_watches[ watchIndex ].descriptor == descriptor )
+		{
+			return watchIndex;
+		}
+	}
+
+	return Invalid< size_t >();
+}
+
+/// Read all available notifications and queue the changes they describe.
+///
+/// @return  True if all events were read, false if the notification queue overflowed and events were lost.
+bool DirectoryWatcher::ReadEvents()
+{
+#if HELIUM_OS_LINUX
+	bool bComplete = true;
+
+	for( ; ; )
+	{
+		ssize_t bytesRead = read( m_handle, m_eventBuffer.GetData(), m_eventBuffer.GetSize() );
+		if( bytesRead < 0 && errno == EINTR )
+		{
+			continue;
+		}
+
+		if( bytesRead <= 0 )
+		{
+			break;
+		}
+
+		uint64_t ticks = Timer::GetTickCount();
+
+		size_t offset = 0;
+		while( offset < static_cast< size_t >( bytesRead ) )
+		{
+			const inotify_event* pEvent = reinterpret_cast< const inotify_event* >( m_eventBuffer.GetData() + offset );
+			offset += sizeof( inotify_event ) + pEvent->len;
+
+			if( pEvent->mask & IN_Q_OVERFLOW )
+			{
+				bComplete = false;
+
+				continue;
+			}
+
+			size_t watchIndex = FindWatch( pEvent->wd );
+			if( IsInvalid( watchIndex ) )
+			{
+				continue;
+			}
+
+			if( pEvent->mask & IN_IGNORED )
+			{
+				// The directory was removed or unwatched; its removal is reported through its parent.
+				m_watches.RemoveSwap( watchIndex );
+
+				continue;
+			}
+
+			if( pEvent->len == 0 )
+			{
+				continue;
+			}
+
+			std::string path = m_watches[ watchIndex ].path + pEvent->name;
+			bool bDirectory = ( ( pEvent->mask & IN_ISDIR ) != 0 );
+
+			if( pEvent->mask & IN_MOVED_FROM )
+			{
+				PendingMove* pMove = m_pendingMoves.New();
+				HELIUM_ASSERT( pMove );
+				pMove->cookie = pEvent->cookie;
+				pMove->path = path;
+				pMove->bDirectory = bDirectory;
+				pMove->ticks = ticks;
+			}
+			else if( pEvent->mask & IN_MOVED_TO )
+			{
+				size_t moveCount = m_pendingMoves.GetSize();
+				size_t moveIndex;
+				for( moveIndex = 0; moveIndex < moveCount; ++moveIndex )
+				{
+					if( m_pendingMoves[ moveIndex ].cookie == pEvent->cookie )
+					{
+						break;
+					}
+				}
+
+				if( moveIndex < moveCount )
+				{
+					// Moved within the watched directories.
+					std::string oldPath = m_pendingMoves[ moveIndex ].path;
+					m_pendingMoves.Remove( moveIndex );
+
+					if( bDirectory )
+					{
+						RenameWatches( GetDirectoryPath( oldPath ), GetDirectoryPath( path ) );
+					}
+
+					QueueChange( CHANGE_RENAMED, path, oldPath, bDirectory, ticks );
+				}
+				else if( bDirectory )
+				{
+					// Moved in from elsewhere, so everything inside it is new to us.
+					AddWatchRecursive( GetDirectoryPath( path ), true );
+				}
+				else
+				{
+					QueueChange( CHANGE_MODIFIED, path, std::string(), false, ticks );
+				}
+			}
+			else if( pEvent->mask & IN_DELETE )
+			{
+				QueueChange( CHANGE_REMOVED, path, std::string(), bDirectory, ticks );
+			}
+			else if( bDirectory )
+			{
+				if( pEvent->mask & IN_CREATE )
+				{
+					AddWatchRecursive( GetDirectoryPath( path ), true );
+				}
+			}
+			else
+			{
+				QueueChange( CHANGE_MODIFIED, path, std::string(), false, ticks );
+			}
+		}
+	}
+
+	return bComplete;
+#else
+	return true;
+#endif
+}
+
+/// Queue a change, merging it with any change still pending for the same file.
+///
+/// @param[in] type        Change type.
+/// @param[in] rPath       Path of the changed file (the new path for renames).
+/// @param[in] rOldPath    Previous path of the file for renames.
+/// @param[in] bDirectory  True if the change applies to a directory.
+/// @param[in] ticks       Tick count at which the change was seen.
+void DirectoryWatcher::QueueChange(
+	EChange type,
+	const std::string& rPath,
+	const std::string& rOldPath,
+	bool bDirectory,
+	uint64_t ticks )
+{
+	std::string oldPath = rOldPath;
+
+	// A rename supersedes anything still pending for its source, and chained renames collapse into one.
+	if( type == CHANGE_RENAMED )
+	{
+		size_t pendingCount = m_pendingChanges.GetSize();
+		for( size_t pendingIndex = 0; pendingIndex < pendingCount; ++pendingIndex )
+		{
+			const Change& rPendingChange = m_pendingChanges[ pendingIndex ].change;
+			if( rPendingChange.path.Get() == oldPath )
+			{
+				if( rPendingChange.type == CHANGE_RENAMED )
+				{
+					oldPath = rPendingChange.oldPath.Get();
+				}
+
+				m_pendingChanges.Remove( pendingIndex );
+
+				break;
+			}
+		}
+	}
+
+	size_t pendingCount = m_pendingChanges.GetSize();
+	for( size_t pendingIndex = 0; pendingIndex < pendingCount; ++pendingIndex )
+	{
+		PendingChange& rPending = m_pendingChanges[ pendingIndex ];
+		Change& rChange = rPending.change;
+		if( rChange.path.Get() != rPath )
+		{
+			continue;
+		}
+
+		rPending.lastEventTicks = ticks;
+
+		switch( type )
+		{
+			case CHANGE_MODIFIED:
+			{
+				// Modifications after a rename keep reporting the rename, while a file that was removed and then
+				// recreated (as some editors do when saving) has simply been modified.
+				if( rChange.type == CHANGE_REMOVED )
+				{
+					rChange.type = CHANGE_MODIFIED;
+				}
+
+				break;
+			}
+
+			case CHANGE_REMOVED:
+			{
+				// Removing a file that was just renamed removes the file we knew about under its original name.
+				if( rChange.type == CHANGE_RENAMED )
+				{
+					rChange.path = rChange.oldPath;
+					rChange.oldPath.Clear();
+				}
+
+				rChange.type = CHANGE_REMOVED;
+				rChange.bDirectory = bDirectory;
+
+				break;
+			}
+
+			default:
+			{
+				rChange.type = type;
+				rChange.oldPath.Set( oldPath );
+				rChange.bDirectory = bDirectory;
+
+				break;
+			}
+		}
+
+		return;
+	}
+
+	PendingChange* pPending = m_pendingChanges.New();
+	HELIUM_ASSERT( pPending );
+	pPending->change.type = type;
+	pPending->change.path.Set( rPath );
+	pPending->change.oldPath.Set( oldPath );
+	pPending->change.bDirectory = bDirectory;
+	pPending->lastEventTicks = ticks;
+}
+
+/// Report moves that were never paired with their destination as removals.
+///
+/// @param[in] ticks   Current tick count.
+/// @param[in] bForce  True to flush all pending moves, false to only flush those older than the settle period.
+void DirectoryWatcher::FlushPendingMoves( uint64_t ticks, bool bForce )
+{
+	size_t moveIndex = 0;
+	while( moveIndex < m_pendingMoves.GetSize() )
+	{
+		const PendingMove& rMove = m_pendingMoves[ moveIndex ];
+		if( !bForce && Timer::TicksToMilliseconds( ticks - rMove.ticks ) < m_settleMilliseconds )
+		{
+			++moveIndex;
+
+			continue;
+		}
+
+		if( rMove.bDirectory )
+		{
+			RemoveWatches( GetDirectoryPath( rMove.path ) );
+		}
+
+		QueueChange( CHANGE_REMOVED, rMove.path, std::string(), rMove.bDirectory, rMove.ticks );
+		m_pendingMoves.Remove( moveIndex );
+	}
+}
+
+/// Move changes that have settled into the output array.
+///
+/// @param[in]  ticks     Current tick count.
+/// @param[out] rChanges  Settled changes are appended to this array.
+void DirectoryWatcher::FlushSettledChanges( uint64_t ticks, DynamicArray< Change >& rChanges )
+{
+	size_t pendingIndex = 0;
+	while( pendingIndex < m_pendingChanges.GetSize() )
+	{
+		const PendingChange& rPending = m_pendingChanges[ pendingIndex ];
+		if( Timer::TicksToMilliseconds( ticks - rPending.lastEventTicks ) < m_settleMilliseconds )
+		{
+			++pendingIndex;
+
+			continue;
+		}
+
+		rChanges.Push( rPending.change );
+		m_pendingChanges.Remove( pendingIndex );
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "PcSupport/PcSupport.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/FilePath.h"
+
+namespace Helium
+{
+	/// Reports changes to the files in one or more directory trees using the notification API of the operating system.
+	///
+	/// Watches are registered recursively, and directories created (or moved) inside a watched tree are watched as soon
+	/// as they appear.  Bursts of events for the same file are coalesced into a single change that is only reported once
+	/// the file has been left alone for a short settle period, so a file that is written in several chunks (or deleted
+	/// and recreated by an editor saving it) results in one notification.  Moves within the watched trees are reported as
+	/// renames, while moves into or out of them are reported as modifications and removals respectively.
+	///
+	/// Native notifications are currently only implemented on Linux (inotify); Initialize() fails on other platforms,
+	/// in which case callers are expected to fall back to scanning the directories themselves.  A watcher is not
+	/// thread-safe and should be used from a single thread.
+	class HELIUM_PC_SUPPORT_API DirectoryWatcher : NonCopyable
+	{
+	public:
+		/// Change types.
+		enum EChange
+		{
+			CHANGE_FIRST   =  0,
+			CHANGE_INVALID = -1,
+
+			/// File was created or modified.
+			CHANGE_MODIFIED,
+			/// File or directory was removed.
+			CHANGE_REMOVED,
+			/// File or directory was renamed or moved within the watched directories.
+			CHANGE_RENAMED,
+
+			CHANGE_MAX,
+			CHANGE_LAST = CHANGE_MAX - 1
+		};
+
+		/// File change.
+		struct Change
+		{
+			/// Change type.
+			EChange type;
+			/// Path of the changed file (the new path for renames).
+			FilePath path;
+			/// Previous path of the file for renames, empty otherwise.
+			FilePath oldPath;
+			/// True if the change applies to a directory.
+			bool bDirectory;
+		};
+
+		/// Default time a file must be left alone before its changes are reported, in milliseconds.
+		static const uint32_t DEFAULT_SETTLE_MILLISECONDS = 200;
+
+		/// @name Construction/Destruction
+		//@{
+		DirectoryWatcher();
+		~DirectoryWatcher();
+		//@}
+
+		/// @name Initialization
+		//@{
+		bool Initialize( uint32_t settleMilliseconds = DEFAULT_SETTLE_MILLISECONDS );
+		void Shutdown();
+
+		inline bool IsInitialized() const;
+		inline uint32_t GetSettleMilliseconds() const;
+		//@}
+
+		/// @name Watch Registration
+		//@{
+		bool AddDirectory( const FilePath& rDirectory );
+		void RemoveDirectory( const FilePath& rDirectory );
+		//@}
+
+		/// @name Change Notification
+		//@{
+		bool Poll( uint32_t timeoutMilliseconds, DynamicArray< Change >& rChanges );
+		inline bool HasPendingChanges() const;
+		//@}
+
+	private:
+		/// Watched directory.
+		struct Watch
+		{
+			/// Watch descriptor.
+			int32_t descriptor;
+			/// Directory path, including a trailing separator.
+			std::string path;
+		};
+
+		/// Change waiting for its file to settle.
+		struct PendingChange
+		{
+			/// Change to report.
+			Change change;
+			/// Tick count of the most recent event merged into this change.
+			uint64_t lastEventTicks;
+		};
+
+		/// Half of a move waiting to be paired with its destination.
+		struct PendingMove
+		{
+			/// Cookie shared by both halves of the move.
+			uint32_t cookie;
+			/// Source path.
+			std::string path;
+			/// True if a directory was moved.
+			bool bDirectory;
+			/// Tick count at which the move was seen.
+			uint64_t ticks;
+		};
+
+		/// Notification handle.
+		int m_handle;
+		/// Time a file must be left alone before its changes are reported, in milliseconds.
+		uint32_t m_settleMilliseconds;
+
+		/// Watched directories.
+		DynamicArray< Watch > m_watches;
+		/// Changes waiting to settle, in the order they were first seen.
+		DynamicArray< PendingChange > m_pendingChanges;
+		/// Moves waiting to be paired.
+		DynamicArray< PendingMove > m_pendingMoves;
+		/// Buffer for reading notifications.
+		DynamicArray< uint8_t > m_eventBuffer;
+
+		/// @name Private Utility Functions
+		//@{
+		bool AddWatchRecursive( const std::string& rDirectory, bool bReportFiles );
+		void RemoveWatches( const std::string& rDirectory );
+		void RenameWatches( const std::string& rOldDirectory, const std::string& rNewDirectory );
+		size_t FindWatch( int32_t descriptor ) const;
+
+		bool ReadEvents();
+		void QueueChange( EChange type, const std::string& rPath, const std::string& rOldPath, bool bDirectory, uint64_t ticks );
+		void FlushPendingMoves( uint64_t ticks, bool bForce );
+		void FlushSettledChanges( uint64_t ticks, DynamicArray< Change >& rChanges );
+		//@}
+	};
+}
+
+#include "PcSupport/DirectoryWatcher.inl"
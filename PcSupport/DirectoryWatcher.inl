@@ -0,0 +1,30 @@
+namespace Helium
+{
+	/// Get whether this watcher has been initialized.
+	///
+	/// @return  True if initialized, false if not.
+	///
+	/// @see Initialize(), Shutdown()
+	bool DirectoryWatcher::IsInitialized() const
+	{
+		return ( m_handle >= 0 );
+	}
+
+	/// Get the time a file must be left alone before its changes are reported.
+	///
+	/// @return  Settle time, in milliseconds.
+	uint32_t DirectoryWatcher::GetSettleMilliseconds() const
+	{
+		return m_settleMilliseconds;
+	}
+
+	/// Get whether any changes have been seen that have not been reported yet.
+	///
+	/// @return  True if changes are waiting to settle, false if not.
+	///
+	/// @see Poll()
+	bool DirectoryWatcher::HasPendingChanges() const
+	{
+		return ( !m_pendingChanges.IsEmpty() || !m_pendingMoves.IsEmpty() );
+	}
+}
@@ -1,6 +1,7 @@
 #include "PcSupportPch.h"
 #include "LooseAssetFileWatcher.h"
 
+#include "Platform/File.h"
 #include "Foundation/DirectoryIterator.h"
 #include "PcSupport/LoosePackageLoader.h"
 #include "Foundation/Log.h"
@@ -48,43 +49,56 @@ LooseAssetFileWatcher::~LooseAssetFileWatcher()
 void LooseAssetFileWatcher::AddPackage( LoosePackageLoader *pPackageLoader )
 {
 	AtomicIncrement( m_InterruptTracking );
-	SpinLock lock( m_PathsToWatchLock );
 
-#if HELIUM_ASSERT_ENABLED
-	for ( DynamicArray<WatchedPackage>::Iterator iter = m_PathsToWatch.Begin(); iter != m_PathsToWatch.End(); ++iter )
 	{
-		HELIUM_ASSERT(pPackageLoader != iter->m_Loader);
-		HELIUM_ASSERT(pPackageLoader->m_packageDirPath != iter->m_Path);
-	}
+		MutexScopeLock scopeLock( m_PathsToWatchLock );
+
+#if HELIUM_ASSERT_ENABLED
+		for ( DynamicArray<WatchedPackage>::Iterator iter = m_PathsToWatch.Begin(); iter != m_PathsToWatch.End(); ++iter )
+		{
+			HELIUM_ASSERT(pPackageLoader != iter->m_Loader);
+			HELIUM_ASSERT(pPackageLoader->m_packageDirPath != iter->m_Path);
+		}
 #endif
 
-	WatchedPackage *pWatchedPackage = m_PathsToWatch.New();
-	pWatchedPackage->m_Path = pPackageLoader->m_packageDirPath;
-	pWatchedPackage->m_Loader = pPackageLoader;
+		WatchedPackage *pWatchedPackage = m_PathsToWatch.New();
+		pWatchedPackage->m_Path = pPackageLoader->m_packageDirPath;
+		pWatchedPackage->m_Loader = pPackageLoader;
+		pWatchedPackage->m_bWatched = false;
+	}
+
 	AtomicDecrement( m_InterruptTracking );
 }
 
 void LooseAssetFileWatcher::RemovePackage( LoosePackageLoader *pPackageLoader )
 {
 	AtomicIncrement( m_InterruptTracking );
-	SpinLock lock( m_PathsToWatchLock );
 
-	for ( size_t i = 0; i < m_PathsToWatch.GetSize(); ++i)
 	{
-		if (pPackageLoader == m_PathsToWatch[i].m_Loader)
+		MutexScopeLock scopeLock( m_PathsToWatchLock );
+
+		for ( size_t i = 0; i < m_PathsToWatch.GetSize(); ++i)
 		{
-			m_PathsToWatch.RemoveSwap(i);
-			break;
+			if (pPackageLoader == m_PathsToWatch[i].m_Loader)
+			{
+				if ( m_PathsToWatch[i].m_bWatched )
+				{
+					m_PathsToUnwatch.Push( m_PathsToWatch[i].m_Path );
+				}
+
+				m_PathsToWatch.RemoveSwap(i);
+				break;
+			}
 		}
-	}
 
 #if HELIUM_ASSERT_ENABLED
-	for ( DynamicArray<WatchedPackage>::Iterator iter = m_PathsToWatch.Begin(); iter != m_PathsToWatch.End(); ++iter )
-	{
-		HELIUM_ASSERT(pPackageLoader != iter->m_Loader);
-		HELIUM_ASSERT(pPackageLoader->m_packageDirPath != iter->m_Path);
-	}
+		for ( DynamicArray<WatchedPackage>::Iterator iter = m_PathsToWatch.Begin(); iter != m_PathsToWatch.End(); ++iter )
+		{
+			HELIUM_ASSERT(pPackageLoader != iter->m_Loader);
+			HELIUM_ASSERT(pPackageLoader->m_packageDirPath != iter->m_Path);
+		}
 #endif
+	}
 
 	AtomicDecrement( m_InterruptTracking );
 }
@@ -117,153 +131,301 @@ void LooseAssetFileWatcher::TrackEverything()
 
 	AssetAwareThreadSynchronizer assetSync;
 
-	while ( !m_StopTracking )
+	// Prefer native change notifications, and fall back to periodically scanning every package when they are not
+	// available on this platform.
+	DirectoryWatcher watcher;
+	bool bUseWatcher = watcher.Initialize();
+	if ( !bUseWatcher )
 	{
-		Log::Print( Log::Levels::Default, TXT("Tracker: Scanning packages for changes...\n"));
+		Log::Print( Log::Levels::Default, TXT("Tracker: File change notifications unavailable, scanning packages periodically.\n"));
+	}
+
+	DynamicArray< DirectoryWatcher::Change > changes;
 
+	while ( !m_StopTracking )
+	{
 		// Do this once outside the inner loop in case we are iterating over nothing
 		assetSync.Sync();
 
+		if ( bUseWatcher )
 		{
-			SpinLock lock( m_PathsToWatchLock );
+			UpdateWatchedDirectories( watcher );
 
-			// Go through all the packages we're tracking
-			for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
+			changes.Resize( 0 );
+			if ( watcher.Poll( 250, changes ) )
 			{
-				assetSync.Sync();
+				ProcessChanges( changes );
+			}
+			else
+			{
+				// Some notifications were lost, so catch up by scanning everything
+				Log::Print( Log::Levels::Default, TXT("Tracker: Change notifications overflowed, scanning packages for changes...\n"));
+				ProcessChanges( changes );
+				ScanPackages( assetSync );
+			}
+		}
+		else
+		{
+			Log::Print( Log::Levels::Default, TXT("Tracker: Scanning packages for changes...\n"));
+			ScanPackages( assetSync );
+		}
+
+		DispatchNotifications();
+
+		if ( !bUseWatcher && !m_StopTracking )
+		{
+			// Sleep between runs and yield to other threads
+			// The complex loop is to prevent Editor from hanging on exit (max hang will be "increments" seconds)
+			SleepBetweenTracking( &m_StopTracking );
+		}
+	}
 
-				//Log::Print( Log::Levels::Default, TXT("Tracker: Scanning package %s\n"), packageIter->m_Path.c_str() );
+	watcher.Shutdown();
+}
 
-				SimpleTimer packageTimer;
-				Helium::DirectoryIterator directory( packageIter->m_Path );
+/// Register newly added packages with the directory watcher and unregister removed ones.  Newly registered packages
+/// are scanned once to catch any changes made between loading them and watching them.
+void LooseAssetFileWatcher::UpdateWatchedDirectories( DirectoryWatcher& rWatcher )
+{
+	MutexScopeLock scopeLock( m_PathsToWatchLock );
 
-				// For each file
-				for( ; !directory.IsDone(); directory.Next() )
-				{
-					// If our thread is supposed to die, bail early
-					if ( m_StopTracking )
-					{
-						break;
-					}
-
-					const DirectoryIteratorItem& item = directory.GetItem();
-
-					bool isNewFile = true;
-					bool isChangedFile = false;
-
-					Name objectName;
-					size_t objectIndex = Invalid< size_t >();
-
-					if ( item.m_Path.IsDirectory() )
-					{
-						// Skip directories
-						continue;
-					}
-					else if ( item.m_Path.Extension() == Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ] )
-					{
-						// JSON files get handled special
-						objectName.Set( item.m_Path.Basename().c_str() );
-						objectIndex = packageIter->m_Loader->FindObjectByName( objectName );
-					}
-					else
-					{
-						// See if it's a raw asset that we can handle
-						String objectNameString( item.m_Path.Filename().c_str() );
-
-						ResourceHandler* pBestHandler = ResourceHandler::GetBestResourceHandlerForFile( objectNameString );
-
-						if (!pBestHandler)
-						{
-							// We don't know what this file is.. skip it
-							continue;
-						}
-
-						objectName.Set( item.m_Path.Filename().c_str() );
-						objectIndex = packageIter->m_Loader->FindObjectByName( objectName );
-					}
-
-					// If the package says it loaded something as fresh as the file, do nothing
-					if ( objectIndex != Invalid< size_t >() &&
-						packageIter->m_Loader->m_objects[objectIndex].fileTimeStamp >= static_cast<int64_t>( directory.GetItem().m_ModTime ))
-					{
-						continue;
-					}
-
-					// If we have already emitted a message for this object, skip it
-					HashMap< Name, WatchedAsset >::Iterator watchedAssetItr = packageIter->m_Assets.Find( objectName );
-					if (watchedAssetItr != packageIter->m_Assets.End())
-					{
-						if (watchedAssetItr->Second().m_LastMessageTime >= static_cast<int64_t>( directory.GetItem().m_ModTime ) )
-						{
-							// We already emitted a message for this file change, so don't do anything
-							continue;
-						}
-
-						// We've emitted a message, but it's been modified again. Emit another message and update the timestamp
-						watchedAssetItr->Second().m_LastMessageTime = static_cast<int64_t>( directory.GetItem().m_ModTime );
-					}
-					else
-					{
-						// We've never emitted a message, so record that we will
-						WatchedAsset watchedAsset;
-						watchedAsset.m_LastMessageTime = static_cast<int64_t>( directory.GetItem().m_ModTime );
-
-						packageIter->m_Assets.Insert(
-							watchedAssetItr, 
-							KeyValue< Name, WatchedAsset >( objectName, watchedAsset ) );
-					}
-				
-					// We know the file is changed and we should throw an event.. choose a different event based on new vs. changed
-					if (objectIndex != Invalid< size_t >())
-					{
-						m_ChangeNotifications.Add( packageIter->m_Loader->GetAssetPath( objectIndex ) );
-					}
-					else
-					{
-						AssetPath path;
-						path.Set( objectName, false, packageIter->m_Loader->GetPackagePath());
-
-						m_NewNotifications.Add( path );
-					}
-				}
+	for ( DynamicArray<FilePath>::Iterator pathIter = m_PathsToUnwatch.Begin(); pathIter != m_PathsToUnwatch.End(); ++pathIter )
+	{
+		rWatcher.RemoveDirectory( *pathIter );
 
-				if ( m_StopTracking || m_InterruptTracking != 0 )
-				{
-					// Our thread is supposed to die, bail early
-					//Log::Print( Log::Levels::Default, TXT("Tracker: Pre-empted after %.2fm\n"), packageTimer.Elapsed() / 1000.f / 60.f );
-					break;
-				}
-				else 
-				{
-					//Log::Print( Log::Levels::Default, TXT("Tracker: Package scanned in %.2fm\n") , packageTimer.Elapsed() / 1000.f / 60.f );
-				}
+		// Watches are recursive, so packages nested in the removed one need to be registered again
+		for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
+		{
+			if ( packageIter->m_Path.Get().compare( 0, pathIter->Get().size(), pathIter->Get() ) == 0 )
+			{
+				packageIter->m_bWatched = false;
 			}
 		}
+	}
+
+	m_PathsToUnwatch.Clear();
+
+	for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
+	{
+		if ( !packageIter->m_bWatched )
+		{
+			// Don't retry packages that fail to register, the watcher has already reported the problem
+			rWatcher.AddDirectory( packageIter->m_Path );
+			packageIter->m_bWatched = true;
+
+			ScanPackage( *packageIter );
+		}
+	}
+}
+
+/// Scan every tracked package for changed files.
+///
+/// The package list is only locked while scanning each package, as waiting for the asset lock while holding it would
+/// deadlock against a thread adding or removing packages with the asset lock held.
+void LooseAssetFileWatcher::ScanPackages( AssetAwareThreadSynchronizer& rAssetSync )
+{
+	// Go through all the packages we're tracking
+	for ( size_t packageIndex = 0; ; ++packageIndex )
+	{
+		rAssetSync.Sync();
 
-		for ( DynamicArray<AssetPath>::Iterator changedAssetIter = m_ChangeNotifications.Begin(); changedAssetIter != m_ChangeNotifications.End(); ++changedAssetIter )
 		{
-			HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *changedAssetIter->ToString());
-			AssetTracker::GetStaticInstance()->NotifyAssetChangedExternally( *changedAssetIter );
+			MutexScopeLock scopeLock( m_PathsToWatchLock );
 
-			AssetPtr asset;
-			AssetLoader::GetStaticInstance()->LoadObject( *changedAssetIter, asset, true );
-			Asset::ReplaceAsset( asset.Get(), *changedAssetIter );
+			// Packages removed in the meantime may shift the rest of the list, which at worst skips or repeats a
+			// package until the next scan
+			if ( packageIndex >= m_PathsToWatch.GetSize() )
+			{
+				break;
+			}
+
+			ScanPackage( m_PathsToWatch[ packageIndex ] );
 		}
 
-		for ( DynamicArray<AssetPath>::Iterator newAssetIter = m_NewNotifications.Begin(); newAssetIter != m_NewNotifications.End(); ++newAssetIter )
+		if ( m_StopTracking || m_InterruptTracking != 0 )
 		{
-			HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *newAssetIter->ToString());
-			AssetTracker::GetStaticInstance()->NotifyAssetCreatedExternally( *newAssetIter );
+			// Our thread is supposed to die, bail early
+			break;
 		}
+	}
+}
 
-		m_ChangeNotifications.Clear();
-		m_NewNotifications.Clear();
+/// Scan the files of a single package for changes.
+void LooseAssetFileWatcher::ScanPackage( WatchedPackage& rPackage )
+{
+	Helium::DirectoryIterator directory( rPackage.m_Path );
 
-		if ( !m_StopTracking )
+	// For each file
+	for( ; !directory.IsDone(); directory.Next() )
+	{
+		// If our thread is supposed to die, bail early
+		if ( m_StopTracking )
 		{
-			// Sleep between runs and yield to other threads
-			// The complex loop is to prevent Editor from hanging on exit (max hang will be "increments" seconds)
-			SleepBetweenTracking( &m_StopTracking );
+			break;
+		}
+
+		const DirectoryIteratorItem& item = directory.GetItem();
+
+		if ( item.m_Path.IsDirectory() )
+		{
+			// Skip directories
+			continue;
+		}
+
+		ProcessFile( rPackage, item.m_Path, static_cast<int64_t>( item.m_ModTime ) );
+	}
+}
+
+/// Apply changes reported by the directory watcher to the tracked packages.
+void LooseAssetFileWatcher::ProcessChanges( const DynamicArray< DirectoryWatcher::Change >& rChanges )
+{
+	if ( rChanges.IsEmpty() )
+	{
+		return;
+	}
+
+	MutexScopeLock scopeLock( m_PathsToWatchLock );
+
+	for ( DynamicArray< DirectoryWatcher::Change >::ConstIterator changeIter = rChanges.Begin(); changeIter != rChanges.End(); ++changeIter )
+	{
+		if ( changeIter->bDirectory )
+		{
+			// Package directories are tracked through their loaders, so just note it
+			HELIUM_TRACE( TraceLevels::Info, TXT("Tracker: Directory %s was %s\n"), changeIter->path.c_str(), changeIter->type == DirectoryWatcher::CHANGE_REMOVED ? TXT("removed") : TXT("changed") );
+			continue;
+		}
+
+		if ( changeIter->type == DirectoryWatcher::CHANGE_REMOVED )
+		{
+			HELIUM_TRACE( TraceLevels::Info, TXT("Tracker: File %s was removed\n"), changeIter->path.c_str() );
+			continue;
+		}
+
+		if ( changeIter->type == DirectoryWatcher::CHANGE_RENAMED )
+		{
+			HELIUM_TRACE( TraceLevels::Info, TXT("Tracker: File %s was renamed to %s\n"), changeIter->oldPath.c_str(), changeIter->path.c_str() );
+		}
+
+		// Find the package owning the file, which is the one for the directory it is directly in
+		std::string directory = FilePath( changeIter->path.Directory() ).Get();
+		while ( !directory.empty() && directory[ directory.size() - 1 ] == TXT('/') )
+		{
+			directory.resize( directory.size() - 1 );
+		}
+
+		for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
+		{
+			const std::string& packagePath = packageIter->m_Path.Get();
+			if ( packagePath.compare( 0, directory.size(), directory ) != 0 ||
+				packagePath.find_first_not_of( TXT('/'), directory.size() ) != std::string::npos )
+			{
+				continue;
+			}
+
+			Status status;
+			if ( status.Read( changeIter->path.Get().c_str() ) )
+			{
+				ProcessFile( *packageIter, changeIter->path, status.m_ModifiedTime );
+			}
+
+			break;
+		}
+	}
+}
+
+/// Queue a notification for a file if it has changed since it was loaded or last reported.
+void LooseAssetFileWatcher::ProcessFile( WatchedPackage& rPackage, const FilePath& rFilePath, int64_t modifiedTime )
+{
+	Name objectName;
+	size_t objectIndex = Invalid< size_t >();
+
+	if ( rFilePath.Extension() == Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ] )
+	{
+		// JSON files get handled special
+		objectName.Set( rFilePath.Basename().c_str() );
+		objectIndex = rPackage.m_Loader->FindObjectByName( objectName );
+	}
+	else
+	{
+		// See if it's a raw asset that we can handle
+		String objectNameString( rFilePath.Filename().c_str() );
+
+		ResourceHandler* pBestHandler = ResourceHandler::GetBestResourceHandlerForFile( objectNameString );
+
+		if (!pBestHandler)
+		{
+			// We don't know what this file is.. skip it
+			return;
 		}
+
+		objectName.Set( rFilePath.Filename().c_str() );
+		objectIndex = rPackage.m_Loader->FindObjectByName( objectName );
+	}
+
+	// If the package says it loaded something as fresh as the file, do nothing
+	if ( objectIndex != Invalid< size_t >() &&
+		rPackage.m_Loader->m_objects[objectIndex].fileTimeStamp >= modifiedTime )
+	{
+		return;
+	}
+
+	// If we have already emitted a message for this object, skip it
+	HashMap< Name, WatchedAsset >::Iterator watchedAssetItr = rPackage.m_Assets.Find( objectName );
+	if (watchedAssetItr != rPackage.m_Assets.End())
+	{
+		if (watchedAssetItr->Second().m_LastMessageTime >= modifiedTime )
+		{
+			// We already emitted a message for this file change, so don't do anything
+			return;
+		}
+
+		// We've emitted a message, but it's been modified again. Emit another message and update the timestamp
+		watchedAssetItr->Second().m_LastMessageTime = modifiedTime;
+	}
+	else
+	{
+		// We've never emitted a message, so record that we will
+		WatchedAsset watchedAsset;
+		watchedAsset.m_LastMessageTime = modifiedTime;
+
+		rPackage.m_Assets.Insert(
+			watchedAssetItr, 
+			KeyValue< Name, WatchedAsset >( objectName, watchedAsset ) );
+	}
+
+	// We know the file is changed and we should throw an event.. choose a different event based on new vs. changed
+	if (objectIndex != Invalid< size_t >())
+	{
+		m_ChangeNotifications.Add( rPackage.m_Loader->GetAssetPath( objectIndex ) );
 	}
-}
\ No newline at end of file
+	else
+	{
+		AssetPath path;
+		path.Set( objectName, false, rPackage.m_Loader->GetPackagePath());
+
+		m_NewNotifications.Add( path );
+	}
+}
+
+/// Send out the notifications queued since the last call.
+void LooseAssetFileWatcher::DispatchNotifications()
+{
+	for ( DynamicArray<AssetPath>::Iterator changedAssetIter = m_ChangeNotifications.Begin(); changedAssetIter != m_ChangeNotifications.End(); ++changedAssetIter )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *changedAssetIter->ToString());
+		AssetTracker::GetStaticInstance()->NotifyAssetChangedExternally( *changedAssetIter );
+
+		AssetPtr asset;
+		AssetLoader::GetStaticInstance()->LoadObject( *changedAssetIter, asset, true );
+		Asset::ReplaceAsset( asset.Get(), *changedAssetIter );
+	}
+
+	for ( DynamicArray<AssetPath>::Iterator newAssetIter = m_NewNotifications.Begin(); newAssetIter != m_NewNotifications.End(); ++newAssetIter )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *newAssetIter->ToString());
+		AssetTracker::GetStaticInstance()->NotifyAssetCreatedExternally( *newAssetIter );
+	}
+
+	m_ChangeNotifications.Clear();
+	m_NewNotifications.Clear();
+}
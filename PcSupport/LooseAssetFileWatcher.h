@@ -1,5 +1,7 @@
 #pragma once
 
+#include "PcSupport/DirectoryWatcher.h"
+
 namespace Helium
 {
 	class LoosePackageLoader;
@@ -20,6 +22,15 @@ namespace Helium
 		void TrackEverything();
 
 	protected:
+		struct WatchedPackage;
+
+		void UpdateWatchedDirectories( DirectoryWatcher& rWatcher );
+		void ScanPackages( AssetAwareThreadSynchronizer& rAssetSync );
+		void ScanPackage( WatchedPackage& rPackage );
+		void ProcessChanges( const DynamicArray< DirectoryWatcher::Change >& rChanges );
+		void ProcessFile( WatchedPackage& rPackage, const FilePath& rFilePath, int64_t modifiedTime );
+		void DispatchNotifications();
+
 		Helium::CallbackThread m_Thread;
 		bool m_StopTracking;
 		volatile int m_InterruptTracking;
@@ -33,12 +44,16 @@ namespace Helium
 		{
 			FilePath m_Path;
 			LoosePackageLoader *m_Loader;
+			bool m_bWatched;  // Registered with the directory watcher (if one is in use)
 
 			HashMap< Name, WatchedAsset > m_Assets;
 		};
 
+		// Guards the package lists.  This is held while scanning files, so it must never be held while waiting on the
+		// asset lock, as packages may be added or removed by a thread that holds it.
 		DynamicArray<WatchedPackage> m_PathsToWatch;
-		SpinLock m_PathsToWatchLock;
+		Mutex m_PathsToWatchLock;
+		DynamicArray<FilePath> m_PathsToUnwatch;
 
 		DynamicArray<AssetPath> m_ChangeNotifications;
 		DynamicArray<AssetPath> m_NewNotifications;
@@ -141,11 +141,13 @@ bool LooseAssetLoader::CacheObject( const AssetPath &path, Asset* pAsset, bool b
 
 	Config& rConfig = Config::GetStaticInstance();
 
-	int64_t objectTimestamp = AssetLoader::GetAssetFileTimestamp( path );
+	// Objects are cached from their asset file, plus the source file for resources.
+	FilePath sourceFilePath;
+	Resource* pResource = NULL;
 
 	if( !pAsset->IsDefaultTemplate() )
 	{
-		Resource* pResource = Reflect::SafeCast< Resource >( pAsset );
+		pResource = Reflect::SafeCast< Resource >( pAsset );
 		if( pResource )
 		{
 			AssetPath baseResourcePath = path;
@@ -161,7 +163,6 @@ bool LooseAssetLoader::CacheObject( const AssetPath &path, Asset* pAsset, bool b
 				baseResourcePath = parentPath;
 			}
 
-			FilePath sourceFilePath;
 			if ( !FileLocations::GetDataDirectory( sourceFilePath ) )
 			{
 				HELIUM_TRACE(
@@ -172,23 +173,16 @@ bool LooseAssetLoader::CacheObject( const AssetPath &path, Asset* pAsset, bool b
 			}
 
 			sourceFilePath += baseResourcePath.ToFilePathString().GetData();
-
-			Status stat;
-			stat.Read( sourceFilePath.Get().c_str() );
-
-			int64_t sourceFileTimestamp = stat.m_ModifiedTime;
-			if( sourceFileTimestamp > objectTimestamp )
-			{
-				objectTimestamp = sourceFileTimestamp;
-			}
 		}
 	}
 
+	uint64_t inputHash = pAssetPreprocessor->ComputeInputHash( path, sourceFilePath, pResource );
+
 	// Cache the object.
 	bool bSuccess = pAssetPreprocessor->CacheObject(
 		path,
 		pAsset,
-		objectTimestamp,
+		inputHash,
 		bEvictPlatformPreprocessedResourceData );
 	if( !bSuccess )
 	{
@@ -1,6 +1,7 @@
 #include "PcSupportPch.h"
 #include "PcSupport/LoosePackageLoader.h"
 
+#include "Platform/Timer.h"
 #include "Engine/FileLocations.h"
 #include "Foundation/FilePath.h"
 #include "Foundation/DirectoryIterator.h"
@@ -15,9 +16,12 @@
 #include "PcSupport/ResourceHandler.h"
 #include "Reflect/TranslatorDeduction.h"
 #include "Persist/ArchiveJson.h"
+#include "Engine/JobPool.h"
 
 #include "LooseAssetLoader.h"
 
+#include <algorithm>
+
 using namespace Helium;
 
 /// Constructor.
@@ -25,6 +29,7 @@ LoosePackageLoader::LoosePackageLoader()
 	: m_startPreloadCounter( 0 )
 	, m_preloadedCounter( 0 )
 	, m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
+	, m_pendingFileReadCount( 0 )
 	, m_parentPackageLoadId( Invalid< size_t >() )
 	//, m_pTocLoadBuffer( 0 )
 	//, m_tocAsyncLoadId( Invalid<size_t>() )
@@ -179,6 +184,8 @@ void LoosePackageLoader::Shutdown()
 	AtomicExchangeRelease( m_preloadedCounter, 0 );
 
 	m_objects.Clear();
+	m_objectPathMap.Clear();
+	m_objectNameMap.Clear();
 
 	size_t loadRequestCount = m_loadRequests.GetSize();
 	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
@@ -260,28 +267,43 @@ bool LoosePackageLoader::BeginPreload()
 			{
 				HELIUM_TRACE( TraceLevels::Info, TXT("- Reading file [%s]\n"), item.m_Path.c_str() );
 
-				FileReadRequest *request = m_fileReadRequests.New();
-				request->expectedSize = item.m_Size;
-
 				HELIUM_ASSERT( item.m_Size < UINT32_MAX );
 
-				// Create a buffer for the file to be read into temporarily
-				request->pLoadBuffer = DefaultAllocator().Allocate( static_cast< size_t > ( item.m_Size ) + 1 );
-				static_cast< char* >( request->pLoadBuffer )[ static_cast< size_t > ( item.m_Size ) ] = '\0'; // for efficiency parsing text files
-				HELIUM_ASSERT( request->pLoadBuffer );
-
-				// Queue up the read
-				request->asyncLoadId = rAsyncLoader.QueueRequest( request->pLoadBuffer, String( item.m_Path.c_str() ), 0, static_cast< size_t >( item.m_Size ) );
-				HELIUM_ASSERT( IsValid( request->asyncLoadId ) );
-
+				FileReadRequest *request = m_fileReadRequests.New();
 				request->filePath = item.m_Path;
+				request->pLoadBuffer = NULL;
+				SetInvalid( request->asyncLoadId );
+				request->expectedSize = item.m_Size;
 				request->fileTimestamp = item.m_ModTime;
+				request->bParsed = false;
 			}
 			else
 			{
 				HELIUM_TRACE( TraceLevels::Info, TXT("- Skipping file [%s] (Extension is %s)\n"), item.m_Path.c_str(), item.m_Path.Extension().c_str() );
 			}
 		}
+
+		// Objects are added to the package in file path order once parsed, regardless of the order in which the
+		// reads complete or the order in which the file system lists the files.
+		std::sort( m_fileReadRequests.GetData(), m_fileReadRequests.GetData() + m_fileReadRequests.GetSize(), CompareFileReadRequests );
+
+		size_t requestCount = m_fileReadRequests.GetSize();
+		for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+		{
+			FileReadRequest& rRequest = m_fileReadRequests[ requestIndex ];
+			size_t fileSize = static_cast< size_t >( rRequest.expectedSize );
+
+			// Create a buffer for the file to be read into temporarily
+			rRequest.pLoadBuffer = DefaultAllocator().Allocate( fileSize + 1 );
+			HELIUM_ASSERT( rRequest.pLoadBuffer );
+			static_cast< char* >( rRequest.pLoadBuffer )[ fileSize ] = '\0'; // for efficiency parsing text files
+
+			// Queue up the read
+			rRequest.asyncLoadId = rAsyncLoader.QueueRequest( rRequest.pLoadBuffer, String( rRequest.filePath.c_str() ), 0, fileSize );
+			HELIUM_ASSERT( IsValid( rRequest.asyncLoadId ) );
+		}
+
+		m_pendingFileReadCount = requestCount;
 	}
 
 	AtomicExchangeRelease( m_startPreloadCounter, 1 );
@@ -340,6 +362,8 @@ size_t LoosePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 		SetInvalid( pRequest->asyncFileLoadId );
 		pRequest->pAsyncFileLoadBuffer = NULL;
 		pRequest->asyncFileLoadBufferSize = 0;
+		pRequest->bytesRead = 0;
+		pRequest->deserializeTicks = 0;
 		pRequest->pResolver = NULL;
 		pRequest->forceReload = forceReload;
 
@@ -437,6 +461,8 @@ size_t LoosePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	SetInvalid( pRequest->asyncFileLoadId );
 	pRequest->pAsyncFileLoadBuffer = NULL;
 	pRequest->asyncFileLoadBufferSize = 0;
+	pRequest->bytesRead = 0;
+	pRequest->deserializeTicks = 0;
 	pRequest->pResolver = pResolver;
 	pRequest->forceReload = forceReload;
 
@@ -671,31 +697,40 @@ void LoosePackageLoader::TickPreload()
 
 	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
 
-	bool bAllFileRequestsDone = true;
+	// Collect the object files that finished reading since the last tick
+	m_parseRequestIndices.Resize( 0 );
 
-	// Walk through every load request
-	for (size_t i = 0; i < m_fileReadRequests.GetSize();)
+	size_t requestCount = m_fileReadRequests.GetSize();
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
 	{
-		FileReadRequest &rRequest = m_fileReadRequests[i];
-		HELIUM_ASSERT(rRequest.asyncLoadId);
-		HELIUM_ASSERT(rRequest.pLoadBuffer);
+		FileReadRequest &rRequest = m_fileReadRequests[ requestIndex ];
+		if( IsInvalid( rRequest.asyncLoadId ) )
+		{
+			// Already handled
+			continue;
+		}
+
+		HELIUM_ASSERT( rRequest.pLoadBuffer );
 
 		size_t bytes_read = 0;
 		if (!rAsyncLoader.TrySyncRequest(rRequest.asyncLoadId, bytes_read))
 		{
 			// Havn't finished reading yet, move on to next entry
-			bAllFileRequestsDone = false;
-			++i;
 			continue;
 		}
 
+		size_t asyncLoadId = rRequest.asyncLoadId;
+		SetInvalid( rRequest.asyncLoadId );
+		HELIUM_ASSERT( m_pendingFileReadCount != 0 );
+		--m_pendingFileReadCount;
+
 		HELIUM_ASSERT(bytes_read == rRequest.expectedSize);
 		if( IsInvalid( bytes_read ) )
 		{
 			HELIUM_TRACE(
 				TraceLevels::Error,
 				TXT( "LoosePackageLoader: Failed to read the contents of async load request \"%d\".\n" ),
-				rRequest.asyncLoadId );
+				asyncLoadId );
 		}
 		else if( bytes_read != rRequest.expectedSize)
 		{
@@ -710,97 +745,26 @@ void LoosePackageLoader::TickPreload()
 		{
 			HELIUM_ASSERT( rRequest.expectedSize < ~static_cast<size_t>( 0 ) );
 
-			// the name is deduced from the file name (bad idea to store it in the file)
-			Name name ( m_fileReadRequests[i].filePath.Basename().c_str() );
-
-			// read some preliminary data from the json
-			struct PreliminaryObjectHandler : rapidjson::BaseReaderHandler<>
-			{
-				Helium::Name typeName;
-				Helium::String templatePath;
-				bool templateIsNext;
-
-				PreliminaryObjectHandler()
-					: typeName( ENullName () )
-					, templatePath( "" )
-				{
-					templateIsNext = false;
-				}
-
-				void String(const Ch* chars, rapidjson::SizeType length, bool copy)
-				{
-					if ( typeName.IsEmpty() )
-					{
-						typeName.Set( Helium::String ( chars, length ) );
-						return;
-					}
-
-					if ( templatePath.IsEmpty() )
-					{
-						Helium::String str ( chars, length ); 
-
-						if ( templateIsNext )
-						{
-							templatePath = str;
-							templateIsNext = false;
-							return;
-						}
-						else
-						{
-							if ( str == "m_spTemplate" )
-							{
-								templateIsNext = true;
-								return;
-							}
-						}
-					}
-				}
-
-				void StartObject() { Default(); }
-				void EndObject( rapidjson::SizeType ) { Default(); }
-
-			} handler;
-
-			// non destructive in-place stream helper
-			rapidjson::StringStream stream ( static_cast< char* >( rRequest.pLoadBuffer ) );
-
-			// the main reader object
-			rapidjson::Reader reader;
-			if ( reader.Parse< rapidjson::kParseDefaultFlags >( stream, handler ) )
-			{
-				SerializedObjectData* pObjectData = m_objects.New();
-				HELIUM_ASSERT( pObjectData );
-				HELIUM_VERIFY( pObjectData->objectPath.Set( name, false, m_packagePath ) );
-				pObjectData->templatePath.Set( handler.templatePath );
-				pObjectData->typeName = handler.typeName;
-				pObjectData->filePath = rRequest.filePath;
-				pObjectData->fileTimeStamp = rRequest.fileTimestamp;
-				pObjectData->bMetadataGood = true;
+			// Parsed (and freed) below
+			m_parseRequestIndices.Push( requestIndex );
 
-				HELIUM_TRACE(
-					TraceLevels::Debug,
-					TXT( "LoosePackageLoader: Success reading preliminary data for object '%s' from file '%s'.\n" ),
-					*name,
-					rRequest.filePath.c_str() );
-			}
-			else
-			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					TXT( "LoosePackageLoader: Failure reading preliminary data for object '%s' from file '%s': %s\n" ),
-					*name,
-					rRequest.filePath.c_str(),
-					reader.GetParseError() );
-			}
+			continue;
 		}
 
-		// We're finished with this load, so deallocate memory and get rid of the request
+		// We're finished with this load, so deallocate memory
 		DefaultAllocator().Free( rRequest.pLoadBuffer );
 		rRequest.pLoadBuffer = NULL;
-		SetInvalid(rRequest.asyncLoadId);
-		m_fileReadRequests.RemoveSwap(i);
 	}
 
+	// Parse the files that were read on the job pool.  Each file only touches its own request.
+	size_t parseRequestCount = m_parseRequestIndices.GetSize();
+	if( parseRequestCount != 0 )
+	{
+		JobPool::GetStaticInstance().Run( &ParseFileJob, this, parseRequestCount );
+	}
+
+	bool bAllFileRequestsDone = ( m_pendingFileReadCount == 0 );
+
 	// Wait for the parent package to finish loading.
 	AssetPtr spParentPackage;
 	if( IsValid( m_parentPackageLoadId ) )
@@ -837,6 +801,24 @@ void LoosePackageLoader::TickPreload()
 
 	HELIUM_ASSERT( pPackage->GetLoader() == this );
 
+	// Add the parsed objects in file path order so that object indices don't depend on read or parse timing.
+	for( DynamicArray< FileReadRequest >::ConstIterator requestIter = m_fileReadRequests.Begin(); requestIter != m_fileReadRequests.End(); ++requestIter )
+	{
+		if( !requestIter->bParsed )
+		{
+			continue;
+		}
+
+		SerializedObjectData* pObjectData = AddObject( requestIter->objectName );
+		pObjectData->templatePath.Set( requestIter->templatePath );
+		pObjectData->typeName = requestIter->typeName;
+		pObjectData->filePath = requestIter->filePath;
+		pObjectData->fileTimeStamp = requestIter->fileTimestamp;
+		pObjectData->bMetadataGood = true;
+	}
+
+	m_fileReadRequests.Clear();
+
 	FilePath packageDirectoryPath;
 
 	if ( !FileLocations::GetDataDirectory( packageDirectoryPath ) )
@@ -889,9 +871,7 @@ void LoosePackageLoader::TickPreload()
 				*pResourceType->GetName(),
 				*m_packagePath.ToString() );
 
-			SerializedObjectData* pObjectData = m_objects.New();
-			HELIUM_ASSERT( pObjectData );
-			HELIUM_VERIFY( pObjectData->objectPath.Set( objectName, false, m_packagePath ) );
+			SerializedObjectData* pObjectData = AddObject( objectName );
 			pObjectData->typeName = pResourceType->GetName();
 			pObjectData->templatePath.Clear();
 			pObjectData->filePath.Clear();
@@ -930,6 +910,9 @@ void LoosePackageLoader::TickPreload()
 /// Update load processing of object load requests.
 void LoosePackageLoader::TickLoadRequests()
 {
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
 	size_t loadRequestCount = m_loadRequests.GetSize();
 	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestCount; ++loadRequestIndex )
 	{
@@ -941,58 +924,219 @@ void LoosePackageLoader::TickLoadRequests()
 		LoadRequest* pRequest = m_loadRequests[ loadRequestIndex ];
 		HELIUM_ASSERT( pRequest );
 
-		if( !( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) )
+		if( ( pRequest->flags & LOAD_FLAG_PRELOADED ) == LOAD_FLAG_PRELOADED )
 		{
-			if( !TickDeserialize( pRequest ) )
-			{
-				continue;
-			}
+			// Waiting to be picked up by the asset loader.
+			continue;
+		}
+
+		// Let the asset loader know once the object can be picked up.
+		if( !TickLoadRequest( pRequest ) )
+		{
+			continue;
+		}
+
+		HELIUM_ASSERT( pRequest->index < m_objects.GetSize() );
+		const AssetPath& rObjectPath = m_objects[ pRequest->index ].objectPath;
+		pAssetLoader->RecordPreloadStatistics( rObjectPath, pRequest->bytesRead, pRequest->deserializeTicks );
+		pAssetLoader->WakeLoadRequest( rObjectPath );
+	}
+}
+
+/// Update load processing for a single object load request.
+///
+/// @param[in] pRequest  Load request to process.
+///
+/// @return  True if the object has been preloaded, false if not.
+bool LoosePackageLoader::TickLoadRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	if( !( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) )
+	{
+		if( !TickDeserialize( pRequest ) )
+		{
+			return false;
+		}
+	}
+
+	//TODO: Investigate removing need to preload properties first. Probably need to have the
+	//      restriction as TickPersistentResourcePreload assumes the object exists.. but this
+	//      may not be the best place to put this 
+	// We can probably remove these early returns..
+	if( !( pRequest->flags & LOAD_FLAG_PERSISTENT_RESOURCE_PRELOADED ) )
+	{
+		if( !TickPersistentResourcePreload( pRequest ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// JobPool callback for parsing the preliminary data of a loose object file.
+///
+/// @param[in] pData      Package loader.
+/// @param[in] itemIndex  Index of the entry in the loader's parse request index list.
+void LoosePackageLoader::ParseFileJob( void* pData, size_t itemIndex )
+{
+	LoosePackageLoader* pLoader = static_cast< LoosePackageLoader* >( pData );
+	HELIUM_ASSERT( pLoader );
+	HELIUM_ASSERT( itemIndex < pLoader->m_parseRequestIndices.GetSize() );
+
+	size_t requestIndex = pLoader->m_parseRequestIndices[ itemIndex ];
+	HELIUM_ASSERT( requestIndex < pLoader->m_fileReadRequests.GetSize() );
+
+	ParseFile( pLoader->m_fileReadRequests[ requestIndex ] );
+}
+
+/// Parse the preliminary data (type and template) of a loose object file that has been read, then free its buffer.
+///
+/// @param[in] rRequest  Completed file read request.
+void LoosePackageLoader::ParseFile( FileReadRequest& rRequest )
+{
+	HELIUM_ASSERT( rRequest.pLoadBuffer );
+
+	// the name is deduced from the file name (bad idea to store it in the file)
+	Name name ( rRequest.filePath.Basename().c_str() );
+
+	// read some preliminary data from the json
+	struct PreliminaryObjectHandler : rapidjson::BaseReaderHandler<>
+	{
+		Helium::Name typeName;
+		Helium::String templatePath;
+		bool templateIsNext;
+
+		PreliminaryObjectHandler()
+			: typeName( ENullName () )
+			, templatePath( "" )
+		{
+			templateIsNext = false;
 		}
 
-		//TODO: Investigate removing need to preload properties first. Probably need to have the
-		//      restriction as TickPersistentResourcePreload assumes the object exists.. but this
-		//      may not be the best place to put this 
-		// We can probably remove these continues..
-		if( !( pRequest->flags & LOAD_FLAG_PERSISTENT_RESOURCE_PRELOADED ) )
+		void String(const Ch* chars, rapidjson::SizeType length, bool copy)
 		{
-			if( !TickPersistentResourcePreload( pRequest ) )
+			if ( typeName.IsEmpty() )
 			{
-				continue;
+				typeName.Set( Helium::String ( chars, length ) );
+				return;
+			}
+
+			if ( templatePath.IsEmpty() )
+			{
+				Helium::String str ( chars, length ); 
+
+				if ( templateIsNext )
+				{
+					templatePath = str;
+					templateIsNext = false;
+					return;
+				}
+				else
+				{
+					if ( str == "m_spTemplate" )
+					{
+						templateIsNext = true;
+						return;
+					}
+				}
 			}
 		}
+
+		void StartObject() { Default(); }
+		void EndObject( rapidjson::SizeType ) { Default(); }
+
+	} handler;
+
+	// non destructive in-place stream helper
+	rapidjson::StringStream stream ( static_cast< char* >( rRequest.pLoadBuffer ) );
+
+	// the main reader object
+	rapidjson::Reader reader;
+	if ( reader.Parse< rapidjson::kParseDefaultFlags >( stream, handler ) )
+	{
+		rRequest.objectName = name;
+		rRequest.typeName = handler.typeName;
+		rRequest.templatePath = handler.templatePath;
+		rRequest.bParsed = true;
+
+		HELIUM_TRACE(
+			TraceLevels::Debug,
+			TXT( "LoosePackageLoader: Success reading preliminary data for object '%s' from file '%s'.\n" ),
+			*name,
+			rRequest.filePath.c_str() );
+	}
+	else
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "LoosePackageLoader: Failure reading preliminary data for object '%s' from file '%s': %s\n" ),
+			*name,
+			rRequest.filePath.c_str(),
+			reader.GetParseError() );
 	}
+
+	// We're finished with this load, so deallocate memory
+	DefaultAllocator().Free( rRequest.pLoadBuffer );
+	rRequest.pLoadBuffer = NULL;
+}
+
+/// Sort comparison for ordering object file read requests by file path.
+///
+/// @param[in] rA  First request.
+/// @param[in] rB  Second request.
+///
+/// @return  True if the first request's file path sorts before the second's, false if not.
+bool LoosePackageLoader::CompareFileReadRequests( const FileReadRequest& rA, const FileReadRequest& rB )
+{
+	return ( rA.filePath.Get() < rB.filePath.Get() );
+}
+
+/// Add an entry for an object in this package and index it for lookups by path and name.
+///
+/// @param[in] name  Object name.
+///
+/// @return  Serialized data entry for the object, with its path set.
+LoosePackageLoader::SerializedObjectData* LoosePackageLoader::AddObject( Name name )
+{
+	size_t objectIndex = m_objects.GetSize();
+	SerializedObjectData* pObjectData = m_objects.New();
+	HELIUM_ASSERT( pObjectData );
+	HELIUM_VERIFY( pObjectData->objectPath.Set( name, false, m_packagePath ) );
+
+	// If an object is registered more than once, lookups resolve to the first entry.
+	HashMap< AssetPath, size_t >::Iterator pathIterator;
+	m_objectPathMap.Insert( pathIterator, KeyValue< AssetPath, size_t >( pObjectData->objectPath, objectIndex ) );
+
+	HashMap< Name, size_t >::Iterator nameIterator;
+	m_objectNameMap.Insert( nameIterator, KeyValue< Name, size_t >( name, objectIndex ) );
+
+	return pObjectData;
 }
 
 size_t LoosePackageLoader::FindObjectByPath( const AssetPath &path ) const
 {
 	// Locate the object within this package.
-	size_t objectCount = m_objects.GetSize();
-	for(size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+	HashMap< AssetPath, size_t >::ConstIterator pathIterator = m_objectPathMap.Find( path );
+	if( pathIterator == m_objectPathMap.End() )
 	{
-		const SerializedObjectData& rObjectData = m_objects[ objectIndex ];
-		if( rObjectData.objectPath == path )
-		{
-			return objectIndex;
-		}
+		return Invalid<size_t>();
 	}
 
-	return Invalid<size_t>();
+	return pathIterator->Second();
 }
 
 size_t LoosePackageLoader::FindObjectByName( const Name &name ) const
 {
 	// Locate the object within this package.
-	size_t objectCount = m_objects.GetSize();
-	for(size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+	HashMap< Name, size_t >::ConstIterator nameIterator = m_objectNameMap.Find( name );
+	if( nameIterator == m_objectNameMap.End() )
 	{
-		const SerializedObjectData& rObjectData = m_objects[ objectIndex ];
-		if( rObjectData.objectPath.GetName() == name )
-		{
-			return objectIndex;
-		}
+		return Invalid<size_t>();
 	}
 
-	return Invalid<size_t>();
+	return nameIterator->Second();
 }
 
 /// Update processing of object property preloading for a given load request.
@@ -1292,10 +1436,15 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				object_file_path.c_str(),
 				pRequest->pResolver);
 
+			uint64_t startTicks = Timer::GetTickCount();
+
 			DynamicArray< Reflect::ObjectPtr > objects;
 			objects.Push( pRequest->spObject.Get() ); // use existing objects
 			Persist::ArchiveReaderJson::ReadFromStream( archiveStream, objects, pRequest->pResolver );
 			HELIUM_ASSERT( objects[0].Get() == pRequest->spObject.Get() );
+
+			pRequest->bytesRead += bytesRead;
+			pRequest->deserializeTicks += Timer::GetTickCount() - startTicks;
 		}
 	}
 
@@ -1345,12 +1494,9 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				HELIUM_ASSERT( pRequest->pCachedObjectDataBuffer );
 				pRequest->cachedObjectDataBufferSize = pEntry->size;
 
-				AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
-				pRequest->persistentResourceDataLoadId = rAsyncLoader.QueueRequest(
-					pRequest->pCachedObjectDataBuffer,
-					pCache->GetCacheFileName(),
-					pEntry->offset,
-					pEntry->size );
+				pRequest->persistentResourceDataLoadId = pCache->BeginReadEntry(
+					*pEntry,
+					pRequest->pCachedObjectDataBuffer );
 				HELIUM_ASSERT( IsValid( pRequest->persistentResourceDataLoadId ) );
 			}
 		}
@@ -1392,6 +1538,11 @@ bool LoosePackageLoader::TickPersistentResourcePreload( LoadRequest* pRequest )
 
 	SetInvalid( pRequest->persistentResourceDataLoadId );
 
+	if( IsValid( bytesRead ) )
+	{
+		pRequest->bytesRead += bytesRead;
+	}
+
 	if( bytesRead != pRequest->cachedObjectDataBufferSize )
 	{
 		HELIUM_TRACE(
@@ -1463,6 +1614,8 @@ bool LoosePackageLoader::TickPersistentResourcePreload( LoadRequest* pRequest )
 				//Reflect::ObjectPtr persistent_data;
 				//archive.ReadSingleObject(persistent_data);
 
+				uint64_t startTicks = Timer::GetTickCount();
+
 				Reflect::ObjectPtr persistent_data;
 				persistent_data = Cache::ReadCacheObjectFromBuffer(pCachedObjectData, /*sizeof( uint32_t )*/ 0, bytesRemaining, pRequest->pResolver);
 
@@ -1475,6 +1628,8 @@ bool LoosePackageLoader::TickPersistentResourcePreload( LoadRequest* pRequest )
 
 					pRequest->flags |= LOAD_FLAG_ERROR;
 				}
+
+				pRequest->deserializeTicks += Timer::GetTickCount() - startTicks;
 			}
 		}
 	}
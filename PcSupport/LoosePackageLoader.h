@@ -5,6 +5,7 @@
 #include "Engine/PackageLoader.h"
 
 #include "Foundation/FilePath.h"
+#include "Foundation/HashMap.h"
 
 namespace Helium
 {
@@ -130,6 +131,11 @@ namespace Helium
 			void* pAsyncFileLoadBuffer;
 			size_t asyncFileLoadBufferSize;
 
+			/// Number of bytes read from the object file and the cached persistent resource data.
+			size_t bytesRead;
+			/// Ticks spent deserializing the object and its persistent resource data.
+			uint64_t deserializeTicks;
+
 			/// Load flags.
 			uint32_t flags;
 
@@ -148,6 +154,10 @@ namespace Helium
 
 		/// Serialized object data parsed from the json package.
 		DynamicArray< SerializedObjectData > m_objects;
+		/// Indices of objects in m_objects, keyed by asset path.
+		HashMap< AssetPath, size_t > m_objectPathMap;
+		/// Indices of objects in m_objects, keyed by object name.
+		HashMap< Name, size_t > m_objectNameMap;
 
 #if HELIUM_TOOLS
 		friend LooseAssetFileWatcher;
@@ -169,8 +179,22 @@ namespace Helium
 			size_t asyncLoadId;
 			uint64_t expectedSize;
 			uint64_t fileTimestamp;
+
+			/// Object name (deduced from the file name).
+			Name objectName;
+			/// Type name parsed from the file.
+			Name typeName;
+			/// Template path parsed from the file.
+			String templatePath;
+			/// True if the file was read and parsed successfully.
+			bool bParsed;
 		};
+		/// Object file read requests, sorted by file path.
 		DynamicArray<FileReadRequest> m_fileReadRequests;
+		/// Number of object file read requests that have not completed yet.
+		size_t m_pendingFileReadCount;
+		/// Indices of the file read requests to parse during the current tick.
+		DynamicArray< size_t > m_parseRequestIndices;
 
 		/// Parent package load request ID.
 		size_t m_parentPackageLoadId;
@@ -183,8 +207,15 @@ namespace Helium
 		void TickPreload();
 
 		void TickLoadRequests();
+		bool TickLoadRequest( LoadRequest* pRequest );
 		bool TickDeserialize( LoadRequest* pRequest );
 		bool TickPersistentResourcePreload( LoadRequest* pRequest );
+
+		SerializedObjectData* AddObject( Name name );
+
+		static void ParseFileJob( void* pData, size_t itemIndex );
+		static void ParseFile( FileReadRequest& rRequest );
+		static bool CompareFileReadRequests( const FileReadRequest& rA, const FileReadRequest& rB );
 		//@}
 
 		size_t FindObjectByPath( const AssetPath &path ) const;
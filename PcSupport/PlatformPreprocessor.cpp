@@ -8,6 +8,20 @@ PlatformPreprocessor::~PlatformPreprocessor()
 {
 }
 
+/// Get the version of the preprocessing settings for the target platform.
+///
+/// The version is part of the stamp identifying up-to-date cache entries for the platform, so preprocessors should
+/// increase it whenever a change to their settings (such as shader compiler flags or profile definitions) alters the
+/// data they produce.
+///
+/// @return  Platform preprocessor version.
+///
+/// @see ResourceHandler::GetVersion()
+uint32_t PlatformPreprocessor::GetVersion() const
+{
+	return 0;
+}
+
 /// @fn PlatformPreprocessor::EByteOrder PlatformPreprocessor::GetByteOrder() const
 /// Get the byte order in which data should be stored for the target platform.
 ///
@@ -54,6 +54,7 @@ namespace Helium
         /// @name Platform Parameters
         //@{
         virtual EByteOrder GetByteOrder() const = 0;
+        virtual uint32_t GetVersion() const;
         inline bool SwapBytes() const;
         //@}
 
@@ -33,6 +33,17 @@ void ResourceHandler::GetSourceExtensions( const char* const*& rppExtensions, si
     rExtensionCount = 0;
 }
 
+/// Get the version of the preprocessed data produced by this handler.
+///
+/// The version is part of the content hash identifying cached resource data, so handlers should increase it whenever
+/// a change to their code alters the data they produce, forcing previously cached resources to be preprocessed again.
+///
+/// @return  Handler version.
+uint32_t ResourceHandler::GetVersion() const
+{
+    return 0;
+}
+
 #if HELIUM_TOOLS
 /// Preprocess and cache the resource data for the given resource for all enabled target platforms.
 ///
@@ -48,6 +59,17 @@ bool ResourceHandler::CacheResource(
 {
     return false;
 }
+
+/// Get whether CacheResource() may be called for several resources at once from different threads.
+///
+/// Handlers relying on shared, non-reentrant state (such as a third-party SDK instance) should return false, in which
+/// case their resources are always preprocessed one at a time.
+///
+/// @return  True if resources can be preprocessed concurrently by this handler, false if not.
+bool ResourceHandler::IsThreadSafe() const
+{
+    return false;
+}
 #endif  // HELIUM_TOOLS
 
 
@@ -30,10 +30,12 @@ namespace Helium
         //@{
         virtual const AssetType* GetResourceType() const;
         virtual void GetSourceExtensions( const char* const*& rppExtensions, size_t& rExtensionCount ) const;
+        virtual uint32_t GetVersion() const;
 
 #if HELIUM_TOOLS
         virtual bool CacheResource(
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
+        virtual bool IsThreadSafe() const;
         
         void SaveObjectToPersistentDataBuffer(Reflect::Object *_object, DynamicArray< uint8_t > &_buffer);
 #endif
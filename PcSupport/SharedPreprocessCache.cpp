@@ -0,0 +1,520 @@
+#include "PcSupportPch.h"
+#include "PcSupport/SharedPreprocessCache.h"
+
+#if HELIUM_TOOLS
+
+#include "Platform/File.h"
+#include "Platform/Timer.h"
+#include "Foundation/FileStream.h"
+#include "PcSupport/ContentHash.h"
+
+#include <algorithm>
+#include <time.h>
+
+#if HELIUM_OS_WIN
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+using namespace Helium;
+
+/// Entry file signature ("HSPC").
+static const uint32_t ENTRY_MAGIC = 0x43505348;
+/// Entry file format version.
+static const uint32_t ENTRY_VERSION = 1;
+/// Entry file extension.
+static const char ENTRY_EXTENSION[] = TXT( ".bin" );
+/// Temporary entry file extension.
+static const char TEMP_EXTENSION[] = TXT( ".tmp" );
+/// Age after which a temporary entry file is considered abandoned by a crashed process, in seconds.
+static const uint64_t STALE_TEMP_FILE_AGE = 60 * 60;
+
+/// Get whether a file name ends with the given extension.
+static bool HasExtension( const std::string& rFileName, const char* pExtension, size_t extensionLength )
+{
+	return ( rFileName.size() >= extensionLength &&
+		rFileName.compare( rFileName.size() - extensionLength, extensionLength, pExtension ) == 0 );
+}
+
+/// Store entry file found while trimming.
+struct SharedPreprocessCacheFile
+{
+	/// File path.
+	FilePath path;
+	/// File size, in bytes.
+	uint64_t size;
+	/// Last modification (or use) time.
+	uint64_t modifiedTime;
+};
+
+/// Sort comparison for ordering store files from least to most recently used.
+static bool CompareFileUseTimes( const SharedPreprocessCacheFile& rA, const SharedPreprocessCacheFile& rB )
+{
+	return rA.modifiedTime < rB.modifiedTime;
+}
+
+/// Append a 32-bit value to an entry buffer.
+static void WriteEntryValue( DynamicArray< uint8_t >& rBuffer, uint32_t value )
+{
+	rBuffer.AddArray( reinterpret_cast< const uint8_t* >( &value ), sizeof( value ) );
+}
+
+/// Append a block of data to an entry buffer, preceded by its size.
+static void WriteEntryData( DynamicArray< uint8_t >& rBuffer, const DynamicArray< uint8_t >& rData )
+{
+	HELIUM_ASSERT( rData.GetSize() <= UINT32_MAX );
+	WriteEntryValue( rBuffer, static_cast< uint32_t >( rData.GetSize() ) );
+	rBuffer.AddArray( rData.GetData(), rData.GetSize() );
+}
+
+/// Read a 32-bit value from an entry buffer.
+///
+/// @return  True if the value was read, false if the end of the buffer was reached.
+static bool ReadEntryValue( const uint8_t*& rpCurrent, const uint8_t* pEnd, uint32_t& rValue )
+{
+	if( static_cast< size_t >( pEnd - rpCurrent ) < sizeof( rValue ) )
+	{
+		return false;
+	}
+
+	MemoryCopy( &rValue, rpCurrent, sizeof( rValue ) );
+	rpCurrent += sizeof( rValue );
+
+	return true;
+}
+
+/// Read a block of data preceded by its size from an entry buffer.
+///
+/// @return  True if the data was read, false if the end of the buffer was reached.
+static bool ReadEntryData( const uint8_t*& rpCurrent, const uint8_t* pEnd, DynamicArray< uint8_t >& rData )
+{
+	uint32_t size;
+	if( !ReadEntryValue( rpCurrent, pEnd, size ) || static_cast< size_t >( pEnd - rpCurrent ) < size )
+	{
+		return false;
+	}
+
+	rData.Resize( 0 );
+	rData.AddArray( rpCurrent, size );
+	rData.Trim();
+	rpCurrent += size;
+
+	return true;
+}
+
+/// Constructor.
+SharedPreprocessCache::SharedPreprocessCache()
+: m_sizeLimit( 0 )
+, m_bytesSinceTrim( 0 )
+, m_tempFileCounter( 0 )
+, m_bInitialized( false )
+{
+}
+
+/// Destructor.
+SharedPreprocessCache::~SharedPreprocessCache()
+{
+	Shutdown();
+}
+
+/// Initialize this store.
+///
+/// The directory is created if it does not exist, and is trimmed to the size limit.
+///
+/// @param[in] rDirectory  Root directory of the store (may be shared with other processes).
+/// @param[in] sizeLimit   Maximum total size of all entries, in bytes.
+///
+/// @return  True if initialization was successful, false if the directory could not be created.
+///
+/// @see Shutdown()
+bool SharedPreprocessCache::Initialize( const FilePath& rDirectory, uint64_t sizeLimit )
+{
+	Shutdown();
+
+	m_directory.Set( rDirectory.Get() + TXT( "/" ) );
+	if( !m_directory.MakePath() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "SharedPreprocessCache::Initialize(): Failed to create directory \"%s\".\n" ),
+			m_directory.c_str() );
+
+		m_directory.Clear();
+
+		return false;
+	}
+
+	m_sizeLimit = sizeLimit;
+	m_bytesSinceTrim = 0;
+	m_bInitialized = true;
+
+	Trim();
+
+	return true;
+}
+
+/// Shut down this store.
+///
+/// @see Initialize()
+void SharedPreprocessCache::Shutdown()
+{
+	m_directory.Clear();
+	m_sizeLimit = 0;
+	m_bytesSinceTrim = 0;
+	m_bInitialized = false;
+}
+
+/// Load the preprocessed data stored for the given key.
+///
+/// @param[in]  key            Hash of the inputs from which the data was built.
+/// @param[out] pPlatformData  Preprocessed data for each platform (Cache::PLATFORM_MAX elements).  Data is only
+///                            modified if the entry was found and is valid, in which case the data for platforms
+///                            without stored data is cleared.
+///
+/// @return  True if the entry was found and loaded, false if not.
+bool SharedPreprocessCache::Load( uint64_t key, Resource::PreprocessedData* pPlatformData )
+{
+	HELIUM_ASSERT( m_bInitialized );
+	HELIUM_ASSERT( pPlatformData );
+
+	FilePath entryPath = GetEntryPath( key );
+
+	Status status;
+	if( !status.Read( entryPath.c_str() ) )
+	{
+		return false;
+	}
+
+	FileStream* pStream = FileStream::OpenFileStream( entryPath, FileStream::MODE_READ );
+	if( !pStream )
+	{
+		// May have been evicted by another process in the meantime.
+		return false;
+	}
+
+	DynamicArray< uint8_t > buffer;
+	buffer.Resize( static_cast< size_t >( status.m_Size ) );
+	size_t bytesRead = pStream->Read( buffer.GetData(), 1, buffer.GetSize() );
+	delete pStream;
+
+	// Validate the entry before touching the output data.
+	bool bValid = ( bytesRead == buffer.GetSize() && buffer.GetSize() >= sizeof( uint64_t ) );
+	if( bValid )
+	{
+		size_t dataSize = buffer.GetSize() - sizeof( uint64_t );
+
+		ContentHash checksum;
+		checksum.Update( buffer.GetData(), dataSize );
+
+		uint64_t storedChecksum;
+		MemoryCopy( &storedChecksum, buffer.GetData() + dataSize, sizeof( storedChecksum ) );
+		bValid = ( storedChecksum == checksum.GetValue() );
+	}
+
+	Resource::PreprocessedData loadedData[ Cache::PLATFORM_MAX ];
+
+	if( bValid )
+	{
+		const uint8_t* pCurrent = buffer.GetData();
+		const uint8_t* pEnd = pCurrent + buffer.GetSize() - sizeof( uint64_t );
+
+		uint32_t magic, version, keyLow, keyHigh, platformMask;
+		bValid =
+			ReadEntryValue( pCurrent, pEnd, magic ) && magic == ENTRY_MAGIC &&
+			ReadEntryValue( pCurrent, pEnd, version ) && version == ENTRY_VERSION &&
+			ReadEntryValue( pCurrent, pEnd, keyLow ) && keyLow == static_cast< uint32_t >( key ) &&
+			ReadEntryValue( pCurrent, pEnd, keyHigh ) && keyHigh == static_cast< uint32_t >( key >> 32 ) &&
+			ReadEntryValue( pCurrent, pEnd, platformMask );
+
+		for( size_t platformIndex = 0; bValid && platformIndex < Cache::PLATFORM_MAX; ++platformIndex )
+		{
+			Resource::PreprocessedData& rData = loadedData[ platformIndex ];
+			rData.bLoaded = ( ( platformMask & ( 1 << platformIndex ) ) != 0 );
+			if( !rData.bLoaded )
+			{
+				continue;
+			}
+
+			uint32_t subDataCount;
+			bValid =
+				ReadEntryData( pCurrent, pEnd, rData.persistentDataBuffer ) &&
+				ReadEntryValue( pCurrent, pEnd, subDataCount );
+
+			if( bValid )
+			{
+				rData.subDataBuffers.Resize( subDataCount );
+				for( uint32_t subDataIndex = 0; bValid && subDataIndex < subDataCount; ++subDataIndex )
+				{
+					bValid = ReadEntryData( pCurrent, pEnd, rData.subDataBuffers[ subDataIndex ] );
+				}
+			}
+		}
+
+		bValid = bValid && pCurrent == pEnd;
+	}
+
+	if( !bValid )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "SharedPreprocessCache: Discarding invalid entry \"%s\".\n" ),
+			entryPath.c_str() );
+
+		entryPath.Delete();
+
+		return false;
+	}
+
+	for( size_t platformIndex = 0; platformIndex < Cache::PLATFORM_MAX; ++platformIndex )
+	{
+		Resource::PreprocessedData& rData = pPlatformData[ platformIndex ];
+		Resource::PreprocessedData& rLoadedData = loadedData[ platformIndex ];
+		rData.persistentDataBuffer.Swap( rLoadedData.persistentDataBuffer );
+		rData.subDataBuffers.Swap( rLoadedData.subDataBuffers );
+		rData.bLoaded = rLoadedData.bLoaded;
+	}
+
+	// Mark the entry as recently used.
+	utime( entryPath.c_str(), NULL );
+
+	return true;
+}
+
+/// Store preprocessed data under the given key.
+///
+/// If an entry for the key already exists (possibly written by another process at the same time), it is left as-is,
+/// as it was built from the same inputs.
+///
+/// @param[in] key            Hash of the inputs from which the data was built.
+/// @param[in] pPlatformData  Preprocessed data for each platform (Cache::PLATFORM_MAX elements).  Only data for
+///                           which the loaded flag is set is stored.
+///
+/// @return  True if the entry was stored or already exists, false if writing failed.
+bool SharedPreprocessCache::Store( uint64_t key, const Resource::PreprocessedData* pPlatformData )
+{
+	HELIUM_ASSERT( m_bInitialized );
+	HELIUM_ASSERT( pPlatformData );
+
+	FilePath entryPath = GetEntryPath( key );
+	if( entryPath.Exists() )
+	{
+		return true;
+	}
+
+	uint32_t platformMask = 0;
+	for( size_t platformIndex = 0; platformIndex < Cache::PLATFORM_MAX; ++platformIndex )
+	{
+		if( pPlatformData[ platformIndex ].bLoaded )
+		{
+			platformMask |= 1 << platformIndex;
+		}
+	}
+
+	DynamicArray< uint8_t > buffer;
+	WriteEntryValue( buffer, ENTRY_MAGIC );
+	WriteEntryValue( buffer, ENTRY_VERSION );
+	WriteEntryValue( buffer, static_cast< uint32_t >( key ) );
+	WriteEntryValue( buffer, static_cast< uint32_t >( key >> 32 ) );
+	WriteEntryValue( buffer, platformMask );
+
+	for( size_t platformIndex = 0; platformIndex < Cache::PLATFORM_MAX; ++platformIndex )
+	{
+		const Resource::PreprocessedData& rData = pPlatformData[ platformIndex ];
+		if( !rData.bLoaded )
+		{
+			continue;
+		}
+
+		WriteEntryData( buffer, rData.persistentDataBuffer );
+
+		size_t subDataCount = rData.subDataBuffers.GetSize();
+		HELIUM_ASSERT( subDataCount <= UINT32_MAX );
+		WriteEntryValue( buffer, static_cast< uint32_t >( subDataCount ) );
+		for( size_t subDataIndex = 0; subDataIndex < subDataCount; ++subDataIndex )
+		{
+			WriteEntryData( buffer, rData.subDataBuffers[ subDataIndex ] );
+		}
+	}
+
+	ContentHash checksum;
+	checksum.Update( buffer.GetData(), buffer.GetSize() );
+	uint64_t checksumValue = checksum.GetValue();
+	buffer.AddArray( reinterpret_cast< const uint8_t* >( &checksumValue ), sizeof( checksumValue ) );
+
+	// Write the entry to a temporary file unique to this process and store, then rename it into place so that other
+	// processes never see a partially written entry.
+	FilePath entryDirectory( entryPath.Directory() );
+	if( !entryDirectory.MakePath() )
+	{
+		return false;
+	}
+
+	int32_t tempFileIndex = AtomicIncrementRelease( m_tempFileCounter );
+
+	char tempSuffix[ 64 ];
+	StringPrint(
+		tempSuffix,
+		TXT( ".%" ) PRIx64 TXT( "-%" ) PRIxPTR TXT( "-%" ) PRId32 TXT( "%s" ),
+		Timer::GetTickCount(),
+		reinterpret_cast< uintptr_t >( this ),
+		tempFileIndex,
+		TEMP_EXTENSION );
+
+	FilePath tempPath( entryPath.Get() + tempSuffix );
+
+	FileStream* pStream = FileStream::OpenFileStream( tempPath, FileStream::MODE_WRITE, true );
+	if( !pStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "SharedPreprocessCache: Failed to create \"%s\".\n" ),
+			tempPath.c_str() );
+
+		return false;
+	}
+
+	size_t bytesWritten = pStream->Write( buffer.GetData(), 1, buffer.GetSize() );
+	delete pStream;
+
+	if( bytesWritten != buffer.GetSize() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "SharedPreprocessCache: Failed to write \"%s\".\n" ),
+			tempPath.c_str() );
+
+		tempPath.Delete();
+
+		return false;
+	}
+
+	if( !tempPath.Move( entryPath ) )
+	{
+		// Another process may have stored the same entry first.
+		tempPath.Delete();
+
+		return entryPath.Exists();
+	}
+
+	// Trim the store once a fraction of the size limit has been written since it was last trimmed.
+	m_bytesSinceTrimLock.Lock();
+	m_bytesSinceTrim += buffer.GetSize();
+	bool bTrim = ( m_bytesSinceTrim > m_sizeLimit / 8 );
+	m_bytesSinceTrimLock.Unlock();
+
+	if( bTrim )
+	{
+		Trim();
+	}
+
+	return true;
+}
+
+/// Evict the least recently used entries until the store is sufficiently below its size limit.
+///
+/// Entries are evicted down to seven eighths of the limit, so that trimming is not needed again right away.  Files
+/// removed by other processes while trimming are simply skipped.  Temporary files are left alone, as other processes
+/// may still be writing them, unless they are old enough to have been abandoned.
+void SharedPreprocessCache::Trim()
+{
+	HELIUM_ASSERT( m_bInitialized );
+
+	m_bytesSinceTrimLock.Lock();
+	m_bytesSinceTrim = 0;
+	m_bytesSinceTrimLock.Unlock();
+
+	DynamicArray< SharedPreprocessCacheFile > files;
+	uint64_t totalSize = 0;
+
+	uint64_t currentTime = static_cast< uint64_t >( time( NULL ) );
+
+	DirectoryIterator rootIterator( m_directory );
+	for( ; !rootIterator.IsDone(); rootIterator.Next() )
+	{
+		const DirectoryIteratorItem& rBucketItem = rootIterator.GetItem();
+		if( !rBucketItem.m_Path.IsDirectory() )
+		{
+			continue;
+		}
+
+		DirectoryIterator bucketIterator( rBucketItem.m_Path );
+		for( ; !bucketIterator.IsDone(); bucketIterator.Next() )
+		{
+			const DirectoryIteratorItem& rItem = bucketIterator.GetItem();
+			if( rItem.m_Path.IsDirectory() )
+			{
+				continue;
+			}
+
+			const std::string& rFileName = rItem.m_Path.Get();
+			if( HasExtension( rFileName, TEMP_EXTENSION, sizeof( TEMP_EXTENSION ) - 1 ) )
+			{
+				if( rItem.m_ModTime + STALE_TEMP_FILE_AGE < currentTime )
+				{
+					rItem.m_Path.Delete();
+				}
+
+				continue;
+			}
+
+			if( !HasExtension( rFileName, ENTRY_EXTENSION, sizeof( ENTRY_EXTENSION ) - 1 ) )
+			{
+				continue;
+			}
+
+			SharedPreprocessCacheFile* pFile = files.New();
+			HELIUM_ASSERT( pFile );
+			pFile->path = rItem.m_Path;
+			pFile->size = rItem.m_Size;
+			pFile->modifiedTime = rItem.m_ModTime;
+
+			totalSize += rItem.m_Size;
+		}
+	}
+
+	if( totalSize <= m_sizeLimit )
+	{
+		return;
+	}
+
+	std::sort( files.GetData(), files.GetData() + files.GetSize(), CompareFileUseTimes );
+
+	uint64_t targetSize = m_sizeLimit - m_sizeLimit / 8;
+	size_t evictedCount = 0;
+	for( size_t fileIndex = 0; fileIndex < files.GetSize() && totalSize > targetSize; ++fileIndex )
+	{
+		const SharedPreprocessCacheFile& rFile = files[ fileIndex ];
+		rFile.path.Delete();
+		totalSize -= rFile.size;
+		++evictedCount;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "SharedPreprocessCache: Evicted %" ) PRIuSZ TXT( " entries from \"%s\".\n" ),
+		evictedCount,
+		m_directory.c_str() );
+}
+
+/// Get the path of the file storing the entry for the given key.
+///
+/// Entries are spread across 256 subdirectories based on the low byte of the key to keep directories small.
+///
+/// @param[in] key  Entry key.
+///
+/// @return  Entry file path.
+FilePath SharedPreprocessCache::GetEntryPath( uint64_t key ) const
+{
+	char entryName[ 64 ];
+	StringPrint(
+		entryName,
+		TXT( "%02" ) PRIx32 TXT( "/%016" ) PRIx64 TXT( "%s" ),
+		static_cast< uint32_t >( key & 0xff ),
+		key,
+		ENTRY_EXTENSION );
+
+	return FilePath( m_directory.Get() + entryName );
+}
+
+#endif  // HELIUM_TOOLS
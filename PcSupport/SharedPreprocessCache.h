@@ -0,0 +1,79 @@
+#pragma once
+
+#include "PcSupport/PcSupport.h"
+
+#include "Platform/Locks.h"
+#include "Foundation/FilePath.h"
+#include "Engine/Resource.h"
+
+#if HELIUM_TOOLS
+
+namespace Helium
+{
+	/// Content-addressed store of preprocessed resource data shared between workspaces on the same machine.
+	///
+	/// Each entry holds the preprocessed data of one resource for every platform, stored in its own file named after
+	/// the hash of the inputs it was built from.  Entries are written to a temporary file and renamed into place, so
+	/// any number of processes can read and write the same directory at once without ever seeing a partial entry.
+	/// The total size of the store is capped by evicting the least recently used entries (based on file modification
+	/// times, which are refreshed whenever an entry is read).
+	///
+	/// Entries are stored in the byte order of the machine, as the store is only meant to be shared locally.  Load(),
+	/// Store(), and Trim() may be called from multiple threads at once.
+	class HELIUM_PC_SUPPORT_API SharedPreprocessCache : NonCopyable
+	{
+	public:
+		/// Default size limit, in bytes.
+		static const uint64_t DEFAULT_SIZE_LIMIT = 4ULL * 1024 * 1024 * 1024;
+
+		/// @name Construction/Destruction
+		//@{
+		SharedPreprocessCache();
+		~SharedPreprocessCache();
+		//@}
+
+		/// @name Initialization
+		//@{
+		bool Initialize( const FilePath& rDirectory, uint64_t sizeLimit = DEFAULT_SIZE_LIMIT );
+		void Shutdown();
+
+		inline bool IsInitialized() const;
+		inline const FilePath& GetDirectory() const;
+		inline uint64_t GetSizeLimit() const;
+		//@}
+
+		/// @name Entry Access
+		//@{
+		bool Load( uint64_t key, Resource::PreprocessedData* pPlatformData );
+		bool Store( uint64_t key, const Resource::PreprocessedData* pPlatformData );
+		//@}
+
+		/// @name Size Management
+		//@{
+		void Trim();
+		//@}
+
+	private:
+		/// Root directory of the store.
+		FilePath m_directory;
+		/// Maximum total size of all entries, in bytes.
+		uint64_t m_sizeLimit;
+		/// Number of bytes stored since the store was last trimmed.
+		uint64_t m_bytesSinceTrim;
+		/// Lock for synchronizing access to the stored byte count.
+		SpinLock m_bytesSinceTrimLock;
+		/// Counter used to generate unique temporary file names.
+		volatile int32_t m_tempFileCounter;
+		/// True if the store has been initialized.
+		bool m_bInitialized;
+
+		/// @name Private Utility Functions
+		//@{
+		FilePath GetEntryPath( uint64_t key ) const;
+		//@}
+	};
+}
+
+#include "PcSupport/SharedPreprocessCache.inl"
+
+#endif  // HELIUM_TOOLS
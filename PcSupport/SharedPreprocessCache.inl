@@ -0,0 +1,28 @@
+namespace Helium
+{
+	/// Get whether this store has been initialized.
+	///
+	/// @return  True if initialized, false if not.
+	///
+	/// @see Initialize(), Shutdown()
+	bool SharedPreprocessCache::IsInitialized() const
+	{
+		return m_bInitialized;
+	}
+
+	/// Get the root directory of this store.
+	///
+	/// @return  Store directory.
+	const FilePath& SharedPreprocessCache::GetDirectory() const
+	{
+		return m_directory;
+	}
+
+	/// Get the maximum total size of all entries in this store.
+	///
+	/// @return  Size limit, in bytes.
+	uint64_t SharedPreprocessCache::GetSizeLimit() const
+	{
+		return m_sizeLimit;
+	}
+}
@@ -188,6 +188,13 @@ PlatformPreprocessor::EByteOrder PcPreprocessor::GetByteOrder() const
 	return BYTE_ORDER_LITTLE;
 }
 
+/// @copydoc PlatformPreprocessor::GetVersion()
+uint32_t PcPreprocessor::GetVersion() const
+{
+	// Increase this when changing the D3DCompile() flags or the shader profile definitions in CompileShader().
+	return 1;
+}
+
 /// @copydoc PlatformPreprocessor::GetShaderProfileCount()
 size_t PcPreprocessor::GetShaderProfileCount() const
 {
@@ -18,6 +18,7 @@ namespace Helium
         /// @name Platform Parameters
         //@{
         virtual EByteOrder GetByteOrder() const;
+        virtual uint32_t GetVersion() const;
         //@}
 
         /// @name Shader Compiling
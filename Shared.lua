@@ -22,6 +22,8 @@ project( prefix .. "Engine" )
 			prefix .. "Persist",
 			prefix .. "Math",
 			prefix .. "MathSimd",
+
+			"zlib",
 		}
 
 project( prefix .. "EngineJobs" )
@@ -584,6 +586,7 @@ project( prefix .. "TestApp" )
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	configuration "linux"
@@ -945,6 +948,7 @@ project( prefix .. "EmptyMain" )
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	configuration "linux"
@@ -0,0 +1,547 @@
+#include "TestAppPch.h"
+
+#if GTEST
+
+#if HELIUM_OS_WIN
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+#if HELIUM_OS_LINUX
+#include <fcntl.h>
+#endif
+
+using namespace Helium;
+
+namespace
+{
+    const size_t BENCHMARK_FILE_COUNT = 8;
+    const size_t BENCHMARK_FILE_SIZE = 1024 * 1024;
+    const size_t BENCHMARK_READ_SIZE = 4096;
+    const size_t BENCHMARK_REQUEST_COUNT = 6000;
+
+    class AsyncLoaderBenchmark : public testing::Test
+    {
+    public:
+        void SetUp()
+        {
+            FilePath userDataDirectory;
+            HELIUM_VERIFY( FileLocations::GetUserDataDirectory( userDataDirectory ) );
+            m_Directory.Set( userDataDirectory + TXT( "AsyncLoaderBenchmark/" ) );
+            HELIUM_VERIFY( m_Directory.MakePath() );
+
+            DynamicArray< uint8_t > contents;
+            contents.Resize( BENCHMARK_FILE_SIZE );
+            for ( size_t byteIndex = 0; byteIndex < BENCHMARK_FILE_SIZE; ++byteIndex )
+            {
+                contents[ byteIndex ] = static_cast< uint8_t >( byteIndex * 31 );
+            }
+
+            for ( size_t fileIndex = 0; fileIndex < BENCHMARK_FILE_COUNT; ++fileIndex )
+            {
+                char fileName[ 32 ];
+                StringPrint( fileName, TXT( "Data%" ) PRIuSZ TXT( ".bin" ), fileIndex );
+                FilePath filePath( m_Directory + fileName );
+
+                FileStream* pStream = FileStream::OpenFileStream( filePath, FileStream::MODE_WRITE, true );
+                ASSERT_TRUE( pStream != NULL );
+                EXPECT_EQ( BENCHMARK_FILE_SIZE, pStream->Write( contents.GetData(), 1, contents.GetSize() ) );
+                delete pStream;
+
+                m_Files.Push( filePath );
+            }
+        }
+
+        void TearDown()
+        {
+            // Wait for the loader workers to close their streams on the files, then remove everything in the benchmark
+            // directory and the directory itself
+            AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+            rLoader.Lock();
+            for ( DirectoryIterator iterator( m_Directory ); !iterator.IsDone(); iterator.Next() )
+            {
+                iterator.GetItem().m_Path.Delete();
+            }
+
+#if HELIUM_OS_WIN
+            _rmdir( m_Directory.c_str() );
+#else
+            rmdir( m_Directory.c_str() );
+#endif
+            rLoader.Unlock();
+
+            EXPECT_FALSE( m_Directory.Exists() );
+        }
+
+        FilePath m_Directory;
+        DynamicArray< FilePath > m_Files;
+    };
+
+    float64_t GetPercentile( DynamicArray< float64_t > &rSamples, float64_t percentile )
+    {
+        if ( rSamples.IsEmpty() )
+        {
+            return 0.0;
+        }
+
+        std::sort( rSamples.GetData(), rSamples.GetData() + rSamples.GetSize() );
+        size_t index = static_cast< size_t >( percentile * static_cast< float64_t >( rSamples.GetSize() - 1 ) );
+
+        return rSamples[ index ];
+    }
+
+    /// Evict a file from the page cache where the platform allows it, so the next reads have to hit the disk.
+    void EvictFromPageCache( const FilePath &rFile )
+    {
+#if HELIUM_OS_LINUX
+        int descriptor = open( rFile.c_str(), O_RDONLY );
+        if ( descriptor != -1 )
+        {
+            fdatasync( descriptor );
+            posix_fadvise( descriptor, 0, 0, POSIX_FADV_DONTNEED );
+            close( descriptor );
+        }
+#else
+        HELIUM_UNREF( rFile );
+#endif
+    }
+}
+
+TEST_F(AsyncLoaderBenchmark, MixedPriorityLatency)
+{
+    AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+
+    DynamicArray< uint8_t > buffer;
+    buffer.Resize( BENCHMARK_REQUEST_COUNT * BENCHMARK_READ_SIZE );
+
+    AsyncLoader::CompletionQueue completionQueue;
+    DynamicArray< size_t > requestIds;
+    DynamicArray< uint64_t > queueTicks;
+    DynamicArray< AsyncLoader::EPriority > priorities;
+    DynamicArray< bool > cancelled;
+    requestIds.Resize( BENCHMARK_REQUEST_COUNT );
+    queueTicks.Resize( BENCHMARK_REQUEST_COUNT );
+    priorities.Resize( BENCHMARK_REQUEST_COUNT );
+    cancelled.Resize( BENCHMARK_REQUEST_COUNT );
+
+    // Mostly low-priority traffic with a sprinkling of urgent reads, the way a level load looks
+    uint32_t random = 12345;
+    for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+    {
+        random = random * 1664525 + 1013904223;
+        uint32_t roll = ( random >> 16 ) % 10;
+        priorities[ requestIndex ] =
+            ( roll == 0 ? AsyncLoader::PRIORITY_HIGH : ( roll < 3 ? AsyncLoader::PRIORITY_NORMAL : AsyncLoader::PRIORITY_LOW ) );
+
+        const FilePath &rFile = m_Files[ requestIndex % m_Files.GetSize() ];
+        uint64_t offset = ( ( random >> 8 ) % ( BENCHMARK_FILE_SIZE / BENCHMARK_READ_SIZE ) ) * BENCHMARK_READ_SIZE;
+
+        queueTicks[ requestIndex ] = Timer::GetTickCount();
+        requestIds[ requestIndex ] = rLoader.QueueRequest(
+            &buffer[ requestIndex * BENCHMARK_READ_SIZE ],
+            String( rFile.c_str() ),
+            offset,
+            BENCHMARK_READ_SIZE,
+            priorities[ requestIndex ],
+            &completionQueue,
+            requestIndex );
+        ASSERT_TRUE( IsValid( requestIds[ requestIndex ] ) );
+        cancelled[ requestIndex ] = false;
+    }
+
+    // Cancel every 50th low-priority request that has not been picked up yet
+    size_t cancelledCount = 0;
+    for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; requestIndex += 50 )
+    {
+        if ( priorities[ requestIndex ] == AsyncLoader::PRIORITY_LOW && rLoader.CancelRequest( requestIds[ requestIndex ] ) )
+        {
+            SetInvalid( requestIds[ requestIndex ] );
+            cancelled[ requestIndex ] = true;
+            ++cancelledCount;
+        }
+    }
+
+    DynamicArray< float64_t > latencies[ AsyncLoader::PRIORITY_MAX ];
+    size_t remainingCount = BENCHMARK_REQUEST_COUNT - cancelledCount;
+    while ( remainingCount != 0 )
+    {
+        for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+        {
+            size_t bytesRead;
+            if ( IsValid( requestIds[ requestIndex ] ) && rLoader.TrySyncRequest( requestIds[ requestIndex ], bytesRead ) )
+            {
+                uint64_t elapsedTicks = Timer::GetTickCount() - queueTicks[ requestIndex ];
+                latencies[ priorities[ requestIndex ] ].Push( Timer::TicksToMilliseconds( elapsedTicks ) );
+                EXPECT_EQ( BENCHMARK_READ_SIZE, bytesRead );
+
+                SetInvalid( requestIds[ requestIndex ] );
+                --remainingCount;
+            }
+        }
+
+        Thread::Yield();
+    }
+
+    // Every request that was not cancelled completed exactly once, and no cancelled request ever did
+    DynamicArray< size_t > completedCookies;
+    {
+        AsyncLoader::CompletionQueue::Handle queueHandle( completionQueue );
+        queueHandle->Swap( completedCookies );
+    }
+    EXPECT_EQ( BENCHMARK_REQUEST_COUNT - cancelledCount, completedCookies.GetSize() );
+    for ( size_t cookieIndex = 0; cookieIndex < completedCookies.GetSize(); ++cookieIndex )
+    {
+        ASSERT_LT( completedCookies[ cookieIndex ], BENCHMARK_REQUEST_COUNT );
+        EXPECT_FALSE( cancelled[ completedCookies[ cookieIndex ] ] );
+    }
+
+    static const char* priorityNames[ AsyncLoader::PRIORITY_MAX ] = { TXT( "low" ), TXT( "normal" ), TXT( "high" ) };
+    for ( size_t priorityIndex = 0; priorityIndex < AsyncLoader::PRIORITY_MAX; ++priorityIndex )
+    {
+        DynamicArray< float64_t > &rLatencies = latencies[ priorityIndex ];
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            TXT( "AsyncLoader %s priority: %" PRIuSZ " reads, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms\n" ),
+            priorityNames[ priorityIndex ],
+            rLatencies.GetSize(),
+            GetPercentile( rLatencies, 0.5 ),
+            GetPercentile( rLatencies, 0.9 ),
+            GetPercentile( rLatencies, 0.99 ) );
+    }
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "AsyncLoader: %" PRIu32 " workers, %" PRIuSZ " low-priority reads cancelled\n" ),
+        rLoader.GetWorkerCount(),
+        cancelledCount );
+}
+
+TEST_F(AsyncLoaderBenchmark, MixedPriorityOrder)
+{
+    AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+
+    // A single worker makes the completion order follow the order requests are picked up in
+    ASSERT_TRUE( rLoader.Initialize( 1, AsyncLoader::BACKEND_THREADS ) );
+
+    const size_t requestCount = 96;
+    DynamicArray< uint8_t > buffer;
+    buffer.Resize( ( requestCount + 1 ) * BENCHMARK_READ_SIZE );
+
+    AsyncLoader::CompletionQueue gateQueue;
+    AsyncLoader::CompletionQueue completionQueue;
+    DynamicArray< size_t > requestIds;
+    DynamicArray< AsyncLoader::EPriority > priorities;
+    DynamicArray< bool > cancelled;
+    requestIds.Resize( requestCount );
+    priorities.Resize( requestCount );
+    cancelled.Resize( requestCount );
+
+    size_t gateId;
+    size_t cancelledCount = 0;
+    {
+        // The worker pushes the gate request's cookie while holding the gate queue lock, so it stalls on the gate
+        // until this scope ends. The gate is the first high priority request and has a file to itself, so it is
+        // always picked up first and alone, and everything below is still queued when the gate opens.
+        AsyncLoader::CompletionQueue::Handle gateHandle( gateQueue );
+        gateId = rLoader.QueueRequest(
+            &buffer[ requestCount * BENCHMARK_READ_SIZE ],
+            String( m_Files[ 0 ].c_str() ),
+            0,
+            BENCHMARK_READ_SIZE,
+            AsyncLoader::PRIORITY_HIGH,
+            &gateQueue );
+        ASSERT_TRUE( IsValid( gateId ) );
+
+        // Each priority reads its own file at offsets rising in queue order, so the order within a priority is not
+        // hidden by the worker sorting a batch by offset
+        for ( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+        {
+            priorities[ requestIndex ] =
+                static_cast< AsyncLoader::EPriority >( ( requestIndex * 7 / 3 ) % AsyncLoader::PRIORITY_MAX );
+            requestIds[ requestIndex ] = rLoader.QueueRequest(
+                &buffer[ requestIndex * BENCHMARK_READ_SIZE ],
+                String( m_Files[ 1 + priorities[ requestIndex ] ].c_str() ),
+                requestIndex * BENCHMARK_READ_SIZE,
+                BENCHMARK_READ_SIZE,
+                priorities[ requestIndex ],
+                &completionQueue,
+                requestIndex );
+            ASSERT_TRUE( IsValid( requestIds[ requestIndex ] ) );
+            cancelled[ requestIndex ] = false;
+        }
+
+        // Nothing besides the gate has been picked up yet, so every cancellation succeeds
+        for ( size_t requestIndex = 0; requestIndex < requestCount; requestIndex += 5 )
+        {
+            if ( priorities[ requestIndex ] == AsyncLoader::PRIORITY_LOW )
+            {
+                EXPECT_TRUE( rLoader.CancelRequest( requestIds[ requestIndex ] ) );
+                cancelled[ requestIndex ] = true;
+                ++cancelledCount;
+            }
+        }
+    }
+
+    rLoader.Flush();
+    EXPECT_EQ( BENCHMARK_READ_SIZE, rLoader.SyncRequest( gateId ) );
+
+    DynamicArray< size_t > completedCookies;
+    {
+        AsyncLoader::CompletionQueue::Handle queueHandle( completionQueue );
+        queueHandle->Swap( completedCookies );
+    }
+    ASSERT_EQ( requestCount - cancelledCount, completedCookies.GetSize() );
+
+    for ( size_t cookieIndex = 0; cookieIndex < completedCookies.GetSize(); ++cookieIndex )
+    {
+        size_t cookie = completedCookies[ cookieIndex ];
+        ASSERT_LT( cookie, requestCount );
+        EXPECT_FALSE( cancelled[ cookie ] );
+
+        // Higher priorities complete first, and requests of the same priority complete in the order they were queued
+        if ( cookieIndex != 0 )
+        {
+            size_t previousCookie = completedCookies[ cookieIndex - 1 ];
+            EXPECT_GE( priorities[ previousCookie ], priorities[ cookie ] );
+            if ( priorities[ previousCookie ] == priorities[ cookie ] )
+            {
+                EXPECT_LT( previousCookie, cookie );
+            }
+        }
+
+        EXPECT_EQ( BENCHMARK_READ_SIZE, rLoader.SyncRequest( requestIds[ cookie ] ) );
+    }
+
+    // Restore the loader configuration the rest of the tests run with.
+    ASSERT_TRUE( rLoader.Initialize() );
+}
+
+TEST_F(AsyncLoaderBenchmark, CoalescedReadsMatchFile)
+{
+    AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+    ASSERT_TRUE( rLoader.Initialize( 1, AsyncLoader::BACKEND_THREADS ) );
+
+    // Adjacent, near, overlapping and distant ranges on one file, ending with a pair whose read runs past the end
+    struct Range
+    {
+        uint64_t offset;
+        size_t size;
+    };
+    const Range ranges[] =
+    {
+        { 0, BENCHMARK_READ_SIZE },
+        { BENCHMARK_READ_SIZE, BENCHMARK_READ_SIZE },
+        { 2 * BENCHMARK_READ_SIZE + 100, 1000 },
+        { 2 * BENCHMARK_READ_SIZE + 500, 2000 },
+        { 2 * BENCHMARK_READ_SIZE + 500, 16 },
+        { 16 * BENCHMARK_READ_SIZE, BENCHMARK_READ_SIZE },
+        { BENCHMARK_FILE_SIZE - 2 * BENCHMARK_READ_SIZE, BENCHMARK_READ_SIZE },
+        { BENCHMARK_FILE_SIZE - BENCHMARK_READ_SIZE / 2, BENCHMARK_READ_SIZE },
+    };
+    const size_t requestCount = HELIUM_ARRAY_COUNT( ranges );
+
+    DynamicArray< uint8_t > buffer;
+    buffer.Resize( ( requestCount + 1 ) * BENCHMARK_READ_SIZE );
+    MemoryZero( buffer.GetData(), buffer.GetSize() );
+
+    AsyncLoader::CompletionQueue gateQueue;
+    DynamicArray< size_t > requestIds;
+    requestIds.Resize( requestCount );
+
+    size_t gateId;
+    {
+        // Hold the worker on the gate request (see MixedPriorityOrder) so the ranges below are picked up as one batch
+        AsyncLoader::CompletionQueue::Handle gateHandle( gateQueue );
+        gateId = rLoader.QueueRequest(
+            &buffer[ requestCount * BENCHMARK_READ_SIZE ],
+            String( m_Files[ 0 ].c_str() ),
+            0,
+            BENCHMARK_READ_SIZE,
+            AsyncLoader::PRIORITY_HIGH,
+            &gateQueue );
+        ASSERT_TRUE( IsValid( gateId ) );
+
+        // Queued back to front, so the worker has to sort them before merging
+        for ( size_t requestIndex = requestCount; requestIndex-- != 0; )
+        {
+            requestIds[ requestIndex ] = rLoader.QueueRequest(
+                &buffer[ requestIndex * BENCHMARK_READ_SIZE ],
+                String( m_Files[ 1 ].c_str() ),
+                ranges[ requestIndex ].offset,
+                ranges[ requestIndex ].size );
+            ASSERT_TRUE( IsValid( requestIds[ requestIndex ] ) );
+        }
+    }
+
+    EXPECT_EQ( BENCHMARK_READ_SIZE, rLoader.SyncRequest( gateId ) );
+
+    for ( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+    {
+        const Range &rRange = ranges[ requestIndex ];
+        size_t expectedSize = static_cast< size_t >(
+            Min< uint64_t >( rRange.size, BENCHMARK_FILE_SIZE - rRange.offset ) );
+        EXPECT_EQ( expectedSize, rLoader.SyncRequest( requestIds[ requestIndex ] ) );
+
+        const uint8_t *pData = &buffer[ requestIndex * BENCHMARK_READ_SIZE ];
+        for ( size_t byteIndex = 0; byteIndex < expectedSize; ++byteIndex )
+        {
+            ASSERT_EQ( static_cast< uint8_t >( ( rRange.offset + byteIndex ) * 31 ), pData[ byteIndex ] );
+        }
+    }
+
+    // Restore the loader configuration the rest of the tests run with.
+    ASSERT_TRUE( rLoader.Initialize() );
+}
+
+TEST_F(AsyncLoaderBenchmark, FlushWaitsForAllRequests)
+{
+    AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+
+    DynamicArray< uint8_t > buffer;
+    buffer.Resize( BENCHMARK_REQUEST_COUNT * BENCHMARK_READ_SIZE );
+
+    DynamicArray< size_t > requestIds;
+    requestIds.Resize( BENCHMARK_REQUEST_COUNT );
+
+    int32_t completionCount = rLoader.GetCompletionCount();
+    for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+    {
+        requestIds[ requestIndex ] = rLoader.QueueRequest(
+            &buffer[ requestIndex * BENCHMARK_READ_SIZE ],
+            String( m_Files[ requestIndex % m_Files.GetSize() ].c_str() ),
+            ( requestIndex % ( BENCHMARK_FILE_SIZE / BENCHMARK_READ_SIZE ) ) * BENCHMARK_READ_SIZE,
+            BENCHMARK_READ_SIZE );
+        ASSERT_TRUE( IsValid( requestIds[ requestIndex ] ) );
+    }
+
+    // Sleeps until the workers are done rather than spinning
+    rLoader.Flush();
+    EXPECT_EQ( static_cast< int32_t >( BENCHMARK_REQUEST_COUNT ), rLoader.GetCompletionCount() - completionCount );
+
+    for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+    {
+        size_t bytesRead;
+        ASSERT_TRUE( rLoader.TrySyncRequest( requestIds[ requestIndex ], bytesRead ) );
+        EXPECT_EQ( BENCHMARK_READ_SIZE, bytesRead );
+    }
+
+    // Nothing left pending, so waiting returns right away
+    rLoader.WaitForCompletion( rLoader.GetCompletionCount() );
+}
+
+TEST_F(AsyncLoaderBenchmark, CompletionQueueReceivesEveryCookie)
+{
+    AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+
+    DynamicArray< uint8_t > buffer;
+    buffer.Resize( BENCHMARK_REQUEST_COUNT * BENCHMARK_READ_SIZE );
+
+    AsyncLoader::CompletionQueue completionQueue;
+    DynamicArray< size_t > requestIds;
+    requestIds.Resize( BENCHMARK_REQUEST_COUNT );
+    for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+    {
+        requestIds[ requestIndex ] = rLoader.QueueRequest(
+            &buffer[ requestIndex * BENCHMARK_READ_SIZE ],
+            String( m_Files[ requestIndex % m_Files.GetSize() ].c_str() ),
+            ( requestIndex % ( BENCHMARK_FILE_SIZE / BENCHMARK_READ_SIZE ) ) * BENCHMARK_READ_SIZE,
+            BENCHMARK_READ_SIZE,
+            AsyncLoader::PRIORITY_NORMAL,
+            &completionQueue,
+            requestIndex );
+        ASSERT_TRUE( IsValid( requestIds[ requestIndex ] ) );
+    }
+
+    rLoader.Flush();
+
+    DynamicArray< size_t > completedCookies;
+    {
+        AsyncLoader::CompletionQueue::Handle queueHandle( completionQueue );
+        queueHandle->Swap( completedCookies );
+    }
+    ASSERT_EQ( BENCHMARK_REQUEST_COUNT, completedCookies.GetSize() );
+
+    // Each cookie is pushed exactly once, in whatever order the requests finished.
+    DynamicArray< bool > cookieSeen;
+    cookieSeen.Resize( BENCHMARK_REQUEST_COUNT );
+    for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+    {
+        cookieSeen[ requestIndex ] = false;
+    }
+
+    for ( size_t cookieIndex = 0; cookieIndex < completedCookies.GetSize(); ++cookieIndex )
+    {
+        size_t cookie = completedCookies[ cookieIndex ];
+        ASSERT_LT( cookie, BENCHMARK_REQUEST_COUNT );
+        EXPECT_FALSE( cookieSeen[ cookie ] );
+        cookieSeen[ cookie ] = true;
+
+        EXPECT_EQ( BENCHMARK_READ_SIZE, rLoader.SyncRequest( requestIds[ cookie ] ) );
+    }
+}
+
+TEST_F(AsyncLoaderBenchmark, BackendColdSmallReads)
+{
+    AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+
+    DynamicArray< uint8_t > buffer;
+    buffer.Resize( BENCHMARK_REQUEST_COUNT * BENCHMARK_READ_SIZE );
+
+    DynamicArray< size_t > requestIds;
+    DynamicArray< uint64_t > offsets;
+    requestIds.Resize( BENCHMARK_REQUEST_COUNT );
+    offsets.Resize( BENCHMARK_REQUEST_COUNT );
+
+    static const char* backendNames[ AsyncLoader::BACKEND_MAX ] = { TXT( "threads" ), TXT( "io_uring" ) };
+    for ( size_t backendIndex = 0; backendIndex < AsyncLoader::BACKEND_MAX; ++backendIndex )
+    {
+        AsyncLoader::EBackend backend = static_cast< AsyncLoader::EBackend >( backendIndex );
+        ASSERT_TRUE( rLoader.Initialize( AsyncLoader::DEFAULT_WORKER_COUNT, backend ) );
+        if ( rLoader.GetBackend() != backend )
+        {
+            HELIUM_TRACE( TraceLevels::Info, TXT( "AsyncLoader %s backend unavailable, skipping\n" ), backendNames[ backendIndex ] );
+            continue;
+        }
+
+        for ( size_t fileIndex = 0; fileIndex < m_Files.GetSize(); ++fileIndex )
+        {
+            EvictFromPageCache( m_Files[ fileIndex ] );
+        }
+
+        uint32_t random = 12345;
+        uint64_t startTicks = Timer::GetTickCount();
+        for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+        {
+            random = random * 1664525 + 1013904223;
+            offsets[ requestIndex ] = ( ( random >> 8 ) % ( BENCHMARK_FILE_SIZE / BENCHMARK_READ_SIZE ) ) * BENCHMARK_READ_SIZE;
+
+            requestIds[ requestIndex ] = rLoader.QueueRequest(
+                &buffer[ requestIndex * BENCHMARK_READ_SIZE ],
+                String( m_Files[ requestIndex % m_Files.GetSize() ].c_str() ),
+                offsets[ requestIndex ],
+                BENCHMARK_READ_SIZE );
+            ASSERT_TRUE( IsValid( requestIds[ requestIndex ] ) );
+        }
+
+        for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+        {
+            EXPECT_EQ( BENCHMARK_READ_SIZE, rLoader.SyncRequest( requestIds[ requestIndex ] ) );
+            EXPECT_EQ( static_cast< uint8_t >( offsets[ requestIndex ] * 31 ), buffer[ requestIndex * BENCHMARK_READ_SIZE ] );
+        }
+        float32_t milliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            TXT( "AsyncLoader %s backend: %" PRIuSZ " cold %" PRIuSZ "-byte reads in %.3f ms\n" ),
+            backendNames[ backendIndex ],
+            BENCHMARK_REQUEST_COUNT,
+            BENCHMARK_READ_SIZE,
+            milliseconds );
+    }
+
+    // Restore the loader configuration the rest of the tests run with.
+    ASSERT_TRUE( rLoader.Initialize() );
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "TestAppPch.h"
+
+#if GTEST
+
+#include "Bullet/BulletWorld.h"
+#include "Bullet/BulletWorldDefinition.h"
+#include "Bullet/BulletBody.h"
+#include "Bullet/BulletBodyDefinition.h"
+#include "Bullet/BulletShapes.h"
+
+using namespace Helium;
+
+class BulletWorldTest : public testing::Test
+{
+public:
+    void SetUp()
+    {
+        BulletWorldDefinition worldDefinition;
+        worldDefinition.m_Gravity = Simd::Vector3( 0.0f, -9.8f, 0.0f );
+        m_World.Initialize( worldDefinition );
+
+        BulletShapeBoxPtr groundShape( new BulletShapeBox() );
+        groundShape->m_Extents = Simd::Vector3( 100.0f, 1.0f, 100.0f );
+        BulletBodyDefinition groundDefinition;
+        groundDefinition.m_Shapes.Push( groundShape );
+
+        BulletShapeBoxPtr boxShape( new BulletShapeBox() );
+        boxShape->m_Mass = 1.0f;
+        BulletBodyDefinition boxDefinition;
+        boxDefinition.m_Shapes.Push( boxShape );
+
+        m_Bodies.Resize( 9 );
+        m_Bodies[ 0 ].Initialize( m_World, groundDefinition, Simd::Vector3( 0.0f, -0.5f, 0.0f ), Simd::Quat::IDENTITY );
+
+        // A loose pile so that there are plenty of contacts and warm-started manifolds
+        for ( size_t i = 1; i < m_Bodies.GetSize(); ++i )
+        {
+            float32_t offset = static_cast< float32_t >( i );
+            m_Bodies[ i ].Initialize(
+                m_World,
+                boxDefinition,
+                Simd::Vector3( 0.3f * ( offset - 4.0f ), 0.6f + 1.1f * offset, 0.1f * offset ),
+                Simd::Quat( 0.0f, 0.2f * offset, 0.0f ) );
+        }
+    }
+
+    void TearDown()
+    {
+        for ( size_t i = 0; i < m_Bodies.GetSize(); ++i )
+        {
+            m_Bodies[ i ].Destruct( m_World );
+        }
+        m_Bodies.Clear();
+    }
+
+    void Step( size_t frameCount )
+    {
+        for ( size_t i = 0; i < frameCount; ++i )
+        {
+            m_World.Simulate( 1.0f / 60.0f );
+        }
+    }
+
+    void SaveState( DynamicArray< uint8_t > &rBuffer )
+    {
+        rBuffer.Resize( m_World.GetStateSize() );
+        EXPECT_EQ( m_World.SaveState( rBuffer.GetData(), rBuffer.GetSize() ), rBuffer.GetSize() );
+    }
+
+    BulletWorld m_World;
+    DynamicArray< BulletBody > m_Bodies;
+};
+
+TEST_F(BulletWorldTest, SaveRestoreStateDeterminism)
+{
+    // Let the pile settle into contact so the snapshot carries persistent manifolds
+    Step( 30 );
+
+    DynamicArray< uint8_t > snapshot;
+    SaveState( snapshot );
+
+    // Saving leaves the world untouched, so saving again right away gives the same bytes
+    DynamicArray< uint8_t > snapshotCopy;
+    SaveState( snapshotCopy );
+    ASSERT_EQ( snapshot.GetSize(), snapshotCopy.GetSize() );
+    EXPECT_EQ( memcmp( snapshot.GetData(), snapshotCopy.GetData(), snapshot.GetSize() ), 0 );
+
+    // The live run carries on from the snapshot. Saving part way through must not change where it ends up.
+    Step( 60 );
+    DynamicArray< uint8_t > midRun;
+    SaveState( midRun );
+    Step( 60 );
+    DynamicArray< uint8_t > liveRun;
+    SaveState( liveRun );
+
+    // Restoring and stepping the same frames again must land on exactly the same state as the live run
+    EXPECT_TRUE( m_World.RestoreState( snapshot.GetData(), snapshot.GetSize() ) );
+
+    DynamicArray< uint8_t > restoredSnapshot;
+    SaveState( restoredSnapshot );
+    ASSERT_EQ( snapshot.GetSize(), restoredSnapshot.GetSize() );
+    EXPECT_EQ( memcmp( snapshot.GetData(), restoredSnapshot.GetData(), snapshot.GetSize() ), 0 );
+
+    Step( 120 );
+    DynamicArray< uint8_t > restoredRun;
+    SaveState( restoredRun );
+
+    ASSERT_EQ( liveRun.GetSize(), restoredRun.GetSize() );
+    EXPECT_EQ( memcmp( liveRun.GetData(), restoredRun.GetData(), liveRun.GetSize() ), 0 );
+
+    // A truncated state must be rejected without touching the world
+    EXPECT_FALSE( m_World.RestoreState( snapshot.GetData(), snapshot.GetSize() / 2 ) );
+}
+
+TEST_F(BulletWorldTest, StepStats)
+{
+    Step( 30 );
+
+    const BulletWorldStepStats &rStats = m_World.GetStepStats();
+    EXPECT_LE( rStats.m_SubStepCount, 2u );
+    EXPECT_GT( rStats.m_OverlappingPairCount, 0u );
+    EXPECT_GT( rStats.m_ManifoldCount, 0u );
+    EXPECT_GE( rStats.m_ContactCount, rStats.m_ManifoldCount );
+    EXPECT_LE( rStats.m_ActiveBodyCount, static_cast< uint32_t >( m_Bodies.GetSize() - 1 ) );
+    EXPECT_GE( rStats.m_IslandCount, 1u );
+    EXPECT_GE( rStats.m_TotalMilliseconds, rStats.m_CollisionDetectionMilliseconds );
+
+    // A long frame is capped at the configured number of substeps
+    m_World.Simulate( 1.0f );
+    EXPECT_EQ( m_World.GetStepStats().m_SubStepCount, 10u );
+}
+
+#endif
@@ -0,0 +1,645 @@
+#include "TestAppPch.h"
+
+#if GTEST
+
+#include "Engine/AssetLoader.h"
+#include "Engine/CachePackageLoader.h"
+
+#if HELIUM_OS_WIN
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace Helium;
+
+namespace
+{
+    const uint32_t BENCHMARK_ENTRY_COUNT = 512;
+    const uint32_t BENCHMARK_ENTRY_SIZE = 128 * 1024;
+
+    class CacheReadBenchmark : public testing::Test
+    {
+    public:
+        void SetUp()
+        {
+            FilePath userDataDirectory;
+            HELIUM_VERIFY( FileLocations::GetUserDataDirectory( userDataDirectory ) );
+            m_Directory.Set( userDataDirectory + TXT( "CacheReadBenchmark/" ) );
+            HELIUM_VERIFY( m_Directory.MakePath() );
+
+            m_TocFile.Set( m_Directory + TXT( "Benchmark." ) HELIUM_CACHE_TOC_EXTENSION );
+            m_CacheFile.Set( m_Directory + TXT( "Benchmark." ) HELIUM_CACHE_EXTENSION );
+            m_TocFile.Delete();
+            m_CacheFile.Delete();
+
+            Cache writer;
+            ASSERT_TRUE( writer.Initialize( Name( TXT( "Benchmark" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+            writer.EnforceTocLoad();
+
+            DynamicArray< uint8_t > contents;
+            contents.Resize( BENCHMARK_ENTRY_SIZE );
+
+            m_Path.Set( TXT( "/CacheReadBenchmark:Entry" ) );
+            for ( uint32_t entryIndex = 0; entryIndex < BENCHMARK_ENTRY_COUNT; ++entryIndex )
+            {
+                for ( uint32_t byteIndex = 0; byteIndex < BENCHMARK_ENTRY_SIZE; ++byteIndex )
+                {
+                    contents[ byteIndex ] = static_cast< uint8_t >( byteIndex * 31 + entryIndex );
+                }
+
+                ASSERT_TRUE( writer.CacheEntry( m_Path, entryIndex, contents.GetData(), 0, BENCHMARK_ENTRY_SIZE ) );
+            }
+        }
+
+        void TearDown()
+        {
+            // Wait for the loader workers to close their streams on the files, then remove everything in the cache
+            // directory and the directory itself
+            AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+            rLoader.Lock();
+            for ( DirectoryIterator iterator( m_Directory ); !iterator.IsDone(); iterator.Next() )
+            {
+                iterator.GetItem().m_Path.Delete();
+            }
+
+#if HELIUM_OS_WIN
+            _rmdir( m_Directory.c_str() );
+#else
+            rmdir( m_Directory.c_str() );
+#endif
+            rLoader.Unlock();
+
+            EXPECT_FALSE( m_Directory.Exists() );
+        }
+
+        uint64_t Checksum( const uint8_t* pData, size_t size )
+        {
+            uint64_t checksum = 0;
+            for ( size_t byteIndex = 0; byteIndex < size; ++byteIndex )
+            {
+                checksum = checksum * 33 + pData[ byteIndex ];
+            }
+
+            return checksum;
+        }
+
+        void ReadEntry( Cache &rCache, uint32_t entryIndex, DynamicArray< uint8_t > &rContents )
+        {
+            const Cache::Entry* pEntry = rCache.FindEntry( m_Path, entryIndex );
+            ASSERT_TRUE( pEntry != NULL );
+
+            rContents.Resize( pEntry->size );
+            FileStream* pStream = FileStream::OpenFileStream( rCache.GetCacheFileName(), FileStream::MODE_READ );
+            ASSERT_TRUE( pStream != NULL );
+            EXPECT_EQ( static_cast< int64_t >( pEntry->offset ), pStream->Seek( pEntry->offset, SeekOrigins::Begin ) );
+            EXPECT_EQ( static_cast< size_t >( pEntry->size ), pStream->Read( rContents.GetData(), 1, pEntry->size ) );
+            delete pStream;
+        }
+
+        AssetPath m_Path;
+        FilePath m_Directory;
+        FilePath m_TocFile;
+        FilePath m_CacheFile;
+    };
+}
+
+TEST_F(CacheReadBenchmark, AsyncVersusMapped)
+{
+    Cache asyncCache;
+    ASSERT_TRUE( asyncCache.Initialize(
+        Name( TXT( "BenchmarkAsync" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str(), Cache::READ_MODE_ASYNC ) );
+    asyncCache.EnforceTocLoad();
+    ASSERT_EQ( BENCHMARK_ENTRY_COUNT, asyncCache.GetEntryCount() );
+
+    Cache mappedCache;
+    ASSERT_TRUE( mappedCache.Initialize(
+        Name( TXT( "BenchmarkMapped" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str(), Cache::READ_MODE_MAPPED ) );
+    if ( mappedCache.GetReadMode() != Cache::READ_MODE_MAPPED )
+    {
+        HELIUM_TRACE( TraceLevels::Info, TXT( "Cache read: memory-mapped reads unsupported on this platform, skipping\n" ) );
+        return;
+    }
+
+    mappedCache.EnforceTocLoad();
+    ASSERT_EQ( BENCHMARK_ENTRY_COUNT, mappedCache.GetEntryCount() );
+
+    // Heap buffer per entry filled by the AsyncLoader, the way CachePackageLoader reads in READ_MODE_ASYNC
+    AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+    DefaultAllocator allocator;
+
+    DynamicArray< uint8_t* > buffers;
+    DynamicArray< size_t > requestIds;
+    buffers.Resize( BENCHMARK_ENTRY_COUNT );
+    requestIds.Resize( BENCHMARK_ENTRY_COUNT );
+
+    uint64_t asyncChecksum = 0;
+    uint64_t startTicks = Timer::GetTickCount();
+    for ( uint32_t entryIndex = 0; entryIndex < BENCHMARK_ENTRY_COUNT; ++entryIndex )
+    {
+        const Cache::Entry* pEntry = asyncCache.FindEntry( m_Path, entryIndex );
+        ASSERT_TRUE( pEntry != NULL );
+
+        buffers[ entryIndex ] = static_cast< uint8_t* >( allocator.Allocate( pEntry->size ) );
+        requestIds[ entryIndex ] = rLoader.QueueRequest( buffers[ entryIndex ], asyncCache.GetCacheFileName(), pEntry->offset, pEntry->size );
+    }
+
+    for ( uint32_t entryIndex = 0; entryIndex < BENCHMARK_ENTRY_COUNT; ++entryIndex )
+    {
+        EXPECT_EQ( static_cast< size_t >( BENCHMARK_ENTRY_SIZE ), rLoader.SyncRequest( requestIds[ entryIndex ] ) );
+        asyncChecksum += Checksum( buffers[ entryIndex ], BENCHMARK_ENTRY_SIZE );
+        allocator.Free( buffers[ entryIndex ] );
+    }
+    float32_t asyncMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    // Pointers into the mapped cache file, prefetched up front and consumed in place
+    DynamicArray< const uint8_t* > mappedData;
+    mappedData.Resize( BENCHMARK_ENTRY_COUNT );
+
+    uint64_t mappedChecksum = 0;
+    startTicks = Timer::GetTickCount();
+    for ( uint32_t entryIndex = 0; entryIndex < BENCHMARK_ENTRY_COUNT; ++entryIndex )
+    {
+        const Cache::Entry* pEntry = mappedCache.FindEntry( m_Path, entryIndex );
+        ASSERT_TRUE( pEntry != NULL );
+
+        mappedData[ entryIndex ] = mappedCache.GetMappedEntryData( *pEntry );
+        ASSERT_TRUE( mappedData[ entryIndex ] != NULL );
+    }
+
+    for ( uint32_t entryIndex = 0; entryIndex < BENCHMARK_ENTRY_COUNT; ++entryIndex )
+    {
+        mappedChecksum += Checksum( mappedData[ entryIndex ], BENCHMARK_ENTRY_SIZE );
+    }
+    float32_t mappedMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    EXPECT_EQ( asyncChecksum, mappedChecksum );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "Cache read: %" ) PRIu32 TXT( " entries of %" ) PRIu32 TXT( " bytes, async %.3f ms, mapped %.3f ms\n" ),
+        BENCHMARK_ENTRY_COUNT,
+        BENCHMARK_ENTRY_SIZE,
+        asyncMilliseconds,
+        mappedMilliseconds );
+
+    asyncCache.Shutdown();
+    mappedCache.Shutdown();
+}
+
+TEST_F(CacheReadBenchmark, JournaledTocCompaction)
+{
+    const uint32_t updatedEntryCount = 64;
+
+    Cache cache;
+    ASSERT_TRUE( cache.Initialize( Name( TXT( "Journal" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+    cache.EnforceTocLoad();
+    ASSERT_EQ( BENCHMARK_ENTRY_COUNT, cache.GetEntryCount() );
+
+    // Entries added after the TOC was first written were journaled rather than rewriting the TOC each time
+    Cache::Stats stats;
+    cache.GetStats( stats );
+    EXPECT_EQ( BENCHMARK_ENTRY_COUNT - 1, stats.journalRecordCount );
+    EXPECT_EQ( 0u, stats.orphanedBytes );
+
+    // Grow some entries so their data moves to the end of the cache file
+    DynamicArray< uint8_t > contents;
+    contents.Resize( BENCHMARK_ENTRY_SIZE * 2 );
+    for ( uint32_t entryIndex = 0; entryIndex < updatedEntryCount; ++entryIndex )
+    {
+        MemorySet( contents.GetData(), static_cast< int >( 0x80 + entryIndex ), contents.GetSize() );
+        ASSERT_TRUE( cache.CacheEntry( m_Path, entryIndex, contents.GetData(), 1, static_cast< uint32_t >( contents.GetSize() ) ) );
+    }
+
+    // Data that would fit in its previous slot is still appended, so the previous data stays intact until the update
+    // is journaled
+    cache.GetStats( stats );
+    uint64_t cacheFileSize = stats.cacheFileSize;
+
+    MemorySet( contents.GetData(), 0x7f, BENCHMARK_ENTRY_SIZE );
+    ASSERT_TRUE( cache.CacheEntry( m_Path, updatedEntryCount, contents.GetData(), 1, BENCHMARK_ENTRY_SIZE ) );
+
+    cache.GetStats( stats );
+    EXPECT_EQ( cacheFileSize + BENCHMARK_ENTRY_SIZE, stats.cacheFileSize );
+    EXPECT_EQ( static_cast< uint64_t >( updatedEntryCount + 1 ) * BENCHMARK_ENTRY_SIZE, stats.orphanedBytes );
+    EXPECT_EQ( BENCHMARK_ENTRY_COUNT + updatedEntryCount, stats.journalRecordCount );
+
+    // Journal records replayed on load supersede the original records
+    {
+        Cache reloaded;
+        ASSERT_TRUE( reloaded.Initialize( Name( TXT( "JournalReload" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+        reloaded.EnforceTocLoad();
+        ASSERT_EQ( BENCHMARK_ENTRY_COUNT, reloaded.GetEntryCount() );
+
+        DynamicArray< uint8_t > entryContents;
+        ReadEntry( reloaded, 0, entryContents );
+        ASSERT_EQ( BENCHMARK_ENTRY_SIZE * 2, entryContents.GetSize() );
+        EXPECT_EQ( 0x80, entryContents[ 0 ] );
+
+        reloaded.Shutdown();
+    }
+
+    uint64_t startTicks = Timer::GetTickCount();
+    ASSERT_TRUE( cache.Compact() );
+    float32_t compactMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    cache.GetStats( stats );
+    EXPECT_EQ( 0u, stats.orphanedBytes );
+    EXPECT_EQ( 0u, stats.journalRecordCount );
+    EXPECT_EQ( stats.liveBytes, stats.cacheFileSize );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "Cache compaction: %" ) PRIu32 TXT( " entries, %" ) PRIu64 TXT( " live bytes in %.3f ms\n" ),
+        stats.entryCount,
+        stats.liveBytes,
+        compactMilliseconds );
+
+    // The compacted files load back with all data intact
+    Cache compacted;
+    ASSERT_TRUE( compacted.Initialize( Name( TXT( "JournalCompacted" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+    compacted.EnforceTocLoad();
+    ASSERT_EQ( BENCHMARK_ENTRY_COUNT, compacted.GetEntryCount() );
+
+    DynamicArray< uint8_t > entryContents;
+    for ( uint32_t entryIndex = 0; entryIndex < BENCHMARK_ENTRY_COUNT; ++entryIndex )
+    {
+        ReadEntry( compacted, entryIndex, entryContents );
+        if ( entryIndex < updatedEntryCount )
+        {
+            ASSERT_EQ( BENCHMARK_ENTRY_SIZE * 2, entryContents.GetSize() );
+            EXPECT_EQ( static_cast< uint8_t >( 0x80 + entryIndex ), entryContents[ BENCHMARK_ENTRY_SIZE ] );
+        }
+        else
+        {
+            ASSERT_EQ( BENCHMARK_ENTRY_SIZE, entryContents.GetSize() );
+            EXPECT_EQ( static_cast< uint8_t >( 31 + entryIndex ), entryContents[ 1 ] );
+        }
+    }
+
+    compacted.Shutdown();
+    cache.Shutdown();
+}
+
+TEST_F(CacheReadBenchmark, BatchedWrites)
+{
+    const uint32_t batchedEntryCount = 64;
+
+    Cache cache;
+    ASSERT_TRUE( cache.Initialize( Name( TXT( "Batch" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+    cache.EnforceTocLoad();
+
+    Cache::Stats stats;
+    cache.GetStats( stats );
+    uint64_t originalCacheFileSize = stats.cacheFileSize;
+
+    // Batched updates and additions only touch the files once the batch ends
+    cache.BeginBatchWrites();
+    EXPECT_TRUE( cache.IsBatchingWrites() );
+
+    DynamicArray< uint8_t > contents;
+    contents.Resize( BENCHMARK_ENTRY_SIZE );
+    uint64_t startTicks = Timer::GetTickCount();
+    for ( uint32_t entryIndex = 0; entryIndex < batchedEntryCount; ++entryIndex )
+    {
+        MemorySet( contents.GetData(), static_cast< int >( 0x40 + entryIndex ), contents.GetSize() );
+        ASSERT_TRUE( cache.CacheEntry( m_Path, entryIndex * 2, contents.GetData(), 1, BENCHMARK_ENTRY_SIZE ) );
+        ASSERT_TRUE( cache.CacheEntry( m_Path, BENCHMARK_ENTRY_COUNT + entryIndex, contents.GetData(), 1, BENCHMARK_ENTRY_SIZE ) );
+    }
+
+    cache.GetStats( stats );
+    EXPECT_EQ( originalCacheFileSize, stats.cacheFileSize );
+
+    ASSERT_TRUE( cache.EndBatchWrites() );
+    float32_t batchMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+    EXPECT_FALSE( cache.IsBatchingWrites() );
+
+    // The batch ends with a full TOC write rather than one journal record per entry
+    cache.GetStats( stats );
+    EXPECT_EQ( 0u, stats.journalRecordCount );
+    EXPECT_EQ( BENCHMARK_ENTRY_COUNT + batchedEntryCount, stats.entryCount );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "Cache batched writes: %" ) PRIu32 TXT( " entries in %.3f ms\n" ),
+        batchedEntryCount * 2,
+        batchMilliseconds );
+
+    Cache reloaded;
+    ASSERT_TRUE( reloaded.Initialize( Name( TXT( "BatchReload" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+    reloaded.EnforceTocLoad();
+    ASSERT_EQ( BENCHMARK_ENTRY_COUNT + batchedEntryCount, reloaded.GetEntryCount() );
+
+    DynamicArray< uint8_t > entryContents;
+    for ( uint32_t entryIndex = 0; entryIndex < batchedEntryCount; ++entryIndex )
+    {
+        ReadEntry( reloaded, entryIndex * 2, entryContents );
+        EXPECT_EQ( static_cast< uint8_t >( 0x40 + entryIndex ), entryContents[ 0 ] );
+        ReadEntry( reloaded, BENCHMARK_ENTRY_COUNT + entryIndex, entryContents );
+        EXPECT_EQ( static_cast< uint8_t >( 0x40 + entryIndex ), entryContents[ BENCHMARK_ENTRY_SIZE - 1 ] );
+    }
+
+    // Entries left out of the batch are untouched
+    ReadEntry( reloaded, 1, entryContents );
+    EXPECT_EQ( static_cast< uint8_t >( 31 + 1 ), entryContents[ 1 ] );
+
+    reloaded.Shutdown();
+    cache.Shutdown();
+}
+
+TEST_F(CacheReadBenchmark, IndexedTocOpen)
+{
+    const uint32_t smallEntryCount = 20000;
+
+    // Many small entries with distinct paths, folded into a single indexed TOC
+    {
+        Cache writer;
+        ASSERT_TRUE( writer.Initialize( Name( TXT( "IndexedWriter" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+        writer.EnforceTocLoad();
+
+        char pathString[ 64 ];
+        AssetPath path;
+        for ( uint32_t entryIndex = 0; entryIndex < smallEntryCount; ++entryIndex )
+        {
+            StringPrint( pathString, TXT( "/CacheReadBenchmark:Small%" ) PRIu32, entryIndex );
+            ASSERT_TRUE( path.Set( pathString ) );
+            ASSERT_TRUE( writer.CacheEntry( path, 0, &entryIndex, 0, sizeof( entryIndex ) ) );
+        }
+
+        ASSERT_TRUE( writer.Compact() );
+        writer.Shutdown();
+    }
+
+    static const char* readModeNames[ Cache::READ_MODE_MAX ] = { TXT( "async" ), TXT( "mapped" ) };
+    for ( size_t readModeIndex = 0; readModeIndex < Cache::READ_MODE_MAX; ++readModeIndex )
+    {
+        Cache cache;
+        uint64_t startTicks = Timer::GetTickCount();
+        ASSERT_TRUE( cache.Initialize(
+            Name( TXT( "Indexed" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str(),
+            static_cast< Cache::EReadMode >( readModeIndex ) ) );
+        cache.EnforceTocLoad();
+        float32_t openMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+        ASSERT_EQ( BENCHMARK_ENTRY_COUNT + smallEntryCount, cache.GetEntryCount() );
+
+        char pathString[ 64 ];
+        AssetPath path;
+        startTicks = Timer::GetTickCount();
+        for ( uint32_t entryIndex = 0; entryIndex < smallEntryCount; entryIndex += 7 )
+        {
+            StringPrint( pathString, TXT( "/CacheReadBenchmark:Small%" ) PRIu32, entryIndex );
+            ASSERT_TRUE( path.Set( pathString ) );
+
+            const Cache::Entry* pEntry = cache.FindEntry( path, 0 );
+            ASSERT_TRUE( pEntry != NULL );
+            EXPECT_EQ( path, pEntry->path );
+            EXPECT_EQ( sizeof( entryIndex ), pEntry->size );
+            EXPECT_TRUE( cache.FindEntry( path, 1 ) == NULL );
+        }
+        float32_t lookupMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+        const Cache::Entry& rFirstEntry = cache.GetEntry( 0 );
+        EXPECT_TRUE( cache.FindEntry( rFirstEntry.path, rFirstEntry.subDataIndex ) == &rFirstEntry );
+
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            TXT( "Cache TOC (%s): opened %" ) PRIu32 TXT( " entries in %.3f ms, %" ) PRIu32 TXT( " lookups in %.3f ms\n" ),
+            readModeNames[ readModeIndex ],
+            cache.GetEntryCount(),
+            openMilliseconds,
+            ( smallEntryCount + 6 ) / 7,
+            lookupMilliseconds );
+
+        cache.Shutdown();
+    }
+}
+
+TEST_F(CacheReadBenchmark, CompressedEntryCodecs)
+{
+    const uint32_t codecEntryCount = 128;
+
+    // Cooked-like payloads: smoothly varying values with low-order noise, similar to texture and vertex data
+    DynamicArray< DynamicArray< uint8_t > > payloads;
+    payloads.Resize( codecEntryCount );
+
+    uint32_t noise = 12345;
+    uint64_t expectedChecksum = 0;
+    for ( uint32_t entryIndex = 0; entryIndex < codecEntryCount; ++entryIndex )
+    {
+        DynamicArray< uint8_t > &rPayload = payloads[ entryIndex ];
+        rPayload.Resize( BENCHMARK_ENTRY_SIZE );
+        for ( uint32_t byteIndex = 0; byteIndex < BENCHMARK_ENTRY_SIZE; ++byteIndex )
+        {
+            noise = noise * 1103515245 + 12345;
+            rPayload[ byteIndex ] = static_cast< uint8_t >( ( ( byteIndex / 64 + entryIndex ) & 0xf0 ) | ( ( noise >> 16 ) & 0x3 ) );
+        }
+
+        expectedChecksum += Checksum( rPayload.GetData(), BENCHMARK_ENTRY_SIZE );
+    }
+
+    AsyncLoader &rLoader = AsyncLoader::GetStaticInstance();
+    DefaultAllocator allocator;
+
+    DynamicArray< uint8_t* > buffers;
+    DynamicArray< size_t > requestIds;
+    buffers.Resize( codecEntryCount );
+    requestIds.Resize( codecEntryCount );
+
+    for ( size_t codecIndex = 0; codecIndex < Compression::CODEC_MAX; ++codecIndex )
+    {
+        Compression::ECodec codec = static_cast< Compression::ECodec >( codecIndex );
+
+        m_TocFile.Delete();
+        m_CacheFile.Delete();
+
+        Cache writer;
+        ASSERT_TRUE( writer.Initialize( Name( TXT( "CodecWriter" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+        writer.EnforceTocLoad();
+
+        uint64_t startTicks = Timer::GetTickCount();
+        for ( uint32_t entryIndex = 0; entryIndex < codecEntryCount; ++entryIndex )
+        {
+            ASSERT_TRUE( writer.CacheEntry( m_Path, entryIndex, payloads[ entryIndex ].GetData(), 0, BENCHMARK_ENTRY_SIZE, codec ) );
+        }
+        float32_t writeMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+        Cache::Stats stats;
+        writer.GetStats( stats );
+        writer.Shutdown();
+
+        Cache reader;
+        ASSERT_TRUE( reader.Initialize( Name( TXT( "CodecReader" ) ), Cache::PLATFORM_PC, m_TocFile.c_str(), m_CacheFile.c_str() ) );
+        reader.EnforceTocLoad();
+        ASSERT_EQ( codecEntryCount, reader.GetEntryCount() );
+
+        // Entries decompress on the loader threads straight into the destination buffers
+        startTicks = Timer::GetTickCount();
+        for ( uint32_t entryIndex = 0; entryIndex < codecEntryCount; ++entryIndex )
+        {
+            const Cache::Entry* pEntry = reader.FindEntry( m_Path, entryIndex );
+            ASSERT_TRUE( pEntry != NULL );
+            ASSERT_EQ( BENCHMARK_ENTRY_SIZE, pEntry->size );
+            EXPECT_EQ( codec, pEntry->codec );
+
+            buffers[ entryIndex ] = static_cast< uint8_t* >( allocator.Allocate( pEntry->size ) );
+            requestIds[ entryIndex ] = reader.BeginReadEntry( *pEntry, buffers[ entryIndex ] );
+            ASSERT_TRUE( IsValid( requestIds[ entryIndex ] ) );
+        }
+
+        uint64_t checksum = 0;
+        for ( uint32_t entryIndex = 0; entryIndex < codecEntryCount; ++entryIndex )
+        {
+            EXPECT_EQ( static_cast< size_t >( BENCHMARK_ENTRY_SIZE ), rLoader.SyncRequest( requestIds[ entryIndex ] ) );
+            checksum += Checksum( buffers[ entryIndex ], BENCHMARK_ENTRY_SIZE );
+            allocator.Free( buffers[ entryIndex ] );
+        }
+        float32_t readMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+        EXPECT_EQ( expectedChecksum, checksum );
+
+        // Partial reads only decompress the leading part of the entry
+        const Cache::Entry* pEntry = reader.FindEntry( m_Path, 1 );
+        ASSERT_TRUE( pEntry != NULL );
+        uint8_t partial[ 100 ];
+        EXPECT_EQ( sizeof( partial ), reader.ReadEntry( *pEntry, partial, sizeof( partial ) ) );
+        EXPECT_EQ( 0, MemoryCompare( partial, payloads[ 1 ].GetData(), sizeof( partial ) ) );
+
+        reader.Shutdown();
+
+        float32_t rawMegabytes = static_cast< float32_t >( codecEntryCount ) * BENCHMARK_ENTRY_SIZE / ( 1024.0f * 1024.0f );
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            ( TXT( "Cache codec %s: %" ) PRIu64 TXT( " bytes stored for %" ) PRIu64 TXT( " (ratio %.2f), " )
+            TXT( "write %.1f MB/s, read %.1f MB/s\n" ) ),
+            Compression::GetCodecName( codec ),
+            stats.liveBytes,
+            static_cast< uint64_t >( codecEntryCount ) * BENCHMARK_ENTRY_SIZE,
+            static_cast< float32_t >( codecEntryCount ) * BENCHMARK_ENTRY_SIZE / static_cast< float32_t >( stats.liveBytes ),
+            rawMegabytes * 1000.0f / Max( writeMilliseconds, 0.001f ),
+            rawMegabytes * 1000.0f / Max( readMilliseconds, 0.001f ) );
+
+        if ( codec != Compression::CODEC_NONE )
+        {
+            EXPECT_LT( stats.liveBytes, static_cast< uint64_t >( codecEntryCount ) * BENCHMARK_ENTRY_SIZE );
+        }
+    }
+}
+
+namespace
+{
+    // Load every object in the asset cache through a fresh loader, returning false if there is no asset cache.
+    // Object references are not followed, so only the objects in the cache itself are loaded.
+    bool LoadAllCachedAssets(
+        bool bParallel, size_t &rLoadedCount, size_t &rBrokenCount, float32_t &rLoadMilliseconds,
+        float32_t &rDeserializeMilliseconds )
+    {
+        CachePackageLoader loader;
+        if ( !loader.Initialize( Name( HELIUM_ASSET_CACHE_NAME ) ) || !loader.BeginPreload() )
+        {
+            return false;
+        }
+
+        while ( !loader.TryFinishPreload() )
+        {
+            Thread::Yield();
+        }
+
+        loader.SetParallelDeserialization( bParallel );
+
+        uint64_t startTicks = Timer::GetTickCount();
+
+        DynamicArray< size_t > requestIds;
+        size_t objectCount = loader.GetObjectCount();
+        for ( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+        {
+            AssetPath path = loader.GetAssetPath( objectIndex );
+            if ( path.IsPackage() )
+            {
+                continue;
+            }
+
+            size_t requestId = loader.BeginLoadObject( path, NULL );
+            if ( IsValid( requestId ) )
+            {
+                requestIds.Push( requestId );
+            }
+        }
+
+        rLoadedCount = 0;
+        rBrokenCount = 0;
+        while ( !requestIds.IsEmpty() )
+        {
+            loader.Tick();
+            AssetLoader::GetStaticInstance()->Tick();
+
+            size_t requestIndex = requestIds.GetSize();
+            while ( requestIndex != 0 )
+            {
+                --requestIndex;
+
+                AssetPtr spObject;
+                if ( loader.TryFinishLoadObject( requestIds[ requestIndex ], spObject ) )
+                {
+                    ++rLoadedCount;
+                    if ( !spObject || spObject->GetAnyFlagSet( Asset::FLAG_BROKEN ) )
+                    {
+                        ++rBrokenCount;
+                    }
+
+                    requestIds.Remove( requestIndex );
+                }
+            }
+        }
+
+        uint64_t loadTicks = Timer::GetTickCount() - startTicks;
+        rLoadMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( loadTicks ) );
+        rDeserializeMilliseconds =
+            static_cast< float32_t >( Timer::TicksToMilliseconds( loader.GetDeserializeTicks() ) );
+
+        loader.Shutdown();
+
+        return true;
+    }
+}
+
+// Headless "load every asset in the cache" pass, deserializing the same objects first one at a time on this thread and
+// then in parallel on the job pool.  Run TestApp with different job pool worker counts to compare how load time scales
+// with core count.
+TEST(Engine, CacheLoadAllAssets)
+{
+    size_t serialLoadedCount = 0;
+    size_t serialBrokenCount = 0;
+    float32_t serialLoadMilliseconds = 0.0f;
+    float32_t serialDeserializeMilliseconds = 0.0f;
+    if ( !LoadAllCachedAssets(
+        false, serialLoadedCount, serialBrokenCount, serialLoadMilliseconds, serialDeserializeMilliseconds ) )
+    {
+        HELIUM_TRACE( TraceLevels::Info, TXT( "Cache load: no asset cache available, skipping\n" ) );
+        return;
+    }
+
+    size_t parallelLoadedCount = 0;
+    size_t parallelBrokenCount = 0;
+    float32_t parallelLoadMilliseconds = 0.0f;
+    float32_t parallelDeserializeMilliseconds = 0.0f;
+    ASSERT_TRUE( LoadAllCachedAssets(
+        true, parallelLoadedCount, parallelBrokenCount, parallelLoadMilliseconds, parallelDeserializeMilliseconds ) );
+
+    EXPECT_EQ( 0u, serialBrokenCount );
+    EXPECT_EQ( 0u, parallelBrokenCount );
+    EXPECT_EQ( serialLoadedCount, parallelLoadedCount );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        ( TXT( "Cache load: %" ) PRIuSZ TXT( " objects; serial %.3f ms (%.3f ms deserializing), parallel %.3f ms " )
+        TXT( "(%.3f ms deserializing) with %" ) PRIu32 TXT( " deserialization threads\n" ) ),
+        parallelLoadedCount,
+        serialLoadMilliseconds,
+        serialDeserializeMilliseconds,
+        parallelLoadMilliseconds,
+        parallelDeserializeMilliseconds,
+        JobPool::GetStaticInstance().GetConcurrency() );
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include "TestAppPch.h"
+
+#if GTEST && HELIUM_TOOLS
+
+#include "Engine/JobPool.h"
+#include "PcSupport/LoosePackageLoader.h"
+
+#if HELIUM_OS_WIN
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace Helium;
+
+namespace
+{
+    const size_t BENCHMARK_OBJECT_COUNT = 20000;
+
+    class LoosePackageBenchmark : public testing::Test
+    {
+    public:
+        void SetUp()
+        {
+            FilePath dataDirectory;
+            HELIUM_VERIFY( FileLocations::GetDataDirectory( dataDirectory ) );
+            m_Directory.Set( dataDirectory + TXT( "LoosePackageBenchmark/" ) );
+            HELIUM_VERIFY( m_Directory.MakePath() );
+
+            const char contents[] = TXT( "[ { \"TestAsset1\": { \"m_TestValue1\": 1.0, \"m_TestValue2\": 2.0 } } ]\n" );
+
+            for ( size_t objectIndex = 0; objectIndex < BENCHMARK_OBJECT_COUNT; ++objectIndex )
+            {
+                char fileName[ 32 ];
+                StringPrint( fileName, TXT( "Object%05" ) PRIuSZ TXT( ".json" ), objectIndex );
+                FilePath filePath( m_Directory + fileName );
+
+                FileStream* pStream = FileStream::OpenFileStream( filePath, FileStream::MODE_WRITE, true );
+                ASSERT_TRUE( pStream != NULL );
+                EXPECT_EQ( sizeof( contents ) - 1, pStream->Write( contents, 1, sizeof( contents ) - 1 ) );
+                delete pStream;
+            }
+        }
+
+        void TearDown()
+        {
+            // Remove everything in the package directory, including anything written while loading, then the
+            // directory itself
+            for ( DirectoryIterator iterator( m_Directory ); !iterator.IsDone(); iterator.Next() )
+            {
+                iterator.GetItem().m_Path.Delete();
+            }
+
+#if HELIUM_OS_WIN
+            _rmdir( m_Directory.c_str() );
+#else
+            rmdir( m_Directory.c_str() );
+#endif
+            EXPECT_FALSE( m_Directory.Exists() );
+        }
+
+        FilePath m_Directory;
+    };
+}
+
+// Preload a synthetic package with tens of thousands of loose objects, then look each of them up by path the way
+// BeginLoadObject() and dependency resolution do.
+TEST_F(LoosePackageBenchmark, PreloadAndLookup)
+{
+    AssetPath packagePath;
+    ASSERT_TRUE( packagePath.Set( TXT( "/LoosePackageBenchmark" ) ) );
+
+    LoosePackageLoader loader;
+    ASSERT_TRUE( loader.Initialize( packagePath ) );
+
+    uint64_t startTicks = Timer::GetTickCount();
+    ASSERT_TRUE( loader.BeginPreload() );
+    while ( !loader.TryFinishPreload() )
+    {
+        loader.Tick();
+        Thread::Yield();
+    }
+    float32_t preloadMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    size_t objectCount = loader.GetObjectCount();
+    ASSERT_EQ( BENCHMARK_OBJECT_COUNT, objectCount );
+
+    // Objects are added in file path order, regardless of the order in which their reads and parses complete
+    size_t misorderedCount = 0;
+    for ( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        char objectName[ 32 ];
+        StringPrint( objectName, TXT( "Object%05" ) PRIuSZ, objectIndex );
+        if ( loader.GetAssetPath( objectIndex ).GetName() != Name( objectName ) )
+        {
+            ++misorderedCount;
+        }
+    }
+
+    EXPECT_EQ( 0, misorderedCount );
+
+    size_t mismatchCount = 0;
+    startTicks = Timer::GetTickCount();
+    for ( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        AssetPath path = loader.GetAssetPath( objectIndex );
+        const FilePath& rFilePath = loader.GetAssetFileSystemPath( path );
+        if ( rFilePath.Basename() != *path.GetName() )
+        {
+            ++mismatchCount;
+        }
+    }
+    float32_t lookupMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    EXPECT_EQ( 0, mismatchCount );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "Loose package: %" ) PRIuSZ TXT( " objects, preload %.3f ms (%" ) PRIu32 TXT( " jobs), lookups %.3f ms\n" ),
+        objectCount,
+        preloadMilliseconds,
+        JobPool::GetStaticInstance().GetConcurrency(),
+        lookupMilliseconds );
+
+    loader.Shutdown();
+}
+
+#endif
@@ -3,6 +3,26 @@
 
 #if GTEST
 
+#include "Platform/File.h"
+#include "Engine/AssetLoadTelemetry.h"
+#include "Engine/ResourceResidencyManager.h"
+#include "Graphics/TextureStreamingManager.h"
+#include "PcSupport/ContentHash.h"
+#include "PcSupport/CookReport.h"
+#include "PcSupport/DirectoryWatcher.h"
+#include "PcSupport/SharedPreprocessCache.h"
+
+#include <cstring>
+#include <time.h>
+
+#if HELIUM_OS_WIN
+#include <direct.h>
+#include <sys/utime.h>
+#else
+#include <unistd.h>
+#include <utime.h>
+#endif
+
 using namespace Helium;
 
 TEST(Foundation, FilePath)
@@ -66,6 +86,401 @@ TEST(Platform, ThreadStartAndJoin)
     delete pRunnable;
 }
 
+static void JobPoolTestFunction( void* pData, size_t itemIndex )
+{
+    volatile int32_t* pCounts = static_cast< volatile int32_t* >( pData );
+    AtomicIncrementRelease( pCounts[ itemIndex ] );
+}
+
+TEST(Engine, JobPoolRun)
+{
+    JobPool& rJobPool = JobPool::GetStaticInstance();
+    EXPECT_GE( rJobPool.GetConcurrency(), 1u );
+
+    // Run several submissions back to back to make sure the pool state is reusable
+    for( size_t submission = 0; submission < 16; ++submission )
+    {
+        DynamicArray< int32_t > counts;
+        counts.Resize( 1000 + submission );
+        MemoryZero( counts.GetData(), counts.GetSize() * sizeof( int32_t ) );
+
+        rJobPool.Run( &JobPoolTestFunction, counts.GetData(), counts.GetSize() );
+
+        for( size_t itemIndex = 0; itemIndex < counts.GetSize(); ++itemIndex )
+        {
+            EXPECT_EQ( counts[ itemIndex ], 1 );
+        }
+    }
+}
+
+TEST(PcSupport, ContentHash)
+{
+    DynamicArray< uint8_t > data;
+    data.Resize( 1000 );
+    for( size_t byteIndex = 0; byteIndex < data.GetSize(); ++byteIndex )
+    {
+        data[ byteIndex ] = static_cast< uint8_t >( byteIndex * 7 );
+    }
+
+    ContentHash wholeHash;
+    wholeHash.Update( data.GetData(), data.GetSize() );
+
+    // The hash only depends on the bytes hashed, not on how they are split across updates
+    for( size_t split = 0; split < 20; ++split )
+    {
+        ContentHash splitHash;
+        splitHash.Update( data.GetData(), split );
+        splitHash.Update( data.GetData() + split, 3 );
+        splitHash.Update( data.GetData() + split + 3, data.GetSize() - split - 3 );
+        EXPECT_EQ( wholeHash.GetValue(), splitHash.GetValue() );
+    }
+
+    // Trailing zeros change the hash
+    uint8_t zeros[ 2 ] = { 0, 0 };
+    ContentHash oneZero;
+    oneZero.Update( zeros, 1 );
+    ContentHash twoZeros;
+    twoZeros.Update( zeros, 2 );
+    EXPECT_NE( oneZero.GetValue(), twoZeros.GetValue() );
+
+    // Hashing a file matches hashing its contents
+    FilePath userDataDirectory;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( userDataDirectory ) );
+    FilePath filePath( userDataDirectory + TXT( "ContentHashTest.bin" ) );
+
+    FileStream* pStream = FileStream::OpenFileStream( filePath, FileStream::MODE_WRITE, true );
+    ASSERT_TRUE( pStream != NULL );
+    EXPECT_EQ( data.GetSize(), pStream->Write( data.GetData(), 1, data.GetSize() ) );
+    delete pStream;
+
+    ContentHash fileHash;
+    EXPECT_TRUE( fileHash.UpdateFile( filePath ) );
+    EXPECT_EQ( wholeHash.GetValue(), fileHash.GetValue() );
+
+    filePath.Delete();
+}
+
+#if HELIUM_TOOLS
+// Delete a directory written by a test, along with everything in it.
+static void RemoveTestDirectory( const FilePath& rDirectory )
+{
+    DynamicArray< FilePath > subDirectories;
+    for( DirectoryIterator iterator( rDirectory ); !iterator.IsDone(); iterator.Next() )
+    {
+        const FilePath& rPath = iterator.GetItem().m_Path;
+        if( rPath.IsDirectory() )
+        {
+            subDirectories.Push( rPath );
+        }
+        else
+        {
+            rPath.Delete();
+        }
+    }
+
+    for( size_t directoryIndex = 0; directoryIndex < subDirectories.GetSize(); ++directoryIndex )
+    {
+        RemoveTestDirectory( subDirectories[ directoryIndex ] );
+    }
+
+#if HELIUM_OS_WIN
+    _rmdir( rDirectory.c_str() );
+#else
+    rmdir( rDirectory.c_str() );
+#endif
+}
+
+TEST(PcSupport, SharedPreprocessCache)
+{
+    FilePath userDataDirectory;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( userDataDirectory ) );
+    FilePath cacheDirectory( userDataDirectory + TXT( "SharedPreprocessCacheTest" ) );
+
+    const uint64_t sizeLimit = 64 * 1024;
+    SharedPreprocessCache cache;
+    ASSERT_TRUE( cache.Initialize( cacheDirectory, sizeLimit ) );
+
+    Resource::PreprocessedData storedData[ Cache::PLATFORM_MAX ];
+    storedData[ 0 ].bLoaded = true;
+    storedData[ 0 ].persistentDataBuffer.Resize( 100 );
+    storedData[ 0 ].subDataBuffers.Resize( 2 );
+    storedData[ 0 ].subDataBuffers[ 0 ].Resize( 4096 );
+    for( size_t byteIndex = 0; byteIndex < storedData[ 0 ].persistentDataBuffer.GetSize(); ++byteIndex )
+    {
+        storedData[ 0 ].persistentDataBuffer[ byteIndex ] = static_cast< uint8_t >( byteIndex );
+    }
+
+    // Entries round-trip, and missing entries are not found
+    const uint64_t key = 0x0123456789abcdefULL;
+    EXPECT_TRUE( cache.Store( key, storedData ) );
+
+    Resource::PreprocessedData loadedData[ Cache::PLATFORM_MAX ];
+    EXPECT_FALSE( cache.Load( key + 1, loadedData ) );
+    ASSERT_TRUE( cache.Load( key, loadedData ) );
+    for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
+    {
+        EXPECT_EQ( storedData[ platformIndex ].bLoaded, loadedData[ platformIndex ].bLoaded );
+    }
+    EXPECT_TRUE( loadedData[ 0 ].persistentDataBuffer == storedData[ 0 ].persistentDataBuffer );
+    ASSERT_EQ( 2, loadedData[ 0 ].subDataBuffers.GetSize() );
+    EXPECT_EQ( 4096, loadedData[ 0 ].subDataBuffers[ 0 ].GetSize() );
+    EXPECT_EQ( 0, loadedData[ 0 ].subDataBuffers[ 1 ].GetSize() );
+
+    // Storing well past the size limit evicts older entries
+    for( uint64_t entryIndex = 0; entryIndex < 64; ++entryIndex )
+    {
+        EXPECT_TRUE( cache.Store( key + 2 + entryIndex, storedData ) );
+    }
+
+    // Another process's in-flight temporary file survives trimming, while an abandoned one is cleaned up
+    FilePath bucketDirectory;
+    for( DirectoryIterator rootIterator( cache.GetDirectory() ); !rootIterator.IsDone(); rootIterator.Next() )
+    {
+        if( rootIterator.GetItem().m_Path.IsDirectory() )
+        {
+            bucketDirectory = rootIterator.GetItem().m_Path;
+            break;
+        }
+    }
+    ASSERT_FALSE( bucketDirectory.IsEmpty() );
+
+    FilePath activeTempPath( bucketDirectory + TXT( "/active.tmp" ) );
+    FilePath staleTempPath( bucketDirectory + TXT( "/stale.tmp" ) );
+    FilePath foreignPath( bucketDirectory + TXT( "/foreign.txt" ) );
+    FilePath writePaths[] = { activeTempPath, staleTempPath, foreignPath };
+    for( size_t pathIndex = 0; pathIndex < HELIUM_ARRAY_COUNT( writePaths ); ++pathIndex )
+    {
+        FileStream* pStream = FileStream::OpenFileStream( writePaths[ pathIndex ], FileStream::MODE_WRITE, true );
+        ASSERT_TRUE( pStream != NULL );
+        delete pStream;
+    }
+
+    struct utimbuf staleTimes;
+    staleTimes.actime = time( NULL ) - 2 * 60 * 60;
+    staleTimes.modtime = staleTimes.actime;
+    ASSERT_EQ( 0, utime( staleTempPath.c_str(), &staleTimes ) );
+
+    cache.Trim();
+
+    EXPECT_TRUE( activeTempPath.Exists() );
+    EXPECT_FALSE( staleTempPath.Exists() );
+    EXPECT_TRUE( foreignPath.Exists() );
+
+    uint64_t totalSize = 0;
+    size_t entryCount = 0;
+    for( DirectoryIterator rootIterator( cache.GetDirectory() ); !rootIterator.IsDone(); rootIterator.Next() )
+    {
+        for( DirectoryIterator bucketIterator( rootIterator.GetItem().m_Path ); !bucketIterator.IsDone(); bucketIterator.Next() )
+        {
+            if( bucketIterator.GetItem().m_Path.Extension() == TXT( "bin" ) )
+            {
+                totalSize += bucketIterator.GetItem().m_Size;
+                ++entryCount;
+            }
+        }
+    }
+    EXPECT_LE( totalSize, sizeLimit );
+    EXPECT_LT( entryCount, 65 );
+    EXPECT_GT( entryCount, 0 );
+
+    cache.Shutdown();
+    RemoveTestDirectory( cacheDirectory );
+    EXPECT_FALSE( cacheDirectory.Exists() );
+}
+
+static void WriteInputHashTestFile( const FilePath& rPath, const char* pContents, time_t modifiedTime )
+{
+    FileStream* pStream = FileStream::OpenFileStream( rPath, FileStream::MODE_WRITE, true );
+    ASSERT_TRUE( pStream != NULL );
+    size_t length = StringLength( pContents );
+    EXPECT_EQ( length, pStream->Write( pContents, 1, length ) );
+    delete pStream;
+
+    struct utimbuf times;
+    times.actime = modifiedTime;
+    times.modtime = modifiedTime;
+    ASSERT_EQ( 0, utime( rPath.c_str(), &times ) );
+}
+
+TEST(PcSupport, AssetPreprocessorInputHash)
+{
+    AssetPreprocessor* pAssetPreprocessor = AssetPreprocessor::GetStaticInstance();
+    ASSERT_TRUE( pAssetPreprocessor != NULL );
+
+    AssetPath testPath;
+    HELIUM_VERIFY( testPath.Set( HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "EngineTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "TestObject" ) ) );
+
+    AssetPtr spObject;
+    HELIUM_VERIFY( gAssetLoader->LoadObject( testPath, spObject ) );
+    ASSERT_TRUE( spObject );
+
+    FilePath userDataDirectory;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( userDataDirectory ) );
+    FilePath sourceFilePath( userDataDirectory + TXT( "AssetPreprocessorInputHashTest.txt" ) );
+
+    time_t modifiedTime = time( NULL ) - 60 * 60;
+    WriteInputHashTestFile( sourceFilePath, TXT( "source contents" ), modifiedTime );
+
+    uint64_t inputHash = pAssetPreprocessor->ComputeInputHash( testPath, sourceFilePath, NULL );
+    EXPECT_TRUE( pAssetPreprocessor->CacheObject( testPath, spObject, inputHash ) );
+
+    AssetPreprocessor::Stats stats;
+
+    // Touching the source file without changing its contents keeps the cache entry up-to-date
+    WriteInputHashTestFile( sourceFilePath, TXT( "source contents" ), modifiedTime + 10 );
+    EXPECT_EQ( inputHash, pAssetPreprocessor->ComputeInputHash( testPath, sourceFilePath, NULL ) );
+
+    pAssetPreprocessor->ResetStats();
+    EXPECT_TRUE( pAssetPreprocessor->CacheObject( testPath, spObject, inputHash ) );
+    pAssetPreprocessor->GetStats( stats );
+    EXPECT_EQ( 1, stats.objectHits );
+    EXPECT_EQ( 0, stats.objectMisses );
+
+    // Changing its contents, even at the same size, makes the entry out-of-date
+    WriteInputHashTestFile( sourceFilePath, TXT( "source CONTENTS" ), modifiedTime + 20 );
+    uint64_t changedInputHash = pAssetPreprocessor->ComputeInputHash( testPath, sourceFilePath, NULL );
+    EXPECT_NE( inputHash, changedInputHash );
+
+    pAssetPreprocessor->ResetStats();
+    EXPECT_TRUE( pAssetPreprocessor->CacheObject( testPath, spObject, changedInputHash ) );
+    pAssetPreprocessor->GetStats( stats );
+    EXPECT_EQ( 0, stats.objectHits );
+    EXPECT_EQ( 1, stats.objectMisses );
+
+    // Leave the object cached from its real inputs
+    pAssetPreprocessor->ResetStats();
+    EXPECT_TRUE( pAssetPreprocessor->CacheObject(
+        testPath, spObject, pAssetPreprocessor->ComputeInputHash( testPath, FilePath(), NULL ) ) );
+    pAssetPreprocessor->ResetStats();
+
+    sourceFilePath.Delete();
+}
+#endif
+
+TEST(PcSupport, CookReport)
+{
+    CookReport report;
+    report.packageCount = 2;
+    report.assetCount = 5;
+    report.preprocessedCount = 3;
+    report.seconds = 1.5f;
+
+    // A cook without failures succeeds
+    String reportJson;
+    report.BuildJson( reportJson );
+    EXPECT_EQ( CookReport::RESULT_SUCCESS, report.GetResult() );
+    EXPECT_STREQ(
+        TXT( "{\n\t\"success\": true,\n\t\"packages\": 2,\n\t\"assets\": 5,\n\t\"preprocessed\": 3,\n" )
+        TXT( "\t\"seconds\": 1.500,\n\t\"failures\": []\n}\n" ),
+        *reportJson );
+
+    // Any failure fails the cook, and each one is reported with its path and stage
+    report.AddFailure( String( TXT( "DataPC/Cache\\\"Test\".cache" ) ), TXT( "write" ) );
+    report.AddFailure( String( TXT( "/Textures:Broken.png" ) ), TXT( "timeout" ) );
+
+    report.BuildJson( reportJson );
+    EXPECT_EQ( CookReport::RESULT_FAILURE, report.GetResult() );
+    EXPECT_STREQ(
+        TXT( "{\n\t\"success\": false,\n\t\"packages\": 2,\n\t\"assets\": 5,\n\t\"preprocessed\": 3,\n" )
+        TXT( "\t\"seconds\": 1.500,\n\t\"failures\": [\n" )
+        TXT( "\t\t{ \"path\": \"DataPC/Cache\\\\\\\"Test\\\".cache\", \"stage\": \"write\" },\n" )
+        TXT( "\t\t{ \"path\": \"/Textures:Broken.png\", \"stage\": \"timeout\" }\n\t]\n}\n" ),
+        *reportJson );
+}
+
+#if HELIUM_OS_LINUX
+static void WriteDirectoryWatcherTestFile( const FilePath& rPath, size_t writeCount )
+{
+    uint8_t data[ 256 ] = { 0 };
+
+    FileStream* pStream = FileStream::OpenFileStream( rPath, FileStream::MODE_WRITE, true );
+    ASSERT_TRUE( pStream != NULL );
+    for( size_t writeIndex = 0; writeIndex < writeCount; ++writeIndex )
+    {
+        EXPECT_EQ( sizeof( data ), pStream->Write( data, 1, sizeof( data ) ) );
+    }
+    delete pStream;
+}
+
+static void PollDirectoryWatcherTest( DirectoryWatcher& rWatcher, DynamicArray< DirectoryWatcher::Change >& rChanges )
+{
+    // Wait until the changes have settled, giving up after a few seconds
+    rChanges.Resize( 0 );
+    for( size_t pollIndex = 0; pollIndex < 50; ++pollIndex )
+    {
+        EXPECT_TRUE( rWatcher.Poll( 100, rChanges ) );
+        if( !rChanges.IsEmpty() && !rWatcher.HasPendingChanges() )
+        {
+            break;
+        }
+    }
+}
+
+TEST(PcSupport, DirectoryWatcher)
+{
+    FilePath userDataDirectory;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( userDataDirectory ) );
+    FilePath rootDirectory( userDataDirectory + TXT( "DirectoryWatcherTest/" ) );
+    FilePath subDirectory( rootDirectory + TXT( "Sub/" ) );
+    ASSERT_TRUE( subDirectory.MakePath() );
+
+    FilePath firstPath( subDirectory + TXT( "First.txt" ) );
+    FilePath secondPath( subDirectory + TXT( "Second.txt" ) );
+    FilePath newDirectory( rootDirectory + TXT( "New/" ) );
+    FilePath thirdPath( newDirectory + TXT( "Third.txt" ) );
+    firstPath.Delete();
+    secondPath.Delete();
+    thirdPath.Delete();
+
+    DirectoryWatcher watcher;
+    ASSERT_TRUE( watcher.Initialize( 50 ) );
+    ASSERT_TRUE( watcher.AddDirectory( rootDirectory ) );
+
+    DynamicArray< DirectoryWatcher::Change > changes;
+
+    // A burst of writes to a file in a subdirectory is reported once
+    WriteDirectoryWatcherTestFile( firstPath, 4 );
+    WriteDirectoryWatcherTestFile( firstPath, 2 );
+    PollDirectoryWatcherTest( watcher, changes );
+    ASSERT_EQ( 1, changes.GetSize() );
+    EXPECT_EQ( DirectoryWatcher::CHANGE_MODIFIED, changes[ 0 ].type );
+    EXPECT_STREQ( firstPath.c_str(), changes[ 0 ].path.c_str() );
+
+    // Renames report both paths
+    ASSERT_TRUE( firstPath.Move( secondPath ) );
+    PollDirectoryWatcherTest( watcher, changes );
+    ASSERT_EQ( 1, changes.GetSize() );
+    EXPECT_EQ( DirectoryWatcher::CHANGE_RENAMED, changes[ 0 ].type );
+    EXPECT_STREQ( secondPath.c_str(), changes[ 0 ].path.c_str() );
+    EXPECT_STREQ( firstPath.c_str(), changes[ 0 ].oldPath.c_str() );
+
+    // Files in directories created after watching started are reported
+    ASSERT_TRUE( newDirectory.MakePath() );
+    WriteDirectoryWatcherTestFile( thirdPath, 1 );
+    PollDirectoryWatcherTest( watcher, changes );
+    bool bFoundThird = false;
+    for( size_t changeIndex = 0; changeIndex < changes.GetSize(); ++changeIndex )
+    {
+        if( changes[ changeIndex ].path.Get() == thirdPath.Get() )
+        {
+            EXPECT_EQ( DirectoryWatcher::CHANGE_MODIFIED, changes[ changeIndex ].type );
+            bFoundThird = true;
+        }
+    }
+    EXPECT_TRUE( bFoundThird );
+
+    // Removals are reported
+    ASSERT_TRUE( secondPath.Delete() );
+    PollDirectoryWatcherTest( watcher, changes );
+    ASSERT_EQ( 1, changes.GetSize() );
+    EXPECT_EQ( DirectoryWatcher::CHANGE_REMOVED, changes[ 0 ].type );
+    EXPECT_STREQ( secondPath.c_str(), changes[ 0 ].path.c_str() );
+
+    watcher.Shutdown();
+    thirdPath.Delete();
+}
+#endif
+
 TEST(DataStructures, String)
 {
     String testString( TXT( "Test" ) );
@@ -368,4 +783,673 @@ TEST(Engine, PackageObjectTest)
     }
 }
 
-#endif
\ No newline at end of file
+static const size_t FIND_OBJECT_GROUP_COUNT = 64;
+static const size_t FIND_OBJECT_CHILD_COUNT = 256;
+static const size_t FIND_OBJECT_LOOKUPS_PER_JOB = 50000;
+
+struct FindObjectBenchmarkData
+{
+    DynamicArray< AssetPath > paths;
+    bool bSearchHierarchy;
+    volatile int32_t mismatchCount;
+};
+
+static void FindObjectBenchmarkFunction( void* pData, size_t itemIndex )
+{
+    FindObjectBenchmarkData* pBenchmark = static_cast< FindObjectBenchmarkData* >( pData );
+    size_t pathCount = pBenchmark->paths.GetSize();
+
+    for( size_t lookupIndex = 0; lookupIndex < FIND_OBJECT_LOOKUPS_PER_JOB; ++lookupIndex )
+    {
+        AssetPath path = pBenchmark->paths[ ( lookupIndex * 7919 + itemIndex ) % pathCount ];
+        Asset* pObject = ( pBenchmark->bSearchHierarchy ? Asset::FindObjectInHierarchy( path ) : Asset::FindObject( path ) );
+        if( !pObject || pObject->GetPath() != path )
+        {
+            AtomicIncrementRelease( pBenchmark->mismatchCount );
+        }
+    }
+}
+
+// Look up objects from every job pool thread at once, both through the path lookup map and by walking the object
+// hierarchy.
+TEST(Engine, FindObjectBenchmark)
+{
+    PackagePtr spRootPackage;
+    ASSERT_TRUE( Asset::Create< Package >( spRootPackage, Name( TXT( "FindObjectBenchmark" ) ), NULL ) );
+
+    FindObjectBenchmarkData benchmark;
+    benchmark.mismatchCount = 0;
+
+    DynamicArray< PackagePtr > packages;
+    for( size_t groupIndex = 0; groupIndex < FIND_OBJECT_GROUP_COUNT; ++groupIndex )
+    {
+        char name[ 32 ];
+        StringPrint( name, TXT( "Group%" ) PRIuSZ, groupIndex );
+
+        PackagePtr spGroup;
+        ASSERT_TRUE( Asset::Create< Package >( spGroup, Name( name ), spRootPackage ) );
+        benchmark.paths.Push( spGroup->GetPath() );
+
+        for( size_t childIndex = 0; childIndex < FIND_OBJECT_CHILD_COUNT; ++childIndex )
+        {
+            StringPrint( name, TXT( "Child%" ) PRIuSZ, childIndex );
+
+            PackagePtr spChild;
+            ASSERT_TRUE( Asset::Create< Package >( spChild, Name( name ), spGroup ) );
+            benchmark.paths.Push( spChild->GetPath() );
+            packages.Push( spChild );
+        }
+
+        packages.Push( spGroup );
+    }
+
+    JobPool& rJobPool = JobPool::GetStaticInstance();
+    size_t jobCount = rJobPool.GetConcurrency() * 4;
+
+    benchmark.bSearchHierarchy = true;
+    uint64_t startTicks = Timer::GetTickCount();
+    rJobPool.Run( &FindObjectBenchmarkFunction, &benchmark, jobCount );
+    float32_t hierarchyMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    benchmark.bSearchHierarchy = false;
+    startTicks = Timer::GetTickCount();
+    rJobPool.Run( &FindObjectBenchmarkFunction, &benchmark, jobCount );
+    float32_t mapMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    EXPECT_EQ( 0, benchmark.mismatchCount );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "FindObject: %" ) PRIuSZ TXT( " lookups of %" ) PRIuSZ TXT( " objects on %" ) PRIu32 TXT( " threads, hierarchy %.3f ms, map %.3f ms\n" ),
+        jobCount * FIND_OBJECT_LOOKUPS_PER_JOB,
+        benchmark.paths.GetSize(),
+        rJobPool.GetConcurrency(),
+        hierarchyMilliseconds,
+        mapMilliseconds );
+
+    // Renaming a package moves it and all of its children in the lookup map
+    Package* pGroup = packages.GetLast();
+    AssetPath oldGroupPath = pGroup->GetPath();
+    AssetPath oldChildPath = packages[ packages.GetSize() - 2 ]->GetPath();
+
+    Asset::RenameParameters renameParameters;
+    renameParameters.name.Set( TXT( "RenamedGroup" ) );
+    renameParameters.spOwner = spRootPackage;
+    ASSERT_TRUE( pGroup->Rename( renameParameters ) );
+
+    EXPECT_TRUE( Asset::FindObject( oldGroupPath ) == NULL );
+    EXPECT_TRUE( Asset::FindObject( oldChildPath ) == NULL );
+    EXPECT_EQ( pGroup, Asset::FindObject( pGroup->GetPath() ) );
+    EXPECT_EQ( packages[ packages.GetSize() - 2 ].Get(), Asset::FindObject( packages[ packages.GetSize() - 2 ]->GetPath() ) );
+    EXPECT_EQ( Asset::FindObjectInHierarchy( pGroup->GetPath() ), Asset::FindObject( pGroup->GetPath() ) );
+
+    // Destroyed objects can no longer be found
+    AssetPath childPath = packages[ 0 ]->GetPath();
+    packages.Clear();
+    EXPECT_TRUE( Asset::FindObject( childPath ) == NULL );
+}
+
+// Stand-in for render resource memory, so residency can be tested without a renderer.
+struct FakeResidencyAllocator
+{
+    size_t allocatedBytes;
+    size_t allocationCount;
+    size_t freeCount;
+};
+
+class FakeResidencyClient : public ResidencyClient
+{
+public:
+    FakeResidencyClient( FakeResidencyAllocator& rAllocator, size_t byteSize )
+        : m_pAllocator( &rAllocator )
+        , m_byteSize( byteSize )
+        , m_bAllocated( true )
+    {
+        m_pAllocator->allocatedBytes += m_byteSize;
+        ++m_pAllocator->allocationCount;
+    }
+
+    virtual void EvictResidentData()
+    {
+        EXPECT_TRUE( m_bAllocated );
+        m_pAllocator->allocatedBytes -= m_byteSize;
+        ++m_pAllocator->freeCount;
+        m_bAllocated = false;
+    }
+
+    virtual bool RestoreResidentData()
+    {
+        EXPECT_FALSE( m_bAllocated );
+        m_pAllocator->allocatedBytes += m_byteSize;
+        ++m_pAllocator->allocationCount;
+        m_bAllocated = true;
+
+        return true;
+    }
+
+    bool IsAllocated() const
+    {
+        return m_bAllocated;
+    }
+
+private:
+    FakeResidencyAllocator* m_pAllocator;
+    size_t m_byteSize;
+    bool m_bAllocated;
+};
+
+TEST(Engine, ResourceResidency)
+{
+    const size_t megabyte = 1 << 20;
+    const size_t textureCount = 8;
+
+    FakeResidencyAllocator allocator = { 0, 0, 0 };
+    ResourceResidencyManager manager;
+    manager.SetBudget( ResourceResidencyManager::CATEGORY_GPU, 4 * megabyte );
+
+    Name textureType( TXT( "FakeTexture" ) );
+    Name meshType( TXT( "FakeMesh" ) );
+
+    DynamicArray< FakeResidencyClient* > clients;
+    DynamicArray< size_t > handles;
+    for( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+    {
+        clients.Push( new FakeResidencyClient( allocator, megabyte ) );
+        handles.Push( manager.Register( clients.GetLast(), ResourceResidencyManager::CATEGORY_GPU, textureType, megabyte ) );
+    }
+
+    // CPU data has no budget, so it is never evicted
+    clients.Push( new FakeResidencyClient( allocator, 2 * megabyte ) );
+    size_t cpuHandle = manager.Register( clients.GetLast(), ResourceResidencyManager::CATEGORY_CPU, meshType, 2 * megabyte );
+
+    // Data registered during the current frame counts as used, so nothing can be evicted yet
+    manager.Update();
+    EXPECT_EQ( 0, manager.GetEvictionCount() );
+    EXPECT_EQ( 8 * megabyte, manager.GetResidentBytes( ResourceResidencyManager::CATEGORY_GPU ) );
+
+    // Anything not seen this frame is evicted, oldest first, until the budget is met
+    for( size_t textureIndex = 4; textureIndex < textureCount; ++textureIndex )
+    {
+        EXPECT_TRUE( manager.Touch( handles[ textureIndex ] ) );
+    }
+
+    manager.Update();
+    EXPECT_EQ( 4, manager.GetEvictionCount() );
+    EXPECT_EQ( 4 * megabyte, manager.GetResidentBytes( ResourceResidencyManager::CATEGORY_GPU ) );
+    for( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+    {
+        EXPECT_EQ( textureIndex >= 4, manager.IsResident( handles[ textureIndex ] ) );
+        EXPECT_EQ( textureIndex >= 4, clients[ textureIndex ]->IsAllocated() );
+    }
+
+    // Pinned data counts towards the budget but is never evicted, and data in use is kept even when over budget
+    clients.Push( new FakeResidencyClient( allocator, megabyte ) );
+    size_t pinnedHandle = manager.Register( clients.GetLast(), ResourceResidencyManager::CATEGORY_GPU, meshType, megabyte, true );
+
+    for( size_t textureIndex = 4; textureIndex < textureCount; ++textureIndex )
+    {
+        manager.Touch( handles[ textureIndex ] );
+    }
+
+    manager.Update();
+    EXPECT_EQ( 4, manager.GetEvictionCount() );
+    EXPECT_EQ( 5 * megabyte, manager.GetResidentBytes( ResourceResidencyManager::CATEGORY_GPU ) );
+
+    for( size_t textureIndex = 5; textureIndex < textureCount; ++textureIndex )
+    {
+        manager.Touch( handles[ textureIndex ] );
+    }
+
+    manager.Update();
+    EXPECT_EQ( 5, manager.GetEvictionCount() );
+    EXPECT_FALSE( manager.IsResident( handles[ 4 ] ) );
+    EXPECT_TRUE( manager.IsResident( pinnedHandle ) );
+    EXPECT_EQ( 4 * megabyte, manager.GetResidentBytes( ResourceResidencyManager::CATEGORY_GPU ) );
+
+    // Using evicted data restores it, which counts as churn and pushes out the least recently used data
+    EXPECT_FALSE( manager.Touch( handles[ 0 ] ) );
+    manager.Touch( handles[ 5 ] );
+    manager.Touch( handles[ 6 ] );
+
+    manager.Update();
+    EXPECT_TRUE( manager.IsResident( handles[ 0 ] ) );
+    EXPECT_TRUE( clients[ 0 ]->IsAllocated() );
+    EXPECT_FALSE( manager.IsResident( handles[ 7 ] ) );
+    EXPECT_EQ( 6, manager.GetEvictionCount() );
+    EXPECT_EQ( 6 * megabyte, manager.GetEvictedBytes() );
+    EXPECT_EQ( 1, manager.GetRestoreCount() );
+    EXPECT_EQ( megabyte, manager.GetRestoredBytes() );
+    EXPECT_EQ( 4 * megabyte, manager.GetResidentBytes( ResourceResidencyManager::CATEGORY_GPU ) );
+    EXPECT_EQ( 2 * megabyte, manager.GetResidentBytes( ResourceResidencyManager::CATEGORY_CPU ) );
+    EXPECT_TRUE( manager.IsResident( cpuHandle ) );
+
+    // The manager's accounting matches what was actually allocated
+    EXPECT_EQ( allocator.allocatedBytes, 6 * megabyte );
+    EXPECT_EQ( allocator.freeCount, manager.GetEvictionCount() );
+    EXPECT_EQ( allocator.allocationCount, clients.GetSize() + manager.GetRestoreCount() );
+
+    const DynamicArray< ResourceResidencyManager::TypeStatistics >& rTypeStatistics = manager.GetTypeStatistics();
+    ASSERT_EQ( 2, rTypeStatistics.GetSize() );
+    EXPECT_EQ( textureType, rTypeStatistics[ 0 ].type );
+    EXPECT_EQ( textureCount, rTypeStatistics[ 0 ].clientCount );
+    EXPECT_EQ( 3, rTypeStatistics[ 0 ].residentCount );
+    EXPECT_EQ( 3 * megabyte, rTypeStatistics[ 0 ].residentBytes );
+    EXPECT_EQ( 6, rTypeStatistics[ 0 ].evictionCount );
+    EXPECT_EQ( 1, rTypeStatistics[ 0 ].restoreCount );
+    EXPECT_EQ( meshType, rTypeStatistics[ 1 ].type );
+    EXPECT_EQ( 2, rTypeStatistics[ 1 ].residentCount );
+    EXPECT_EQ( 0, rTypeStatistics[ 1 ].evictionCount );
+
+    manager.TraceReport();
+
+    manager.ResetStatistics();
+    EXPECT_EQ( 0, manager.GetEvictionCount() );
+    EXPECT_EQ( 0, manager.GetRestoreCount() );
+    EXPECT_EQ( 0, rTypeStatistics[ 0 ].evictionCount );
+
+    for( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+    {
+        manager.Unregister( handles[ textureIndex ] );
+    }
+
+    manager.Unregister( cpuHandle );
+    manager.Unregister( pinnedHandle );
+    EXPECT_EQ( 0, manager.GetResidentBytes( ResourceResidencyManager::CATEGORY_GPU ) );
+    EXPECT_EQ( 0, manager.GetResidentBytes( ResourceResidencyManager::CATEGORY_CPU ) );
+
+    for( size_t clientIndex = 0; clientIndex < clients.GetSize(); ++clientIndex )
+    {
+        delete clients[ clientIndex ];
+    }
+}
+
+TEST(Graphics, TextureStreamingMipSelection)
+{
+    // 256x256 texture with a full mip chain
+    const uint32_t baseLevelSize = 256;
+    const uint32_t mipCount = 9;
+
+    // Pick the smallest mip level that is still at least as large as the texture appears on screen
+    EXPECT_EQ( 0, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, mipCount, 1000.0f ) );
+    EXPECT_EQ( 0, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, mipCount, 256.0f ) );
+    EXPECT_EQ( 0, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, mipCount, 200.0f ) );
+    EXPECT_EQ( 1, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, mipCount, 128.0f ) );
+    EXPECT_EQ( 1, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, mipCount, 100.0f ) );
+    EXPECT_EQ( 4, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, mipCount, 10.0f ) );
+    EXPECT_EQ( 8, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, mipCount, 0.5f ) );
+    EXPECT_EQ( 8, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, mipCount, 0.0f ) );
+
+    // Never pick a mip level past the end of a truncated mip chain
+    EXPECT_EQ( 2, TextureStreamingManager::ComputeDesiredMipIndex( baseLevelSize, 3, 1.0f ) );
+
+    TextureStreamingManager manager;
+    EXPECT_EQ( TextureStreamingManager::DEFAULT_INITIAL_MIP_COUNT, manager.GetInitialMipCount() );
+
+    // Only the smallest mip levels are loaded initially
+    manager.SetInitialMipCount( 4 );
+    EXPECT_EQ( 5, manager.GetInitialMipIndex( mipCount ) );
+    EXPECT_EQ( 0, manager.GetInitialMipIndex( 4 ) );
+    EXPECT_EQ( 0, manager.GetInitialMipIndex( 1 ) );
+
+    // Zero loads every mip level up front, disabling streaming
+    manager.SetInitialMipCount( 0 );
+    EXPECT_EQ( 0, manager.GetInitialMipIndex( mipCount ) );
+
+    // Updating without any registered textures is harmless
+    manager.SetBudget( 1024 );
+    manager.Update();
+    EXPECT_EQ( 0, manager.GetTargetBytes() );
+    EXPECT_EQ( 0, manager.GetStreamInCount() );
+    EXPECT_EQ( 0, manager.GetStreamOutCount() );
+}
+
+// Stand-in for a texture render resource, so streaming can be tested without a renderer.  Each stream takes one
+// extra update to finish loading, as a real texture would with pending async loads.
+class FakeStreamingTexture : public TextureStreamingClient
+{
+public:
+    explicit FakeStreamingTexture( uint32_t residentMipIndex )
+        : m_residentMipIndex( residentMipIndex )
+        , m_streamingMipIndex( Invalid< uint32_t >() )
+        , m_bLoadPending( false )
+        , m_bDetached( false )
+    {
+    }
+
+    virtual uint32_t GetResidentMipIndex() const
+    {
+        return m_residentMipIndex;
+    }
+
+    virtual bool IsStreamingMips() const
+    {
+        return IsValid( m_streamingMipIndex );
+    }
+
+    virtual uint32_t GetStreamingMipIndex() const
+    {
+        return m_streamingMipIndex;
+    }
+
+    virtual bool BeginStreamMips( uint32_t firstMipIndex )
+    {
+        EXPECT_FALSE( IsStreamingMips() );
+        EXPECT_TRUE( IsValid( m_residentMipIndex ) );
+        m_streamingMipIndex = firstMipIndex;
+        m_bLoadPending = true;
+
+        return true;
+    }
+
+    virtual bool TryFinishStreamMips()
+    {
+        if( m_bLoadPending )
+        {
+            m_bLoadPending = false;
+
+            return false;
+        }
+
+        if( IsValid( m_streamingMipIndex ) )
+        {
+            m_residentMipIndex = m_streamingMipIndex;
+            SetInvalid( m_streamingMipIndex );
+        }
+
+        return true;
+    }
+
+    virtual void DetachStreaming()
+    {
+        m_bDetached = true;
+    }
+
+    void Evict()
+    {
+        SetInvalid( m_residentMipIndex );
+    }
+
+    bool IsDetached() const
+    {
+        return m_bDetached;
+    }
+
+private:
+    uint32_t m_residentMipIndex;
+    uint32_t m_streamingMipIndex;
+    bool m_bLoadPending;
+    bool m_bDetached;
+};
+
+TEST(Graphics, TextureStreamingUpdate)
+{
+    // 256x256 texture with one byte per pixel
+    const uint32_t mipCount = 9;
+    DynamicArray< size_t > mipSizes;
+    for( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    {
+        mipSizes.Push( static_cast< size_t >( 1 ) << ( 2 * ( mipCount - 1 - mipIndex ) ) );
+    }
+
+    // Total size of the mip levels from each level to the end of the chain
+    const size_t fullSize = 87381;
+    const size_t fromMip1Size = 21845;
+    const size_t fromMip2Size = 5461;
+    const size_t initialSize = 21;
+
+    TextureStreamingManager* pManager = new TextureStreamingManager;
+    pManager->SetInitialMipCount( 4 );
+    const uint32_t initialMipIndex = pManager->GetInitialMipIndex( mipCount );
+    ASSERT_EQ( 5, initialMipIndex );
+
+    FakeStreamingTexture texture0( initialMipIndex );
+    FakeStreamingTexture texture1( initialMipIndex );
+    size_t handle0 = pManager->Register( &texture0, mipSizes );
+    size_t handle1 = pManager->Register( &texture1, mipSizes );
+
+    // Textures that are not requested keep their initial mip levels
+    pManager->Update();
+    EXPECT_EQ( 2 * initialSize, pManager->GetTargetBytes() );
+    EXPECT_EQ( 0, pManager->GetStreamInCount() );
+    EXPECT_FALSE( texture0.IsStreamingMips() );
+
+    // The most detailed mip level requested during a frame is streamed in, while the old levels stay in use
+    pManager->RequestMipIndex( handle0, 2 );
+    pManager->RequestMipIndex( handle0, 0 );
+    pManager->Update();
+    EXPECT_EQ( fullSize + initialSize, pManager->GetTargetBytes() );
+    EXPECT_EQ( 1, pManager->GetStreamInCount() );
+    EXPECT_EQ( 0, pManager->GetStreamOutCount() );
+    EXPECT_EQ( initialMipIndex, texture0.GetResidentMipIndex() );
+    EXPECT_EQ( 0, texture0.GetStreamingMipIndex() );
+
+    // Pending streams are advanced on later updates even without new requests
+    pManager->Update();
+    EXPECT_EQ( 0, texture0.GetResidentMipIndex() );
+    EXPECT_FALSE( texture0.IsStreamingMips() );
+    EXPECT_EQ( initialMipIndex, texture1.GetResidentMipIndex() );
+    EXPECT_EQ( 1, pManager->GetStreamInCount() );
+
+    // Over budget, detail is dropped from the least recently requested texture first, one mip level at a time
+    pManager->SetBudget( 100000 );
+    pManager->RequestMipIndex( handle1, 0 );
+    pManager->Update();
+    EXPECT_EQ( fromMip2Size + fullSize, pManager->GetTargetBytes() );
+    EXPECT_LE( pManager->GetTargetBytes(), pManager->GetBudget() );
+    EXPECT_EQ( 2, texture0.GetStreamingMipIndex() );
+    EXPECT_EQ( 0, texture1.GetStreamingMipIndex() );
+    EXPECT_EQ( 2, pManager->GetStreamInCount() );
+    EXPECT_EQ( 1, pManager->GetStreamOutCount() );
+
+    pManager->Update();
+    EXPECT_EQ( 2, texture0.GetResidentMipIndex() );
+    EXPECT_EQ( 0, texture1.GetResidentMipIndex() );
+    EXPECT_EQ( fromMip2Size + fullSize, pManager->GetTargetBytes() );
+
+    // Requests never go below the initial mip levels, and cannot make room by dropping the initial levels either
+    pManager->SetBudget( 1 );
+    pManager->Update();
+    EXPECT_EQ( 2 * initialSize, pManager->GetTargetBytes() );
+    EXPECT_EQ( initialMipIndex, texture0.GetStreamingMipIndex() );
+    EXPECT_EQ( initialMipIndex, texture1.GetStreamingMipIndex() );
+    EXPECT_EQ( 3, pManager->GetStreamOutCount() );
+
+    pManager->Update();
+    EXPECT_EQ( initialMipIndex, texture0.GetResidentMipIndex() );
+    EXPECT_EQ( initialMipIndex, texture1.GetResidentMipIndex() );
+
+    // Textures without resident data (i.e. evicted) are skipped entirely
+    pManager->SetBudget( 0 );
+    texture1.Evict();
+    pManager->RequestMipIndex( handle0, 1 );
+    pManager->RequestMipIndex( handle1, 0 );
+    pManager->Update();
+    EXPECT_EQ( fromMip1Size, pManager->GetTargetBytes() );
+    EXPECT_EQ( 1, texture0.GetStreamingMipIndex() );
+    EXPECT_FALSE( texture1.IsStreamingMips() );
+    EXPECT_EQ( 3, pManager->GetStreamInCount() );
+
+    // Unregistered textures are left alone, and textures still registered are detached when the manager goes away
+    pManager->Unregister( handle0 );
+    delete pManager;
+    EXPECT_FALSE( texture0.IsDetached() );
+    EXPECT_TRUE( texture1.IsDetached() );
+}
+
+TEST(Engine, AssetLoadTelemetry)
+{
+    AssetLoadTelemetry telemetry;
+    EXPECT_EQ( 0, telemetry.GetRecordCount() );
+
+    Name textureType( TXT( "Texture2d" ) );
+    Name meshType( TXT( "Mesh" ) );
+
+    AssetPath texturePath;
+    HELIUM_VERIFY( texturePath.Set( HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "TelemetryTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Texture" ) ) );
+    AssetPath meshPath;
+    HELIUM_VERIFY( meshPath.Set( HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "TelemetryTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "Mesh" ) ) );
+
+    AssetLoadTelemetry::Record record;
+    record.queuedTicks = 100;
+    record.bytesRead = 0;
+    record.deserializeTicks = 0;
+    record.bError = false;
+
+    // Two small textures
+    record.path = texturePath;
+    record.type = textureType;
+    record.stageEndTicks[ AssetLoadTelemetry::STAGE_PRELOAD ] = 110;
+    record.stageEndTicks[ AssetLoadTelemetry::STAGE_LINK ] = 115;
+    record.stageEndTicks[ AssetLoadTelemetry::STAGE_PRECACHE ] = 130;
+    record.stageEndTicks[ AssetLoadTelemetry::STAGE_FINALIZE ] = 132;
+    record.bytesRead = 1000;
+    record.deserializeTicks = 4;
+    EXPECT_EQ( 10, record.GetStageTicks( AssetLoadTelemetry::STAGE_PRELOAD ) );
+    EXPECT_EQ( 15, record.GetStageTicks( AssetLoadTelemetry::STAGE_PRECACHE ) );
+    EXPECT_EQ( 32, record.GetTotalTicks() );
+    telemetry.AddRecord( record );
+    telemetry.AddRecord( record );
+
+    // One slow mesh that failed to load
+    record.path = meshPath;
+    record.type = meshType;
+    record.stageEndTicks[ AssetLoadTelemetry::STAGE_PRELOAD ] = 200;
+    record.stageEndTicks[ AssetLoadTelemetry::STAGE_LINK ] = 200;
+    record.stageEndTicks[ AssetLoadTelemetry::STAGE_PRECACHE ] = 200;
+    record.stageEndTicks[ AssetLoadTelemetry::STAGE_FINALIZE ] = 200;
+    record.bytesRead = 5000;
+    record.deserializeTicks = 50;
+    record.bError = true;
+    EXPECT_EQ( 0, record.GetStageTicks( AssetLoadTelemetry::STAGE_LINK ) );
+    telemetry.AddRecord( record );
+
+    EXPECT_EQ( 3, telemetry.GetRecordCount() );
+
+    // Type statistics are sorted from slowest to fastest
+    DynamicArray< AssetLoadTelemetry::TypeStatistics > typeStatistics;
+    telemetry.GetTypeStatistics( typeStatistics );
+    ASSERT_EQ( 2, typeStatistics.GetSize() );
+
+    EXPECT_EQ( meshType, typeStatistics[ 0 ].type );
+    EXPECT_EQ( 1, typeStatistics[ 0 ].loadCount );
+    EXPECT_EQ( 1, typeStatistics[ 0 ].errorCount );
+    EXPECT_EQ( 100, typeStatistics[ 0 ].totalTicks );
+
+    EXPECT_EQ( textureType, typeStatistics[ 1 ].type );
+    EXPECT_EQ( 2, typeStatistics[ 1 ].loadCount );
+    EXPECT_EQ( 0, typeStatistics[ 1 ].errorCount );
+    EXPECT_EQ( 2000, typeStatistics[ 1 ].bytesRead );
+    EXPECT_EQ( 8, typeStatistics[ 1 ].deserializeTicks );
+    EXPECT_EQ( 30, typeStatistics[ 1 ].stageTicks[ AssetLoadTelemetry::STAGE_PRECACHE ] );
+    EXPECT_EQ( 64, typeStatistics[ 1 ].totalTicks );
+    EXPECT_EQ( 32, typeStatistics[ 1 ].maxTicks );
+
+    telemetry.TraceReport();
+
+    FilePath userDataDirectory;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( userDataDirectory ) );
+    FilePath tracePath( userDataDirectory + TXT( "AssetLoadTelemetryTest.json" ) );
+    EXPECT_TRUE( telemetry.WriteTraceFile( tracePath ) );
+    ASSERT_TRUE( tracePath.Exists() );
+
+    DynamicArray< char > traceText;
+    FileStream* pTraceStream = FileStream::OpenFileStream( tracePath, FileStream::MODE_READ );
+    ASSERT_TRUE( pTraceStream != NULL );
+    traceText.Resize( static_cast< size_t >( pTraceStream->GetSize() ) );
+    EXPECT_EQ( traceText.GetSize(), pTraceStream->Read( traceText.GetData(), 1, traceText.GetSize() ) );
+    traceText.Push( TXT( '\0' ) );
+    delete pTraceStream;
+    tracePath.Delete();
+
+    // Each record is written as a load event with a nested event for each stage, and the mesh load (the third record)
+    // starts when the trace starts
+    const char* pBeginEventText = TXT( "\"ph\": \"b\"" );
+    size_t beginEventCount = 0;
+    for( const char* pEvent = strstr( traceText.GetData(), pBeginEventText ); pEvent; pEvent = strstr( pEvent + 1, pBeginEventText ) )
+    {
+        ++beginEventCount;
+    }
+    EXPECT_EQ( 3 * ( 1 + AssetLoadTelemetry::STAGE_MAX ), beginEventCount );
+    EXPECT_TRUE( strstr( traceText.GetData(), *meshPath.ToString() ) != NULL );
+    EXPECT_TRUE( strstr( traceText.GetData(), *texturePath.ToString() ) != NULL );
+    EXPECT_TRUE( strstr( traceText.GetData(), TXT( "\"cat\": \"Mesh\", \"ph\": \"b\", \"id\": 2, \"ts\": 0.000" ) ) != NULL );
+    EXPECT_TRUE( strstr( traceText.GetData(), TXT( "\"name\": \"Precache\", \"cat\": \"Texture2d\"" ) ) != NULL );
+    EXPECT_TRUE( strstr( traceText.GetData(), TXT( "\"bytesRead\": 5000" ) ) != NULL );
+    EXPECT_TRUE( strstr( traceText.GetData(), TXT( "\"error\": true" ) ) != NULL );
+
+    telemetry.Reset();
+    EXPECT_EQ( 0, telemetry.GetRecordCount() );
+    telemetry.GetTypeStatistics( typeStatistics );
+    EXPECT_EQ( 0, typeStatistics.GetSize() );
+
+    // Only the most recent records are kept, while type statistics still cover every load
+    AssetLoadTelemetry boundedTelemetry( 2 );
+    record.path = texturePath;
+    boundedTelemetry.AddRecord( record );
+    record.path = meshPath;
+    boundedTelemetry.AddRecord( record );
+    record.path = texturePath;
+    record.bytesRead = 1;
+    boundedTelemetry.AddRecord( record );
+
+    EXPECT_EQ( 2, boundedTelemetry.GetRecordCount() );
+    EXPECT_EQ( 1, boundedTelemetry.GetDroppedRecordCount() );
+
+    DynamicArray< AssetLoadTelemetry::Record > records;
+    boundedTelemetry.GetRecords( records );
+    ASSERT_EQ( 2, records.GetSize() );
+    EXPECT_EQ( meshPath, records[ 0 ].path );
+    EXPECT_EQ( texturePath, records[ 1 ].path );
+    EXPECT_EQ( 1, records[ 1 ].bytesRead );
+
+    boundedTelemetry.GetTypeStatistics( typeStatistics );
+    ASSERT_EQ( 1, typeStatistics.GetSize() );
+    EXPECT_EQ( 3, typeStatistics[ 0 ].loadCount );
+
+    boundedTelemetry.Reset();
+    EXPECT_EQ( 0, boundedTelemetry.GetRecordCount() );
+    EXPECT_EQ( 0, boundedTelemetry.GetDroppedRecordCount() );
+}
+
+TEST(Engine, AssetLoaderTelemetry)
+{
+    AssetPath testPath;
+    HELIUM_VERIFY( testPath.Set( HELIUM_PACKAGE_PATH_CHAR_STRING TXT( "EngineTest" ) HELIUM_OBJECT_PATH_CHAR_STRING TXT( "TestObject" ) ) );
+
+    AssetLoadTelemetry& rTelemetry = gAssetLoader->GetLoadTelemetry();
+    rTelemetry.Reset();
+
+    // Force a reload so that the object goes through every load stage again
+    AssetPtr spObject;
+    HELIUM_VERIFY( gAssetLoader->LoadObject( testPath, spObject, true ) );
+    ASSERT_TRUE( spObject );
+
+    DynamicArray< AssetLoadTelemetry::Record > records;
+    rTelemetry.GetRecords( records );
+
+    const AssetLoadTelemetry::Record* pRecord = NULL;
+    for( size_t recordIndex = 0; recordIndex < records.GetSize(); ++recordIndex )
+    {
+        if( records[ recordIndex ].path == testPath )
+        {
+            pRecord = &records[ recordIndex ];
+        }
+    }
+    ASSERT_TRUE( pRecord != NULL );
+
+    // Every stage is stamped in order, and the record is tagged with the asset type
+    EXPECT_FALSE( pRecord->bError );
+    EXPECT_EQ( spObject->GetAssetType()->GetName(), pRecord->type );
+    EXPECT_NE( 0, pRecord->queuedTicks );
+
+    uint64_t previousTicks = pRecord->queuedTicks;
+    for( size_t stageIndex = 0; stageIndex < AssetLoadTelemetry::STAGE_MAX; ++stageIndex )
+    {
+        EXPECT_LE( previousTicks, pRecord->stageEndTicks[ stageIndex ] );
+        previousTicks = pRecord->stageEndTicks[ stageIndex ];
+    }
+
+    rTelemetry.Reset();
+}
+
+#endif
@@ -0,0 +1,207 @@
+#include "TestAppPch.h"
+
+#if GTEST
+
+#include "GraphicsTypes/TransformBatch.h"
+#include "GraphicsTypes/GraphicsSceneObject.h"
+#include "GraphicsJobs/GraphicsJobsInterface.h"
+
+using namespace Helium;
+
+namespace
+{
+    void FillTransforms(
+        size_t transformCount,
+        DynamicArray< Simd::Vector3 > &rPositions,
+        DynamicArray< Simd::Quat > &rRotations,
+        DynamicArray< float32_t > &rScales )
+    {
+        rPositions.Resize( transformCount );
+        rRotations.Resize( transformCount );
+        rScales.Resize( transformCount );
+
+        for ( size_t i = 0; i < transformCount; ++i )
+        {
+            float32_t value = static_cast< float32_t >( i );
+            rPositions[ i ] = Simd::Vector3( value, -0.5f * value, 2.0f + value );
+            rRotations[ i ] = Simd::Quat( 0.01f * value, 0.02f * value, -0.03f * value );
+            rScales[ i ] = 0.5f + 0.001f * value;
+        }
+    }
+
+    Simd::Matrix44 BuildReferenceMatrix( const Simd::Vector3 &rPosition, const Simd::Quat &rRotation, float32_t scale )
+    {
+        Simd::Matrix44 matrix( Simd::Matrix44::INIT_ROTATION_TRANSLATION, rRotation, rPosition );
+        matrix.ScaleLocal( scale );
+
+        return matrix;
+    }
+}
+
+TEST(Graphics, TransformBatchMatchesMatrix44)
+{
+    // Not a multiple of the SIMD width, so the padded tail is covered as well
+    const size_t transformCount = 37;
+
+    DynamicArray< Simd::Vector3 > positions;
+    DynamicArray< Simd::Quat > rotations;
+    DynamicArray< float32_t > scales;
+    FillTransforms( transformCount, positions, rotations, scales );
+
+    DynamicArray< Simd::Matrix44 > matrices;
+    matrices.Resize( transformCount );
+    BuildTransformMatrices( positions.GetData(), rotations.GetData(), scales.GetData(), transformCount, matrices.GetData() );
+
+    for ( size_t i = 0; i < transformCount; ++i )
+    {
+        Simd::Matrix44 reference = BuildReferenceMatrix( positions[ i ], rotations[ i ], scales[ i ] );
+
+        for ( size_t element = 0; element < 16; ++element )
+        {
+            EXPECT_NEAR( reference.GetElement( element ), matrices[ i ].GetElement( element ), 1.0e-5f );
+        }
+    }
+}
+
+TEST(Graphics, TransformBatchTransposeMatchesSingle)
+{
+    // Each matrix goes to its own destination, in both layouts
+    const size_t matrixCount = 37;
+
+    DynamicArray< Simd::Vector3 > positions;
+    DynamicArray< Simd::Quat > rotations;
+    DynamicArray< float32_t > scales;
+    FillTransforms( matrixCount, positions, rotations, scales );
+
+    DynamicArray< Simd::Matrix44 > matrices;
+    matrices.Resize( matrixCount );
+    BuildTransformMatrices( positions.GetData(), rotations.GetData(), scales.GetData(), matrixCount, matrices.GetData() );
+
+    const TransposedMatrixLayout layouts[] = { TransposedMatrixLayouts::Rows3x4, TransposedMatrixLayouts::Rows4x4 };
+    for ( size_t layoutIndex = 0; layoutIndex < HELIUM_ARRAY_COUNT( layouts ); ++layoutIndex )
+    {
+        TransposedMatrixLayout layout = layouts[ layoutIndex ];
+        size_t floatCount = GetTransposedMatrixFloatCount( layout );
+
+        DynamicArray< float32_t > expected;
+        DynamicArray< float32_t > batched;
+        expected.Resize( matrixCount * floatCount );
+        batched.Resize( matrixCount * floatCount );
+
+        DynamicArray< const Simd::Matrix44* > matrixPointers;
+        DynamicArray< float32_t* > destinations;
+        for ( size_t i = 0; i < matrixCount; ++i )
+        {
+            StoreTransposedMatrix( matrices[ i ], &expected[ i * floatCount ], layout );
+
+            matrixPointers.Push( &matrices[ i ] );
+            destinations.Push( &batched[ i * floatCount ] );
+        }
+
+        StoreTransposedMatrices( matrixPointers.GetData(), destinations.GetData(), matrixCount, layout );
+
+        for ( size_t element = 0; element < matrixCount * floatCount; ++element )
+        {
+            EXPECT_EQ( expected[ element ], batched[ element ] );
+        }
+    }
+}
+
+TEST(Graphics, UpdateGraphicsSceneObjectBuffersMatchesSingle)
+{
+    // More than one gathered batch, with some objects lacking a constant buffer
+    const size_t sceneObjectCount = 150;
+    const size_t floatCount = GetTransposedMatrixFloatCount( TransposedMatrixLayouts::Rows3x4 );
+
+    DynamicArray< Simd::Vector3 > positions;
+    DynamicArray< Simd::Quat > rotations;
+    DynamicArray< float32_t > scales;
+    FillTransforms( sceneObjectCount, positions, rotations, scales );
+
+    DynamicArray< Simd::Matrix44 > matrices;
+    matrices.Resize( sceneObjectCount );
+    BuildTransformMatrices(
+        positions.GetData(), rotations.GetData(), scales.GetData(), sceneObjectCount, matrices.GetData() );
+
+    DynamicArray< GraphicsSceneObject > sceneObjects;
+    sceneObjects.Resize( sceneObjectCount );
+
+    DynamicArray< float32_t > expected;
+    DynamicArray< float32_t > constantBuffers;
+    expected.Resize( sceneObjectCount * floatCount );
+    constantBuffers.Resize( sceneObjectCount * floatCount );
+    MemoryZero( expected.GetData(), expected.GetSize() * sizeof( float32_t ) );
+    MemoryZero( constantBuffers.GetData(), constantBuffers.GetSize() * sizeof( float32_t ) );
+
+    DynamicArray< float32_t* > constantBufferPointers;
+    for ( size_t i = 0; i < sceneObjectCount; ++i )
+    {
+        sceneObjects[ i ].SetTransform( matrices[ i ] );
+
+        if ( i % 7 == 3 )
+        {
+            constantBufferPointers.Push( NULL );
+            continue;
+        }
+
+        StoreTransposedMatrix( matrices[ i ], &expected[ i * floatCount ], TransposedMatrixLayouts::Rows3x4 );
+        constantBufferPointers.Push( &constantBuffers[ i * floatCount ] );
+    }
+
+    UpdateGraphicsSceneObjectBuffersJob job;
+    UpdateGraphicsSceneObjectBuffersJob::Parameters& rParameters = job.GetParameters();
+    rParameters.sceneObjectCount = static_cast< uint32_t >( sceneObjectCount );
+    rParameters.pSceneObjects = sceneObjects.GetData();
+    rParameters.ppConstantBufferData = constantBufferPointers.GetData();
+    job.Run();
+
+    for ( size_t element = 0; element < sceneObjectCount * floatCount; ++element )
+    {
+        EXPECT_EQ( expected[ element ], constantBuffers[ element ] );
+    }
+}
+
+TEST(Graphics, TransformBatchBenchmark)
+{
+    const size_t transformCount = 100000;
+
+    DynamicArray< Simd::Vector3 > positions;
+    DynamicArray< Simd::Quat > rotations;
+    DynamicArray< float32_t > scales;
+    FillTransforms( transformCount, positions, rotations, scales );
+
+    DynamicArray< float32_t > constantBuffer;
+    constantBuffer.Resize( transformCount * GetTransposedMatrixFloatCount( TransposedMatrixLayouts::Rows3x4 ) );
+
+    // One matrix at a time, the way scene objects were synchronized before
+    uint64_t startTicks = Timer::GetTickCount();
+    for ( size_t i = 0; i < transformCount; ++i )
+    {
+        Simd::Matrix44 matrix = BuildReferenceMatrix( positions[ i ], rotations[ i ], scales[ i ] );
+        StoreTransposedMatrix( matrix, &constantBuffer[ i * 12 ], TransposedMatrixLayouts::Rows3x4 );
+    }
+    float32_t individualMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    DynamicArray< Simd::Matrix44 > matrices;
+    matrices.Resize( transformCount );
+
+    startTicks = Timer::GetTickCount();
+    BuildTransformMatrices(
+        positions.GetData(), rotations.GetData(), scales.GetData(), transformCount, matrices.GetData() );
+    for ( size_t i = 0; i < transformCount; ++i )
+    {
+        StoreTransposedMatrix( matrices[ i ], &constantBuffer[ i * 12 ], TransposedMatrixLayouts::Rows3x4 );
+    }
+    float32_t batchMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "Transform batch: %" PRIuSZ " transforms, individual %.3f ms, batched %.3f ms\n" ),
+        transformCount,
+        individualMilliseconds,
+        batchMilliseconds );
+
+    EXPECT_EQ( constantBuffer[ 3 ], positions[ 0 ].GetElement( 0 ) );
+}
+
+#endif
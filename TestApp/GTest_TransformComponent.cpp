@@ -0,0 +1,155 @@
+#include "TestAppPch.h"
+
+#if GTEST
+
+#include "Framework/Components.h"
+#include "Components/ComponentTasks.h"
+#include "Components/TransformComponent.h"
+#include "GraphicsTypes/TransformBatch.h"
+
+using namespace Helium;
+
+namespace
+{
+    class TransformHost : public Components::IHasComponents
+    {
+    public:
+        TransformHost( ComponentManager &rManager )
+            : m_rManager( rManager )
+        {
+        }
+
+        TransformComponent *AllocateTransform()
+        {
+            return m_rManager.Allocate< TransformComponent >( this, m_Components );
+        }
+
+        virtual ComponentManager* VirtualGetComponentManager()
+        {
+            return &m_rManager;
+        }
+
+        virtual ComponentCollection& VirtualGetComponents()
+        {
+            return m_Components;
+        }
+
+    private:
+        ComponentManager &m_rManager;
+        ComponentCollection m_Components;
+    };
+
+    void ExpectMatricesNear( const Simd::Matrix44 &rExpected, const Simd::Matrix44 &rActual )
+    {
+        for ( size_t element = 0; element < 16; ++element )
+        {
+            EXPECT_NEAR( rExpected.GetElement( element ), rActual.GetElement( element ), 1.0e-4f );
+        }
+    }
+
+    void ExpectRootWorldMatrix( const TransformComponent &rRoot )
+    {
+        Simd::Matrix44 expected;
+        BuildTransformMatrices( &rRoot.GetPosition(), &rRoot.GetRotation(), &rRoot.m_Scale, 1, &expected );
+
+        ExpectMatricesNear( expected, rRoot.GetWorldMatrix() );
+    }
+
+    void ExpectChildWorldMatrix( const TransformComponent &rChild, const TransformComponent &rParent )
+    {
+        Simd::Matrix44 local;
+        BuildTransformMatrices(
+            &rChild.GetLocalPosition(), &rChild.GetLocalRotation(), &rChild.m_LocalScale, 1, &local );
+
+        Simd::Matrix44 expected;
+        expected.MultiplySet( local, rParent.GetWorldMatrix() );
+
+        ExpectMatricesNear( expected, rChild.GetWorldMatrix() );
+
+        // The decomposed world position follows the matrix
+        Simd::Vector3 position = rChild.GetPosition();
+        EXPECT_NEAR( expected.GetElement( 12 ), position.GetX(), 1.0e-4f );
+        EXPECT_NEAR( expected.GetElement( 13 ), position.GetY(), 1.0e-4f );
+        EXPECT_NEAR( expected.GetElement( 14 ), position.GetZ(), 1.0e-4f );
+    }
+}
+
+TEST(Components, TransformHierarchyPropagation)
+{
+    ComponentManagerPtr spManager( Components::CreateManager( NULL ) );
+
+    {
+        TransformHost host( *spManager );
+
+        // Two roots, with a parent -> child -> grandchild chain under the first one
+        TransformComponent *pRoot = host.AllocateTransform();
+        TransformComponent *pChild = host.AllocateTransform();
+        TransformComponent *pGrandchild = host.AllocateTransform();
+        TransformComponent *pOtherRoot = host.AllocateTransform();
+        ASSERT_TRUE( pRoot && pChild && pGrandchild && pOtherRoot );
+
+        pRoot->SetPosition( Simd::Vector3( 1.0f, 2.0f, 3.0f ) );
+        pRoot->SetRotation( Simd::Quat( 0.0f, 0.5f, 0.0f ) );
+        pRoot->SetScale( 2.0f );
+
+        pOtherRoot->SetPosition( Simd::Vector3( -4.0f, 0.0f, 1.0f ) );
+        pOtherRoot->SetRotation( Simd::Quat( 0.25f, 0.0f, 0.0f ) );
+
+        pChild->SetParent( pRoot );
+        pChild->SetLocalPosition( Simd::Vector3( 0.0f, 1.0f, 0.0f ) );
+        pChild->SetLocalRotation( Simd::Quat( 0.3f, 0.0f, 0.0f ) );
+        pChild->SetLocalScale( 0.5f );
+
+        pGrandchild->SetParent( pChild );
+        pGrandchild->SetLocalPosition( Simd::Vector3( 2.0f, 0.0f, -1.0f ) );
+        pGrandchild->SetLocalRotation( Simd::Quat( 0.0f, 0.0f, 0.2f ) );
+        pGrandchild->SetLocalScale( 1.5f );
+
+        EXPECT_EQ( 0u, pRoot->GetDepth() );
+        EXPECT_EQ( 1u, pChild->GetDepth() );
+        EXPECT_EQ( 2u, pGrandchild->GetDepth() );
+        EXPECT_EQ( 0u, pOtherRoot->GetDepth() );
+
+        PropagateTransforms( *spManager );
+
+        ExpectRootWorldMatrix( *pRoot );
+        ExpectRootWorldMatrix( *pOtherRoot );
+        ExpectChildWorldMatrix( *pChild, *pRoot );
+        ExpectChildWorldMatrix( *pGrandchild, *pChild );
+
+        pRoot->ClearDirtyFlag();
+        pChild->ClearDirtyFlag();
+        pGrandchild->ClearDirtyFlag();
+        pOtherRoot->ClearDirtyFlag();
+
+        // Move the grandchild under the other root and move the first root. Only the dirty paths are recomputed,
+        // and both have to land on parentWorld * local.
+        pGrandchild->SetParent( pOtherRoot );
+        pRoot->SetPosition( Simd::Vector3( 0.0f, 5.0f, 0.0f ) );
+
+        EXPECT_EQ( pOtherRoot, pGrandchild->GetParent() );
+        EXPECT_EQ( 1u, pGrandchild->GetDepth() );
+        EXPECT_EQ( 1u, pChild->GetDepth() );
+
+        PropagateTransforms( *spManager );
+
+        ExpectRootWorldMatrix( *pRoot );
+        ExpectChildWorldMatrix( *pChild, *pRoot );
+        ExpectChildWorldMatrix( *pGrandchild, *pOtherRoot );
+
+        // UpdateWorldMatrices on its own recomputes a level whose parent changed
+        pOtherRoot->ClearDirtyFlag();
+        pGrandchild->ClearDirtyFlag();
+        pOtherRoot->SetRotation( Simd::Quat( 0.0f, 0.0f, 0.6f ) );
+
+        TransformComponent *pLevel0[] = { pOtherRoot };
+        TransformComponent *pLevel1[] = { pGrandchild };
+        TransformComponent::UpdateWorldMatrices( pLevel0, 1 );
+        TransformComponent::UpdateWorldMatrices( pLevel1, 1 );
+
+        ExpectRootWorldMatrix( *pOtherRoot );
+        ExpectChildWorldMatrix( *pGrandchild, *pOtherRoot );
+    }
+}
+
+#endif
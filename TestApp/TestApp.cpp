@@ -89,6 +89,7 @@ int main( int argc, const char* argv[] )
 #endif
 
 	AsyncLoader::GetStaticInstance().Initialize();
+	JobPool::GetStaticInstance().Initialize();
 
 	FilePath baseDirectory;
 	if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
@@ -386,8 +387,6 @@ int main( int argc, const char* argv[] )
 		Helium::StrongPtr<Helium::Texture2d> texture;
 		gAssetLoader->LoadObject( AssetPath( TXT( "/Textures:Triangle.png" ) ), texture);
 
-		Helium::RTexture2d *rTexture2d = texture->GetRenderResource2d();
-
 
 		while( windowData.bProcessMessages )
 		{
@@ -442,7 +441,7 @@ int main( int argc, const char* argv[] )
 
 
 			transform.SetRotationTranslationScaling(rotation, location, scale);
-			rSceneDrawer.DrawTexturedQuad(rTexture2d, transform, Simd::Vector2(0.0f, 0.0f), Simd::Vector2(0.5f, 0.5f));
+			rSceneDrawer.DrawTexturedQuad(texture->GetRenderResource2d(), transform, Simd::Vector2(0.0f, 0.0f), Simd::Vector2(0.5f, 0.5f));
 #endif
 
 			//Helium::Simd::Vector3 up = Simd::Vector3::BasisY;
@@ -493,6 +492,7 @@ int main( int argc, const char* argv[] )
 					RenderResourceManager::DestroyStaticInstance();
 
 					Renderer::DestroyStaticInstance();
+					TextureStreamingManager::DestroyStaticInstance();
 
 					break;
 				}
@@ -539,6 +539,7 @@ int main( int argc, const char* argv[] )
 	Helium::Input::Cleanup();
 
 	Renderer::DestroyStaticInstance();
+	TextureStreamingManager::DestroyStaticInstance();
 
 	Config::DestroyStaticInstance();
 
@@ -547,6 +548,7 @@ int main( int argc, const char* argv[] )
 #endif
 	AssetLoader::DestroyStaticInstance();
 	CacheManager::DestroyStaticInstance();
+	JobPool::DestroyStaticInstance();
 
 	Helium::Components::Cleanup();
 
@@ -554,6 +556,7 @@ int main( int argc, const char* argv[] )
 	Reflect::Cleanup();
 	AssetType::Shutdown();
 	Asset::Shutdown();
+	ResourceResidencyManager::DestroyStaticInstance();
 
 
 	Reflect::ObjectRefCountSupport::Shutdown();
@@ -10,6 +10,7 @@
 #include "Foundation/FilePath.h"
 #include "Foundation/FileStream.h"
 #include "Engine/AsyncLoader.h"
+#include "Engine/JobPool.h"
 #include "Foundation/Map.h"
 #include "Foundation/SortedMap.h"
 #include "Foundation/SortedSet.h"
@@ -33,6 +34,7 @@
 #include "Graphics/GraphicsConfig.h"
 #include "Graphics/Material.h"
 #include "Graphics/RenderResourceManager.h"
+#include "Graphics/TextureStreamingManager.h"
 #include "GraphicsJobs/GraphicsJobs.h"
 #include "Framework/Slice.h"
 #include "Graphics/Mesh.h"
@@ -163,6 +163,83 @@ project( prefix .. "EditorScene" )
 		}
 	end
 
+project( prefix .. "Cook" )
+
+	kind "ConsoleApp"
+
+	Helium.DoBasicProjectSettings()
+	Helium.DoGraphicsProjectSettings()
+	Helium.DoFbxProjectSettings()
+
+	files
+	{
+		"Cook/**.h",
+		"Cook/**.cpp",
+	}
+
+	defines
+	{
+		"HELIUM_MODULE=Cook",
+	}
+
+	includedirs
+	{
+		"Dependencies/freetype/include",
+		"Dependencies/bullet/src",
+		"Example",
+	}
+
+	if os.get() == "windows" then
+		pchheader( "CookPch.h" )
+		pchsource( "Cook/CookPch.cpp" )
+	else
+		includedirs
+		{
+			"Cook",
+		}
+	end
+
+	links
+	{
+		prefix .. "ExampleGame",
+		prefix .. "Bullet",
+		prefix .. "Components",
+		prefix .. "PreprocessingPc",
+		prefix .. "PcSupport",
+		prefix .. "EditorSupport",
+		prefix .. "Framework",
+		prefix .. "Graphics",
+		prefix .. "GraphicsJobs",
+		prefix .. "GraphicsTypes",
+		prefix .. "Rendering",
+		prefix .. "EngineJobs",
+		prefix .. "Engine",
+
+		-- core
+		prefix .. "MathSimd",
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+
+		"bullet",
+		"mongo-c",
+		"zlib",
+	}
+
+	configuration "linux"
+		links
+		{
+			"pthread",
+			"dl",
+			"rt",
+			"m",
+			"stdc++",
+		}
+
+	configuration {}
+
 project( prefix .. "Editor" )
 
 	kind "ConsoleApp"
@@ -262,6 +339,7 @@ project( prefix .. "Editor" )
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	configuration "linux"